@@ -0,0 +1,67 @@
+/**
+ * @file bench_builder_cpp.cpp
+ * @brief Benchmark de cprint::Builder frente a std::ostringstream
+ *
+ * Arma la misma línea (texto, enteros, flotantes y string_view) con cada
+ * alternativa y extrae el resultado como std::string.
+ */
+
+#include "c_print_builder.hpp"
+#include <chrono>
+#include <cstdio>
+#include <sstream>
+#include <string>
+#include <string_view>
+
+static const int ITERATIONS = 200000;
+
+static volatile std::size_t sink_total = 0;
+
+template <typename Fn>
+static double measure_ns(Fn&& fn) {
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < ITERATIONS; i++) fn(i);
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count() / ITERATIONS;
+}
+
+static void report(const char* name, double ns, double baseline) {
+    std::printf("  %-28s %8.1f ns/op  (%.2fx)\n", name, ns, baseline / ns);
+}
+
+int main() {
+    const std::string user = "carlos-sweb";
+    std::string_view action = "checkout";
+
+    double ostream_ns = measure_ns([&](int i) {
+        std::ostringstream os;
+        os << "user=" << user << " action=" << action << " id=" << i
+           << " total=" << i * 0.25 << " items=" << (i & 15);
+        std::string line = std::move(os).str();
+        sink_total = sink_total + line.size();
+    });
+
+    double builder_ns = measure_ns([&](int i) {
+        cprint::Builder b;
+        b << "user=" << user << " action=" << action << " id=" << i
+          << " total=" << i * 0.25 << " items=" << (i & 15);
+        std::string line = std::move(b).str();
+        sink_total = sink_total + line.size();
+    });
+
+    double reused_ns = measure_ns([&](int i) {
+        static cprint::Builder b;
+        b.clear();
+        b << "user=" << user << " action=" << action << " id=" << i
+          << " total=" << i * 0.25 << " items=" << (i & 15);
+        sink_total = sink_total + b.view().size();
+    });
+
+    std::printf("\ncprint::Builder vs std::ostringstream (%d iterations)\n", ITERATIONS);
+    report("std::ostringstream", ostream_ns, ostream_ns);
+    report("cprint::Builder + str() &&", builder_ns, ostream_ns);
+    report("cprint::Builder reused", reused_ns, ostream_ns);
+    std::printf("\n");
+
+    return sink_total == 0;
+}
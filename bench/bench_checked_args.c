@@ -0,0 +1,61 @@
+/**
+ * @file bench_checked_args.c
+ * @brief Coste de c_print_checked_array() según el número de argumentos
+ *
+ * Los argumentos se leen por puntero sin copia previa, así que el coste
+ * por campo debe mantenerse constante al crecer el número de campos.
+ * La salida va a /dev/null.
+ */
+
+#define C_PRINT_USE_GENERIC
+#include "c_print_generic.h"
+#include "pattern_compiler.h"
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#define ITERATIONS 20000
+#define MAX_FIELDS 128
+
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+int main(void) {
+    static const int field_counts[] = { 4, 16, 64, 128 };
+    char pattern[MAX_FIELDS * 5 + 2];
+    CPrintArg args[MAX_FIELDS];
+    double results[sizeof(field_counts) / sizeof(field_counts[0])];
+
+    for (int i = 0; i < MAX_FIELDS; i++) args[i] = CPRINT_ARG(i * 37);
+
+    if (!freopen("/dev/null", "w", stdout)) return 1;
+
+    for (size_t n = 0; n < sizeof(field_counts) / sizeof(field_counts[0]); n++) {
+        int fields = field_counts[n];
+
+        pattern[0] = '\0';
+        for (int i = 0; i < fields; i++) strcat(pattern, "{d} ");
+        strcat(pattern, "\n");
+
+        double start = now_ns();
+        for (int it = 0; it < ITERATIONS; it++) {
+            c_print_checked_array(pattern, args, (size_t)fields);
+        }
+        results[n] = (now_ns() - start) / ITERATIONS;
+    }
+
+    fflush(stdout);
+    clear_pattern_cache();
+
+    fprintf(stderr, "\nc_print_checked_array (%d iterations, output to /dev/null)\n", ITERATIONS);
+    for (size_t n = 0; n < sizeof(field_counts) / sizeof(field_counts[0]); n++) {
+        fprintf(stderr, "  %3d fields: %9.1f ns/call  %6.1f ns/field\n",
+                field_counts[n], results[n], results[n] / field_counts[n]);
+    }
+    fprintf(stderr, "\n");
+
+    return 0;
+}
@@ -0,0 +1,166 @@
+/**
+ * @file bench_contention.c
+ * @brief Benchmark de contención: varios hilos imprimiendo a la vez
+ *
+ * Cada hilo imprime la misma cantidad de líneas a /dev/null por c_print,
+ * c_print_safe, C_PRINT, c_printf_styled y printf, con 1, 2, 4, ... hasta
+ * N hilos. Se informa el rendimiento agregado (líneas/s) y el coste por
+ * línea visto desde cada hilo, que crece con la espera en el lock de
+ * stdout.
+ *
+ * Si la biblioteca se compiló con C_PRINT_BATCH se agrega "c_print batch":
+ * c_print con c_print_batch_start(), donde cada hilo entrega lotes
+ * enteros en vez de tomar el lock una vez por línea.
+ *
+ * Uso:
+ *   bench_contention [líneas_por_hilo] [hilos_max]
+ */
+
+#define C_PRINT_USE_GENERIC
+#include "c_print.h"
+#include "c_print_generic.h"
+#include "c_print_safe.h"
+#include "c_print_batch.h"
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#define DEFAULT_LINES 50000
+#define DEFAULT_MAX_THREADS 8
+#define MAX_THREADS 64
+
+// ============================================================================
+// CASOS
+// ============================================================================
+
+typedef struct {
+    const char* name;
+    void (*print_line)(int thread, int i);
+    bool batched;               // Con c_print_batch_start()
+} ContentionCase;
+
+static void line_c_print(int thread, int i) {
+    c_print("[{d:>2}] request {d:05} from {s:cyan} took {f:.2} ms\n", thread, i, "10.0.0.1", i * 0.01);
+}
+
+static void line_safe(int thread, int i) {
+    c_print_safe("[{d:>2}] request {d:05} from {s:cyan} took {f:.2} ms\n", thread, i, "10.0.0.1", i * 0.01);
+}
+
+static void line_checked(int thread, int i) {
+    C_PRINT("[{d:>2}] request {d:05} from {s:cyan} took {f:.2} ms\n", thread, i, "10.0.0.1", i * 0.01);
+}
+
+static void line_styled(int thread, int i) {
+    c_printf_styled(COLOR_CYAN, BG_RESET, STYLE_RESET,
+                    "[%2d] request %05d from %s took %.2f ms\n", thread, i, "10.0.0.1", i * 0.01);
+}
+
+static void line_printf(int thread, int i) {
+    printf("[%2d] request %05d from \033[36m%s\033[0m took %.2f ms\n", thread, i, "10.0.0.1", i * 0.01);
+}
+
+static const ContentionCase cases[] = {
+    { "c_print", line_c_print },
+    { "c_print_safe", line_safe },
+    { "C_PRINT", line_checked },
+    { "c_printf_styled", line_styled },
+    { "printf", line_printf },
+    { "c_print batch", line_c_print, true },
+};
+
+#define CASE_COUNT (sizeof(cases) / sizeof(cases[0]))
+
+// ============================================================================
+// EJECUCIÓN
+// ============================================================================
+
+typedef struct {
+    const ContentionCase* c;
+    int id;
+    int lines;
+} Worker;
+
+static atomic_int ready;
+static atomic_bool go;
+
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+static void* worker_main(void* arg) {
+    const Worker* w = (const Worker*)arg;
+
+    atomic_fetch_add(&ready, 1);
+    while (!atomic_load(&go)) { }
+
+    for (int i = 0; i < w->lines; i++) w->c->print_line(w->id, i);
+    return NULL;
+}
+
+/**
+ * @brief Lanza los hilos a la vez y devuelve el tiempo total en ns
+ */
+static double run_case(const ContentionCase* c, int threads, int lines) {
+    pthread_t ids[MAX_THREADS];
+    Worker workers[MAX_THREADS];
+
+    atomic_store(&ready, 0);
+    atomic_store(&go, false);
+
+    for (int t = 0; t < threads; t++) {
+        workers[t].c = c;
+        workers[t].id = t;
+        workers[t].lines = lines;
+        pthread_create(&ids[t], NULL, worker_main, &workers[t]);
+    }
+    while (atomic_load(&ready) < threads) { }
+
+    double start = now_ns();
+    atomic_store(&go, true);
+    for (int t = 0; t < threads; t++) pthread_join(ids[t], NULL);
+    fflush(stdout);
+    return now_ns() - start;
+}
+
+int main(int argc, char** argv) {
+    int lines = argc > 1 ? atoi(argv[1]) : DEFAULT_LINES;
+    int max_threads = argc > 2 ? atoi(argv[2]) : DEFAULT_MAX_THREADS;
+    if (lines <= 0) lines = DEFAULT_LINES;
+    if (max_threads <= 0 || max_threads > MAX_THREADS) max_threads = DEFAULT_MAX_THREADS;
+
+    // Toda la salida va a /dev/null
+    fflush(stdout);
+    int null_fd = open("/dev/null", O_WRONLY);
+    if (null_fd < 0) {
+        perror("open /dev/null");
+        return 1;
+    }
+    dup2(null_fd, STDOUT_FILENO);
+    close(null_fd);
+
+    fprintf(stderr, "Contention: %d lines per thread, up to %d threads\n\n", lines, max_threads);
+    fprintf(stderr, "%-16s %8s %14s %14s\n", "api", "threads", "Mlines/s", "ns/line/thread");
+
+    for (size_t k = 0; k < CASE_COUNT; k++) {
+        if (cases[k].batched && !c_print_batch_start(NULL)) continue;
+        run_case(&cases[k], 1, lines / 10 + 1);     // Calentamiento (caché de patrones)
+
+        for (int threads = 1; threads <= max_threads; threads *= 2) {
+            double elapsed = run_case(&cases[k], threads, lines);
+            double total = (double)threads * lines;
+            fprintf(stderr, "%-16s %8d %14.2f %14.1f\n", cases[k].name, threads,
+                    total / elapsed * 1e3, elapsed / lines);
+        }
+        if (cases[k].batched) c_print_batch_stop();
+        fprintf(stderr, "\n");
+    }
+
+    return 0;
+}
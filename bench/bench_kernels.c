@@ -0,0 +1,383 @@
+/**
+ * @file bench_kernels.c
+ * @brief Microbenchmarks por kernel con comparación contra una línea base
+ *
+ * Cada kernel (formateadores numéricos, alineación, parseo de patrones y
+ * de colores) se mide al estilo de Google Benchmark: se calibra el número
+ * de iteraciones hasta superar un tiempo mínimo y se toma el mejor de
+ * varias repeticiones, que es la medida menos sensible al ruido.
+ *
+ * Uso:
+ *   bench_kernels [--filter texto] [--min-time ms] [--repetitions n]
+ *                 [--baseline archivo [--tolerance pct]]
+ *                 [--write-baseline archivo]
+ *
+ * Los tiempos absolutos dependen de la máquina, así que la línea base
+ * guarda cada kernel relativo a un kernel de calibración que no usa la
+ * biblioteca (un hash de strings cortos): el cociente kernel/calibración
+ * se mantiene bastante estable entre CPUs parecidas. Con --baseline
+ * termina con código 1 si el cociente de algún kernel supera al de la
+ * línea base en más del porcentaje de tolerancia (25 por defecto).
+ *
+ * El formato del archivo es una línea "nombre cociente" por kernel; las
+ * líneas que empiezan con '#' son comentarios. Con una CPU o un
+ * compilador muy distintos conviene regenerarla en la máquina que corre
+ * el gate (objetivo bench_kernels_baseline).
+ */
+
+#include "number_formatter.h"
+#include "text_alignment.h"
+#include "pattern_parser.h"
+#include "color_parser.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define DEFAULT_MIN_TIME_MS 20
+#define DEFAULT_REPETITIONS 5
+#define DEFAULT_TOLERANCE 25.0
+#define MAX_BASELINE 64
+#define NAME_MAX_LEN 64
+
+// Evita que el compilador elimine los resultados de los kernels
+static volatile unsigned long long sink;
+
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+// ============================================================================
+// KERNELS
+// ============================================================================
+
+static const long long separator_inputs[] = {
+    0, 42, -1234, 1234567, -987654321, 9223372036854775807LL, 100000, -5
+};
+
+static const unsigned int unsigned_inputs[] = {
+    0u, 7u, 255u, 4096u, 65535u, 0xdeadbeefu, 1000000u, 0xffffffffu
+};
+
+static const char* const pattern_inputs[] = {
+    "{s}",
+    "{d:,}",
+    "{s:red:bold:>20}",
+    "{f:.2:green:bg_white}",
+    "{d:05:,}",
+    "{x:#:08}",
+    "{s:*^30:cyan:underline}",
+    "{f:%:.1}",
+};
+
+static const char* const color_inputs[] = {
+    "red", "Bright_Magenta", "white", "BLUE", "bright_black", "nope", "cyan", "green"
+};
+
+static const char* const bg_inputs[] = {
+    "bg_red", "bg_bright_cyan", "white", "BG_BLUE", "bg_black", "nope", "bg_yellow", "magenta"
+};
+
+static const char* const style_inputs[] = {
+    "bold", "dim", "italic", "Underline", "blink", "reverse", "nope", "strikethrough"
+};
+
+#define INPUT(arr, i) (arr)[(i) & (sizeof(arr) / sizeof((arr)[0]) - 1)]
+
+/**
+ * @brief Kernel de calibración: hash de strings cortos, sin la biblioteca
+ */
+static void k_calibration(size_t iterations) {
+    for (size_t i = 0; i < iterations; i++) {
+        unsigned long long hash = 5381 + i;
+        for (size_t s = 0; s < sizeof(color_inputs) / sizeof(color_inputs[0]); s++) {
+            for (const char* p = color_inputs[s]; *p; p++) {
+                hash = hash * 33 + (unsigned char)*p;
+            }
+        }
+        sink += hash;
+    }
+}
+
+static void k_format_with_separator(size_t iterations) {
+    char buffer[64];
+    for (size_t i = 0; i < iterations; i++) {
+        format_with_separator(buffer, sizeof(buffer), INPUT(separator_inputs, i), ',');
+        sink += (unsigned char)buffer[0];
+    }
+}
+
+static void k_format_binary(size_t iterations) {
+    char buffer[80];
+    for (size_t i = 0; i < iterations; i++) {
+        format_binary(buffer, sizeof(buffer), INPUT(unsigned_inputs, i), (int)(i & 1));
+        sink += (unsigned char)buffer[0];
+    }
+}
+
+static void k_format_hex(size_t iterations) {
+    char buffer[32];
+    for (size_t i = 0; i < iterations; i++) {
+        format_hex(buffer, sizeof(buffer), INPUT(unsigned_inputs, i), (int)(i & 1), 8, 1);
+        sink += (unsigned char)buffer[0];
+    }
+}
+
+static void k_format_octal(size_t iterations) {
+    char buffer[32];
+    for (size_t i = 0; i < iterations; i++) {
+        format_octal(buffer, sizeof(buffer), INPUT(unsigned_inputs, i), (int)(i & 1));
+        sink += (unsigned char)buffer[0];
+    }
+}
+
+static void k_print_aligned(size_t iterations) {
+    static const TextAlign aligns[] = { ALIGN_LEFT, ALIGN_RIGHT, ALIGN_CENTER, ALIGN_CENTER };
+    for (size_t i = 0; i < iterations; i++) {
+        print_aligned(INPUT(color_inputs, i), aligns[i & 3], 20, '.');
+    }
+}
+
+static void k_parse_pattern(size_t iterations) {
+    PatternStyle style;
+    for (size_t i = 0; i < iterations; i++) {
+        parse_pattern(INPUT(pattern_inputs, i), &style);
+        sink += (unsigned char)style.format_type;
+    }
+}
+
+static void k_parse_text_color(size_t iterations) {
+    for (size_t i = 0; i < iterations; i++) {
+        sink += (unsigned)parse_text_color(INPUT(color_inputs, i));
+    }
+}
+
+static void k_parse_bg_color(size_t iterations) {
+    for (size_t i = 0; i < iterations; i++) {
+        sink += (unsigned)parse_bg_color(INPUT(bg_inputs, i));
+    }
+}
+
+static void k_parse_text_style(size_t iterations) {
+    for (size_t i = 0; i < iterations; i++) {
+        sink += (unsigned)parse_text_style(INPUT(style_inputs, i));
+    }
+}
+
+static void k_is_background_color(size_t iterations) {
+    for (size_t i = 0; i < iterations; i++) {
+        sink += is_background_color(INPUT(bg_inputs, i));
+    }
+}
+
+typedef struct {
+    const char* name;
+    void (*run)(size_t iterations);
+} Kernel;
+
+static const Kernel kernels[] = {
+    { "format_with_separator", k_format_with_separator },
+    { "format_binary", k_format_binary },
+    { "format_hex", k_format_hex },
+    { "format_octal", k_format_octal },
+    { "print_aligned", k_print_aligned },
+    { "parse_pattern", k_parse_pattern },
+    { "parse_text_color", k_parse_text_color },
+    { "parse_bg_color", k_parse_bg_color },
+    { "parse_text_style", k_parse_text_style },
+    { "is_background_color", k_is_background_color },
+};
+
+#define KERNEL_COUNT (sizeof(kernels) / sizeof(kernels[0]))
+
+static const Kernel calibration = { "calibration", k_calibration };
+
+// ============================================================================
+// MEDICIÓN
+// ============================================================================
+
+/**
+ * @brief ns/op de un kernel: calibra iteraciones y toma la mejor repetición
+ */
+static double measure(const Kernel* kernel, double min_time_ns, int repetitions) {
+    size_t iterations = 1;
+    double elapsed;
+
+    // Calibración: duplicar hasta superar el tiempo mínimo
+    for (;;) {
+        double start = now_ns();
+        kernel->run(iterations);
+        elapsed = now_ns() - start;
+        if (elapsed >= min_time_ns || iterations >= ((size_t)1 << 40)) break;
+        iterations *= 2;
+    }
+
+    double best = elapsed / (double)iterations;
+    for (int r = 1; r < repetitions; r++) {
+        double start = now_ns();
+        kernel->run(iterations);
+        double per_op = (now_ns() - start) / (double)iterations;
+        if (per_op < best) best = per_op;
+    }
+    return best;
+}
+
+/**
+ * @brief ns/op de un kernel y su cociente contra la calibración
+ *
+ * La calibración se mide justo antes y justo después del kernel, así que
+ * los cambios de frecuencia o de carga de la máquina afectan a ambos.
+ */
+static double measure_ratio(const Kernel* kernel, double min_time_ns, int repetitions,
+                            double* ns) {
+    double before = measure(&calibration, min_time_ns, repetitions);
+    *ns = measure(kernel, min_time_ns, repetitions);
+    double after = measure(&calibration, min_time_ns, repetitions);
+    return *ns / (before < after ? before : after);
+}
+
+// ============================================================================
+// LÍNEA BASE
+// ============================================================================
+
+typedef struct {
+    char name[NAME_MAX_LEN];
+    double ratio;               // ns/op del kernel / ns/op de la calibración
+} BaselineEntry;
+
+static size_t load_baseline(const char* path, BaselineEntry* entries, size_t max) {
+    FILE* file = fopen(path, "r");
+    if (!file) {
+        fprintf(stderr, "bench_kernels: cannot open baseline '%s'\n", path);
+        exit(2);
+    }
+
+    char line[256];
+    size_t count = 0;
+    while (count < max && fgets(line, sizeof(line), file)) {
+        if (line[0] == '#' || line[0] == '\n') continue;
+        if (sscanf(line, "%63s %lf", entries[count].name, &entries[count].ratio) == 2) {
+            count++;
+        }
+    }
+
+    fclose(file);
+    return count;
+}
+
+static const BaselineEntry* find_baseline(const BaselineEntry* entries, size_t count,
+                                          const char* name) {
+    for (size_t i = 0; i < count; i++) {
+        if (strcmp(entries[i].name, name) == 0) return &entries[i];
+    }
+    return NULL;
+}
+
+static void usage(void) {
+    fprintf(stderr,
+            "usage: bench_kernels [--filter text] [--min-time ms] [--repetitions n]\n"
+            "                     [--baseline file [--tolerance pct]]\n"
+            "                     [--write-baseline file]\n");
+    exit(2);
+}
+
+int main(int argc, char** argv) {
+    const char* filter = NULL;
+    const char* baseline_path = NULL;
+    const char* write_path = NULL;
+    double min_time_ms = DEFAULT_MIN_TIME_MS;
+    double tolerance = DEFAULT_TOLERANCE;
+    int repetitions = DEFAULT_REPETITIONS;
+
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        if (i + 1 >= argc) usage();
+
+        if (strcmp(arg, "--filter") == 0) filter = argv[++i];
+        else if (strcmp(arg, "--min-time") == 0) min_time_ms = atof(argv[++i]);
+        else if (strcmp(arg, "--repetitions") == 0) repetitions = atoi(argv[++i]);
+        else if (strcmp(arg, "--baseline") == 0) baseline_path = argv[++i];
+        else if (strcmp(arg, "--tolerance") == 0) tolerance = atof(argv[++i]);
+        else if (strcmp(arg, "--write-baseline") == 0) write_path = argv[++i];
+        else usage();
+    }
+    if (repetitions < 1) repetitions = 1;
+
+    BaselineEntry baseline[MAX_BASELINE];
+    size_t baseline_count = baseline_path
+        ? load_baseline(baseline_path, baseline, MAX_BASELINE) : 0;
+
+    // print_aligned escribe en stdout
+    if (!freopen("/dev/null", "w", stdout)) return 2;
+
+    double results[KERNEL_COUNT];
+    double ratios[KERNEL_COUNT];
+    int regressions = 0;
+
+    fprintf(stderr, "\n%-24s %12s %9s %9s %9s\n", "kernel", "ns/op", "ratio", "baseline", "delta");
+
+    for (size_t k = 0; k < KERNEL_COUNT; k++) {
+        results[k] = -1.0;
+        if (filter && !strstr(kernels[k].name, filter)) continue;
+
+        double ratio = measure_ratio(&kernels[k], min_time_ms * 1e6, repetitions, &results[k]);
+
+        const BaselineEntry* base = find_baseline(baseline, baseline_count, kernels[k].name);
+        if (!base) {
+            ratios[k] = ratio;
+            fprintf(stderr, "%-24s %12.2f %9.3f %9s\n", kernels[k].name, results[k], ratio,
+                    baseline_path ? "(new)" : "");
+            continue;
+        }
+
+        double delta = (ratio - base->ratio) / base->ratio * 100.0;
+
+        // Una regresión aparente se vuelve a medir antes de darla por buena
+        if (delta > tolerance) {
+            double retry_ns;
+            double retry = measure_ratio(&kernels[k], min_time_ms * 1e6, repetitions, &retry_ns);
+            if (retry < ratio) {
+                ratio = retry;
+                results[k] = retry_ns;
+            }
+            delta = (ratio - base->ratio) / base->ratio * 100.0;
+        }
+
+        ratios[k] = ratio;
+        bool regressed = delta > tolerance;
+        if (regressed) regressions++;
+
+        fprintf(stderr, "%-24s %12.2f %9.3f %9.3f %+8.1f%%%s\n", kernels[k].name, results[k],
+                ratio, base->ratio, delta, regressed ? "  REGRESSION" : "");
+    }
+
+    fflush(stdout);
+
+    if (write_path) {
+        FILE* out = fopen(write_path, "w");
+        if (!out) {
+            fprintf(stderr, "bench_kernels: cannot write '%s'\n", write_path);
+            return 2;
+        }
+        fprintf(out, "# bench_kernels baseline: kernel ns/op relative to the calibration kernel\n"
+                     "# (best of %d, min time %.0f ms)\n", repetitions, min_time_ms);
+        for (size_t k = 0; k < KERNEL_COUNT; k++) {
+            if (results[k] >= 0.0) fprintf(out, "%s %.3f\n", kernels[k].name, ratios[k]);
+        }
+        fclose(out);
+        fprintf(stderr, "\nbaseline written to %s\n", write_path);
+    }
+
+    if (baseline_path) {
+        if (regressions > 0) {
+            fprintf(stderr, "\n%d kernel(s) slower than baseline (relative to calibration) by more than %.0f%%\n\n",
+                    regressions, tolerance);
+            return 1;
+        }
+        fprintf(stderr, "\nall kernels within %.0f%% of baseline\n\n", tolerance);
+    }
+
+    return 0;
+}
@@ -0,0 +1,433 @@
+/**
+ * @file c_print_bench.c
+ * @brief Benchmark de todos los caminos de impresión
+ *
+ * Mide ns/llamada y MB/s de c_print, c_print_fd (contra c_snprint + write,
+ * también una llamada al sistema por línea), c_printf_styled, CPrintBuilder,
+ * C_PRINT (c_print_checked), c_print_safe y printf con patrones
+ * representativos, escribiendo a /dev/null, a un pipe (vaciado por un
+ * hilo lector) y a memoria (las APIs que pueden renderizar en un buffer).
+ *
+ * Uso:
+ *   c_print_bench [iteraciones] [salida.json]
+ *
+ * El resumen legible va a stderr; el JSON va a stdout o al archivo dado.
+ */
+
+#define C_PRINT_USE_GENERIC
+#include "c_print.h"
+#include "c_print_generic.h"
+#include "c_print_safe.h"
+#include "c_print_builder.h"
+#include "c_print_argv.h"
+#include "pattern_compiler.h"
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+
+#define DEFAULT_ITERATIONS 100000
+#define MEMORY_BUFFER 512
+
+// ============================================================================
+// CASOS
+// ============================================================================
+
+static const char* const names[] = { "ana", "carlos-sweb", "root", "guest" };
+static const char* const hosts[] = { "10.0.0.1", "192.168.1.20", "127.0.0.1", "172.16.4.9" };
+
+#define NAME(i) names[(i) & 3]
+#define HOST(i) hosts[(i) & 3]
+
+typedef struct {
+    const char* api;
+    const char* pattern;
+    void (*to_stdout)(int i);                                // NULL = solo memoria
+    size_t (*to_memory)(char* buffer, size_t size, int i);   // NULL = no soportado
+} BenchCase;
+
+// Builder reutilizado (sin malloc por llamada)
+static CPrintBuilderStorage builder_storage;
+static char builder_buffer[MEMORY_BUFFER];
+static CPrintBuilder* builder;
+
+// --- plain: "user {s} logged in from {s}\n" ---------------------------------
+
+static void plain_c_print(int i) { c_print("user {s} logged in from {s}\n", NAME(i), HOST(i)); }
+static void plain_fd(int i) { c_print_fd(STDOUT_FILENO, "user {s} logged in from {s}\n", NAME(i), HOST(i)); }
+static void plain_write(int i) {
+    char line[MEMORY_BUFFER];
+    size_t len = c_snprint(line, sizeof(line), "user {s} logged in from {s}\n", NAME(i), HOST(i));
+    if (write(STDOUT_FILENO, line, len) < 0) return;
+}
+static void plain_safe(int i) { c_print_safe("user {s} logged in from {s}\n", NAME(i), HOST(i)); }
+static void plain_checked(int i) { C_PRINT("user {s} logged in from {s}\n", NAME(i), HOST(i)); }
+static void plain_printf(int i) { printf("user %s logged in from %s\n", NAME(i), HOST(i)); }
+
+static void plain_styled(int i) {
+    c_printf_styled(COLOR_RESET, BG_RESET, STYLE_RESET,
+                    "user %s logged in from %s\n", NAME(i), HOST(i));
+}
+
+static void plain_build(int i) {
+    cp_reset(builder);
+    cp_text(builder, "user ");
+    cp_str(builder, NAME(i));
+    cp_text(builder, " logged in from ");
+    cp_str(builder, HOST(i));
+    cp_text(builder, "\n");
+}
+
+static void plain_builder(int i) { plain_build(i); cp_print(builder); }
+
+static size_t plain_builder_mem(char* buffer, size_t size, int i) {
+    (void)buffer; (void)size;
+    plain_build(i);
+    return cp_view(builder).length;
+}
+
+static size_t plain_snprintf(char* buffer, size_t size, int i) {
+    return (size_t)snprintf(buffer, size, "user %s logged in from %s\n", NAME(i), HOST(i));
+}
+
+static size_t plain_argv(char* buffer, size_t size, int i) {
+    CPrintArg args[] = { CPRINT_ARG(NAME(i)), CPRINT_ARG(HOST(i)) };
+    return c_print_argv("user {s} logged in from {s}\n", args, 2, buffer, size);
+}
+
+// --- numeric: "id={d:05} total={f:.2} mask={x:#}\n" -------------------------
+
+static void numeric_c_print(int i) { c_print("id={d:05} total={f:.2} mask={x:#}\n", i, i * 0.25, (unsigned)i); }
+static void numeric_fd(int i) { c_print_fd(STDOUT_FILENO, "id={d:05} total={f:.2} mask={x:#}\n", i, i * 0.25, (unsigned)i); }
+static void numeric_write(int i) {
+    char line[MEMORY_BUFFER];
+    size_t len = c_snprint(line, sizeof(line), "id={d:05} total={f:.2} mask={x:#}\n", i, i * 0.25, (unsigned)i);
+    if (write(STDOUT_FILENO, line, len) < 0) return;
+}
+static void numeric_safe(int i) { c_print_safe("id={d:05} total={f:.2} mask={x:#}\n", i, i * 0.25, (unsigned)i); }
+static void numeric_checked(int i) { C_PRINT("id={d:05} total={f:.2} mask={x:#}\n", i, i * 0.25, (unsigned)i); }
+static void numeric_printf(int i) { printf("id=%05d total=%.2f mask=%#x\n", i, i * 0.25, (unsigned)i); }
+
+static void numeric_styled(int i) {
+    c_printf_styled(COLOR_RESET, BG_RESET, STYLE_RESET,
+                    "id=%05d total=%.2f mask=%#x\n", i, i * 0.25, (unsigned)i);
+}
+
+static void numeric_build(int i) {
+    cp_reset(builder);
+    cp_text(builder, "id=");
+    cp_int(cp_zero_pad(builder, 5), i);
+    cp_text(builder, " total=");
+    cp_float(cp_precision(builder, 2), i * 0.25);
+    cp_text(builder, " mask=");
+    cp_hex(cp_show_prefix(builder, true), (unsigned)i);
+    cp_text(builder, "\n");
+}
+
+static void numeric_builder(int i) { numeric_build(i); cp_print(builder); }
+
+static size_t numeric_builder_mem(char* buffer, size_t size, int i) {
+    (void)buffer; (void)size;
+    numeric_build(i);
+    return cp_view(builder).length;
+}
+
+static size_t numeric_snprintf(char* buffer, size_t size, int i) {
+    return (size_t)snprintf(buffer, size, "id=%05d total=%.2f mask=%#x\n", i, i * 0.25, (unsigned)i);
+}
+
+static size_t numeric_argv(char* buffer, size_t size, int i) {
+    CPrintArg args[] = { CPRINT_ARG(i), CPRINT_ARG(i * 0.25), CPRINT_ARG((unsigned)i) };
+    return c_print_argv("id={d:05} total={f:.2} mask={x:#}\n", args, 3, buffer, size);
+}
+
+// --- styled: "{s:green:bold} {d:>8:cyan} {s:<12}|\n" ------------------------
+
+static void styled_c_print(int i) { c_print("{s:green:bold} {d:>8:cyan} {s:<12}|\n", NAME(i), i, HOST(i)); }
+static void styled_fd(int i) { c_print_fd(STDOUT_FILENO, "{s:green:bold} {d:>8:cyan} {s:<12}|\n", NAME(i), i, HOST(i)); }
+static void styled_write(int i) {
+    char line[MEMORY_BUFFER];
+    size_t len = c_snprint(line, sizeof(line), "{s:green:bold} {d:>8:cyan} {s:<12}|\n", NAME(i), i, HOST(i));
+    if (write(STDOUT_FILENO, line, len) < 0) return;
+}
+static void styled_safe(int i) { c_print_safe("{s:green:bold} {d:>8:cyan} {s:<12}|\n", NAME(i), i, HOST(i)); }
+static void styled_checked(int i) { C_PRINT("{s:green:bold} {d:>8:cyan} {s:<12}|\n", NAME(i), i, HOST(i)); }
+
+static void styled_printf(int i) {
+    printf("\033[32;1m%s\033[0m \033[36m%8d\033[0m %-12s|\n", NAME(i), i, HOST(i));
+}
+
+static void styled_styled(int i) {
+    c_printf_styled(COLOR_GREEN, BG_RESET, STYLE_BOLD, "%s", NAME(i));
+    c_printf_styled(COLOR_CYAN, BG_RESET, STYLE_RESET, " %8d", i);
+    printf(" %-12s|\n", HOST(i));
+}
+
+static void styled_build(int i) {
+    cp_reset(builder);
+    cp_str(cp_style(cp_color(builder, COLOR_GREEN), STYLE_BOLD), NAME(i));
+    cp_text(builder, " ");
+    cp_int(cp_align_right(cp_color(builder, COLOR_CYAN), 8), i);
+    cp_text(builder, " ");
+    cp_str(cp_align_left(builder, 12), HOST(i));
+    cp_text(builder, "|\n");
+}
+
+static void styled_builder(int i) { styled_build(i); cp_print(builder); }
+
+static size_t styled_builder_mem(char* buffer, size_t size, int i) {
+    (void)buffer; (void)size;
+    styled_build(i);
+    return cp_view(builder).length;
+}
+
+static size_t styled_snprintf(char* buffer, size_t size, int i) {
+    return (size_t)snprintf(buffer, size, "\033[32;1m%s\033[0m \033[36m%8d\033[0m %-12s|\n",
+                            NAME(i), i, HOST(i));
+}
+
+static size_t styled_argv(char* buffer, size_t size, int i) {
+    CPrintArg args[] = { CPRINT_ARG(NAME(i)), CPRINT_ARG(i), CPRINT_ARG(HOST(i)) };
+    return c_print_argv("{s:green:bold} {d:>8:cyan} {s:<12}|\n", args, 3, buffer, size);
+}
+
+static const BenchCase cases[] = {
+    { "c_print",         "plain",   plain_c_print,   NULL },
+    { "c_print_fd",      "plain",   plain_fd,        NULL },
+    { "snprint+write",   "plain",   plain_write,     NULL },
+    { "c_printf_styled", "plain",   plain_styled,    NULL },
+    { "CPrintBuilder",   "plain",   plain_builder,   plain_builder_mem },
+    { "c_print_checked", "plain",   plain_checked,   NULL },
+    { "c_print_argv",    "plain",   NULL,            plain_argv },
+    { "c_print_safe",    "plain",   plain_safe,      NULL },
+    { "printf",          "plain",   plain_printf,    plain_snprintf },
+
+    { "c_print",         "numeric", numeric_c_print, NULL },
+    { "c_print_fd",      "numeric", numeric_fd,      NULL },
+    { "snprint+write",   "numeric", numeric_write,   NULL },
+    { "c_printf_styled", "numeric", numeric_styled,  NULL },
+    { "CPrintBuilder",   "numeric", numeric_builder, numeric_builder_mem },
+    { "c_print_checked", "numeric", numeric_checked, NULL },
+    { "c_print_argv",    "numeric", NULL,            numeric_argv },
+    { "c_print_safe",    "numeric", numeric_safe,    NULL },
+    { "printf",          "numeric", numeric_printf,  numeric_snprintf },
+
+    { "c_print",         "styled",  styled_c_print,  NULL },
+    { "c_print_fd",      "styled",  styled_fd,       NULL },
+    { "snprint+write",   "styled",  styled_write,    NULL },
+    { "c_printf_styled", "styled",  styled_styled,   NULL },
+    { "CPrintBuilder",   "styled",  styled_builder,  styled_builder_mem },
+    { "c_print_checked", "styled",  styled_checked,  NULL },
+    { "c_print_argv",    "styled",  NULL,            styled_argv },
+    { "c_print_safe",    "styled",  styled_safe,     NULL },
+    { "printf",          "styled",  styled_printf,   styled_snprintf },
+};
+
+#define CASE_COUNT (sizeof(cases) / sizeof(cases[0]))
+
+// ============================================================================
+// DESTINOS
+// ============================================================================
+
+typedef enum { TARGET_PIPE, TARGET_DEVNULL, TARGET_MEMORY, TARGET_COUNT } Target;
+
+static const char* const target_names[] = { "pipe", "devnull", "memory" };
+
+typedef struct {
+    double ns_per_call;
+    double bytes_per_call;
+    bool measured;
+} Result;
+
+static Result results[CASE_COUNT][TARGET_COUNT];
+
+// Hilo que vacía el pipe y cuenta los bytes recibidos
+static int pipe_fds[2];
+static atomic_ullong pipe_bytes;
+
+static void* pipe_reader(void* arg) {
+    (void)arg;
+    char buffer[64 * 1024];
+    ssize_t n;
+    while ((n = read(pipe_fds[0], buffer, sizeof(buffer))) > 0) {
+        atomic_fetch_add(&pipe_bytes, (unsigned long long)n);
+    }
+    return NULL;
+}
+
+static void wait_pipe_drained(void) {
+    int pending = 1;
+    while (ioctl(pipe_fds[0], FIONREAD, &pending) == 0 && pending > 0) usleep(100);
+    usleep(100);
+}
+
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+static double run_stdout(const BenchCase* c, int iterations) {
+    double start = now_ns();
+    for (int i = 0; i < iterations; i++) c->to_stdout(i);
+    fflush(stdout);
+    return (now_ns() - start) / iterations;
+}
+
+static void bench_pipe(int iterations) {
+    if (pipe(pipe_fds) != 0) return;
+
+    pthread_t reader;
+    pthread_create(&reader, NULL, pipe_reader, NULL);
+
+    fflush(stdout);
+    dup2(pipe_fds[1], STDOUT_FILENO);
+
+    for (size_t c = 0; c < CASE_COUNT; c++) {
+        if (!cases[c].to_stdout) continue;
+
+        // Espera a que el lector vacíe lo anterior antes de medir
+        fflush(stdout);
+        wait_pipe_drained();
+        unsigned long long before = atomic_load(&pipe_bytes);
+
+        double ns = run_stdout(&cases[c], iterations);
+        wait_pipe_drained();
+
+        results[c][TARGET_PIPE].ns_per_call = ns;
+        results[c][TARGET_PIPE].bytes_per_call =
+            (double)(atomic_load(&pipe_bytes) - before) / iterations;
+        results[c][TARGET_PIPE].measured = true;
+    }
+
+    close(pipe_fds[1]);
+    close(STDOUT_FILENO);
+    pthread_join(reader, NULL);
+    close(pipe_fds[0]);
+}
+
+static void bench_devnull(int iterations) {
+    int null_fd = open("/dev/null", O_WRONLY);
+    if (null_fd < 0) return;
+
+    fflush(stdout);
+    dup2(null_fd, STDOUT_FILENO);
+    close(null_fd);
+
+    for (size_t c = 0; c < CASE_COUNT; c++) {
+        if (!cases[c].to_stdout) continue;
+        results[c][TARGET_DEVNULL].ns_per_call = run_stdout(&cases[c], iterations);
+        // Mismos bytes que en el pipe
+        results[c][TARGET_DEVNULL].bytes_per_call = results[c][TARGET_PIPE].bytes_per_call;
+        results[c][TARGET_DEVNULL].measured = true;
+    }
+}
+
+static void bench_memory(int iterations) {
+    static char buffer[MEMORY_BUFFER];
+
+    for (size_t c = 0; c < CASE_COUNT; c++) {
+        if (!cases[c].to_memory) continue;
+
+        size_t bytes = 0;
+        double start = now_ns();
+        for (int i = 0; i < iterations; i++) {
+            bytes += cases[c].to_memory(buffer, sizeof(buffer), i);
+        }
+        double elapsed = now_ns() - start;
+
+        results[c][TARGET_MEMORY].ns_per_call = elapsed / iterations;
+        results[c][TARGET_MEMORY].bytes_per_call = (double)bytes / iterations;
+        results[c][TARGET_MEMORY].measured = true;
+    }
+}
+
+// ============================================================================
+// INFORMES
+// ============================================================================
+
+static double mb_per_s(const Result* r) {
+    return r->ns_per_call > 0 ? r->bytes_per_call * 1e3 / r->ns_per_call : 0.0;
+}
+
+static void report_text(FILE* out, int iterations) {
+    fprintf(out, "\nc_print_bench (%d iterations per case)\n\n", iterations);
+    fprintf(out, "  %-8s %-16s %-8s %10s %10s %8s\n",
+            "pattern", "api", "target", "ns/call", "MB/s", "bytes");
+
+    for (size_t c = 0; c < CASE_COUNT; c++) {
+        for (int t = 0; t < TARGET_COUNT; t++) {
+            const Result* r = &results[c][t];
+            if (!r->measured) continue;
+            fprintf(out, "  %-8s %-16s %-8s %10.1f %10.1f %8.1f\n",
+                    cases[c].pattern, cases[c].api, target_names[t],
+                    r->ns_per_call, mb_per_s(r), r->bytes_per_call);
+        }
+    }
+    fprintf(out, "\n");
+}
+
+static void report_json(FILE* out, int iterations) {
+    bool first = true;
+
+    fprintf(out, "{\n  \"benchmark\": \"c_print_bench\",\n");
+    fprintf(out, "  \"iterations\": %d,\n  \"results\": [\n", iterations);
+
+    for (size_t c = 0; c < CASE_COUNT; c++) {
+        for (int t = 0; t < TARGET_COUNT; t++) {
+            const Result* r = &results[c][t];
+            if (!r->measured) continue;
+            fprintf(out, "%s    {\"api\": \"%s\", \"pattern\": \"%s\", \"target\": \"%s\", "
+                         "\"ns_per_call\": %.2f, \"mb_per_s\": %.2f, \"bytes_per_call\": %.2f}",
+                    first ? "" : ",\n", cases[c].api, cases[c].pattern, target_names[t],
+                    r->ns_per_call, mb_per_s(r), r->bytes_per_call);
+            first = false;
+        }
+    }
+
+    fprintf(out, "\n  ]\n}\n");
+}
+
+int main(int argc, char** argv) {
+    int iterations = argc > 1 ? atoi(argv[1]) : DEFAULT_ITERATIONS;
+    const char* json_path = argc > 2 ? argv[2] : NULL;
+    if (iterations <= 0) iterations = DEFAULT_ITERATIONS;
+
+    builder = cp_init(CP_BUILDER(&builder_storage), builder_buffer, sizeof(builder_buffer));
+
+    // stdout se redirige durante las mediciones; se conserva el original
+    fflush(stdout);
+    int saved_stdout = dup(STDOUT_FILENO);
+
+    bench_pipe(iterations);
+    bench_devnull(iterations);
+    bench_memory(iterations);
+
+    fflush(stdout);
+    dup2(saved_stdout, STDOUT_FILENO);
+    close(saved_stdout);
+
+    cp_free(builder);
+    clear_pattern_cache();
+
+    report_text(stderr, iterations);
+
+    if (json_path) {
+        FILE* out = fopen(json_path, "w");
+        if (!out) {
+            fprintf(stderr, "c_print_bench: cannot open %s\n", json_path);
+            return 1;
+        }
+        report_json(out, iterations);
+        fclose(out);
+    } else {
+        report_json(stdout, iterations);
+    }
+
+    return 0;
+}
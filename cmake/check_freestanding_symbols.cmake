@@ -0,0 +1,74 @@
+# Verifica que la biblioteca freestanding solo dependa de funciones de string.h
+#
+# Uso: cmake -DNM=<nm> -DARCHIVE=<libc_print_freestanding.a> -P check_freestanding_symbols.cmake
+#
+# Lista los símbolos externos que el archivo usa pero no define. Fuera de
+# la lista permitida (memoria y strings, más lo que agrega el compilador)
+# cualquier símbolo hace fallar el chequeo: un printf, malloc o isdigit
+# que se cuele en el camino freestanding se detecta aquí.
+
+cmake_minimum_required(VERSION 3.15)
+
+if(NOT NM OR NOT ARCHIVE)
+    message(FATAL_ERROR "NM y ARCHIVE son obligatorios")
+endif()
+
+set(ALLOWED_SYMBOLS
+    memcpy memmove memset memcmp
+    strlen strcmp strncmp strchr strncpy
+)
+# Protección de pila, tablas e instrumentación de sanitizers que agrega el compilador
+set(ALLOWED_PREFIXES __stack_chk _GLOBAL_OFFSET_TABLE_ __asan_ __ubsan_ __sanitizer_)
+
+execute_process(
+    COMMAND ${NM} -g ${ARCHIVE}
+    OUTPUT_VARIABLE nm_output
+    RESULT_VARIABLE nm_result
+    ERROR_QUIET)
+if(NOT nm_result EQUAL 0)
+    message(FATAL_ERROR "${NM} falló sobre ${ARCHIVE}")
+endif()
+
+string(REPLACE "\n" ";" nm_lines "${nm_output}")
+set(defined)
+set(undefined)
+foreach(line IN LISTS nm_lines)
+    if(line MATCHES "^[0-9a-fA-F]* *U ([^ ]+)$")
+        list(APPEND undefined ${CMAKE_MATCH_1})
+    elseif(line MATCHES "^[0-9a-fA-F]+ [A-TV-Za-z] ([^ ]+)$")
+        list(APPEND defined ${CMAKE_MATCH_1})
+    endif()
+endforeach()
+list(REMOVE_DUPLICATES undefined)
+
+set(external)
+set(unexpected)
+foreach(symbol IN LISTS undefined)
+    if(symbol IN_LIST defined)
+        continue()
+    endif()
+    list(APPEND external ${symbol})
+
+    # En macOS los símbolos de C llevan '_' delante
+    string(REGEX REPLACE "^_" "" plain_symbol "${symbol}")
+    if(plain_symbol IN_LIST ALLOWED_SYMBOLS)
+        continue()
+    endif()
+    set(allowed FALSE)
+    foreach(prefix IN LISTS ALLOWED_PREFIXES)
+        if(symbol MATCHES "^_?${prefix}")
+            set(allowed TRUE)
+        endif()
+    endforeach()
+    if(NOT allowed)
+        list(APPEND unexpected ${symbol})
+    endif()
+endforeach()
+
+if(unexpected)
+    list(JOIN unexpected ", " unexpected_text)
+    message(FATAL_ERROR "Símbolos externos no permitidos en ${ARCHIVE}: ${unexpected_text}")
+endif()
+
+list(JOIN external ", " external_text)
+message(STATUS "Símbolos externos de ${ARCHIVE}: ${external_text}")
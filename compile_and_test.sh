@@ -90,7 +90,7 @@ for example in example_shared example_static example_builder example_generic; do
 done
 
 # Tests
-for test in test_string_utils test_color_parser test_number_formatter test_text_alignment test_builder; do
+for test in test_string_utils test_color_parser test_number_formatter test_text_alignment test_builder test_alloc test_typed test_safe test_checked test_sampling test_argv test_stats test_latency test_no_heap test_probes test_atomic_lines test_batch test_queue test_writev test_signal_safe test_freestanding test_validated; do
     if [ -f "build/bin/$test" ] || [ -f "build/$test" ]; then
         echo -e "  ${GREEN}✓${NC} $test"
     else
@@ -117,7 +117,7 @@ echo ""
 test_failed=false
 
 # Ejecutar cada test
-for test in test_string_utils test_color_parser test_number_formatter test_text_alignment test_builder; do
+for test in test_string_utils test_color_parser test_number_formatter test_text_alignment test_builder test_alloc test_typed test_safe test_checked test_sampling test_argv test_stats test_latency test_no_heap test_probes test_atomic_lines test_batch test_queue test_writev test_signal_safe test_freestanding test_validated; do
     test_path=""
     if [ -f "build/bin/$test" ]; then
         test_path="build/bin/$test"
@@ -231,7 +231,7 @@ echo -e "${BLUE}═════════════════════
 echo ""
 echo -e "${CYAN}Summary:${NC}"
 echo -e "  ${GREEN}✓${NC} Libraries compiled (shared + static)"
-echo -e "  ${GREEN}✓${NC} 5 unit tests passed"
+echo -e "  ${GREEN}✓${NC} 22 unit tests passed"
 echo -e "  ${GREEN}✓${NC} 3 examples executed successfully"
 echo ""
 echo -e "${CYAN}Available APIs:${NC}"
@@ -9,7 +9,11 @@
 #ifndef ANSI_CODES_H
 #define ANSI_CODES_H
 
+#include <stddef.h>
+
+#ifndef C_PRINT_FREESTANDING
 #include <stdio.h>
+#endif
 
 #ifdef __cplusplus
 extern "C" {
@@ -70,6 +74,27 @@ typedef enum {
     STYLE_STRIKETHROUGH = 9
 } TextStyle;
 
+// Secuencia que resetea todos los atributos
+#define ANSI_RESET_SEQUENCE "\033[0m"
+#define ANSI_RESET_LENGTH 4
+
+// Longitud máxima de una secuencia generada por format_ansi_codes()
+#define ANSI_MAX_SEQUENCE 16
+
+/**
+ * @brief Escribe en un buffer la secuencia ANSI de color, fondo y estilo
+ * @param buffer Buffer de salida (al menos ANSI_MAX_SEQUENCE bytes)
+ * @param size Tamaño del buffer
+ * @return Longitud de la secuencia (sin el terminador), 0 si no cabe
+ *
+ * Genera exactamente lo mismo que apply_ansi_codes(), sin pasar por stdio.
+ * Ejemplo: format_ansi_codes(buf, 16, COLOR_RED, BG_RESET, STYLE_BOLD) → "\033[1;31m"
+ */
+size_t format_ansi_codes(char* buffer, size_t size, TextColor fg, BackgroundColor bg,
+                         TextStyle style);
+
+#ifndef C_PRINT_FREESTANDING
+
 /**
  * @brief Aplica códigos ANSI para color de texto, fondo y estilo
  * @param fg Color de texto (TextColor)
@@ -83,6 +108,8 @@ void apply_ansi_codes(TextColor fg, BackgroundColor bg, TextStyle style);
  */
 void reset_ansi_codes(void);
 
+#endif // !C_PRINT_FREESTANDING
+
 #ifdef __cplusplus
 }
 #endif
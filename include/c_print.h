@@ -12,6 +12,7 @@
 
 #include <stdio.h>
 #include <stdarg.h>
+#include <stddef.h>
 
 // Importar tipos públicos de los módulos
 #include "ansi_codes.h"
@@ -74,6 +75,49 @@ typedef struct {
  */
 void c_print(const char* pattern, ...);
 
+struct CompiledPattern;
+
+/**
+ * @brief Como c_print() pero escribe en un buffer del llamador
+ * @return Longitud completa del resultado, como snprintf (la salida se
+ *         trunca a size - 1 bytes y siempre termina en NUL si size > 0)
+ *
+ * No reserva memoria salvo la primera vez que un hilo usa un patrón
+ * (caché de patrones compilados).
+ */
+size_t c_snprint(char* buffer, size_t size, const char* pattern, ...);
+
+/**
+ * @brief Versión de c_snprint() con va_list
+ */
+size_t c_vsnprint(char* buffer, size_t size, const char* pattern, va_list args);
+
+/**
+ * @brief c_snprint() con un patrón ya compilado; nunca reserva memoria
+ *
+ * El patrón puede compilarse con compile_pattern() sobre un arena
+ * inicializado con memoria propia (cp_arena_init), sin tocar el heap.
+ */
+size_t c_snprint_compiled(char* buffer, size_t size,
+                          const struct CompiledPattern* compiled, ...);
+
+/**
+ * @brief Como c_print() pero escribe en un descriptor con una sola writev
+ * @return Bytes escritos
+ *
+ * Los literales del patrón, los escapes ANSI y los strings de los
+ * argumentos no se copian: la writev apunta a ellos en su lugar. Solo los
+ * valores formateados pasan por un área de pila. Una línea con más de 64
+ * tramos o más de 2 KB de valores sale en varias writev. No pasa por
+ * stdio ni por los modos de lotes o cola.
+ */
+size_t c_print_fd(int fd, const char* pattern, ...);
+
+/**
+ * @brief Versión de c_print_fd() con va_list
+ */
+size_t c_vprint_fd(int fd, const char* pattern, va_list args);
+
 // ============================================================================
 // API LEGACY: Funciones tradicionales (compatibilidad)
 // ============================================================================
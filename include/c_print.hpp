@@ -0,0 +1,645 @@
+/**
+ * @file c_print.hpp
+ * @brief Front end C++17/20 header-only con patrones parseados en compile-time
+ *
+ * El patrón se analiza en compile-time y se convierte en un array constexpr
+ * de segmentos con su PatternStyle, la secuencia ANSI y el formato printf ya
+ * calculados. Los tipos de los argumentos se comprueban con templates y en
+ * runtime solo se llama a los kernels de formateo de la biblioteca, sin
+ * parseo por llamada ni borrado de tipos.
+ *
+ * Uso (C++20):
+ *   cprint::print<"{s:red} tiene {d:green} años\n">("Juan", 25);
+ *
+ * Uso (C++17):
+ *   cprint::print(CPRINT_COMPILE("{s:red} tiene {d:green} años\n"), "Juan", 25);
+ */
+
+#ifndef C_PRINT_HPP
+#define C_PRINT_HPP
+
+#if __cplusplus < 201703L && !(defined(_MSVC_LANG) && _MSVC_LANG >= 201703L)
+#error "c_print.hpp requires C++17 or later"
+#endif
+
+#include "c_print.h"
+#include "number_formatter.h"
+#include "format_engine.h"
+#include <array>
+#include <charconv>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace cprint {
+
+/**
+ * @brief Base de los tipos que transportan un patrón en compile-time
+ */
+struct compiled_string {};
+
+namespace detail {
+
+// ============================================================================
+// PARSEO CONSTEXPR (mismas reglas que pattern_parser.c y color_parser.c)
+// ============================================================================
+
+struct NamedCode {
+    std::string_view name;
+    int code;
+};
+
+inline constexpr NamedCode color_names[] = {
+    {"black", 30}, {"red", 31}, {"green", 32}, {"yellow", 33},
+    {"blue", 34}, {"magenta", 35}, {"cyan", 36}, {"white", 37},
+    {"bright_black", 90}, {"bright_red", 91}, {"bright_green", 92},
+    {"bright_yellow", 93}, {"bright_blue", 94}, {"bright_magenta", 95},
+    {"bright_cyan", 96}, {"bright_white", 97},
+};
+
+inline constexpr NamedCode style_names[] = {
+    {"bold", 1}, {"dim", 2}, {"italic", 3}, {"underline", 4},
+    {"blink", 5}, {"reverse", 7}, {"hidden", 8}, {"strikethrough", 9},
+};
+
+constexpr bool is_digit(char c) { return c >= '0' && c <= '9'; }
+
+constexpr char to_lower(char c) { return (c >= 'A' && c <= 'Z') ? char(c - 'A' + 'a') : c; }
+
+constexpr int parse_digits(std::string_view s) {
+    int value = 0;
+    for (char c : s) {
+        if (!is_digit(c)) break;
+        value = value * 10 + (c - '0');
+    }
+    return value;
+}
+
+constexpr bool is_number(std::string_view s) {
+    if (s.empty()) return false;
+    for (char c : s) {
+        if (!is_digit(c)) return false;
+    }
+    return true;
+}
+
+// Los parsers de C copian como máximo 49 caracteres y pasan a minúsculas
+constexpr bool equals_name(std::string_view token, std::string_view name) {
+    if (token.size() > 49) token = token.substr(0, 49);
+    if (token.size() != name.size()) return false;
+    for (std::size_t i = 0; i < token.size(); i++) {
+        if (to_lower(token[i]) != name[i]) return false;
+    }
+    return true;
+}
+
+template <std::size_t N>
+constexpr int lookup_code(std::string_view token, const NamedCode (&table)[N]) {
+    for (const NamedCode& entry : table) {
+        if (equals_name(token, entry.name)) return entry.code;
+    }
+    return 0;
+}
+
+constexpr bool is_background(std::string_view token) {
+    return token.size() >= 3 && to_lower(token[0]) == 'b' &&
+           to_lower(token[1]) == 'g' && token[2] == '_';
+}
+
+constexpr bool is_alignment(std::string_view token, PatternStyle& style) {
+    if (token.size() < 2) return false;
+
+    char fill_char = ' ';
+    std::size_t start = 0;
+    if (token.size() >= 3 && (token[1] == '<' || token[1] == '>' || token[1] == '^')) {
+        fill_char = token[0];
+        start = 1;
+    }
+
+    char first = token[start];
+    if ((first == '<' || first == '>' || first == '^') && is_number(token.substr(start + 1))) {
+        style.align = static_cast<TextAlign>(first);
+        style.width = parse_digits(token.substr(start + 1));
+        style.fill_char = fill_char;
+        style.has_alignment = 1;
+        return true;
+    }
+    return false;
+}
+
+constexpr bool is_format_modifier(std::string_view token, PatternStyle& style) {
+    if (token.empty()) return false;
+    char next = token.size() > 1 ? token[1] : '\0';
+
+    if (token[0] == '.' && is_digit(next)) {
+        style.precision = parse_digits(token.substr(1));
+        style.has_precision = 1;
+        return true;
+    }
+    if (token[0] == '0' && is_digit(next)) {
+        style.padding = parse_digits(token.substr(1));
+        style.zero_pad = 1;
+        return true;
+    }
+    if (is_digit(token[0]) && token[0] != '0') {
+        style.padding = parse_digits(token);
+        style.zero_pad = 0;
+        return true;
+    }
+    if (token == "," || token == "_") {
+        style.separator = token[0];
+        style.has_separator = 1;
+        return true;
+    }
+    if (token == "#") { style.show_prefix = 1; return true; }
+    if (token == "+") { style.show_sign = 1; return true; }
+    if (token == " ") { style.show_sign = 2; return true; }
+    if (token == "%") { style.as_percentage = 1; return true; }
+    return false;
+}
+
+constexpr void parse_spec(std::string_view token, PatternStyle& style) {
+    while (!token.empty() && token.front() == ' ') token.remove_prefix(1);
+    while (!token.empty() && token.back() == ' ') token.remove_suffix(1);
+
+    if (is_alignment(token, style) || is_format_modifier(token, style)) return;
+
+    if (is_background(token)) {
+        std::string_view name = token.substr(3);
+        int code = lookup_code(name, color_names);
+        style.bg_color = static_cast<BackgroundColor>(code ? code + 10 : 0);
+        style.has_bg = 1;
+        return;
+    }
+
+    if (int code = lookup_code(token, style_names)) {
+        style.style = static_cast<TextStyle>(code);
+        style.has_style = 1;
+    } else if (int color = lookup_code(token, color_names)) {
+        style.text_color = static_cast<TextColor>(color);
+        style.has_color = 1;
+    }
+}
+
+/**
+ * @brief Equivalente constexpr de parse_pattern() sobre el contenido entre llaves
+ */
+constexpr bool parse_content(std::string_view content, PatternStyle& style) {
+    style = PatternStyle{};
+    style.text_color = COLOR_RESET;
+    style.bg_color = BG_RESET;
+    style.style = STYLE_RESET;
+    style.align = ALIGN_NONE;
+    style.fill_char = ' ';
+    style.precision = 6;
+
+    int part = 0;
+    std::size_t pos = 0;
+    while (pos < content.size()) {
+        // Tokens separados por ':' (strtok ignora los vacíos)
+        while (pos < content.size() && content[pos] == ':') pos++;
+        if (pos >= content.size()) break;
+        std::size_t end = pos;
+        while (end < content.size() && content[end] != ':') end++;
+        std::string_view token = content.substr(pos, end - pos);
+        pos = end;
+
+        if (part == 0) {
+            while (!token.empty() && token.front() == ' ') token.remove_prefix(1);
+            style.format_type = token.empty() ? '\0' : token[0];
+        } else {
+            parse_spec(token, style);
+        }
+        part++;
+    }
+
+    return style.format_type != '\0';
+}
+
+constexpr bool is_known_format(char format_type) {
+    switch (format_type) {
+        case 's': case 'd': case 'i': case 'f': case 'c':
+        case 'b': case 'x': case 'o': case 'u': case 'l':
+            return true;
+        default:
+            return false;
+    }
+}
+
+// ============================================================================
+// SEGMENTOS COMPILADOS
+// ============================================================================
+
+/**
+ * @brief Segmento del patrón con todo lo que el renderizado necesita
+ */
+struct Segment {
+    PatternSegment base{};
+    char int_format[24] = {};   // Formato printf para {d} con padding o signo
+};
+
+constexpr std::size_t put_code(char* out, int code) {
+    std::size_t len = 0;
+    if (code >= 100) out[len++] = char('0' + code / 100);
+    if (code >= 10) out[len++] = char('0' + (code / 10) % 10);
+    out[len++] = char('0' + code % 10);
+    return len;
+}
+
+// Mismo resultado que format_ansi_codes()
+constexpr void build_escape(PatternSegment& seg) {
+    const PatternStyle& style = seg.style;
+    if (!(style.has_color || style.has_bg || style.has_style)) return;
+
+    std::size_t len = 0;
+    bool first = true;
+    seg.escape[len++] = '\033';
+    seg.escape[len++] = '[';
+    if (style.style != STYLE_RESET) {
+        len += put_code(seg.escape + len, style.style);
+        first = false;
+    }
+    if (style.text_color != COLOR_RESET) {
+        if (!first) seg.escape[len++] = ';';
+        len += put_code(seg.escape + len, style.text_color);
+        first = false;
+    }
+    if (style.bg_color != BG_RESET) {
+        if (!first) seg.escape[len++] = ';';
+        len += put_code(seg.escape + len, style.bg_color);
+    }
+    seg.escape[len++] = 'm';
+    seg.escape_length = static_cast<unsigned char>(len);
+}
+
+// Mismo formato que construye c_print() para enteros con padding o signo
+constexpr void build_int_format(Segment& seg) {
+    const PatternStyle& style = seg.base.style;
+    std::size_t len = 0;
+    seg.int_format[len++] = '%';
+    if (style.show_sign == 1) seg.int_format[len++] = '+';
+    else if (style.show_sign == 2) seg.int_format[len++] = ' ';
+    if (style.zero_pad) seg.int_format[len++] = '0';
+    if (style.padding > 0) {
+        char digits[12] = {};
+        std::size_t count = 0;
+        for (int value = style.padding; value > 0 && count < 10; value /= 10) {
+            digits[count++] = char('0' + value % 10);
+        }
+        while (count > 0) seg.int_format[len++] = digits[--count];
+    }
+    seg.int_format[len++] = 'd';
+}
+
+constexpr void add_literal(Segment* out, std::size_t& count, std::string_view text,
+                           std::size_t start, std::size_t end) {
+    if (end <= start) return;
+    if (out) {
+        Segment& seg = out[count];
+        seg.base.kind = SEGMENT_LITERAL;
+        seg.base.text = text.data() + start;
+        seg.base.length = end - start;
+    }
+    count++;
+}
+
+/**
+ * @brief Recorre el patrón con las mismas reglas que c_print()
+ *
+ * Con out == nullptr solo cuenta segmentos.
+ */
+constexpr std::size_t scan(std::string_view text, Segment* out) {
+    std::size_t count = 0;
+    std::size_t run_start = 0;
+    std::size_t p = 0;
+
+    while (p < text.size()) {
+        if (text[p] == '{') {
+            std::size_t close = text.find('}', p);
+            std::size_t len = close == std::string_view::npos ? 0 : close - p - 1;
+            PatternStyle style{};
+
+            if (len > 0 && len < 200 && parse_content(text.substr(p + 1, len), style)) {
+                add_literal(out, count, text, run_start, p);
+                if (out) {
+                    Segment& seg = out[count];
+                    seg.base.kind = SEGMENT_FIELD;
+                    seg.base.style = style;
+                    seg.base.consumes_argument = is_known_format(style.format_type);
+                    build_escape(seg.base);
+                    build_int_format(seg);
+                }
+                count++;
+                p = close + 1;
+                run_start = p;
+            } else {
+                p++;
+            }
+        } else if (text[p] == '\\' && p + 1 < text.size() && text[p + 1] == '{') {
+            add_literal(out, count, text, run_start, p);
+            run_start = p + 1;
+            p += 2;
+        } else {
+            p++;
+        }
+    }
+
+    add_literal(out, count, text, run_start, text.size());
+    return count;
+}
+
+template <std::size_t N>
+constexpr std::array<Segment, N> build_segments(std::string_view text) {
+    std::array<Segment, N> segments{};
+    scan(text, segments.data());
+    return segments;
+}
+
+template <typename Source>
+struct Compiled {
+    static constexpr std::string_view text = Source::value();
+    static constexpr std::size_t segment_count = scan(text, nullptr);
+    static constexpr std::array<Segment, segment_count> segments = build_segments<segment_count>(text);
+
+    static constexpr std::size_t field_count() {
+        std::size_t count = 0;
+        for (const Segment& seg : segments) {
+            if (seg.base.kind == SEGMENT_FIELD && seg.base.consumes_argument) count++;
+        }
+        return count;
+    }
+
+    // Índice del argumento que consume el segmento I
+    static constexpr std::size_t arg_index(std::size_t segment) {
+        std::size_t index = 0;
+        for (std::size_t i = 0; i < segment; i++) {
+            if (segments[i].base.kind == SEGMENT_FIELD && segments[i].base.consumes_argument) index++;
+        }
+        return index;
+    }
+};
+
+// ============================================================================
+// COMPROBACIÓN DE TIPOS
+// ============================================================================
+
+enum class Kind { String, Int, UInt, Long, Double, Char, Other };
+
+template <typename T>
+constexpr Kind kind_of() {
+    using D = std::decay_t<T>;
+    if constexpr (std::is_same_v<D, char*> || std::is_same_v<D, const char*> ||
+                  std::is_same_v<D, std::string> || std::is_same_v<D, std::string_view>) {
+        return Kind::String;
+    } else if constexpr (std::is_same_v<D, bool>) {
+        return Kind::Other;
+    } else if constexpr (std::is_same_v<D, char> || std::is_same_v<D, signed char> ||
+                         std::is_same_v<D, unsigned char>) {
+        return Kind::Char;
+    } else if constexpr (std::is_same_v<D, long> || std::is_same_v<D, long long>) {
+        return Kind::Long;
+    } else if constexpr (std::is_integral_v<D> && std::is_signed_v<D> && sizeof(D) <= sizeof(int)) {
+        return Kind::Int;
+    } else if constexpr (std::is_integral_v<D> && std::is_unsigned_v<D> &&
+                         sizeof(D) <= sizeof(unsigned int)) {
+        return Kind::UInt;
+    } else if constexpr (std::is_same_v<D, float> || std::is_same_v<D, double>) {
+        return Kind::Double;
+    } else {
+        return Kind::Other;
+    }
+}
+
+// Mismas reglas que cprint_validate_arg_type()
+constexpr bool accepts(char format_type, Kind kind) {
+    switch (format_type) {
+        case 's': return kind == Kind::String;
+        case 'd':
+        case 'i': return kind == Kind::Int;
+        case 'f': return kind == Kind::Double;
+        case 'c': return kind == Kind::Char;
+        case 'b':
+        case 'x':
+        case 'o':
+        case 'u': return kind == Kind::UInt || kind == Kind::Int;
+        case 'l': return kind == Kind::Long;
+        default: return false;
+    }
+}
+
+template <typename Source, typename... Args>
+constexpr bool types_match() {
+    using C = Compiled<Source>;
+    constexpr Kind kinds[sizeof...(Args) + 1] = {kind_of<Args>()..., Kind::Other};
+    std::size_t arg = 0;
+
+    for (const Segment& seg : C::segments) {
+        if (seg.base.kind != SEGMENT_FIELD || !seg.base.consumes_argument) continue;
+        if (arg >= sizeof...(Args) || !accepts(seg.base.style.format_type, kinds[arg])) return false;
+        arg++;
+    }
+    return true;
+}
+
+// ============================================================================
+// RENDERIZADO
+// ============================================================================
+
+inline void string_span(const char* s, const char*& data, std::size_t& len) {
+    data = s ? s : "";
+    len = s ? std::strlen(s) : 0;
+}
+
+inline void string_span(std::string_view s, const char*& data, std::size_t& len) {
+    data = s.data();
+    len = s.size();
+}
+
+template <typename T>
+inline std::size_t write_integer(char* buffer, std::size_t size, T value) {
+    auto result = std::to_chars(buffer, buffer + size - 1, value);
+    *result.ptr = '\0';
+    return static_cast<std::size_t>(result.ptr - buffer);
+}
+
+inline std::size_t clamp_length(int written, std::size_t size) {
+    if (written < 0) return 0;
+    return static_cast<std::size_t>(written) < size ? static_cast<std::size_t>(written) : size - 1;
+}
+
+/**
+ * @brief Formatea un argumento; cada rama se resuelve en compile-time
+ */
+template <typename Source, std::size_t I, typename T>
+inline void render_value(OutputBuffer* out, const T& arg) {
+    constexpr const Segment& seg = Compiled<Source>::segments[I];
+    constexpr const PatternStyle& style = seg.base.style;
+    constexpr char type = style.format_type;
+    char buffer[FORMAT_VALUE_BUFFER];
+    std::size_t len = 0;
+
+    if constexpr (type == 's') {
+        const char* data;
+        string_span(arg, data, len);
+        if constexpr (style.has_truncate != 0) {
+            if (len > static_cast<std::size_t>(style.truncate)) len = static_cast<std::size_t>(style.truncate);
+        }
+        render_field(out, &seg.base, data, len);
+        return;
+    } else if constexpr (type == 'd' || type == 'i') {
+        int num = static_cast<int>(arg);
+        if constexpr (style.has_separator != 0) {
+            format_with_separator(buffer, sizeof(buffer), num, style.separator);
+            len = std::strlen(buffer);
+        } else if constexpr (style.padding > 0 || style.show_sign != 0) {
+            len = clamp_length(std::snprintf(buffer, sizeof(buffer), seg.int_format, num), sizeof(buffer));
+        } else {
+            len = write_integer(buffer, sizeof(buffer), num);
+        }
+    } else if constexpr (type == 'f') {
+        double num = static_cast<double>(arg);
+        if constexpr (style.as_percentage != 0) {
+            num *= 100.0;
+            int precision = style.has_precision ? style.precision : 1;
+            len = clamp_length(std::snprintf(buffer, sizeof(buffer), "%.*f%%", precision, num), sizeof(buffer));
+        } else if constexpr (style.has_precision != 0) {
+            len = clamp_length(std::snprintf(buffer, sizeof(buffer), "%.*f", style.precision, num), sizeof(buffer));
+        } else {
+            len = clamp_length(std::snprintf(buffer, sizeof(buffer), "%f", num), sizeof(buffer));
+        }
+    } else if constexpr (type == 'c') {
+        buffer[0] = static_cast<char>(arg);
+        len = buffer[0] ? 1 : 0;
+    } else if constexpr (type == 'b') {
+        format_binary(buffer, sizeof(buffer), static_cast<unsigned int>(arg), style.show_prefix);
+        len = std::strlen(buffer);
+    } else if constexpr (type == 'x') {
+        format_hex(buffer, sizeof(buffer), static_cast<unsigned int>(arg),
+                   style.show_prefix, style.padding, style.zero_pad);
+        len = std::strlen(buffer);
+    } else if constexpr (type == 'o') {
+        format_octal(buffer, sizeof(buffer), static_cast<unsigned int>(arg), style.show_prefix);
+        len = std::strlen(buffer);
+    } else if constexpr (type == 'u') {
+        unsigned int num = static_cast<unsigned int>(arg);
+        if constexpr (style.has_separator != 0) {
+            format_with_separator(buffer, sizeof(buffer), num, style.separator);
+            len = std::strlen(buffer);
+        } else {
+            len = write_integer(buffer, sizeof(buffer), num);
+        }
+    } else if constexpr (type == 'l') {
+        long num = static_cast<long>(arg);
+        if constexpr (style.has_separator != 0) {
+            format_with_separator(buffer, sizeof(buffer), num, style.separator);
+            len = std::strlen(buffer);
+        } else {
+            len = write_integer(buffer, sizeof(buffer), num);
+        }
+    }
+
+    render_field(out, &seg.base, buffer, len);
+}
+
+template <typename Source, std::size_t I, typename Tuple>
+inline void render_segment(OutputBuffer* out, const Tuple& args) {
+    using C = Compiled<Source>;
+    constexpr const Segment& seg = C::segments[I];
+
+    if constexpr (seg.base.kind == SEGMENT_LITERAL) {
+        render_literal(out, &seg.base);
+    } else if constexpr (!seg.base.consumes_argument) {
+        render_field(out, &seg.base, "{?}", 3);
+    } else {
+        render_value<Source, I>(out, std::get<C::arg_index(I)>(args));
+    }
+}
+
+template <typename Source, typename Tuple, std::size_t... I>
+inline void render_all(OutputBuffer* out, const Tuple& args, std::index_sequence<I...>) {
+    (render_segment<Source, I>(out, args), ...);
+}
+
+template <typename Source, typename... Args>
+inline void print_compiled(const Args&... args) {
+    using C = Compiled<Source>;
+    static_assert(C::field_count() == sizeof...(Args),
+                  "cprint::print: argument count does not match pattern fields");
+    static_assert(types_match<Source, Args...>(),
+                  "cprint::print: argument type does not match pattern field");
+
+    // Mismo destino que c_print: línea atómica, modo por lotes y cola
+    char storage[1024];
+    LineStream stream;
+    OutputBuffer out;
+    line_stream_init(&stream, stdout);
+    output_init(&out, storage, sizeof(storage), &stream.sink);
+
+    render_all<Source>(&out, std::forward_as_tuple(args...),
+                       std::make_index_sequence<C::segment_count>{});
+    line_stream_finish(&stream, &out);
+}
+
+} // namespace detail
+
+// ============================================================================
+// API PÚBLICA
+// ============================================================================
+
+/**
+ * @brief Imprime un patrón compilado con CPRINT_COMPILE (C++17)
+ */
+template <typename Source, typename... Args,
+          typename = std::enable_if_t<std::is_base_of_v<compiled_string, Source>>>
+inline void print(Source, const Args&... args) {
+    detail::print_compiled<Source>(args...);
+}
+
+#if __cplusplus >= 202002L
+
+/**
+ * @brief Literal utilizable como parámetro de template (C++20)
+ */
+template <std::size_t N>
+struct fixed_string {
+    char data[N] = {};
+
+    constexpr fixed_string(const char (&text)[N]) {
+        for (std::size_t i = 0; i < N; i++) data[i] = text[i];
+    }
+};
+
+template <fixed_string S>
+struct literal_source : compiled_string {
+    static constexpr std::string_view value() { return {S.data, sizeof(S.data) - 1}; }
+};
+
+/**
+ * @brief Imprime con el patrón como parámetro de template (C++20)
+ */
+template <fixed_string Pattern, typename... Args>
+inline void print(const Args&... args) {
+    detail::print_compiled<literal_source<Pattern>>(args...);
+}
+
+#endif
+
+} // namespace cprint
+
+/**
+ * @brief Convierte un literal en un patrón compilado (estilo FMT_COMPILE)
+ */
+#define CPRINT_COMPILE(s) \
+    [] { \
+        struct cprint_source : ::cprint::compiled_string { \
+            static constexpr std::string_view value() { return s; } \
+        }; \
+        return cprint_source{}; \
+    }()
+
+#endif // C_PRINT_HPP
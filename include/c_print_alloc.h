@@ -0,0 +1,139 @@
+/**
+ * @file c_print_alloc.h
+ * @brief Interfaz de allocators para builders y estructuras internas
+ *
+ * Toda la memoria dinámica de la biblioteca pasa por un CPrintAllocator.
+ * Por defecto se usa malloc/realloc/free, pero se puede instalar uno
+ * global o asignar uno por builder. Se incluye un arena (bump-pointer)
+ * pensado para resetearse al final de cada petición.
+ */
+
+#ifndef C_PRINT_ALLOC_H
+#define C_PRINT_ALLOC_H
+
+#include <stddef.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ============================================================================
+// INTERFAZ DE ALLOCATOR
+// ============================================================================
+
+/**
+ * @brief Tabla de funciones de un allocator
+ *
+ * Las funciones reciben el tamaño anterior del bloque para que los
+ * allocators sin cabecera (arenas, pools) no necesiten guardarlo.
+ */
+typedef struct CPrintAllocator {
+    void* (*alloc)(void* ctx, size_t size);
+    void* (*realloc)(void* ctx, void* ptr, size_t old_size, size_t new_size);
+    void  (*free)(void* ctx, void* ptr, size_t size);
+    void* ctx;
+} CPrintAllocator;
+
+/**
+ * @brief Allocator basado en malloc/realloc/free
+ */
+const CPrintAllocator* cp_heap_allocator(void);
+
+/**
+ * @brief Establece el allocator global
+ * @param allocator Allocator a usar (NULL = cp_heap_allocator())
+ *
+ * Afecta a los builders creados después de la llamada. Debe configurarse
+ * al inicio del programa, antes de que otros hilos usen la biblioteca.
+ */
+void c_print_set_allocator(const CPrintAllocator* allocator);
+
+/**
+ * @brief Obtiene el allocator global actual
+ */
+const CPrintAllocator* c_print_get_allocator(void);
+
+/**
+ * @brief Helpers que delegan en un allocator (NULL = allocator global)
+ */
+void* cp_alloc(const CPrintAllocator* allocator, size_t size);
+void* cp_realloc(const CPrintAllocator* allocator, void* ptr,
+                 size_t old_size, size_t new_size);
+void cp_dealloc(const CPrintAllocator* allocator, void* ptr, size_t size);
+
+// ============================================================================
+// ARENA (BUMP-POINTER)
+// ============================================================================
+
+/**
+ * @brief Arena de memoria lineal
+ *
+ * Cada reserva avanza un puntero; liberar es gratis y cp_arena_reset()
+ * devuelve toda la memoria de golpe. Un realloc del último bloque crece
+ * en el sitio. Si el arena se agota, las reservas devuelven NULL.
+ */
+typedef struct CPrintArena {
+    char* base;
+    size_t capacity;
+    size_t offset;          // Primer byte libre
+    size_t last_offset;     // Inicio del último bloque (para realloc en sitio)
+    bool owns_memory;       // Memoria reservada por cp_arena_create()
+    CPrintAllocator allocator;
+} CPrintArena;
+
+/**
+ * @brief Inicializa un arena sobre memoria del llamador
+ */
+void cp_arena_init(CPrintArena* arena, void* memory, size_t size);
+
+/**
+ * @brief Inicializa un arena reservando su memoria con el allocator global
+ * @return false si no se pudo reservar
+ */
+bool cp_arena_create(CPrintArena* arena, size_t size);
+
+/**
+ * @brief Libera la memoria de un arena creado con cp_arena_create()
+ */
+void cp_arena_destroy(CPrintArena* arena);
+
+/**
+ * @brief Descarta todas las reservas (típicamente al final de cada petición)
+ */
+void cp_arena_reset(CPrintArena* arena);
+
+/**
+ * @brief Bytes actualmente en uso
+ */
+size_t cp_arena_used(const CPrintArena* arena);
+
+/**
+ * @brief Allocator que reserva desde el arena
+ */
+const CPrintAllocator* cp_arena_allocator(CPrintArena* arena);
+
+// ============================================================================
+// EJEMPLO DE USO
+// ============================================================================
+
+/*
+CPrintArena arena;
+cp_arena_create(&arena, 64 * 1024);
+
+for (;;) {  // Una iteración por petición
+    CPrintBuilder* b = cp_new_with_allocator(cp_arena_allocator(&arena));
+    cp_text(b, "status=");
+    cp_int(b, 200);
+    send_response(cp_to_string(b));   // También reservado en el arena
+    cp_arena_reset(&arena);           // Libera todo en O(1)
+}
+
+cp_arena_destroy(&arena);
+*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // C_PRINT_ALLOC_H
@@ -0,0 +1,95 @@
+/**
+ * @file c_print_argv.h
+ * @brief Entrada no variádica (estilo argv) para FFI y bindings
+ *
+ * c_print() es variádica y no puede llamarse de forma portable desde FFI
+ * (Bun, Node, Python ctypes...). c_print_argv() recibe los argumentos
+ * como un array de CPrintArg y escribe en un buffer del llamador, así que
+ * un binding usa el motor de patrones completo con una sola llamada.
+ * c_print_argv_batch() renderiza muchos registros por llamada para
+ * amortizar el coste de cruzar la frontera FFI.
+ *
+ * Disposición de CPrintArg (ABI de C): type es un int en el offset 0 y
+ * value una unión de 8 bytes; en plataformas de 64 bits value está en el
+ * offset 8 y el tamaño total es 16.
+ */
+
+#ifndef C_PRINT_ARGV_H
+#define C_PRINT_ARGV_H
+
+#include <stddef.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ============================================================================
+// TIPOS PARA ARGUMENTOS TIPADOS
+// ============================================================================
+
+typedef enum {
+    CPRINT_ARG_STRING,
+    CPRINT_ARG_INT,
+    CPRINT_ARG_UINT,
+    CPRINT_ARG_LONG,
+    CPRINT_ARG_ULONG,
+    CPRINT_ARG_DOUBLE,
+    CPRINT_ARG_CHAR,
+    CPRINT_ARG_BOOL,
+    CPRINT_ARG_PTR,
+    CPRINT_ARG_UNKNOWN
+} CPrintArgType;
+
+typedef struct {
+    CPrintArgType type;
+    union {
+        const char* s;
+        int i;
+        unsigned int u;
+        long l;
+        unsigned long ul;
+        double d;
+        char c;
+        bool b;
+        void* ptr;
+    } value;
+} CPrintArg;
+
+// ============================================================================
+// API
+// ============================================================================
+
+/**
+ * @brief Renderiza un patrón con argumentos tipados en un buffer
+ * @param pattern Patrón de formato (mismas reglas que c_print)
+ * @param args Argumentos, uno por campo
+ * @param count Número de argumentos
+ * @param buffer Destino (NULL si size es 0)
+ * @param size Tamaño del buffer
+ * @return Longitud completa del resultado, como snprintf (la salida se
+ *         trunca y termina en NUL si no cabe)
+ *
+ * Los errores de tipo o argumentos faltantes se muestran en la salida,
+ * igual que C_PRINT.
+ */
+size_t c_print_argv(const char* pattern, const CPrintArg* args, size_t count,
+                    char* buffer, size_t size);
+
+/**
+ * @brief Renderiza records registros con el mismo patrón, uno tras otro
+ * @param args records * fields_per_record argumentos (registro r empieza
+ *             en args[r * fields_per_record])
+ * @return Longitud completa de todos los registros, como snprintf
+ *
+ * El patrón se resuelve una sola vez para todo el lote.
+ */
+size_t c_print_argv_batch(const char* pattern, const CPrintArg* args,
+                          size_t fields_per_record, size_t records,
+                          char* buffer, size_t size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // C_PRINT_ARGV_H
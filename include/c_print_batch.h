@@ -0,0 +1,128 @@
+/**
+ * @file c_print_batch.h
+ * @brief Salida por lotes con un buffer por hilo
+ *
+ * Con la opción de CMake C_PRINT_BATCH=ON y tras c_print_batch_start(),
+ * las líneas de c_print(), c_print_safe(), C_PRINT y c_print_typed() no
+ * van a stdout una por una: cada hilo las acumula en su propio buffer y
+ * lo entrega completo a stdout (un solo fwrite, un solo lock) cuando:
+ *
+ *   - la línea siguiente no cabe en el buffer (tamaño),
+ *   - lo pendiente supera flush_interval_ms (un hilo de fondo vacía
+ *     también los buffers de hilos inactivos),
+ *   - se llama a c_print_batch_flush() o c_print_batch_flush_all(),
+ *   - el hilo termina, se llama a c_print_batch_stop() o el programa
+ *     sale con exit().
+ *
+ * Los buffers se entregan siempre en un límite de línea, así que las
+ * líneas de distintos hilos nunca se intercalan, y cada hilo conserva el
+ * orden de sus propias líneas. Entre hilos el orden es el de entrega.
+ *
+ * c_print_styled(), c_printf_styled() y cp_print()/cp_println() entregan
+ * antes lo pendiente del hilo para no adelantarse a sus líneas. Otras
+ * escrituras directas a stdout (printf) no lo hacen: llamar antes a
+ * c_print_batch_flush() si el orden importa.
+ *
+ * Sin la opción (o en Windows) c_print_batch_start() devuelve false y
+ * todo se escribe línea por línea.
+ *
+ * Uso:
+ *   CPrintBatchConfig config = { 64 * 1024, 50 };
+ *   c_print_batch_start(&config);
+ *   ...
+ *   c_print_batch_stop();
+ */
+
+#ifndef C_PRINT_BATCH_H
+#define C_PRINT_BATCH_H
+
+#include <stdio.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Tamaño por defecto del buffer de cada hilo
+#define CPRINT_BATCH_DEFAULT_BUFFER (16 * 1024)
+
+/**
+ * @brief Configuración del modo por lotes
+ */
+typedef struct {
+    size_t buffer_size;             // Bytes por hilo (0 = CPRINT_BATCH_DEFAULT_BUFFER)
+    unsigned flush_interval_ms;     // Antigüedad máxima de lo pendiente (0 = sin límite)
+} CPrintBatchConfig;
+
+/**
+ * @brief Activa el modo por lotes
+ * @param config NULL para los valores por defecto
+ * @return false si la biblioteca se compiló sin C_PRINT_BATCH o si no se
+ *         pudo crear el hilo de vaciado
+ *
+ * Si ya estaba activo, aplica la nueva configuración.
+ */
+bool c_print_batch_start(const CPrintBatchConfig* config);
+
+/**
+ * @brief Entrega todo lo pendiente y vuelve a escribir línea por línea
+ */
+void c_print_batch_stop(void);
+
+/**
+ * @brief Indica si el modo por lotes está activo
+ */
+bool c_print_batch_active(void);
+
+/**
+ * @brief Entrega lo pendiente del hilo actual y vacía stdout
+ */
+void c_print_batch_flush(void);
+
+/**
+ * @brief Entrega lo pendiente de todos los hilos y vacía stdout
+ *
+ * Espera a que cada hilo termine la línea que está escribiendo.
+ */
+void c_print_batch_flush_all(void);
+
+// ============================================================================
+// USO INTERNO (caminos de impresión de la biblioteca)
+// ============================================================================
+
+/**
+ * @brief Empieza una línea por lotes: bloquea el buffer del hilo
+ * @return false si el modo no está activo (escribir directo)
+ */
+bool cp_batch_begin_line(void);
+
+/**
+ * @brief Agrega parte de la línea en curso
+ */
+void cp_batch_write(const char* data, size_t len);
+
+/**
+ * @brief Termina la línea: entrega el buffer si venció el intervalo
+ */
+void cp_batch_end_line(void);
+
+/**
+ * @brief Entrega lo pendiente del hilo antes de una escritura directa
+ */
+void cp_batch_sync(void);
+
+#if defined(C_PRINT_BATCH) && !defined(_WIN32)
+    #define CP_BATCH_ENABLED 1
+    #define CP_BATCH_BEGIN_LINE(fp) ((fp) == stdout && cp_batch_begin_line())
+    #define CP_BATCH_SYNC() cp_batch_sync()
+#else
+    #define CP_BATCH_BEGIN_LINE(fp) false
+    #define CP_BATCH_SYNC() ((void)0)
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // C_PRINT_BATCH_H
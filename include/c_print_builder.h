@@ -10,7 +10,10 @@
 #define C_PRINT_BUILDER_H
 
 #include "ansi_codes.h"
+#include "c_print_alloc.h"
+#include "c_print_sink.h"
 #include <stdbool.h>
+#include <stddef.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -22,6 +25,32 @@ extern "C" {
 
 typedef struct CPrintBuilder CPrintBuilder;
 
+/**
+ * @brief Tamaño (en bytes) del almacenamiento opaco de un builder
+ *
+ * Cambiar este valor rompe la ABI: la estructura interna se valida
+ * contra él en compile-time.
+ */
+#define CP_BUILDER_STORAGE_SIZE 320
+
+/**
+ * @brief Almacenamiento opaco para builders propiedad del llamador
+ *
+ * Permite declarar un builder en el stack o dentro de una estructura
+ * de usuario sin pasar por malloc. Se inicializa con cp_init().
+ */
+typedef union CPrintBuilderStorage {
+    unsigned char opaque[CP_BUILDER_STORAGE_SIZE];
+    void* align_ptr;
+    long long align_ll;
+    long double align_ld;
+} CPrintBuilderStorage;
+
+/**
+ * @brief Obtiene el builder contenido en un CPrintBuilderStorage
+ */
+#define CP_BUILDER(storage) ((CPrintBuilder*)(void*)(storage))
+
 // ============================================================================
 // CREACIÓN Y DESTRUCCIÓN
 // ============================================================================
@@ -32,16 +61,94 @@ typedef struct CPrintBuilder CPrintBuilder;
  */
 CPrintBuilder* cp_new(void);
 
+/**
+ * @brief Crea un builder que reserva su memoria con un allocator concreto
+ * @param allocator Allocator a usar (NULL = allocator global)
+ *
+ * El allocator debe sobrevivir al builder. Con un arena, cp_free() es
+ * opcional: cp_arena_reset() recupera también la estructura.
+ */
+CPrintBuilder* cp_new_with_allocator(const CPrintAllocator* allocator);
+
+/**
+ * @brief Asigna el allocator de un builder creado con cp_init()
+ *
+ * Solo tiene efecto antes de que el builder reserve memoria dinámica.
+ */
+CPrintBuilder* cp_set_allocator(CPrintBuilder* b, const CPrintAllocator* allocator);
+
+/**
+ * @brief Inicializa un builder en memoria del llamador (sin malloc)
+ * @param b Builder obtenido con CP_BUILDER() sobre un CPrintBuilderStorage
+ * @param storage Buffer inicial para el contenido (NULL = buffer interno)
+ * @param n Tamaño de storage en bytes
+ * @return El mismo builder, listo para usar
+ *
+ * El contenido se escribe en storage (o en el buffer interno del builder
+ * si storage es NULL) y solo se copia al heap si se desborda.
+ * Debe liberarse con cp_free(), que solo libera la memoria desbordada.
+ * El builder no debe copiarse ni moverse tras la inicialización.
+ *
+ * @code
+ * CPrintBuilderStorage storage;
+ * char text[128];
+ * CPrintBuilder* b = cp_init(CP_BUILDER(&storage), text, sizeof(text));
+ * cp_int(b, 42);
+ * cp_println(b);
+ * cp_free(b);
+ * @endcode
+ */
+CPrintBuilder* cp_init(CPrintBuilder* b, char* storage, size_t n);
+
 /**
  * @brief Libera un builder
+ *
+ * Para builders creados con cp_init() solo libera la memoria del heap
+ * usada tras un desbordamiento; el almacenamiento es del llamador.
  */
 void cp_free(CPrintBuilder* builder);
 
 /**
  * @brief Resetea un builder para reutilizarlo
+ *
+ * Descarta el contenido, las opciones pendientes, los slots y el modo
+ * streaming de cp_stream_to().
  */
 void cp_reset(CPrintBuilder* builder);
 
+// ============================================================================
+// POOL DE BUILDERS (THREAD-LOCAL)
+// ============================================================================
+
+/**
+ * @brief Número máximo de builders retenidos por hilo
+ */
+#define CP_POOL_MAX_BUILDERS 16
+
+/**
+ * @brief Obtiene un builder vacío del pool del hilo actual
+ *
+ * Reutiliza un builder liberado con cp_pool_release() (incluido su
+ * buffer ya crecido) y solo reserva memoria si el pool está vacío.
+ */
+CPrintBuilder* cp_pool_acquire(void);
+
+/**
+ * @brief Devuelve un builder al pool del hilo actual
+ *
+ * Si el pool está lleno, o el builder no proviene de cp_pool_acquire()/
+ * cp_new() con el allocator del heap, se libera con cp_free().
+ */
+void cp_pool_release(CPrintBuilder* b);
+
+/**
+ * @brief Libera los builders retenidos por el hilo actual
+ *
+ * Al terminar un hilo su pool se libera solo (salvo en Windows); sirve
+ * para devolver antes la memoria de un hilo que sigue vivo.
+ */
+void cp_pool_drain(void);
+
 // ============================================================================
 // AGREGAR CONTENIDO (TYPE-SAFE)
 // ============================================================================
@@ -56,6 +163,16 @@ CPrintBuilder* cp_text(CPrintBuilder* b, const char* text);
  */
 CPrintBuilder* cp_str(CPrintBuilder* b, const char* str);
 
+/**
+ * @brief Agrega length bytes de texto literal (sin strlen)
+ */
+CPrintBuilder* cp_text_n(CPrintBuilder* b, const char* text, size_t length);
+
+/**
+ * @brief Agrega length bytes de un string con formato (sin strlen)
+ */
+CPrintBuilder* cp_str_n(CPrintBuilder* b, const char* str, size_t length);
+
 /**
  * @brief Agrega un entero con formato
  */
@@ -190,6 +307,50 @@ CPrintBuilder* cp_align_center(CPrintBuilder* b, int width);
  */
 CPrintBuilder* cp_fill_char(CPrintBuilder* b, char ch);
 
+// ============================================================================
+// PLANTILLAS CON SLOTS
+// ============================================================================
+
+/**
+ * @brief Reserva un slot de ancho fijo para un valor que cambiará
+ * @param width Ancho del slot en bytes
+ * @return Identificador del slot, o -1 si no se pudo reservar
+ *
+ * Consume las opciones pendientes igual que cp_int()/cp_str(): colores,
+ * alineación, relleno, precisión y separador quedan fijados en el slot.
+ * Las secuencias ANSI y el texto literal se generan una sola vez; cada
+ * cp_slot_set_*() posterior solo reescribe los bytes del slot.
+ * No disponible en modo streaming.
+ *
+ * @code
+ * CPrintBuilder* b = cp_new();
+ * cp_text(b, "CPU: ");
+ * int cpu = cp_slot(cp_precision(cp_color_str(b, "green"), 1), 5);
+ * cp_text(b, "% | Jobs: ");
+ * int jobs = cp_slot(b, 6);
+ *
+ * for (;;) {
+ *     cp_slot_set_float(b, cpu, read_cpu());
+ *     cp_slot_set_int(b, jobs, count_jobs());
+ *     cp_print(b);
+ * }
+ * @endcode
+ */
+int cp_slot(CPrintBuilder* b, int width);
+
+/**
+ * @brief Escriben un valor en un slot
+ *
+ * Los números se alinean a la derecha (salvo otra alineación al reservar)
+ * y si no caben el slot se rellena con '#'. Los strings se alinean a la
+ * izquierda y se truncan al ancho del slot.
+ */
+void cp_slot_set_int(CPrintBuilder* b, int slot, int value);
+void cp_slot_set_uint(CPrintBuilder* b, int slot, unsigned int value);
+void cp_slot_set_long(CPrintBuilder* b, int slot, long value);
+void cp_slot_set_float(CPrintBuilder* b, int slot, double value);
+void cp_slot_set_str(CPrintBuilder* b, int slot, const char* value);
+
 // ============================================================================
 // IMPRESIÓN
 // ============================================================================
@@ -206,10 +367,75 @@ void cp_println(CPrintBuilder* b);
 
 /**
  * @brief Obtiene el string construido (sin imprimir)
- * @return String que debe ser liberado con free()
+ * @return String reservado con el allocator del builder
+ *         (con el allocator por defecto, liberar con free())
  */
 char* cp_to_string(CPrintBuilder* b);
 
+// ============================================================================
+// SALIDA SIN COPIAS
+// ============================================================================
+
+/**
+ * @brief Vista de solo lectura sobre el contenido de un builder
+ */
+typedef struct {
+    const char* data;   // Terminado en NUL
+    size_t length;
+} CPrintView;
+
+/**
+ * @brief Obtiene el contenido sin copiarlo
+ *
+ * La vista es válida hasta la siguiente modificación del builder.
+ */
+CPrintView cp_view(const CPrintBuilder* b);
+
+/**
+ * @brief Transfiere el buffer al llamador y deja el builder vacío
+ * @param length [out] Longitud del contenido (puede ser NULL)
+ * @return String reservado con el allocator del builder
+ *
+ * Si el contenido ya está en el heap se entrega sin copiar; si aún vive
+ * en el buffer interno o en el del llamador se copia una vez.
+ */
+char* cp_detach(CPrintBuilder* b, size_t* length);
+
+/**
+ * @brief Escribe el contenido en un sink usando su longitud conocida
+ * @return Bytes escritos
+ */
+size_t cp_write(CPrintBuilder* b, const CPrintSink* sink);
+
+// ============================================================================
+// STREAMING
+// ============================================================================
+
+/**
+ * @brief Conecta el builder a un sink con auto-flush
+ * @param sink Destino (se copia; NULL desactiva el streaming)
+ * @param high_water Umbral en bytes a partir del cual se vuelca el contenido
+ *
+ * Cuando el contenido supera high_water, los elementos ya completos se
+ * escriben en el sink y el buffer se reutiliza. Las opciones de formato
+ * pendientes (color, alineación...) se conservan entre volcados, por lo
+ * que la memoria queda acotada a high_water más el elemento más grande.
+ * Llamar a cp_flush() antes de cp_free() para volcar el resto.
+ *
+ * @return b, o NULL si el builder ya tiene slots reservados con cp_slot()
+ *         (un volcado los invalidaría); en ese caso no cambia nada
+ */
+CPrintBuilder* cp_stream_to(CPrintBuilder* b, const CPrintSink* sink, size_t high_water);
+
+/**
+ * @brief Vuelca el contenido actual al sink de streaming
+ * @return Bytes escritos (0 si el builder no está en modo streaming)
+ *
+ * Si el sink acepta menos bytes de los entregados, el resto queda en el
+ * builder y se reintenta en el próximo volcado.
+ */
+size_t cp_flush(CPrintBuilder* b);
+
 // ============================================================================
 // UTILIDADES
 // ============================================================================
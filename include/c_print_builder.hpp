@@ -0,0 +1,263 @@
+/**
+ * @file c_print_builder.hpp
+ * @brief Envoltorio RAII de C++17 para CPrintBuilder
+ *
+ * cprint::Builder es move-only, libera el builder en su destructor y
+ * agrega std::string_view, enteros y flotantes por longitud, sin strlen
+ * ni cadenas de formato. El contenido vive en un std::string propio
+ * (a través de un CPrintAllocator), así que str() && lo entrega por
+ * movimiento sin copiarlo. Un Builder movido queda vacío: las lecturas
+ * devuelven texto vacío y la siguiente escritura le crea un estado nuevo.
+ *
+ * Uso:
+ *   cprint::Builder b;
+ *   b.color(COLOR_GREEN) << "total";
+ *   b << ": " << 42 << " items, " << 3.5 << " kg";
+ *   std::string line = std::move(b).str();
+ */
+
+#ifndef C_PRINT_BUILDER_HPP
+#define C_PRINT_BUILDER_HPP
+
+#if __cplusplus < 201703L && !(defined(_MSVC_LANG) && _MSVC_LANG >= 201703L)
+#error "c_print_builder.hpp requires C++17 or later"
+#endif
+
+#include "c_print_builder.h"
+#include <charconv>
+#include <cstddef>
+#include <cstdio>
+#include <new>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+namespace cprint {
+
+class Builder {
+public:
+    Builder() : state_(create_state()) {}
+
+    Builder(const Builder&) = delete;
+    Builder& operator=(const Builder&) = delete;
+
+    Builder(Builder&& other) noexcept : state_(std::exchange(other.state_, nullptr)) {}
+
+    Builder& operator=(Builder&& other) noexcept {
+        if (this != &other) {
+            destroy();
+            state_ = std::exchange(other.state_, nullptr);
+        }
+        return *this;
+    }
+
+    ~Builder() { destroy(); }
+
+    /**
+     * @brief Builder C subyacente, para usar el resto de la API cp_*
+     *
+     * Tras un movimiento la versión no const crea un estado vacío nuevo y
+     * la const devuelve nullptr (la API cp_* lo trata como builder vacío).
+     */
+    CPrintBuilder* raw() {
+        if (!state_) state_ = create_state();
+        return CP_BUILDER(&state_->storage);
+    }
+    const CPrintBuilder* raw() const noexcept {
+        return state_ ? CP_BUILDER(&state_->storage) : nullptr;
+    }
+
+    // ------------------------------------------------------------------------
+    // Agregar valores (consumen las opciones pendientes como cp_str)
+    // ------------------------------------------------------------------------
+
+    Builder& operator<<(std::string_view text) {
+        cp_str_n(raw(), text.data(), text.size());
+        return *this;
+    }
+
+    Builder& operator<<(const char* text) {
+        if (text) *this << std::string_view(text);
+        return *this;
+    }
+
+    Builder& operator<<(const std::string& text) {
+        return *this << std::string_view(text);
+    }
+
+    Builder& operator<<(char ch) {
+        cp_str_n(raw(), &ch, 1);
+        return *this;
+    }
+
+    Builder& operator<<(bool value) {
+        cp_bool(raw(), value);
+        return *this;
+    }
+
+    template <typename T,
+              typename = std::enable_if_t<std::is_integral_v<T> && !std::is_same_v<T, bool> &&
+                                          !std::is_same_v<T, char>>>
+    Builder& operator<<(T value) {
+        char buffer[24];
+        auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+        cp_str_n(raw(), buffer, static_cast<std::size_t>(result.ptr - buffer));
+        return *this;
+    }
+
+    Builder& operator<<(double value) {
+        // Mismo texto que std::ostream por defecto (%g con 6 dígitos)
+        char buffer[32];
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+        auto result = std::to_chars(buffer, buffer + sizeof(buffer), value,
+                                    std::chars_format::general, 6);
+        std::size_t len = static_cast<std::size_t>(result.ptr - buffer);
+#else
+        int written = std::snprintf(buffer, sizeof(buffer), "%g", value);
+        std::size_t len = written > 0 ? static_cast<std::size_t>(written) : 0;
+#endif
+        cp_str_n(raw(), buffer, len);
+        return *this;
+    }
+
+    Builder& operator<<(float value) { return *this << static_cast<double>(value); }
+
+    /**
+     * @brief Agrega texto literal sin aplicar opciones pendientes
+     */
+    Builder& text(std::string_view literal) {
+        cp_text_n(raw(), literal.data(), literal.size());
+        return *this;
+    }
+
+    // ------------------------------------------------------------------------
+    // Opciones para el siguiente valor
+    // ------------------------------------------------------------------------
+
+    Builder& color(TextColor color) { cp_color(raw(), color); return *this; }
+    Builder& bg(BackgroundColor color) { cp_bg(raw(), color); return *this; }
+    Builder& style(TextStyle style) { cp_style(raw(), style); return *this; }
+    Builder& align_left(int width) { cp_align_left(raw(), width); return *this; }
+    Builder& align_right(int width) { cp_align_right(raw(), width); return *this; }
+    Builder& align_center(int width) { cp_align_center(raw(), width); return *this; }
+    Builder& fill(char ch) { cp_fill_char(raw(), ch); return *this; }
+
+    // ------------------------------------------------------------------------
+    // Salida
+    // ------------------------------------------------------------------------
+
+    std::string_view view() const noexcept {
+        CPrintView v = cp_view(raw());
+        return std::string_view(v.data, v.length);
+    }
+
+    std::size_t size() const noexcept { return cp_size(raw()); }
+    bool empty() const noexcept { return cp_is_empty(raw()); }
+
+    void clear() noexcept {
+        if (state_) cp_reset(raw());
+    }
+
+    void print() { cp_print(raw()); }
+    void println() { cp_println(raw()); }
+
+    /**
+     * @brief Copia del contenido; el builder conserva su texto
+     */
+    std::string str() const & { return std::string(view()); }
+
+    /**
+     * @brief Entrega el contenido por movimiento y deja el builder vacío
+     *
+     * Si el contenido ya desbordó el buffer interno vive en el std::string
+     * del builder y se mueve sin copiarse.
+     */
+    std::string str() && {
+        std::size_t length = 0;
+        char* data = cp_detach(raw(), &length);
+        if (!data) return std::string();
+
+        if (state_->owns(data)) {
+            state_->in_use = false;
+            state_->text.resize(length);
+            return std::move(state_->text);
+        }
+
+        std::string result(data, length);
+        cp_dealloc(cp_heap_allocator(), data, length + 1);
+        return result;
+    }
+
+private:
+    /**
+     * @brief Estado en el heap: el builder C no puede moverse de dirección
+     */
+    struct State {
+        CPrintBuilderStorage storage;
+        CPrintAllocator allocator;
+        std::string text;           // Memoria del contenido desbordado
+        bool in_use = false;
+
+        bool owns(const void* ptr) const { return in_use && ptr == text.data(); }
+
+        // El primer bloque (el buffer de contenido) se sirve desde text;
+        // cualquier otro bloque simultáneo va al heap
+        static void* alloc(void* ctx, size_t size) {
+            State* self = static_cast<State*>(ctx);
+            if (self->in_use) return cp_alloc(cp_heap_allocator(), size);
+            try {
+                self->text.resize(size);
+            } catch (const std::bad_alloc&) {
+                return nullptr;
+            }
+            self->in_use = true;
+            return &self->text[0];
+        }
+
+        static void* realloc(void* ctx, void* ptr, size_t old_size, size_t new_size) {
+            State* self = static_cast<State*>(ctx);
+            if (!self->owns(ptr)) return cp_realloc(cp_heap_allocator(), ptr, old_size, new_size);
+            try {
+                self->text.resize(new_size);
+            } catch (const std::bad_alloc&) {
+                return nullptr;
+            }
+            return &self->text[0];
+        }
+
+        static void free(void* ctx, void* ptr, size_t size) {
+            State* self = static_cast<State*>(ctx);
+            if (self->owns(ptr)) {
+                self->in_use = false;
+                return;
+            }
+            cp_dealloc(cp_heap_allocator(), ptr, size);
+        }
+    };
+
+    static State* create_state() {
+        State* state = new State;
+        state->allocator.alloc = &State::alloc;
+        state->allocator.realloc = &State::realloc;
+        state->allocator.free = &State::free;
+        state->allocator.ctx = state;
+
+        CPrintBuilder* b = cp_init(CP_BUILDER(&state->storage), nullptr, 0);
+        cp_set_allocator(b, &state->allocator);
+        return state;
+    }
+
+    void destroy() noexcept {
+        if (!state_) return;
+        cp_free(raw());
+        delete state_;
+        state_ = nullptr;
+    }
+
+    State* state_;
+};
+
+} // namespace cprint
+
+#endif // C_PRINT_BUILDER_HPP
@@ -0,0 +1,30 @@
+/**
+ * @file c_print_config.h
+ * @brief Configuración de plataforma compartida por los módulos
+ *
+ * Macros de portabilidad usadas internamente por la biblioteca
+ * (almacenamiento thread-local, etc.).
+ */
+
+#ifndef C_PRINT_CONFIG_H
+#define C_PRINT_CONFIG_H
+
+// Almacenamiento thread-local
+#if defined(_MSC_VER)
+    #define CP_THREAD_LOCAL __declspec(thread)
+#elif defined(__cplusplus)
+    #define CP_THREAD_LOCAL thread_local
+#else
+    #define CP_THREAD_LOCAL _Thread_local
+#endif
+
+// Bloqueo de un FILE para que una línea no se intercale con otros hilos
+#if defined(_WIN32)
+    #define CP_LOCK_FILE(fp) _lock_file(fp)
+    #define CP_UNLOCK_FILE(fp) _unlock_file(fp)
+#else
+    #define CP_LOCK_FILE(fp) flockfile(fp)
+    #define CP_UNLOCK_FILE(fp) funlockfile(fp)
+#endif
+
+#endif // C_PRINT_CONFIG_H
@@ -0,0 +1,73 @@
+/**
+ * @file c_print_freestanding.h
+ * @brief Renderizado sin stdio ni heap sobre memoria del llamador
+ *
+ * c_print_to() acepta los mismos patrones que c_print() y arma la salida
+ * en un buffer que pone el llamador. Solo usa el parser de patrones, los
+ * formateadores de number_formatter, la alineación y las secuencias de
+ * format_ansi_codes(): no llama a printf/snprintf, no reserva memoria, no
+ * consulta el locale ni usa ctype. De la biblioteca de C solo necesita
+ * memcpy, memset, strlen, strcmp, strncmp, strchr y strncpy.
+ *
+ * Es el punto de entrada de la compilación freestanding
+ * (-DC_PRINT_FREESTANDING=ON, biblioteca c_print_freestanding), pensada
+ * para firmware y kernels sin libc completa. También está en la
+ * biblioteca normal, donde la usa c_print_signal_safe().
+ *
+ * Con sink, el buffer es un área de paso: se entrega al sink cada vez que
+ * se llena y al final, así que basta con unas decenas de bytes. Sin sink
+ * se comporta como snprintf. Los floats siempre usan '.' como punto
+ * decimal y los valores que no son strings se recortan a 511 bytes; el
+ * resto del texto es el mismo que el de c_print().
+ *
+ * Uso:
+ *   static size_t uart_write(void* ctx, const char* data, size_t len) {
+ *       for (size_t i = 0; i < len; i++) uart_putc(data[i]);
+ *       return len;
+ *   }
+ *
+ *   char staging[64];
+ *   CPrintSink uart = {uart_write, NULL};
+ *   c_print_to(&uart, staging, sizeof(staging), "{s:green} {d:05}\n", "boot", 42);
+ */
+
+#ifndef C_PRINT_FREESTANDING_H
+#define C_PRINT_FREESTANDING_H
+
+#include "c_print_sink.h"
+#include <stdarg.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Valores no string formateados (los strings se copian en su lugar)
+#define CPRINT_FREESTANDING_VALUE_BUFFER 512
+
+/**
+ * @brief Renderiza un patrón en memoria del llamador
+ * @param sink Destino de la salida; NULL para escribir solo en el buffer
+ * @param buffer Memoria para armar la salida
+ * @param capacity Tamaño del buffer en bytes
+ * @param pattern Patrón con la sintaxis de c_print()
+ * @return Con sink, bytes aceptados por el sink. Sin sink, longitud
+ *         completa del resultado como snprintf (la salida se trunca a
+ *         capacity - 1 bytes y termina en NUL si capacity > 0)
+ *
+ * Usa menos de 1 KB de pila además del buffer.
+ */
+size_t c_print_to(const CPrintSink* sink, char* buffer, size_t capacity,
+                  const char* pattern, ...);
+
+/**
+ * @brief Versión de c_print_to() con va_list
+ */
+size_t c_vprint_to(const CPrintSink* sink, char* buffer, size_t capacity,
+                   const char* pattern, va_list args);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // C_PRINT_FREESTANDING_H
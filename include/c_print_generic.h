@@ -9,54 +9,30 @@
  *   #define C_PRINT_USE_GENERIC
  *   #include "c_print.h"
  *   #include "c_print_generic.h"
+ *
+ * Con C_PRINT_VALIDATED definido, C_PRINT exige patrones literales. En
+ * C++20 el patrón se valida contra los argumentos con consteval y la
+ * llamada va directa a c_print(); en C solo se pueden comprobar los tipos
+ * en compile-time, así que el cruce con el patrón sigue en runtime.
  */
 
 #ifndef C_PRINT_GENERIC_H
 #define C_PRINT_GENERIC_H
 
 #include "c_print.h"
+#include "c_print_macros.h"
+#include "c_print_argv.h"
+#include <stddef.h>
 #include <stdint.h>
 #include <stdbool.h>
 
-// Solo disponible en C11+
+// Solo disponible en C11+ (C++20 usa la validación consteval más abajo)
 #if __STDC_VERSION__ >= 201112L
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
-// ============================================================================
-// TIPOS PARA ARGUMENTOS TIPADOS
-// ============================================================================
-
-typedef enum {
-    CPRINT_ARG_STRING,
-    CPRINT_ARG_INT,
-    CPRINT_ARG_UINT,
-    CPRINT_ARG_LONG,
-    CPRINT_ARG_ULONG,
-    CPRINT_ARG_DOUBLE,
-    CPRINT_ARG_CHAR,
-    CPRINT_ARG_BOOL,
-    CPRINT_ARG_PTR,
-    CPRINT_ARG_UNKNOWN
-} CPrintArgType;
-
-typedef struct {
-    CPrintArgType type;
-    union {
-        const char* s;
-        int i;
-        unsigned int u;
-        long l;
-        unsigned long ul;
-        double d;
-        char c;
-        bool b;
-        void* ptr;
-    } value;
-} CPrintArg;
-
 // ============================================================================
 // MACROS _GENERIC PARA DETECCIÓN AUTOMÁTICA DE TIPOS
 // ============================================================================
@@ -101,6 +77,50 @@ typedef struct {
     default: CPRINT_ARG_UNKNOWN \
 )
 
+// ============================================================================
+// VALIDACIÓN EN COMPILE-TIME
+// ============================================================================
+
+/**
+ * @brief Tipo de un argumento como expresión constante entera
+ */
+#define CPRINT_ARG_TYPE(x) _Generic((x), \
+    char*: CPRINT_ARG_STRING, \
+    const char*: CPRINT_ARG_STRING, \
+    int: CPRINT_ARG_INT, \
+    unsigned int: CPRINT_ARG_UINT, \
+    long: CPRINT_ARG_LONG, \
+    unsigned long: CPRINT_ARG_ULONG, \
+    long long: CPRINT_ARG_LONG, \
+    unsigned long long: CPRINT_ARG_ULONG, \
+    float: CPRINT_ARG_DOUBLE, \
+    double: CPRINT_ARG_DOUBLE, \
+    char: CPRINT_ARG_CHAR, \
+    signed char: CPRINT_ARG_CHAR, \
+    unsigned char: CPRINT_ARG_CHAR, \
+    _Bool: CPRINT_ARG_BOOL, \
+    void*: CPRINT_ARG_PTR, \
+    default: CPRINT_ARG_UNKNOWN \
+)
+
+/**
+ * @brief Rechaza en compile-time un argumento de tipo no soportado
+ *
+ * C no permite leer el contenido de un literal en una expresión
+ * constante, así que el cruce patrón/argumentos se hace en runtime
+ * (o en compile-time desde C++20); aquí se garantiza al menos que
+ * todos los tipos tienen representación.
+ */
+#define CPRINT_STATIC_CHECK_ARG(x) \
+    (void)sizeof(struct { \
+        _Static_assert(CPRINT_ARG_TYPE(x) != CPRINT_ARG_UNKNOWN, \
+                       "C_PRINT: unsupported argument type"); \
+        char unused; \
+    })
+
+#define C_PRINT_STATIC_CHECK(...) \
+    (CP_PP_MAP_LIST(CPRINT_STATIC_CHECK_ARG, __VA_ARGS__))
+
 // ============================================================================
 // FUNCIONES HELPER PARA CREAR CPrintArg
 // ============================================================================
@@ -237,40 +257,40 @@ static inline const char* cprint_expected_type_name(char format_type) {
  */
 void c_print_checked(const char* pattern, ...);
 
-// Implementación con macros variádicas
-#define C_PRINT_MAX_ARGS 10
-
-// Helper para contar argumentos usando el truco del contador
-#define C_PRINT_NARG(...) C_PRINT_NARG_(__VA_ARGS__, C_PRINT_RSEQ_N())
-#define C_PRINT_NARG_(...) C_PRINT_ARG_N(__VA_ARGS__)
-#define C_PRINT_ARG_N(_1, _2, _3, _4, _5, _6, _7, _8, _9, _10, N, ...) N
-#define C_PRINT_RSEQ_N() 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0
-
-// Macros para aplicar CPRINT_ARG a cada elemento
-#define C_PRINT_APPLY_ARG_1(x1) CPRINT_ARG(x1)
-#define C_PRINT_APPLY_ARG_2(x1, x2) CPRINT_ARG(x1), CPRINT_ARG(x2)
-#define C_PRINT_APPLY_ARG_3(x1, x2, x3) CPRINT_ARG(x1), CPRINT_ARG(x2), CPRINT_ARG(x3)
-#define C_PRINT_APPLY_ARG_4(x1, x2, x3, x4) CPRINT_ARG(x1), CPRINT_ARG(x2), CPRINT_ARG(x3), CPRINT_ARG(x4)
-#define C_PRINT_APPLY_ARG_5(x1, x2, x3, x4, x5) CPRINT_ARG(x1), CPRINT_ARG(x2), CPRINT_ARG(x3), CPRINT_ARG(x4), CPRINT_ARG(x5)
-#define C_PRINT_APPLY_ARG_6(x1, x2, x3, x4, x5, x6) CPRINT_ARG(x1), CPRINT_ARG(x2), CPRINT_ARG(x3), CPRINT_ARG(x4), CPRINT_ARG(x5), CPRINT_ARG(x6)
-#define C_PRINT_APPLY_ARG_7(x1, x2, x3, x4, x5, x6, x7) CPRINT_ARG(x1), CPRINT_ARG(x2), CPRINT_ARG(x3), CPRINT_ARG(x4), CPRINT_ARG(x5), CPRINT_ARG(x6), CPRINT_ARG(x7)
-#define C_PRINT_APPLY_ARG_8(x1, x2, x3, x4, x5, x6, x7, x8) CPRINT_ARG(x1), CPRINT_ARG(x2), CPRINT_ARG(x3), CPRINT_ARG(x4), CPRINT_ARG(x5), CPRINT_ARG(x6), CPRINT_ARG(x7), CPRINT_ARG(x8)
-#define C_PRINT_APPLY_ARG_9(x1, x2, x3, x4, x5, x6, x7, x8, x9) CPRINT_ARG(x1), CPRINT_ARG(x2), CPRINT_ARG(x3), CPRINT_ARG(x4), CPRINT_ARG(x5), CPRINT_ARG(x6), CPRINT_ARG(x7), CPRINT_ARG(x8), CPRINT_ARG(x9)
-#define C_PRINT_APPLY_ARG_10(x1, x2, x3, x4, x5, x6, x7, x8, x9, x10) CPRINT_ARG(x1), CPRINT_ARG(x2), CPRINT_ARG(x3), CPRINT_ARG(x4), CPRINT_ARG(x5), CPRINT_ARG(x6), CPRINT_ARG(x7), CPRINT_ARG(x8), CPRINT_ARG(x9), CPRINT_ARG(x10)
-
-// Macro para seleccionar la macro correcta según el número de argumentos
-#define C_PRINT_APPLY_ARG_(N) C_PRINT_APPLY_ARG_##N
-#define C_PRINT_APPLY_ARG(N) C_PRINT_APPLY_ARG_(N)
-
-// Macro de expansión intermedia necesaria para forzar la evaluación
-#define C_PRINT_EXPAND(x) x
+/**
+ * @brief Array temporal de CPrintArg, uno por argumento (sin límite)
+ */
+#define CPRINT_ARGS(...) \
+    ((const CPrintArg[]){ CP_PP_MAP_LIST(CPRINT_ARG, __VA_ARGS__) })
+
+/**
+ * @brief Número de argumentos, calculado en compile-time
+ */
+#define CPRINT_ARGS_COUNT(...) \
+    (sizeof(CPRINT_ARGS(__VA_ARGS__)) / sizeof(CPrintArg))
 
+#ifdef C_PRINT_VALIDATED
+// En C el patrón no se puede leer en compile-time: se exige literal, pero
+// el cruce patrón/argumentos sigue en runtime (el camino directo es de C++20)
+#define C_PRINT(pattern, ...) \
+    (C_PRINT_STATIC_CHECK(__VA_ARGS__), \
+     c_print_checked_array("" pattern "", CPRINT_ARGS(__VA_ARGS__), CPRINT_ARGS_COUNT(__VA_ARGS__)))
+#else
 // Macro principal - aplica CPRINT_ARG a cada argumento
 #define C_PRINT(pattern, ...) \
-    c_print_checked_wrapper(pattern, C_PRINT_NARG(__VA_ARGS__), \
-                           C_PRINT_EXPAND(C_PRINT_APPLY_ARG(C_PRINT_NARG(__VA_ARGS__))(__VA_ARGS__)))
+    (C_PRINT_STATIC_CHECK(__VA_ARGS__), \
+     c_print_checked_array(pattern, CPRINT_ARGS(__VA_ARGS__), CPRINT_ARGS_COUNT(__VA_ARGS__)))
+#endif
 
-// Wrapper que recibe CPrintArg[]
+/**
+ * @brief Imprime validando cada argumento contra el patrón
+ *
+ * Los argumentos se leen por puntero a medida que el patrón los pide,
+ * sin copia ni límite en su número.
+ */
+void c_print_checked_array(const char* pattern, const CPrintArg* args, size_t count);
+
+// Variante variádica (argc valores CPrintArg, leídos uno a uno del va_list)
 void c_print_checked_wrapper(const char* pattern, int argc, ...);
 
 // ============================================================================
@@ -283,8 +303,8 @@ void c_print_checked_wrapper(const char* pattern, int argc, ...);
      */
     #define C_PRINT_VALIDATE(pattern, ...) \
         do { \
-            if (!c_print_validate_pattern(pattern, C_PRINT_NARG(__VA_ARGS__), \
-                                         C_PRINT_EXPAND(C_PRINT_APPLY_ARG(C_PRINT_NARG(__VA_ARGS__))(__VA_ARGS__)))) { \
+            if (!c_print_validate_pattern_array(pattern, CPRINT_ARGS(__VA_ARGS__), \
+                                               CPRINT_ARGS_COUNT(__VA_ARGS__))) { \
                 fprintf(stderr, "[C_PRINT ERROR] Type mismatch in: %s\n", pattern); \
                 abort(); \
             } \
@@ -298,6 +318,8 @@ void c_print_checked_wrapper(const char* pattern, int argc, ...);
  */
 bool c_print_validate_pattern(const char* pattern, int argc, ...);
 
+bool c_print_validate_pattern_array(const char* pattern, const CPrintArg* args, size_t count);
+
 // ============================================================================
 // INFORMACIÓN DE TIPOS (para debugging)
 // ============================================================================
@@ -306,11 +328,12 @@ bool c_print_validate_pattern(const char* pattern, int argc, ...);
  * @brief Imprime información sobre los tipos de los argumentos
  */
 #define C_PRINT_DEBUG_TYPES(pattern, ...) \
-    c_print_debug_types_impl(pattern, C_PRINT_NARG(__VA_ARGS__), \
-                            C_PRINT_EXPAND(C_PRINT_APPLY_ARG(C_PRINT_NARG(__VA_ARGS__))(__VA_ARGS__)))
+    c_print_debug_types_array(pattern, CPRINT_ARGS(__VA_ARGS__), CPRINT_ARGS_COUNT(__VA_ARGS__))
 
 void c_print_debug_types_impl(const char* pattern, int argc, ...);
 
+void c_print_debug_types_array(const char* pattern, const CPrintArg* args, size_t count);
+
 #ifdef __cplusplus
 }
 #endif
@@ -362,6 +385,147 @@ if (!c_print_validate_pattern("{s} {d}", 2,
 }
 */
 
+#elif defined(__cplusplus) && __cplusplus >= 202002L
+
+// ============================================================================
+// C++20: VALIDACIÓN COMPLETA DEL PATRÓN EN COMPILE-TIME (consteval)
+// ============================================================================
+
+#include <cstddef>
+#include <type_traits>
+
+namespace cprint_detail {
+
+enum class ArgKind { String, Int, UInt, Long, ULong, Double, Char, Bool, Ptr, Unknown };
+
+template <typename T>
+consteval ArgKind arg_kind() {
+    using U = std::remove_cv_t<T>;
+    if constexpr (std::is_same_v<U, bool>) return ArgKind::Bool;
+    else if constexpr (std::is_same_v<U, char> || std::is_same_v<U, signed char> ||
+                       std::is_same_v<U, unsigned char>) return ArgKind::Char;
+    else if constexpr (std::is_same_v<U, int>) return ArgKind::Int;
+    else if constexpr (std::is_same_v<U, unsigned int>) return ArgKind::UInt;
+    else if constexpr (std::is_same_v<U, long> || std::is_same_v<U, long long>) return ArgKind::Long;
+    else if constexpr (std::is_same_v<U, unsigned long> ||
+                       std::is_same_v<U, unsigned long long>) return ArgKind::ULong;
+    else if constexpr (std::is_same_v<U, float> || std::is_same_v<U, double>) return ArgKind::Double;
+    else if constexpr (std::is_pointer_v<U> &&
+                       std::is_same_v<std::remove_cv_t<std::remove_pointer_t<U>>, char>) return ArgKind::String;
+    else if constexpr (std::is_pointer_v<U>) return ArgKind::Ptr;
+    else return ArgKind::Unknown;
+}
+
+// Mismas reglas que cprint_validate_arg_type()
+consteval bool accepts(char format_type, ArgKind kind) {
+    switch (format_type) {
+        case 's': return kind == ArgKind::String;
+        case 'd':
+        case 'i': return kind == ArgKind::Int;
+        case 'f': return kind == ArgKind::Double;
+        case 'c': return kind == ArgKind::Char;
+        case 'b':
+        case 'x':
+        case 'o':
+        case 'u': return kind == ArgKind::UInt || kind == ArgKind::Int;
+        case 'l': return kind == ArgKind::Long;
+        default: return false;
+    }
+}
+
+consteval bool is_known_format(char format_type) {
+    switch (format_type) {
+        case 's': case 'd': case 'i': case 'f': case 'c':
+        case 'b': case 'x': case 'o': case 'u': case 'l':
+            return true;
+        default:
+            return false;
+    }
+}
+
+// No son constexpr: llamarlas en consteval produce el error de compilación
+void C_PRINT_argument_type_does_not_match_pattern();
+void C_PRINT_missing_argument_for_pattern_field();
+void C_PRINT_too_many_arguments_for_pattern();
+
+/**
+ * @brief Patrón validado contra los tipos Args al construirse
+ *
+ * Recorre el patrón con las mismas reglas que c_print() (escape \{,
+ * llaves sin cierre o vacías como literal, primer token como tipo).
+ */
+template <typename... Args>
+struct CheckedPattern {
+    const char* text;
+
+    consteval CheckedPattern(const char* pattern) : text(pattern) {
+        constexpr ArgKind kinds[sizeof...(Args) + 1] = {arg_kind<Args>()..., ArgKind::Unknown};
+        std::size_t arg = 0;
+        std::size_t p = 0;
+
+        while (pattern[p]) {
+            if (pattern[p] == '\\' && pattern[p + 1] == '{') {
+                p += 2;
+                continue;
+            }
+            if (pattern[p] != '{') {
+                p++;
+                continue;
+            }
+
+            std::size_t end = p + 1;
+            while (pattern[end] && pattern[end] != '}') end++;
+            std::size_t len = end - p - 1;
+            if (!pattern[end] || len == 0 || len >= 200) {
+                p++;
+                continue;
+            }
+
+            std::size_t i = p + 1;
+            while (i < end && pattern[i] == ':') i++;
+            while (i < end && pattern[i] == ' ') i++;
+            char format_type = (i < end && pattern[i] != ':') ? pattern[i] : '\0';
+            if (format_type == '\0') {
+                p++;
+                continue;
+            }
+
+            if (is_known_format(format_type)) {
+                if (arg >= sizeof...(Args)) C_PRINT_missing_argument_for_pattern_field();
+                if (!accepts(format_type, kinds[arg])) C_PRINT_argument_type_does_not_match_pattern();
+                arg++;
+            }
+            p = end + 1;
+        }
+
+        if (arg != sizeof...(Args)) C_PRINT_too_many_arguments_for_pattern();
+    }
+};
+
+// Conversión a los tipos que c_print() lee con va_arg
+template <typename T>
+inline T pass(T value) { return value; }
+inline long pass(long long value) { return static_cast<long>(value); }
+inline unsigned long pass(unsigned long long value) { return static_cast<unsigned long>(value); }
+inline int pass(bool value) { return value ? 1 : 0; }
+
+} // namespace cprint_detail
+
+/**
+ * @brief c_print con el patrón validado en compile-time
+ *
+ * Tras la validación se llama directamente a c_print(), sin ninguna
+ * comprobación en runtime.
+ */
+template <typename... Args>
+inline void c_print_validated(
+        cprint_detail::CheckedPattern<std::type_identity_t<Args>...> pattern, Args... args) {
+    c_print(pattern.text, cprint_detail::pass(args)...);
+}
+
+#define C_PRINT(pattern, ...) c_print_validated(pattern __VA_OPT__(,) __VA_ARGS__)
+#define C_PRINT_DEBUG_TYPES(pattern, ...) ((void)0)
+
 #else
     // C99 fallback: sin _Generic
     #warning "C11 _Generic not available. C_PRINT will fallback to c_print without type checking."
@@ -0,0 +1,174 @@
+/**
+ * @file c_print_latency.h
+ * @brief Latencia por etapa con histogramas log-lineales
+ *
+ * Con la opción de CMake C_PRINT_LATENCY=ON, c_print() y CPrintBuilder
+ * miden cuánto tarda cada etapa (parseo del patrón, formateo numérico,
+ * alineación y escritura) con el contador de ciclos (rdtsc en x86) o
+ * clock_gettime. Cada hilo acumula sus muestras en histogramas
+ * log-lineales estilo HDR (16 sub-buckets por potencia de dos, error
+ * relativo < 6.25%) y c_print_latency() los combina bajo demanda.
+ *
+ * En c_print() cada llamada aporta una muestra por etapa usada (el tiempo
+ * total de esa etapa en la llamada); en el builder cada valor agregado
+ * aporta su formateo y su alineación, y cada cp_print/cp_write/cp_flush
+ * su escritura.
+ *
+ * Sin la opción no se toma ninguna marca de tiempo y las consultas
+ * devuelven false.
+ *
+ * Uso:
+ *   c_print_latency_dump(stderr);
+ *
+ *   CPrintLatency lat;
+ *   if (c_print_latency(CPRINT_STAGE_WRITE, &lat) && lat.p99_ns > 5000) { ... }
+ */
+
+#ifndef C_PRINT_LATENCY_H
+#define C_PRINT_LATENCY_H
+
+#include <stdio.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Etapas medidas
+ */
+typedef enum {
+    CPRINT_STAGE_PARSE = 0,         // Patrón compilado (caché o compilación)
+    CPRINT_STAGE_FORMAT,            // Formateo del valor (números, strings)
+    CPRINT_STAGE_ALIGN,             // Alineación con relleno
+    CPRINT_STAGE_WRITE,             // Escritura de literales, escapes y valores
+    CPRINT_STAGE_COUNT
+} CPrintStage;
+
+/**
+ * @brief Resumen de una etapa (todos los hilos, desde el último reset)
+ *
+ * Los percentiles son el límite superior del bucket que los contiene.
+ */
+typedef struct {
+    unsigned long long count;
+    double p50_ns;
+    double p99_ns;
+    double p999_ns;
+    double max_ns;
+} CPrintLatency;
+
+/**
+ * @brief Combina los histogramas de todos los hilos para una etapa
+ * @return false si se compiló sin C_PRINT_LATENCY
+ */
+bool c_print_latency(CPrintStage stage, CPrintLatency* out);
+
+/**
+ * @brief Escribe una tabla con count/p50/p99/p999/max de cada etapa
+ */
+void c_print_latency_dump(FILE* fp);
+
+/**
+ * @brief Descarta las muestras acumuladas hasta ahora
+ */
+void c_print_latency_reset(void);
+
+/**
+ * @brief Nombre de una etapa ("parse", "format", "align", "write")
+ */
+const char* c_print_latency_stage_name(CPrintStage stage);
+
+// ============================================================================
+// USO INTERNO (puntos de medida de la biblioteca)
+// ============================================================================
+
+#ifdef C_PRINT_LATENCY
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+    #ifdef _MSC_VER
+        #include <intrin.h>
+    #else
+        #include <x86intrin.h>
+    #endif
+    #define CP_LATENCY_TSC 1
+#else
+    #include <time.h>
+#endif
+
+/**
+ * @brief Marca de tiempo en ticks (ciclos con rdtsc, ns con clock_gettime)
+ */
+static inline unsigned long long cp_latency_now(void) {
+#ifdef CP_LATENCY_TSC
+    return __rdtsc();
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (unsigned long long)ts.tv_sec * 1000000000ull + (unsigned long long)ts.tv_nsec;
+#endif
+}
+
+/**
+ * @brief Agrega una muestra (en ticks) al histograma del hilo actual
+ */
+void cp_latency_record(CPrintStage stage, unsigned long long ticks);
+
+/**
+ * @brief Acumulador de etapas de una llamada: se cobra el tiempo al
+ *        cambiar de etapa y al terminar se registra una muestra por etapa
+ */
+typedef struct {
+    unsigned long long last;
+    unsigned long long ticks[CPRINT_STAGE_COUNT];
+    unsigned entered;               // Bit por etapa usada
+    int current;                    // -1 = ninguna
+} CPLatencyScope;
+
+static inline void cp_latency_enter(CPLatencyScope* scope, CPrintStage stage) {
+    if (scope->current == (int)stage) return;
+
+    unsigned long long now = cp_latency_now();
+    if (scope->current >= 0) scope->ticks[scope->current] += now - scope->last;
+    scope->last = now;
+    scope->current = (int)stage;
+    scope->entered |= 1u << stage;
+}
+
+static inline void cp_latency_end(CPLatencyScope* scope) {
+    if (scope->current >= 0) scope->ticks[scope->current] += cp_latency_now() - scope->last;
+
+    for (int s = 0; s < CPRINT_STAGE_COUNT; s++) {
+        if (scope->entered & (1u << s)) cp_latency_record((CPrintStage)s, scope->ticks[s]);
+    }
+}
+
+#define CP_LAT_SCOPE(scope) \
+    CPLatencyScope scope = { 0, { 0 }, 0, -1 }
+#define CP_LAT_ENTER(scope, stage) cp_latency_enter(&(scope), (stage))
+#define CP_LAT_END(scope) cp_latency_end(&(scope))
+
+/**
+ * @brief Ejecuta las sentencias y registra su duración en una etapa
+ */
+#define CP_LAT_TIME(stage, ...) do { \
+    unsigned long long cp_lat_start_ = cp_latency_now(); \
+    __VA_ARGS__; \
+    cp_latency_record((stage), cp_latency_now() - cp_lat_start_); \
+} while (0)
+
+#else
+
+#define CP_LAT_SCOPE(scope) ((void)0)
+#define CP_LAT_ENTER(scope, stage) ((void)0)
+#define CP_LAT_END(scope) ((void)0)
+#define CP_LAT_TIME(stage, ...) do { __VA_ARGS__; } while (0)
+
+#endif // C_PRINT_LATENCY
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // C_PRINT_LATENCY_H
@@ -0,0 +1,44 @@
+/**
+ * @file c_print_macros.h
+ * @brief Utilidades del preprocesador compartidas por las APIs tipadas
+ *
+ * CP_PP_MAP_LIST(f, a, b, c) se expande a f(a), f(b), f(c) sin límite
+ * práctico de argumentos (hasta ~365 por las pasadas de CP_PP_EVAL).
+ */
+
+#ifndef C_PRINT_MACROS_H
+#define C_PRINT_MACROS_H
+
+// Fuerza múltiples pasadas de re-escaneo (3^5 niveles)
+#define CP_PP_EVAL0(...) __VA_ARGS__
+#define CP_PP_EVAL1(...) CP_PP_EVAL0(CP_PP_EVAL0(CP_PP_EVAL0(__VA_ARGS__)))
+#define CP_PP_EVAL2(...) CP_PP_EVAL1(CP_PP_EVAL1(CP_PP_EVAL1(__VA_ARGS__)))
+#define CP_PP_EVAL3(...) CP_PP_EVAL2(CP_PP_EVAL2(CP_PP_EVAL2(__VA_ARGS__)))
+#define CP_PP_EVAL4(...) CP_PP_EVAL3(CP_PP_EVAL3(CP_PP_EVAL3(__VA_ARGS__)))
+#define CP_PP_EVAL(...)  CP_PP_EVAL4(CP_PP_EVAL4(CP_PP_EVAL4(__VA_ARGS__)))
+
+// Detección del marcador de fin ()()()
+#define CP_PP_MAP_END(...)
+#define CP_PP_MAP_OUT
+#define CP_PP_MAP_COMMA ,
+
+#define CP_PP_MAP_GET_END2() 0, CP_PP_MAP_END
+#define CP_PP_MAP_GET_END1(...) CP_PP_MAP_GET_END2
+#define CP_PP_MAP_GET_END(...) CP_PP_MAP_GET_END1
+#define CP_PP_MAP_NEXT0(test, next, ...) next CP_PP_MAP_OUT
+#define CP_PP_MAP_LIST_NEXT1(test, next) CP_PP_MAP_NEXT0(test, CP_PP_MAP_COMMA next, 0)
+#define CP_PP_MAP_LIST_NEXT(test, next) CP_PP_MAP_LIST_NEXT1(CP_PP_MAP_GET_END test, next)
+
+// Recursión alternando dos macros para evitar el bloqueo de auto-expansión
+#define CP_PP_MAP_LIST0(f, x, peek, ...) \
+    f(x) CP_PP_MAP_LIST_NEXT(peek, CP_PP_MAP_LIST1)(f, peek, __VA_ARGS__)
+#define CP_PP_MAP_LIST1(f, x, peek, ...) \
+    f(x) CP_PP_MAP_LIST_NEXT(peek, CP_PP_MAP_LIST0)(f, peek, __VA_ARGS__)
+
+/**
+ * @brief Aplica f a cada argumento y separa los resultados con comas
+ */
+#define CP_PP_MAP_LIST(f, ...) \
+    CP_PP_EVAL(CP_PP_MAP_LIST1(f, __VA_ARGS__, ()()(), ()()(), ()()(), 0))
+
+#endif // C_PRINT_MACROS_H
@@ -0,0 +1,105 @@
+/**
+ * @file c_print_probes.h
+ * @brief Tracepoints estáticos USDT (uso interno)
+ *
+ * Con la opción de CMake C_PRINT_USDT=ON la biblioteca marca unos pocos
+ * puntos con probes USDT del proveedor "c_print", visibles para
+ * bpftrace, perf y SystemTap:
+ *
+ *   format_start(pattern)          Inicio del renderizado de un patrón
+ *   format_end(pattern, bytes)     Fin del renderizado y bytes producidos
+ *   sink_write(bytes)              Escritura en un CPrintSink
+ *   queue_full(bytes)              Línea que no cabe en c_print_queue
+ *   queue_drop(bytes)              Línea descartada por c_print_queue
+ *
+ * Cada probe es un nop más una nota ELF en la sección .note.stapsdt: sin
+ * un tracer enganchado no cuesta más que preparar sus argumentos. Se usa
+ * <sys/sdt.h> si está disponible; si no, una implementación mínima de
+ * las mismas notas para GCC/Clang en x86-64 y AArch64.
+ *
+ * Sin la opción los probes se expanden a nada.
+ *
+ * Ejemplo:
+ *   bpftrace -e 'usdt:./app:c_print:format_end { @bytes = hist(arg1); }'
+ */
+
+#ifndef C_PRINT_PROBES_H
+#define C_PRINT_PROBES_H
+
+#include <stdint.h>
+
+#if defined(C_PRINT_USDT) && defined(__has_include)
+    #if __has_include(<sys/sdt.h>)
+        #include <sys/sdt.h>
+        #define CP_USDT_SYS_SDT 1
+    #endif
+#endif
+
+#if defined(C_PRINT_USDT) && !defined(CP_USDT_SYS_SDT) && \
+    (defined(__GNUC__) || defined(__clang__)) && defined(__ELF__) && \
+    (defined(__x86_64__) || defined(__aarch64__))
+    #define CP_USDT_BUILTIN 1
+#endif
+
+#if defined(CP_USDT_SYS_SDT)
+
+#define CP_PROBE1(name, a1) DTRACE_PROBE1(c_print, name, a1)
+#define CP_PROBE2(name, a1, a2) DTRACE_PROBE2(c_print, name, a1, a2)
+
+#elif defined(CP_USDT_BUILTIN)
+
+/**
+ * @brief Nota stapsdt (versión 3): pc del nop, base, semáforo (ninguno),
+ *        proveedor, nombre y argumentos "8@<operando>"
+ */
+#define CP_USDT_NOTE(name, args) \
+    "990: nop\n" \
+    ".pushsection .note.stapsdt,\"?\",\"note\"\n" \
+    ".balign 4\n" \
+    ".4byte 992f-991f, 994f-993f, 3\n" \
+    "991: .asciz \"stapsdt\"\n" \
+    "992: .balign 4\n" \
+    "993: .8byte 990b\n" \
+    ".8byte _.stapsdt.base\n" \
+    ".8byte 0\n" \
+    ".asciz \"c_print\"\n" \
+    ".asciz \"" #name "\"\n" \
+    ".asciz \"" args "\"\n" \
+    "994: .balign 4\n" \
+    ".popsection\n" \
+    ".ifndef _.stapsdt.base\n" \
+    ".pushsection .stapsdt.base,\"aG\",\"progbits\",.stapsdt.base,comdat\n" \
+    ".weak _.stapsdt.base\n" \
+    ".hidden _.stapsdt.base\n" \
+    "_.stapsdt.base: .space 1\n" \
+    ".size _.stapsdt.base, 1\n" \
+    ".popsection\n" \
+    ".endif\n"
+
+// Los argumentos se pasan como enteros de 64 bits sin signo
+#define CP_PROBE1(name, a1) \
+    __asm__ __volatile__(CP_USDT_NOTE(name, "8@%[arg1]") \
+                         :: [arg1] "nor" ((uint64_t)(uintptr_t)(a1)))
+#define CP_PROBE2(name, a1, a2) \
+    __asm__ __volatile__(CP_USDT_NOTE(name, "8@%[arg1] 8@%[arg2]") \
+                         :: [arg1] "nor" ((uint64_t)(uintptr_t)(a1)), \
+                            [arg2] "nor" ((uint64_t)(uintptr_t)(a2)))
+
+#else
+
+#define CP_PROBE1(name, a1) ((void)0)
+#define CP_PROBE2(name, a1, a2) ((void)0)
+
+#endif
+
+// ============================================================================
+// PROBES DE LA BIBLIOTECA
+// ============================================================================
+
+#define CP_PROBE_FORMAT_START(pattern) CP_PROBE1(format_start, (pattern))
+#define CP_PROBE_FORMAT_END(pattern, bytes) CP_PROBE2(format_end, (pattern), (bytes))
+#define CP_PROBE_SINK_WRITE(bytes) CP_PROBE1(sink_write, (bytes))
+#define CP_PROBE_QUEUE_FULL(bytes) CP_PROBE1(queue_full, (bytes))
+#define CP_PROBE_QUEUE_DROP(bytes) CP_PROBE1(queue_drop, (bytes))
+
+#endif // C_PRINT_PROBES_H
@@ -0,0 +1,168 @@
+/**
+ * @file c_print_queue.h
+ * @brief Salida no bloqueante con buffer de desborde acotado
+ *
+ * Con la opción de CMake C_PRINT_QUEUE=ON, c_print_queue_create() pone
+ * un descriptor en modo no bloqueante y le agrega un buffer en memoria
+ * de tamaño fijo. Cada línea se intenta escribir enseguida; lo que el
+ * lector no acepta queda en el buffer y sale en las escrituras
+ * siguientes o con c_print_queue_flush(). Un lector detenido ya no
+ * bloquea a los hilos que imprimen.
+ *
+ * Cuando una línea no cabe en el buffer se aplica la política:
+ *
+ *   CPRINT_QUEUE_BLOCK        esperar a que haya lugar, como mucho
+ *                             block_timeout_ms; después se descarta
+ *   CPRINT_QUEUE_DROP_NEWEST  descartar la línea nueva
+ *   CPRINT_QUEUE_DROP_OLDEST  descartar las líneas más viejas que aún
+ *                             no empezaron a escribirse
+ *
+ * Siempre se descartan líneas enteras: una línea que empezó a salir se
+ * termina, así la salida nunca queda cortada. Una línea más grande que
+ * el buffer se descarta con cualquier política. Las líneas y bytes
+ * descartados se cuentan y, cada report_interval_ms, se agrega a la
+ * salida una línea de resumen:
+ *
+ *   c_print: dropped 120 lines (5400 bytes)
+ *
+ * c_print_queue_attach() manda a la cola las líneas que c_print(),
+ * c_print_safe(), C_PRINT y c_print_typed() escribirían en stdout. Las
+ * demás escrituras a stdout (c_print_styled, printf) siguen por stdio:
+ * con el descriptor en modo no bloqueante pueden fallar con EAGAIN.
+ *
+ * Sin la opción (o en Windows) c_print_queue_create() devuelve NULL.
+ *
+ * Uso:
+ *   CPrintQueueConfig config = { 64 * 1024, CPRINT_QUEUE_DROP_OLDEST, 0, 1000 };
+ *   CPrintQueue* q = c_print_queue_create(STDOUT_FILENO, &config);
+ *   c_print_queue_attach(q);
+ *   ...
+ *   c_print_queue_attach(NULL);
+ *   c_print_queue_destroy(q);
+ */
+
+#ifndef C_PRINT_QUEUE_H
+#define C_PRINT_QUEUE_H
+
+#include <stdio.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "c_print_sink.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Tamaño por defecto del buffer de desborde
+#define CPRINT_QUEUE_DEFAULT_CAPACITY (64 * 1024)
+
+/**
+ * @brief Qué hacer con una línea que no cabe en el buffer
+ */
+typedef enum {
+    CPRINT_QUEUE_BLOCK = 0,
+    CPRINT_QUEUE_DROP_NEWEST,
+    CPRINT_QUEUE_DROP_OLDEST
+} CPrintQueuePolicy;
+
+/**
+ * @brief Configuración de una cola
+ */
+typedef struct {
+    size_t capacity;                // Bytes del buffer (0 = CPRINT_QUEUE_DEFAULT_CAPACITY)
+    CPrintQueuePolicy policy;
+    unsigned block_timeout_ms;      // Espera máxima con CPRINT_QUEUE_BLOCK (0 = sin límite)
+    unsigned report_interval_ms;    // Periodo del resumen de descartes (0 = sin resumen)
+} CPrintQueueConfig;
+
+/**
+ * @brief Contadores de una cola
+ */
+typedef struct {
+    unsigned long long written_bytes;   // Bytes aceptados por el descriptor
+    unsigned long long dropped_lines;
+    unsigned long long dropped_bytes;
+    unsigned long long reports;         // Líneas de resumen agregadas
+    size_t pending_bytes;               // Bytes esperando en el buffer
+} CPrintQueueStats;
+
+typedef struct CPrintQueue CPrintQueue;
+
+/**
+ * @brief Crea una cola sobre un descriptor y lo pone en modo no bloqueante
+ * @param config NULL para los valores por defecto (BLOCK sin límite)
+ * @return NULL si la biblioteca se compiló sin C_PRINT_QUEUE o sin memoria
+ */
+CPrintQueue* c_print_queue_create(int fd, const CPrintQueueConfig* config);
+
+/**
+ * @brief Intenta vaciar la cola, devuelve el modo del descriptor y la libera
+ *
+ * Espera como mucho block_timeout_ms (o nada si la política descarta).
+ * La cola no debe estar enganchada ni en uso por otro hilo.
+ */
+void c_print_queue_destroy(CPrintQueue* q);
+
+/**
+ * @brief Escribe una línea (se descarta o se encola entera)
+ * @return true si la línea salió o quedó en el buffer
+ */
+bool c_print_queue_write(CPrintQueue* q, const char* data, size_t len);
+
+/**
+ * @brief Escribe lo pendiente, agregando antes el resumen de descartes
+ * @param timeout_ms Espera máxima (0 = solo lo que se pueda sin esperar)
+ * @return true si la cola quedó vacía
+ */
+bool c_print_queue_flush(CPrintQueue* q, unsigned timeout_ms);
+
+/**
+ * @brief Contadores desde la creación de la cola
+ */
+CPrintQueueStats c_print_queue_stats(CPrintQueue* q);
+
+/**
+ * @brief Sink que escribe en la cola (cada escritura es una línea)
+ */
+CPrintSink cp_sink_queue(CPrintQueue* q);
+
+/**
+ * @brief Manda a la cola las líneas de stdout de c_print
+ * @param q NULL para volver a stdout
+ *
+ * Tiene prioridad sobre el modo por lotes (c_print_batch).
+ */
+void c_print_queue_attach(CPrintQueue* q);
+
+// ============================================================================
+// USO INTERNO (caminos de impresión de la biblioteca)
+// ============================================================================
+
+/**
+ * @brief Empieza una línea para la cola enganchada
+ * @return false si no hay cola (escribir directo)
+ */
+bool cp_queue_begin_line(void);
+
+/**
+ * @brief Guarda parte de la línea en curso (volcados a mitad de línea)
+ */
+void cp_queue_write_part(const char* data, size_t len);
+
+/**
+ * @brief Termina la línea con su último tramo y la entrega a la cola
+ */
+void cp_queue_end_line(const char* data, size_t len);
+
+#if defined(C_PRINT_QUEUE) && !defined(_WIN32)
+    #define CP_QUEUE_ENABLED 1
+    #define CP_QUEUE_BEGIN_LINE(fp) ((fp) == stdout && cp_queue_begin_line())
+#else
+    #define CP_QUEUE_BEGIN_LINE(fp) false
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // C_PRINT_QUEUE_H
@@ -0,0 +1,53 @@
+/**
+ * @file c_print_safe.h
+ * @brief c_print con validaciones en runtime (modo seguro)
+ *
+ * c_print_safe() acepta los mismos patrones que c_print() y además
+ * detecta punteros de string sospechosos (un int pasado en lugar de un
+ * string) y caracteres fuera de rango. El análisis del patrón se hace
+ * una sola vez gracias a la caché de patrones compilados.
+ *
+ * El modo seguro puede desactivarse en runtime con
+ * c_print_safe_set_enabled(false) o con la variable de entorno
+ * C_PRINT_SAFE=0; entonces c_print_safe() usa el camino rápido sin
+ * comprobaciones.
+ */
+
+#ifndef C_PRINT_SAFE_H
+#define C_PRINT_SAFE_H
+
+#include "c_print.h"
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Versión de c_print con validaciones en runtime
+ */
+void c_print_safe(const char* pattern, ...);
+
+/**
+ * @brief Activa o desactiva las validaciones de c_print_safe()
+ *
+ * Tiene prioridad sobre la variable de entorno C_PRINT_SAFE. Debe
+ * configurarse al inicio del programa, antes de que otros hilos usen
+ * la biblioteca.
+ */
+void c_print_safe_set_enabled(bool enabled);
+
+/**
+ * @brief Indica si c_print_safe() valida los argumentos
+ *
+ * Si no se configuró con c_print_safe_set_enabled(), se lee una vez
+ * C_PRINT_SAFE ("0", "off", "fast" o "false" desactivan; por defecto
+ * activado).
+ */
+bool c_print_safe_enabled(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // C_PRINT_SAFE_H
@@ -0,0 +1,98 @@
+/**
+ * @file c_print_sampling.h
+ * @brief Validación muestreada para producción
+ *
+ * Con una tasa N > 1, c_print_safe() y C_PRINT (c_print_checked_array)
+ * validan la primera llamada de cada patrón y luego 1 de cada N. En
+ * c_print_safe() el resto toma el camino rápido de c_print() sin
+ * comprobaciones. En C_PRINT el muestreo solo decide qué se informa: la
+ * etiqueta de tipo de cada argumento se sigue comprobando en todas las
+ * llamadas (sin ella un int podría leerse como puntero), y un desajuste en
+ * una llamada no muestreada se imprime en la salida pero no se cuenta. En
+ * modo muestreado (N >= 1) los desajustes se cuentan y se entregan a un
+ * callback en lugar de escribirse en stderr.
+ *
+ * Uso:
+ *   c_print_set_sample_rate(100);
+ *   c_print_set_mismatch_handler(on_mismatch, NULL);
+ *   ...
+ *   if (c_print_mismatch_count() > 0) { ... }
+ */
+
+#ifndef C_PRINT_SAMPLING_H
+#define C_PRINT_SAMPLING_H
+
+#include <stddef.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Callback para un desajuste detectado en una llamada validada
+ * @param ctx Contexto registrado con el callback
+ * @param pattern Patrón de la llamada
+ * @param arg_index Argumento afectado (SIZE_MAX si es el conteo)
+ * @param message Descripción, p. ej. "{? expected string, got int}"
+ */
+typedef void (*CPrintMismatchHandler)(void* ctx, const char* pattern,
+                                      size_t arg_index, const char* message);
+
+/**
+ * @brief Configura la tasa de muestreo de la validación
+ * @param rate 0 = validar siempre e informar por stderr (por defecto);
+ *             1 = validar siempre e informar por contador/callback;
+ *             N = validar la primera llamada de cada patrón y 1 de cada N
+ *
+ * Debe configurarse al inicio del programa, antes de que otros hilos
+ * usen la biblioteca.
+ */
+void c_print_set_sample_rate(unsigned rate);
+
+/**
+ * @brief Tasa de muestreo actual
+ */
+unsigned c_print_get_sample_rate(void);
+
+/**
+ * @brief Registra el callback de desajustes (NULL para quitarlo)
+ */
+void c_print_set_mismatch_handler(CPrintMismatchHandler handler, void* ctx);
+
+/**
+ * @brief Desajustes detectados desde el inicio (o el último reset), en todos los hilos
+ */
+unsigned long c_print_mismatch_count(void);
+
+/**
+ * @brief Pone a cero el contador de desajustes
+ */
+void c_print_reset_mismatch_count(void);
+
+// ============================================================================
+// USO INTERNO (validadores de la biblioteca)
+// ============================================================================
+
+/**
+ * @brief Indica si la llamada actual con este patrón debe validarse
+ *
+ * Los contadores son por hilo e indexados por la dirección del patrón.
+ */
+bool cp_sample_should_validate(const char* pattern);
+
+/**
+ * @brief Indica si los desajustes van al contador/callback (modo muestreado)
+ */
+bool cp_sample_reporting(void);
+
+/**
+ * @brief Cuenta un desajuste y lo entrega al callback registrado
+ */
+void cp_report_mismatch(const char* pattern, size_t arg_index, const char* message);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // C_PRINT_SAMPLING_H
@@ -0,0 +1,64 @@
+/**
+ * @file c_print_signal.h
+ * @brief Impresión segura desde manejadores de señales
+ *
+ * c_print() no se puede usar en un manejador de señales ni en un
+ * manejador de crash: stdio toma locks, snprintf puede reservar memoria
+ * y consulta el locale, y la caché de patrones reserva en el primer uso.
+ * Si la señal llega mientras el hilo tiene uno de esos locks, el
+ * proceso se bloquea.
+ *
+ * c_print_signal_safe() acepta los mismos patrones y usa solo:
+ *   - buffers en la pila (menos de 3 KB en total)
+ *   - el renderizado de c_vprint_to() (c_print_freestanding.h): parser de
+ *     patrones y formateadores propios, sin stdio ni locale
+ *   - las secuencias ANSI de format_ansi_codes(), armadas desde los
+ *     códigos fijos de los enums sin pasar por stdio
+ *   - write(2), reintentando EINTR y escrituras parciales
+ *
+ * No toma locks, no reserva memoria, no lee el locale y deja errno como
+ * estaba. El patrón se parsea en cada llamada (sin caché) y no se
+ * cuentan estadísticas. Los floats siempre usan '.' como punto decimal
+ * y los valores que no son strings se recortan a 511 bytes; el resto del
+ * texto es el mismo que el de c_print(). Una línea de más
+ * de CPRINT_SIGNAL_BUFFER bytes sale en varias write, así que puede
+ * intercalarse con escrituras de otros hilos.
+ *
+ * Uso:
+ *   static void on_crash(int sig) {
+ *       c_print_signal_safe(STDERR_FILENO, "{s:red:bold} signal {d}\n", "fatal:", sig);
+ *       _exit(1);
+ *   }
+ */
+
+#ifndef C_PRINT_SIGNAL_H
+#define C_PRINT_SIGNAL_H
+
+#include <stdarg.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Bytes de la línea que se acumulan antes de cada write
+#define CPRINT_SIGNAL_BUFFER 512
+
+/**
+ * @brief Imprime un patrón en un descriptor de forma async-signal-safe
+ * @param fd Descriptor de destino (normalmente STDERR_FILENO)
+ * @param pattern Patrón con la sintaxis de c_print()
+ * @return Bytes aceptados por el descriptor
+ */
+size_t c_print_signal_safe(int fd, const char* pattern, ...);
+
+/**
+ * @brief Versión de c_print_signal_safe() con va_list
+ */
+size_t c_vprint_signal_safe(int fd, const char* pattern, va_list args);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // C_PRINT_SIGNAL_H
@@ -0,0 +1,60 @@
+/**
+ * @file c_print_sink.h
+ * @brief Destinos de salida (sinks) para contenido ya formateado
+ *
+ * Un sink recibe bloques de bytes con longitud conocida, de modo que
+ * la salida no necesita terminar en NUL ni volver a escanearse.
+ */
+
+#ifndef C_PRINT_SINK_H
+#define C_PRINT_SINK_H
+
+#include <stddef.h>
+
+#ifndef C_PRINT_FREESTANDING
+#include <stdio.h>
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Destino de escritura genérico
+ *
+ * write() debe escribir len bytes y devolver cuántos escribió
+ * (menos de len indica error).
+ */
+typedef struct CPrintSink {
+    size_t (*write)(void* ctx, const char* data, size_t len);
+    void* ctx;
+} CPrintSink;
+
+// En la compilación freestanding solo existe el tipo: el sink lo pone el usuario
+#ifndef C_PRINT_FREESTANDING
+
+/**
+ * @brief Sink que escribe en un FILE* con fwrite()
+ */
+CPrintSink cp_sink_file(FILE* fp);
+
+/**
+ * @brief Sink que escribe en un descriptor con write(2)
+ *
+ * Reintenta escrituras parciales e interrupciones (EINTR).
+ */
+CPrintSink cp_sink_fd(int fd);
+
+/**
+ * @brief Escribe un bloque en un sink
+ * @return Bytes escritos
+ */
+size_t cp_sink_write(const CPrintSink* sink, const char* data, size_t len);
+
+#endif // !C_PRINT_FREESTANDING
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // C_PRINT_SINK_H
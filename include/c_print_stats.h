@@ -0,0 +1,122 @@
+/**
+ * @file c_print_stats.h
+ * @brief Estadísticas de uso en tiempo de ejecución
+ *
+ * Con la opción de CMake C_PRINT_STATS=ON la biblioteca cuenta llamadas
+ * por API, bytes escritos, bytes de secuencias ANSI, aciertos y fallos
+ * de la caché de patrones compilados, reservas del CPrintBuilder y líneas
+ * descartadas por las colas de c_print_queue.h. Cada
+ * hilo incrementa sus propios contadores (sin operaciones atómicas de
+ * lectura-modificación-escritura) y c_print_stats() los suma.
+ *
+ * Sin la opción los contadores no existen: los puntos de conteo se
+ * expanden a nada y c_print_stats() devuelve ceros con enabled = false.
+ *
+ * Uso:
+ *   CPrintStats stats = c_print_stats();
+ *   printf("%llu bytes, %llu cache misses\n", stats.bytes, stats.cache_misses);
+ */
+
+#ifndef C_PRINT_STATS_H
+#define C_PRINT_STATS_H
+
+#include <stddef.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief APIs de impresión con contador de llamadas propio
+ */
+typedef enum {
+    CPRINT_API_PRINT = 0,           // c_print
+    CPRINT_API_STYLED,              // c_print_styled, c_print_color, c_print_bg, ...
+    CPRINT_API_PRINTF_STYLED,       // c_printf_styled
+    CPRINT_API_BUILDER,             // cp_print, cp_println, cp_write, cp_flush
+    CPRINT_API_TYPED,               // c_print_typed, c_print_typed_array
+    CPRINT_API_CHECKED,             // C_PRINT (c_print_checked_*)
+    CPRINT_API_SAFE,                // c_print_safe
+    CPRINT_API_ARGV,                // c_print_argv, c_print_argv_batch
+    CPRINT_API_SNPRINT,             // c_snprint, c_vsnprint, c_snprint_compiled
+    CPRINT_API_FD,                  // c_print_fd, c_vprint_fd
+    CPRINT_API_COUNT
+} CPrintApi;
+
+/**
+ * @brief Instantánea de los contadores (suma de todos los hilos)
+ */
+typedef struct {
+    bool enabled;                               // false si se compiló sin C_PRINT_STATS
+    unsigned long long calls[CPRINT_API_COUNT]; // Llamadas por API
+    unsigned long long bytes;                   // Bytes escritos en la salida (incluye escapes)
+    unsigned long long escape_bytes;            // Bytes de secuencias ANSI generadas
+    unsigned long long cache_hits;              // Patrones encontrados ya compilados
+    unsigned long long cache_misses;            // Patrones compilados
+    unsigned long long builder_allocs;          // Reservas de buffer en CPrintBuilder
+    unsigned long long builder_reallocs;        // Crecimientos de buffer en CPrintBuilder
+    unsigned long long queue_drops;             // Líneas descartadas por CPrintQueue
+    unsigned long long queue_dropped_bytes;     // Bytes de esas líneas
+} CPrintStats;
+
+/**
+ * @brief Suma los contadores de todos los hilos desde el último reset
+ *
+ * Los hilos que siguen escribiendo durante la lectura pueden quedar
+ * contados a medias; cada contador por separado es consistente.
+ */
+CPrintStats c_print_stats(void);
+
+/**
+ * @brief Pone a cero los contadores visibles por c_print_stats()
+ */
+void c_print_stats_reset(void);
+
+/**
+ * @brief Nombre de una API ("c_print", "builder", ...)
+ */
+const char* c_print_stats_api_name(CPrintApi api);
+
+// ============================================================================
+// USO INTERNO (puntos de conteo de la biblioteca)
+// ============================================================================
+
+/**
+ * @brief Contadores internos; las llamadas por API ocupan CP_STAT_CALLS + api
+ */
+enum {
+    CP_STAT_BYTES = 0,
+    CP_STAT_ESCAPE_BYTES,
+    CP_STAT_CACHE_HITS,
+    CP_STAT_CACHE_MISSES,
+    CP_STAT_BUILDER_ALLOCS,
+    CP_STAT_BUILDER_REALLOCS,
+    CP_STAT_QUEUE_DROPS,
+    CP_STAT_QUEUE_DROPPED_BYTES,
+    CP_STAT_CALLS,
+    CP_STAT_SLOTS = CP_STAT_CALLS + CPRINT_API_COUNT
+};
+
+#ifdef C_PRINT_STATS
+
+/**
+ * @brief Suma n al contador slot del hilo actual
+ */
+void cp_stat_add(unsigned slot, unsigned long long n);
+
+#define CP_STAT_ADD(slot, n) cp_stat_add((slot), (unsigned long long)(n))
+#define CP_STAT_CALL(api) cp_stat_add(CP_STAT_CALLS + (api), 1)
+
+#else
+
+#define CP_STAT_ADD(slot, n) ((void)0)
+#define CP_STAT_CALL(api) ((void)0)
+
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // C_PRINT_STATS_H
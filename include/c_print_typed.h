@@ -12,7 +12,10 @@
 #define C_PRINT_TYPED_H
 
 #include "c_print.h"
+#include "c_print_macros.h"
 #include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -64,6 +67,70 @@ typedef struct {
 #define CPRINT_CHAR(x) ((CPrintValue){.type = CPRINT_TYPE_CHAR, .value.c = (x)})
 #define CPRINT_BOOL(x) ((CPrintValue){.type = CPRINT_TYPE_BOOL, .value.b = (x)})
 
+// ============================================================================
+// FUNCIONES HELPER PARA CREAR VALORES (usadas por _Generic)
+// ============================================================================
+
+static inline CPrintValue cprint_value_str(const char* s) {
+    CPrintValue v = {CPRINT_TYPE_STRING, {0}};
+    v.value.s = s;
+    return v;
+}
+
+static inline CPrintValue cprint_value_int(int i) {
+    CPrintValue v = {CPRINT_TYPE_INT, {0}};
+    v.value.i = i;
+    return v;
+}
+
+static inline CPrintValue cprint_value_uint(unsigned int u) {
+    CPrintValue v = {CPRINT_TYPE_UINT, {0}};
+    v.value.u = u;
+    return v;
+}
+
+static inline CPrintValue cprint_value_long(long l) {
+    CPrintValue v = {CPRINT_TYPE_LONG, {0}};
+    v.value.l = l;
+    return v;
+}
+
+static inline CPrintValue cprint_value_ulong(unsigned long ul) {
+    CPrintValue v = {CPRINT_TYPE_ULONG, {0}};
+    v.value.ul = ul;
+    return v;
+}
+
+static inline CPrintValue cprint_value_double(double d) {
+    CPrintValue v = {CPRINT_TYPE_DOUBLE, {0}};
+    v.value.d = d;
+    return v;
+}
+
+static inline CPrintValue cprint_value_char(char c) {
+    CPrintValue v = {CPRINT_TYPE_CHAR, {0}};
+    v.value.c = c;
+    return v;
+}
+
+static inline CPrintValue cprint_value_bool(bool b) {
+    CPrintValue v = {CPRINT_TYPE_BOOL, {0}};
+    v.value.b = b;
+    return v;
+}
+
+static inline CPrintValue cprint_value_ptr(const void* ptr) {
+    CPrintValue v = {CPRINT_TYPE_POINTER, {0}};
+    v.value.ptr = (void*)ptr;
+    return v;
+}
+
+static inline CPrintValue cprint_value_unknown(int x) {
+    CPrintValue v = {CPRINT_TYPE_UNKNOWN, {0}};
+    v.value.i = x;
+    return v;
+}
+
 // ============================================================================
 // _GENERIC: DETECCIÓN AUTOMÁTICA DE TIPOS (C11)
 // ============================================================================
@@ -71,17 +138,23 @@ typedef struct {
 #if __STDC_VERSION__ >= 201112L
 
 #define CPRINT_AUTO(x) _Generic((x), \
-    char*: CPRINT_STR, \
-    const char*: CPRINT_STR, \
-    int: CPRINT_INT, \
-    unsigned int: CPRINT_UINT, \
-    long: CPRINT_LONG, \
-    unsigned long: CPRINT_UINT, \
-    float: CPRINT_FLOAT, \
-    double: CPRINT_FLOAT, \
-    char: CPRINT_CHAR, \
-    bool: CPRINT_BOOL, \
-    default: CPRINT_INT \
+    char*: cprint_value_str, \
+    const char*: cprint_value_str, \
+    int: cprint_value_int, \
+    unsigned int: cprint_value_uint, \
+    long: cprint_value_long, \
+    unsigned long: cprint_value_ulong, \
+    long long: cprint_value_long, \
+    unsigned long long: cprint_value_ulong, \
+    float: cprint_value_double, \
+    double: cprint_value_double, \
+    char: cprint_value_char, \
+    signed char: cprint_value_char, \
+    unsigned char: cprint_value_char, \
+    bool: cprint_value_bool, \
+    void*: cprint_value_ptr, \
+    const void*: cprint_value_ptr, \
+    default: cprint_value_unknown \
 )(x)
 
 #else
@@ -94,8 +167,22 @@ typedef struct {
 // ============================================================================
 
 /**
- * @brief Versión type-safe de c_print (máximo 10 argumentos)
- * 
+ * @brief Versión type-safe de c_print con valores en un array
+ * @param pattern Patrón de formato (se compila una vez y se cachea)
+ * @param values Valores tipados, uno por campo del patrón
+ * @param count Número de valores
+ *
+ * La comprobación de tipos es una consulta a tabla por argumento y no
+ * hay límite en el número de argumentos. Los tipos incorrectos o los
+ * argumentos que faltan se muestran en rojo en lugar del valor.
+ */
+void c_print_typed_array(const char* pattern, const CPrintValue* values, size_t count);
+
+/**
+ * @brief Versión type-safe de c_print con argumentos variádicos
+ *
+ * Lee un CPrintValue por cada campo del patrón.
+ *
  * Uso:
  *   c_print_typed("{s:red} {d:blue}", CPRINT_STR("Hello"), CPRINT_INT(42));
  *   // O con auto-detección (C11):
@@ -105,21 +192,21 @@ void c_print_typed(const char* pattern, ...);
 
 /**
  * @brief Macro conveniente que usa _Generic (C11)
- * 
+ *
+ * Construye un array de CPrintValue como compound literal, sin límite
+ * de argumentos. Requiere al menos un argumento (sin argumentos usar
+ * c_print). No combinar con c_print_generic.h, que define su propio C_PRINT.
+ *
  * Uso:
  *   C_PRINT("{s:red} {d:blue}", "Hello", 42);
  */
 #if __STDC_VERSION__ >= 201112L
+    #define CPRINT_VALUES(...) \
+        ((const CPrintValue[]){ CP_PP_MAP_LIST(CPRINT_AUTO, __VA_ARGS__) })
+
     #define C_PRINT(pattern, ...) \
-        c_print_typed_helper(pattern, ##__VA_ARGS__, (CPrintValue){.type = CPRINT_TYPE_UNKNOWN})
-    
-    // Helper que convierte automáticamente con _Generic
-    #define c_print_typed_helper(pattern, ...) \
-        c_print_typed(pattern, _CPRINT_WRAP_ARGS(__VA_ARGS__))
-    
-    // Macro recursiva para envolver cada argumento
-    #define _CPRINT_WRAP_ARGS(...) \
-        _CPRINT_MAP(CPRINT_AUTO, __VA_ARGS__)
+        c_print_typed_array(pattern, CPRINT_VALUES(__VA_ARGS__), \
+                            sizeof(CPRINT_VALUES(__VA_ARGS__)) / sizeof(CPrintValue))
 #else
     #define C_PRINT(pattern, ...) \
         c_print(pattern, ##__VA_ARGS__)
@@ -137,6 +224,8 @@ bool c_print_validate(const char* pattern, int num_args, CPrintValueType expecte
 
 /**
  * @brief Imprime información de debug sobre los argumentos
+ *
+ * Lee un CPrintValue por cada campo del patrón.
  */
 void c_print_debug_args(const char* pattern, ...);
 
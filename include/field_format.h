@@ -0,0 +1,68 @@
+/**
+ * @file field_format.h
+ * @brief Lectura y formateo del valor de un campo, sin stdio
+ *
+ * Convierte el argumento de un campo {type:specs} en texto según su
+ * PatternStyle. Solo usa los formateadores de number_formatter y
+ * funciones de string.h: no depende de stdio, del locale ni del heap,
+ * así que sirve para el camino de señales y para la compilación
+ * freestanding.
+ */
+
+#ifndef FIELD_FORMAT_H
+#define FIELD_FORMAT_H
+
+#include "pattern_parser.h"
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdarg.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Tamaño del buffer para un valor formateado (igual que c_print)
+#define FORMAT_VALUE_BUFFER 1024
+
+/**
+ * @brief Valor crudo de un campo
+ *
+ * Según el tipo del campo se lee: 's' → s; 'd','i','c','l' → i;
+ * 'b','x','o','u' → u; 'f' → d.
+ */
+typedef union {
+    const char* s;
+    long long i;
+    unsigned long long u;
+    double d;
+} FieldValue;
+
+/**
+ * @brief Indica si el tipo de formato lee el valor como entero sin signo
+ */
+bool is_unsigned_format(char format_type);
+
+/**
+ * @brief Formatea un valor según las especificaciones de un campo
+ * @return Longitud del texto generado
+ *
+ * Mismo texto que format_field_value() salvo en los floats, que usan
+ * format_fixed() (punto decimal siempre '.'). Se puede usar desde un
+ * manejador de señales.
+ */
+size_t format_field_value_plain(char* buffer, size_t size, const PatternStyle* style,
+                                FieldValue value);
+
+/**
+ * @brief Lee de una lista variádica el argumento de un campo
+ *
+ * Usa las mismas promociones que c_print(): 's' → const char*,
+ * 'f' → double, 'l' → long, 'd','i','c' → int, resto → unsigned int.
+ */
+FieldValue read_field_value(char format_type, va_list* args);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // FIELD_FORMAT_H
@@ -0,0 +1,161 @@
+/**
+ * @file format_engine.h
+ * @brief Motor de renderizado de patrones compilados sobre buffers
+ *
+ * Formatea valores según un PatternStyle y ensambla la línea completa
+ * en un OutputBuffer (output_buffer.h), que vuelca a un sink cuando se
+ * llena o trunca (como snprintf) cuando no tiene sink.
+ */
+
+#ifndef FORMAT_ENGINE_H
+#define FORMAT_ENGINE_H
+
+#include "pattern_compiler.h"
+#include "field_format.h"
+#include "output_buffer.h"
+#include "c_print_sink.h"
+#include <stdio.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdarg.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ============================================================================
+// LÍNEA ATÓMICA
+// ============================================================================
+
+/**
+ * @brief Destino de una línea atómica en un FILE
+ *
+ * La línea se arma en el OutputBuffer sin bloquear nada: si cabe, sale
+ * con un único fwrite. Si no cabe, el primer volcado bloquea el FILE y
+ * lo mantiene hasta line_stream_finish(), así la línea nunca se
+ * intercala con la de otro hilo. En modo por lotes la línea se agrega
+ * al buffer del hilo en lugar de ir a stdout; con una cola enganchada
+ * (c_print_queue) la línea completa va a la cola.
+ */
+typedef struct {
+    FILE* fp;
+    bool locked;
+    bool batched;               // La línea va al buffer por hilo (c_print_batch)
+    bool queued;                // La línea va a la cola enganchada (c_print_queue)
+    CPrintSink sink;
+} LineStream;
+
+/**
+ * @brief Prepara el sink de una línea (usar &stream->sink en output_init)
+ */
+void line_stream_init(LineStream* stream, FILE* fp);
+
+/**
+ * @brief Vuelca lo pendiente y libera el FILE si se bloqueó
+ * @return Bytes escritos en el último volcado
+ */
+size_t line_stream_finish(LineStream* stream, OutputBuffer* out);
+
+// ============================================================================
+// LÍNEA COMO TRAMOS (writev)
+// ============================================================================
+
+#ifndef _WIN32
+
+#include <sys/uio.h>
+
+#define IOV_LINE_ENTRIES 64     // Tramos por writev
+#define IOV_LINE_SCRATCH 2048   // Bytes para valores formateados y relleno
+
+/**
+ * @brief Línea armada como lista de tramos para una sola writev
+ *
+ * Los literales del patrón, las secuencias ANSI precalculadas, el reset
+ * y los strings de los argumentos se referencian en su lugar. Solo los
+ * valores formateados (números, chars) y el relleno que no es espacio
+ * se escriben en scratch. Tramos contiguos se unen en uno. Si se acaban
+ * los tramos o el scratch, la parte armada sale antes (otra writev).
+ */
+typedef struct {
+    int fd;
+    int count;
+    struct iovec iov[IOV_LINE_ENTRIES];
+    size_t pending;             // Bytes referenciados por iov
+    size_t total;               // Bytes producidos en total
+    size_t written;             // Bytes aceptados por el descriptor
+    size_t scratch_used;
+    char scratch[IOV_LINE_SCRATCH];
+} IovLine;
+
+/**
+ * @brief Prepara una línea vacía para un descriptor
+ */
+void iov_line_init(IovLine* line, int fd);
+
+/**
+ * @brief Agrega un tramo sin copiarlo (debe vivir hasta el volcado)
+ */
+void iov_line_add(IovLine* line, const char* data, size_t len);
+
+/**
+ * @brief Escribe lo armado con writev, reintentando escrituras parciales
+ * @return Bytes escritos en este volcado
+ */
+size_t iov_line_flush(IovLine* line);
+
+/**
+ * @brief Renderiza un patrón compilado completo (mismo texto que c_print)
+ */
+void render_pattern_iov(IovLine* line, const CompiledPattern* compiled, va_list* args);
+
+#endif // !_WIN32
+
+// ============================================================================
+// FORMATEO DE VALORES
+// ============================================================================
+
+/**
+ * @brief Formatea un valor según las especificaciones de un campo
+ * @return Longitud del texto generado
+ *
+ * Produce exactamente el mismo texto que c_print() para cada tipo. Los
+ * floats pasan por snprintf (punto decimal del locale); el resto por
+ * format_field_value_plain().
+ */
+size_t format_field_value(char* buffer, size_t size, const PatternStyle* style,
+                          FieldValue value);
+
+// ============================================================================
+// RENDERIZADO DE CAMPOS
+// ============================================================================
+
+/**
+ * @brief Agrega un valor ya formateado con escape ANSI, alineación y reset
+ */
+void render_field(OutputBuffer* out, const PatternSegment* segment,
+                  const char* value, size_t len);
+
+/**
+ * @brief Agrega un mensaje de error resaltado en rojo en lugar del valor
+ */
+void render_field_error(OutputBuffer* out, const PatternSegment* segment,
+                        const char* message);
+
+/**
+ * @brief Renderiza un patrón compilado completo leyendo los argumentos
+ *        de la lista variádica, sin validaciones (mismo texto que c_print)
+ */
+void render_pattern(OutputBuffer* out, const CompiledPattern* compiled, va_list* args);
+
+/**
+ * @brief Agrega un segmento literal
+ */
+static inline void render_literal(OutputBuffer* out, const PatternSegment* segment) {
+    output_write(out, segment->text, segment->length);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // FORMAT_ENGINE_H
@@ -8,6 +8,10 @@
  * - Padding con ceros
  * - Precisión decimal
  * - Conversión a porcentajes
+ *
+ * Todas las funciones escriben solo en el buffer del llamador, sin stdio,
+ * locale ni memoria dinámica, así que se pueden usar desde un manejador
+ * de señales.
  */
 
 #ifndef NUMBER_FORMATTER_H
@@ -19,6 +23,52 @@
 extern "C" {
 #endif
 
+/**
+ * @brief Escribe los dígitos de un entero sin signo en una base
+ * @param buffer Buffer de salida (trunca como snprintf)
+ * @param size Tamaño del buffer
+ * @param num Número a convertir
+ * @param base Base entre 2 y 16 (dígitos en minúscula)
+ * @return Longitud escrita (sin el terminador)
+ *
+ * Ejemplo:
+ * - format_unsigned(buf, 100, 255, 16) → "ff"
+ */
+size_t format_unsigned(char* buffer, size_t size, unsigned long long num, unsigned base);
+
+/**
+ * @brief Formatea un entero decimal con signo y ancho (mismo texto que "%+0*d")
+ * @param buffer Buffer de salida (trunca como snprintf)
+ * @param size Tamaño del buffer
+ * @param num Número a formatear
+ * @param show_sign 0 = solo '-', 1 = '+' en positivos, 2 = espacio en positivos
+ * @param width Ancho mínimo incluyendo el signo (0 = sin padding)
+ * @param zero_pad Si es 1, rellena con ceros entre el signo y los dígitos
+ * @return Longitud escrita (sin el terminador)
+ *
+ * Ejemplo:
+ * - format_decimal(buf, 100, 42, 1, 5, 1)  → "+0042"
+ * - format_decimal(buf, 100, -7, 0, 4, 0)  → "  -7"
+ */
+size_t format_decimal(char* buffer, size_t size, long long num,
+                      int show_sign, int width, int zero_pad);
+
+/**
+ * @brief Formatea un double en notación fija (mismo texto que "%.*f")
+ * @param buffer Buffer de salida (trunca como snprintf)
+ * @param size Tamaño del buffer
+ * @param num Número a formatear
+ * @param precision Decimales (negativo = 6)
+ * @return Longitud escrita (sin el terminador)
+ *
+ * Redondea al par como printf y escribe la parte entera exacta de
+ * cualquier double. El punto decimal es siempre '.', sin locale.
+ * Ejemplo:
+ * - format_fixed(buf, 100, 3.14159, 2) → "3.14"
+ * - format_fixed(buf, 100, 0.125, 2)   → "0.12"
+ */
+size_t format_fixed(char* buffer, size_t size, double num, int precision);
+
 /**
  * @brief Formatea un número entero con separadores de miles
  * @param buffer Buffer de salida
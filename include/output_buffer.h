@@ -0,0 +1,69 @@
+/**
+ * @file output_buffer.h
+ * @brief Buffer de salida sobre memoria del llamador, sin stdio
+ *
+ * Arma texto en un buffer que vuelca a un CPrintSink cuando se llena o
+ * trunca (como snprintf) cuando no tiene sink. Lo comparten el motor de
+ * patrones compilados (format_engine), c_print_to() y el camino de
+ * señales, así que solo usa string.h: no depende de stdio ni del heap.
+ */
+
+#ifndef OUTPUT_BUFFER_H
+#define OUTPUT_BUFFER_H
+
+#include "pattern_parser.h"
+#include "c_print_sink.h"
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Buffer de salida con volcado a sink o truncado
+ */
+typedef struct {
+    char* data;
+    size_t length;              // Bytes pendientes en data
+    size_t capacity;
+    size_t total;               // Bytes producidos en total (incluye volcados/truncados)
+    size_t written;             // Bytes aceptados por el sink
+    const CPrintSink* sink;     // NULL = modo truncado estilo snprintf
+} OutputBuffer;
+
+/**
+ * @brief Inicializa un buffer de salida sobre memoria del llamador
+ * @param sink Destino al llenarse; NULL para truncar (se reserva 1 byte para NUL)
+ */
+void output_init(OutputBuffer* out, char* storage, size_t capacity, const CPrintSink* sink);
+
+/**
+ * @brief Agrega bytes al buffer
+ */
+void output_write(OutputBuffer* out, const char* data, size_t len);
+
+/**
+ * @brief Agrega count copias de un carácter
+ */
+void output_fill(OutputBuffer* out, char ch, size_t count);
+
+/**
+ * @brief Agrega texto con la alineación del campo (mismo resultado que print_aligned)
+ */
+void output_write_aligned(OutputBuffer* out, const PatternStyle* style,
+                          const char* value, size_t len);
+
+/**
+ * @brief Vuelca el contenido pendiente al sink (o termina en NUL sin sink)
+ * @return Bytes escritos en el sink
+ *
+ * Llama directamente al write del sink, sin contar estadísticas: los
+ * sinks que deben contar bytes lo hacen ellos mismos (cp_sink_write).
+ */
+size_t output_flush(OutputBuffer* out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // OUTPUT_BUFFER_H
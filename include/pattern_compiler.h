@@ -0,0 +1,96 @@
+/**
+ * @file pattern_compiler.h
+ * @brief Compilación y caché de patrones completos
+ *
+ * Un patrón como "Hola {s:red}, tienes {d:05} mensajes\n" se analiza una
+ * sola vez y se convierte en una lista de segmentos: tramos literales
+ * (que apuntan al texto original) y campos con su PatternStyle ya
+ * parseado y la secuencia ANSI precalculada. Los renderizadores recorren
+ * los segmentos sin volver a parsear.
+ */
+
+#ifndef PATTERN_COMPILER_H
+#define PATTERN_COMPILER_H
+
+#include "pattern_parser.h"
+#include "c_print_alloc.h"
+#include <stddef.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Tipo de segmento de un patrón compilado
+ */
+typedef enum {
+    SEGMENT_LITERAL = 0,    // Texto que se copia tal cual
+    SEGMENT_FIELD = 1       // {type:specs} que consume un argumento
+} SegmentKind;
+
+/**
+ * @brief Segmento de un patrón compilado
+ */
+typedef struct {
+    SegmentKind kind;
+    const char* text;               // LITERAL: tramo dentro de CompiledPattern.source
+    size_t length;                  // LITERAL: longitud del tramo
+    PatternStyle style;             // FIELD: especificaciones parseadas
+    bool consumes_argument;         // FIELD: false para tipos desconocidos ("{?}")
+    unsigned char escape_length;    // FIELD: 0 si no tiene colores ni estilos
+    char escape[ANSI_MAX_SEQUENCE]; // FIELD: secuencia ANSI precalculada
+} PatternSegment;
+
+/**
+ * @brief Patrón compilado (un único bloque de memoria)
+ */
+typedef struct CompiledPattern {
+    const char* source;             // Copia propia del patrón
+    size_t source_length;
+    PatternSegment* segments;
+    size_t segment_count;
+    size_t field_count;             // Campos que consumen argumento
+    char* field_types;              // format_type de cada campo (field_count + NUL)
+    const CPrintAllocator* allocator;
+    size_t block_size;
+} CompiledPattern;
+
+/**
+ * @brief Compila un patrón
+ * @param pattern Patrón a compilar
+ * @param allocator Allocator para el resultado (NULL = allocator global)
+ * @return Patrón compilado (liberar con free_compiled_pattern) o NULL
+ */
+CompiledPattern* compile_pattern(const char* pattern, const CPrintAllocator* allocator);
+
+/**
+ * @brief Libera un patrón compilado
+ */
+void free_compiled_pattern(CompiledPattern* compiled);
+
+/**
+ * @brief Obtiene un patrón compilado desde la caché del hilo actual
+ * @return Patrón compilado (propiedad de la caché) o NULL si falla la memoria
+ *
+ * La caché se indexa por la dirección del patrón y verifica el contenido,
+ * así que patrones en buffers reutilizados siguen siendo correctos.
+ * El resultado es válido hasta la siguiente llamada desde el mismo hilo
+ * que desaloje la entrada; no debe guardarse.
+ */
+const CompiledPattern* get_compiled_pattern(const char* pattern);
+
+/**
+ * @brief Libera la caché de patrones del hilo actual
+ *
+ * En POSIX se llama sola cuando termina un hilo que usó la caché (clave
+ * de pthread registrada en el primer fallo). En Windows debe llamarse
+ * antes de que termine el hilo.
+ */
+void clear_pattern_cache(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // PATTERN_COMPILER_H
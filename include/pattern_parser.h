@@ -84,6 +84,11 @@ bool parse_pattern(const char* pattern, PatternStyle* style);
  */
 bool is_format_modifier(const char* token, PatternStyle* style);
 
+/**
+ * @brief Indica si un tipo de formato consume un argumento
+ */
+bool is_known_format_type(char format_type);
+
 #ifdef __cplusplus
 }
 #endif
@@ -28,6 +28,23 @@ void to_lowercase(char* str);
  */
 bool is_number(const char* str);
 
+/**
+ * @brief Lee los dígitos decimales del inicio de un string (como atoi)
+ * @param str String a leer
+ * @return Valor leído (0 sin dígitos, INT_MAX si se desborda)
+ *
+ * No depende del locale ni reserva memoria: se puede usar desde un
+ * manejador de señales.
+ */
+int parse_digits(const char* str);
+
+/**
+ * @brief Indica si un carácter es un dígito ASCII (sin locale)
+ */
+static inline bool is_ascii_digit(char ch) {
+    return ch >= '0' && ch <= '9';
+}
+
 /**
  * @brief Elimina espacios en blanco al inicio y final de un string (in-place)
  * @param str String a procesar (será modificado)
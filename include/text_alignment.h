@@ -10,7 +10,7 @@
 #define TEXT_ALIGNMENT_H
 
 #include <stdbool.h>
-
+#include <stddef.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -24,6 +24,22 @@ typedef enum {
     ALIGN_CENTER = '^'
 } TextAlign;
 
+/**
+ * @brief Reparte el relleno de un campo alineado
+ * @param align Tipo de alineación
+ * @param width Ancho total del campo
+ * @param len Longitud del texto
+ * @param right [out] Relleno a la derecha del texto
+ * @return Relleno a la izquierda del texto
+ *
+ * Es la regla que siguen todas las APIs: sin relleno si el texto ocupa
+ * el ancho o si la alineación no es ALIGN_LEFT, ALIGN_RIGHT ni
+ * ALIGN_CENTER; al centrar, el carácter sobrante va a la derecha.
+ */
+size_t alignment_padding(TextAlign align, size_t width, size_t len, size_t* right);
+
+#ifndef C_PRINT_FREESTANDING
+
 /**
  * @brief Imprime texto con alineación y carácter de relleno
  * @param text Texto a imprimir
@@ -38,6 +54,8 @@ typedef enum {
  */
 void print_aligned(const char* text, TextAlign align, int width, char fill_char);
 
+#endif // !C_PRINT_FREESTANDING
+
 /**
  * @brief Detecta si un token representa alineación
  * @param token String a analizar (ej: "<20", ">30", "*^15")
@@ -0,0 +1,74 @@
+/**
+ * @file thread_blocks.h
+ * @brief Registro de bloques por hilo en una lista global que solo crece
+ *
+ * Uso interno de las estadísticas, la latencia y la salida por lotes.
+ * Cada hilo toma un bloque libre de la lista (o agrega uno nuevo) y es
+ * su único dueño hasta que termina: en POSIX un destructor de
+ * pthread_key llama al callback release del módulo y marca el bloque
+ * como libre para el siguiente hilo. Los bloques nunca se liberan, así
+ * que se pueden recorrer sin locks mientras otros hilos agregan más.
+ *
+ * Cada tipo de bloque empieza con un ThreadBlock:
+ *
+ *   typedef struct {
+ *       ThreadBlock header;
+ *       atomic_ullong counters[N];
+ *   } MyBlock;
+ *
+ *   static ThreadBlockList my_blocks = THREAD_BLOCK_LIST_INIT(MyBlock, NULL, my_release);
+ */
+
+#ifndef THREAD_BLOCKS_H
+#define THREAD_BLOCKS_H
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+
+#ifndef _WIN32
+    #include <pthread.h>
+#endif
+
+typedef struct ThreadBlockList ThreadBlockList;
+
+/**
+ * @brief Cabecera común de los bloques (primer miembro de cada bloque)
+ */
+typedef struct ThreadBlock {
+    atomic_bool in_use;
+    ThreadBlockList* list;          // Lista dueña (para el destructor)
+    struct ThreadBlock* next;       // Inmutable una vez publicado
+} ThreadBlock;
+
+struct ThreadBlockList {
+    _Atomic(ThreadBlock*) head;
+    size_t block_size;
+    void (*init)(ThreadBlock* block);       // Bloque nuevo, antes de publicarlo (opcional)
+    void (*release)(ThreadBlock* block);    // El hilo dueño termina (opcional)
+#ifndef _WIN32
+    atomic_bool key_ready;
+    pthread_key_t key;
+#endif
+};
+
+#define THREAD_BLOCK_LIST_INIT(type, on_init, on_release) \
+    { .head = NULL, .block_size = sizeof(type), .init = (on_init), .release = (on_release) }
+
+/**
+ * @brief Asigna un bloque al hilo actual: reutiliza uno libre o agrega uno
+ * @return Bloque en cero (o el que dejó un hilo terminado); NULL sin memoria
+ *
+ * Llamar una sola vez por hilo y guardar el resultado en una variable
+ * thread-local; el callback release debe ponerla en NULL.
+ */
+ThreadBlock* thread_block_acquire(ThreadBlockList* list);
+
+/**
+ * @brief Primer bloque de la lista, para recorrerla con ->next
+ */
+static inline ThreadBlock* thread_block_first(ThreadBlockList* list) {
+    return atomic_load(&list->head);
+}
+
+#endif // THREAD_BLOCKS_H
@@ -4,34 +4,67 @@
  */
 
 #include "ansi_codes.h"
+#include "c_print_stats.h"
 
-void apply_ansi_codes(TextColor fg, BackgroundColor bg, TextStyle style) {
-    printf("\033[");
+/**
+ * @brief Escribe un código numérico (máximo 3 dígitos) en el buffer
+ */
+static size_t put_code(char* out, int code) {
+    size_t len = 0;
+    if (code >= 100) out[len++] = (char)('0' + code / 100);
+    if (code >= 10) out[len++] = (char)('0' + (code / 10) % 10);
+    out[len++] = (char)('0' + code % 10);
+    return len;
+}
+
+size_t format_ansi_codes(char* buffer, size_t size, TextColor fg, BackgroundColor bg,
+                         TextStyle style) {
+    if (!buffer || size < ANSI_MAX_SEQUENCE) return 0;
+    
+    size_t len = 0;
+    buffer[len++] = '\033';
+    buffer[len++] = '[';
     
     int first = 1;
     
     // Aplicar estilo si no es RESET
     if (style != STYLE_RESET) {
-        printf("%d", style);
+        len += put_code(buffer + len, style);
         first = 0;
     }
     
     // Aplicar color de texto si no es RESET
     if (fg != COLOR_RESET) {
-        if (!first) printf(";");
-        printf("%d", fg);
+        if (!first) buffer[len++] = ';';
+        len += put_code(buffer + len, fg);
         first = 0;
     }
     
     // Aplicar color de fondo si no es RESET
     if (bg != BG_RESET) {
-        if (!first) printf(";");
-        printf("%d", bg);
+        if (!first) buffer[len++] = ';';
+        len += put_code(buffer + len, bg);
     }
     
-    printf("m");
+    buffer[len++] = 'm';
+    buffer[len] = '\0';
+    return len;
+}
+
+#ifndef C_PRINT_FREESTANDING
+
+void apply_ansi_codes(TextColor fg, BackgroundColor bg, TextStyle style) {
+    char codes[ANSI_MAX_SEQUENCE];
+    size_t len = format_ansi_codes(codes, sizeof(codes), fg, bg, style);
+    fwrite(codes, 1, len, stdout);
+    CP_STAT_ADD(CP_STAT_BYTES, len);
+    CP_STAT_ADD(CP_STAT_ESCAPE_BYTES, len);
 }
 
 void reset_ansi_codes(void) {
-    printf("\033[0m");
-}
\ No newline at end of file
+    fwrite(ANSI_RESET_SEQUENCE, 1, ANSI_RESET_LENGTH, stdout);
+    CP_STAT_ADD(CP_STAT_BYTES, ANSI_RESET_LENGTH);
+    CP_STAT_ADD(CP_STAT_ESCAPE_BYTES, ANSI_RESET_LENGTH);
+}
+
+#endif // !C_PRINT_FREESTANDING
@@ -8,189 +8,173 @@
 
 #include "c_print.h"
 #include "ansi_codes.h"
-#include "color_parser.h"
-#include "pattern_parser.h"
-#include "number_formatter.h"
-#include "text_alignment.h"
+#include "pattern_compiler.h"
+#include "format_engine.h"
+#include "c_print_config.h"
+#include "c_print_stats.h"
+#include "c_print_latency.h"
+#include "c_print_probes.h"
+#include "c_print_batch.h"
 #include <stdlib.h>
 #include <string.h>
 #include <stdarg.h>
 
+// Buffer de pila para armar una línea de c_print
+#define PRINT_OUTPUT_BUFFER 1024
+
 // ============================================================================
 // FUNCIÓN PRINCIPAL: c_print con sistema de patrones
 // ============================================================================
 
+/**
+ * La línea se arma completa en un buffer de pila y sale con un único
+ * fwrite, así dos hilos nunca intercalan sus líneas. Si no cabe en el
+ * buffer, stdout queda bloqueado desde el primer volcado hasta el final.
+ */
 void c_print(const char* pattern, ...) {
-    if (!pattern) return;    
+    if (!pattern) return;
+    CP_STAT_CALL(CPRINT_API_PRINT);
+    CP_LAT_SCOPE(latency);
+
+    CP_LAT_ENTER(latency, CPRINT_STAGE_PARSE);
+    const CompiledPattern* compiled = get_compiled_pattern(pattern);
+    if (!compiled) return;
+    CP_PROBE_FORMAT_START(pattern);
+
+    char storage[PRINT_OUTPUT_BUFFER];
+    char value_buffer[FORMAT_VALUE_BUFFER];
+    LineStream stream;
+    OutputBuffer out;
+    line_stream_init(&stream, stdout);
+    output_init(&out, storage, sizeof(storage), &stream.sink);
 
     va_list args;
-    va_start(args, pattern);  
-    
-    const char* p = pattern;
-    
-    while (*p) {
-        // Buscar el inicio de un patrón
-        if (*p == '{') {
-            PatternStyle style;
-            
-            // Intentar parsear el patrón
-            if (parse_pattern(p, &style)) {
-                // Buffer para el valor formateado
-                char value_buffer[1024];
-                value_buffer[0] = '\0';
-                
-                // Formatear el valor según el tipo
-                switch (style.format_type) {
-                    case 's': {
-                        char* str = va_arg(args, char*);                        
-                        if (str) {                            
-                            if (style.has_truncate && strlen(str) > (size_t)style.truncate) {
-                                snprintf(value_buffer, sizeof(value_buffer), "%.*s", 
-                                        style.truncate, str);
-                            } else {
-                                snprintf(value_buffer, sizeof(value_buffer), "%s", str);
-                            }
-                        }
-                        break;
-                    }
-                    
-                    case 'd':
-                    case 'i': {
-                        int num = va_arg(args, int);
-                        
-                        if (style.has_separator) {
-                            format_with_separator(value_buffer, sizeof(value_buffer), 
-                                                 num, style.separator);
-                        } else if (style.padding > 0 || style.show_sign) {
-                            char fmt[20] = "%";
-                            if (style.show_sign == 1) strcat(fmt, "+");
-                            else if (style.show_sign == 2) strcat(fmt, " ");
-                            if (style.zero_pad) strcat(fmt, "0");
-                            if (style.padding > 0) {
-                                char width[10];
-                                snprintf(width, sizeof(width), "%d", style.padding);
-                                strcat(fmt, width);
-                            }
-                            strcat(fmt, "d");
-                            snprintf(value_buffer, sizeof(value_buffer), fmt, num);
-                        } else {
-                            snprintf(value_buffer, sizeof(value_buffer), "%d", num);
-                        }
-                        break;
-                    }
-                    
-                    case 'f': {
-                        double num = va_arg(args, double);
-                        
-                        if (style.as_percentage) {
-                            num *= 100.0;
-                            if (style.has_precision) {
-                                snprintf(value_buffer, sizeof(value_buffer), 
-                                        "%.*f%%", style.precision, num);
-                            } else {
-                                snprintf(value_buffer, sizeof(value_buffer), "%.1f%%", num);
-                            }
-                        } else if (style.has_precision) {
-                            snprintf(value_buffer, sizeof(value_buffer), 
-                                    "%.*f", style.precision, num);
-                        } else {
-                            snprintf(value_buffer, sizeof(value_buffer), "%f", num);
-                        }
-                        break;
-                    }
-                    
-                    case 'c': {
-                        char ch = (char)va_arg(args, int);
-                        snprintf(value_buffer, sizeof(value_buffer), "%c", ch);
-                        break;
-                    }
-                    
-                    case 'b': {
-                        unsigned int num = va_arg(args, unsigned int);
-                        format_binary(value_buffer, sizeof(value_buffer), 
-                                     num, style.show_prefix);
-                        break;
-                    }
-                    
-                    case 'x': {
-                        unsigned int num = va_arg(args, unsigned int);
-                        format_hex(value_buffer, sizeof(value_buffer), num, 
-                                  style.show_prefix, style.padding, style.zero_pad);
-                        break;
-                    }
-                    
-                    case 'o': {
-                        unsigned int num = va_arg(args, unsigned int);
-                        format_octal(value_buffer, sizeof(value_buffer), 
-                                    num, style.show_prefix);
-                        break;
-                    }
-                    
-                    case 'u': {
-                        unsigned int num = va_arg(args, unsigned int);
-                        if (style.has_separator) {
-                            format_with_separator(value_buffer, sizeof(value_buffer), 
-                                                 num, style.separator);
-                        } else {
-                            snprintf(value_buffer, sizeof(value_buffer), "%u", num);
-                        }
-                        break;
-                    }
-                    
-                    case 'l': {
-                        long num = va_arg(args, long);
-                        if (style.has_separator) {
-                            format_with_separator(value_buffer, sizeof(value_buffer), 
-                                                 num, style.separator);
-                        } else {
-                            snprintf(value_buffer, sizeof(value_buffer), "%ld", num);
-                        }
-                        break;
-                    }
-                    
-                    default:
-                        snprintf(value_buffer, sizeof(value_buffer), "{?}");
-                        break;
-                }
-                
-                // Aplicar estilos ANSI
-                if (style.has_color || style.has_bg || style.has_style) {
-                    apply_ansi_codes(style.text_color, style.bg_color, style.style);
-                }
-                
-                // Imprimir con o sin alineación
-                if (style.has_alignment) {
-                    print_aligned(value_buffer, style.align, style.width, style.fill_char);
-                } else {
-                    printf("%s", value_buffer);
-                }
-                
-                // Resetear estilos
-                if (style.has_color || style.has_bg || style.has_style) {
-                    reset_ansi_codes();
-                }
-                
-                // Avanzar hasta después del }
-                while (*p && *p != '}') p++;
-                if (*p == '}') p++;
-                
-            } else {
-                // No es un patrón válido, imprimir literal
-                putchar(*p);
-                p++;
-            }
-        } else if (*p == '\\' && *(p + 1) == '{') {
-            // Escape para {
-            putchar('{');
-            p += 2;
-        } else {
-            // Carácter normal
-            putchar(*p);
-            p++;
+    va_start(args, pattern);
+
+    for (size_t i = 0; i < compiled->segment_count; i++) {
+        const PatternSegment* seg = &compiled->segments[i];
+
+        if (seg->kind == SEGMENT_LITERAL) {
+            CP_LAT_ENTER(latency, CPRINT_STAGE_WRITE);
+            render_literal(&out, seg);
+            continue;
         }
+
+        // Tipos desconocidos se muestran como "{?}" sin consumir argumento
+        CP_LAT_ENTER(latency, CPRINT_STAGE_FORMAT);
+        FieldValue value;
+        value.u = 0;
+        if (seg->consumes_argument) value = read_field_value(seg->style.format_type, &args);
+        size_t len = format_field_value(value_buffer, sizeof(value_buffer), &seg->style, value);
+
+        CP_LAT_ENTER(latency, seg->style.has_alignment ? CPRINT_STAGE_ALIGN
+                                                       : CPRINT_STAGE_WRITE);
+        render_field(&out, seg, value_buffer, len);
     }
-    
+
+    va_end(args);
+
+    CP_LAT_ENTER(latency, CPRINT_STAGE_WRITE);
+    line_stream_finish(&stream, &out);
+    CP_LAT_END(latency);
+    CP_PROBE_FORMAT_END(pattern, out.total);
+}
+
+// ============================================================================
+// SALIDA A BUFFER: c_snprint
+// ============================================================================
+
+static size_t render_to_buffer(char* buffer, size_t size, const char* pattern,
+                               const CompiledPattern* compiled, va_list* args) {
+    CP_STAT_CALL(CPRINT_API_SNPRINT);
+    CP_PROBE_FORMAT_START(pattern);
+    OutputBuffer out;
+    output_init(&out, buffer, buffer ? size : 0, NULL);
+    if (compiled) render_pattern(&out, compiled, args);
+    output_flush(&out);
+    CP_PROBE_FORMAT_END(pattern, out.total);
+    return out.total;
+}
+
+size_t c_vsnprint(char* buffer, size_t size, const char* pattern, va_list args) {
+    const CompiledPattern* compiled = pattern ? get_compiled_pattern(pattern) : NULL;
+
+    va_list copy;
+    va_copy(copy, args);
+    size_t total = render_to_buffer(buffer, size, pattern, compiled, &copy);
+    va_end(copy);
+    return total;
+}
+
+size_t c_snprint(char* buffer, size_t size, const char* pattern, ...) {
+    va_list args;
+    va_start(args, pattern);
+    size_t total = c_vsnprint(buffer, size, pattern, args);
+    va_end(args);
+    return total;
+}
+
+size_t c_snprint_compiled(char* buffer, size_t size,
+                          const struct CompiledPattern* compiled, ...) {
+    va_list args;
+    va_start(args, compiled);
+    size_t total = render_to_buffer(buffer, size, compiled ? compiled->source : NULL,
+                                    compiled, &args);
+    va_end(args);
+    return total;
+}
+
+// ============================================================================
+// SALIDA A DESCRIPTOR: c_print_fd
+// ============================================================================
+
+/**
+ * La línea sale con una writev cuyos tramos apuntan a los literales del
+ * patrón compilado, a sus escapes precalculados y a los strings de los
+ * argumentos; solo los valores formateados se copian al scratch de pila.
+ */
+size_t c_vprint_fd(int fd, const char* pattern, va_list args) {
+    if (!pattern || fd < 0) return 0;
+    CP_STAT_CALL(CPRINT_API_FD);
+
+    const CompiledPattern* compiled = get_compiled_pattern(pattern);
+    if (!compiled) return 0;
+    CP_PROBE_FORMAT_START(pattern);
+
+    va_list copy;
+    va_copy(copy, args);
+    size_t written;
+
+#ifndef _WIN32
+    IovLine line;
+    iov_line_init(&line, fd);
+    render_pattern_iov(&line, compiled, &copy);
+    iov_line_flush(&line);
+    written = line.written;
+    CP_PROBE_FORMAT_END(pattern, line.total);
+#else
+    // Sin writev: línea armada en la pila y escrita con write
+    char storage[PRINT_OUTPUT_BUFFER];
+    CPrintSink sink = cp_sink_fd(fd);
+    OutputBuffer out;
+    output_init(&out, storage, sizeof(storage), &sink);
+    render_pattern(&out, compiled, &copy);
+    output_flush(&out);
+    written = out.total;        // cp_sink_fd reintenta las escrituras parciales
+    CP_STAT_ADD(CP_STAT_BYTES, out.written);
+    CP_PROBE_FORMAT_END(pattern, out.total);
+#endif
+
+    va_end(copy);
+    return written;
+}
+
+size_t c_print_fd(int fd, const char* pattern, ...) {
+    va_list args;
+    va_start(args, pattern);
+    size_t written = c_vprint_fd(fd, pattern, args);
     va_end(args);
+    return written;
 }
 
 // ============================================================================
@@ -198,9 +182,15 @@ void c_print(const char* pattern, ...) {
 // ============================================================================
 
 void c_print_styled(const char* text, TextColor fg, BackgroundColor bg, TextStyle style) {
+    CP_STAT_CALL(CPRINT_API_STYLED);
+    CP_BATCH_SYNC();            // Sin adelantarse a las líneas por lotes del hilo
+    CP_LOCK_FILE(stdout);       // Escape, texto y reset sin intercalado
     apply_ansi_codes(fg, bg, style);
-    printf("%s", text);
+    int written = printf("%s", text);
+    CP_STAT_ADD(CP_STAT_BYTES, written > 0 ? written : 0);
+    (void)written;
     reset_ansi_codes();
+    CP_UNLOCK_FILE(stdout);
 }
 
 void c_print_color(const char* text, TextColor fg) {
@@ -221,12 +211,18 @@ void c_print_full(const char* text, PrintOptions opts) {
 
 void c_printf_styled(TextColor fg, BackgroundColor bg, TextStyle style, 
                      const char* format, ...) {
+    CP_STAT_CALL(CPRINT_API_PRINTF_STYLED);
+    CP_BATCH_SYNC();
+    CP_LOCK_FILE(stdout);
     apply_ansi_codes(fg, bg, style);
     
     va_list args;
     va_start(args, format);
-    vprintf(format, args);
+    int written = vprintf(format, args);
     va_end(args);
+    CP_STAT_ADD(CP_STAT_BYTES, written > 0 ? written : 0);
+    (void)written;
     
     reset_ansi_codes();
+    CP_UNLOCK_FILE(stdout);
 }
\ No newline at end of file
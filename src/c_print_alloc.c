@@ -0,0 +1,170 @@
+/**
+ * @file c_print_alloc.c
+ * @brief Implementación del allocator por defecto y del arena
+ */
+
+#include "c_print_alloc.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#define ARENA_ALIGNMENT 16
+
+// ============================================================================
+// ALLOCATOR DEL HEAP
+// ============================================================================
+
+static void* heap_alloc(void* ctx, size_t size) {
+    (void)ctx;
+    return malloc(size);
+}
+
+static void* heap_realloc(void* ctx, void* ptr, size_t old_size, size_t new_size) {
+    (void)ctx;
+    (void)old_size;
+    return realloc(ptr, new_size);
+}
+
+static void heap_free(void* ctx, void* ptr, size_t size) {
+    (void)ctx;
+    (void)size;
+    free(ptr);
+}
+
+static const CPrintAllocator heap_allocator = {
+    heap_alloc, heap_realloc, heap_free, NULL
+};
+
+static const CPrintAllocator* global_allocator = &heap_allocator;
+
+const CPrintAllocator* cp_heap_allocator(void) {
+    return &heap_allocator;
+}
+
+void c_print_set_allocator(const CPrintAllocator* allocator) {
+    global_allocator = allocator ? allocator : &heap_allocator;
+}
+
+const CPrintAllocator* c_print_get_allocator(void) {
+    return global_allocator;
+}
+
+void* cp_alloc(const CPrintAllocator* allocator, size_t size) {
+    if (!allocator) allocator = global_allocator;
+    return allocator->alloc(allocator->ctx, size);
+}
+
+void* cp_realloc(const CPrintAllocator* allocator, void* ptr,
+                 size_t old_size, size_t new_size) {
+    if (!allocator) allocator = global_allocator;
+    return allocator->realloc(allocator->ctx, ptr, old_size, new_size);
+}
+
+void cp_dealloc(const CPrintAllocator* allocator, void* ptr, size_t size) {
+    if (!ptr) return;
+    if (!allocator) allocator = global_allocator;
+    allocator->free(allocator->ctx, ptr, size);
+}
+
+// ============================================================================
+// ARENA
+// ============================================================================
+
+static size_t align_up(size_t value) {
+    return (value + (ARENA_ALIGNMENT - 1)) & ~(size_t)(ARENA_ALIGNMENT - 1);
+}
+
+static void* arena_alloc(void* ctx, size_t size) {
+    CPrintArena* arena = ctx;
+
+    // Alinear la dirección real, no solo el desplazamiento
+    uintptr_t base = (uintptr_t)arena->base;
+    size_t start = align_up(base + arena->offset) - base;
+
+    if (start > arena->capacity || size > arena->capacity - start) {
+        return NULL;
+    }
+
+    arena->last_offset = start;
+    arena->offset = start + size;
+    return arena->base + start;
+}
+
+static void* arena_realloc(void* ctx, void* ptr, size_t old_size, size_t new_size) {
+    CPrintArena* arena = ctx;
+
+    if (!ptr) return arena_alloc(ctx, new_size);
+
+    // El último bloque puede crecer (o encoger) en el sitio
+    if ((char*)ptr == arena->base + arena->last_offset) {
+        if (new_size <= arena->capacity - arena->last_offset) {
+            arena->offset = arena->last_offset + new_size;
+            return ptr;
+        }
+        return NULL;
+    }
+
+    void* new_ptr = arena_alloc(ctx, new_size);
+    if (new_ptr) {
+        memcpy(new_ptr, ptr, old_size < new_size ? old_size : new_size);
+    }
+    return new_ptr;
+}
+
+static void arena_free(void* ctx, void* ptr, size_t size) {
+    CPrintArena* arena = ctx;
+    (void)size;
+
+    // Solo se recupera el último bloque; el resto se libera con reset
+    if ((char*)ptr == arena->base + arena->last_offset) {
+        arena->offset = arena->last_offset;
+    }
+}
+
+void cp_arena_init(CPrintArena* arena, void* memory, size_t size) {
+    if (!arena) return;
+
+    arena->base = memory;
+    arena->capacity = memory ? size : 0;
+    arena->offset = 0;
+    arena->last_offset = 0;
+    arena->owns_memory = false;
+    arena->allocator.alloc = arena_alloc;
+    arena->allocator.realloc = arena_realloc;
+    arena->allocator.free = arena_free;
+    arena->allocator.ctx = arena;
+}
+
+bool cp_arena_create(CPrintArena* arena, size_t size) {
+    if (!arena) return false;
+
+    void* memory = cp_alloc(NULL, size);
+    cp_arena_init(arena, memory, size);
+    if (!memory) return false;
+
+    arena->owns_memory = true;
+    return true;
+}
+
+void cp_arena_destroy(CPrintArena* arena) {
+    if (!arena) return;
+
+    if (arena->owns_memory) {
+        cp_dealloc(NULL, arena->base, arena->capacity);
+    }
+    cp_arena_init(arena, NULL, 0);
+}
+
+void cp_arena_reset(CPrintArena* arena) {
+    if (!arena) return;
+    arena->offset = 0;
+    arena->last_offset = 0;
+}
+
+size_t cp_arena_used(const CPrintArena* arena) {
+    return arena ? arena->offset : 0;
+}
+
+const CPrintAllocator* cp_arena_allocator(CPrintArena* arena) {
+    return arena ? &arena->allocator : NULL;
+}
@@ -0,0 +1,355 @@
+/**
+ * @file c_print_batch.c
+ * @brief Buffers de salida por hilo con entrega por lotes
+ *
+ * Cada hilo toma un bloque de una lista global que solo crece (igual que
+ * las estadísticas). El mutex del bloque casi nunca tiene contención:
+ * lo toma su dueño una vez por línea y, de vez en cuando, el hilo de
+ * vaciado o c_print_batch_flush_all(). El orden de bloqueo es siempre
+ * bloque → stdout.
+ *
+ * Dentro del bloque, [0, committed) son líneas completas y
+ * [committed, length) la línea en curso. Solo se entrega hasta
+ * committed; si una línea sola no cabe en el buffer sale directa con
+ * stdout bloqueado hasta su fin.
+ */
+
+#include "c_print_batch.h"
+#include "c_print_config.h"
+#include "c_print_sink.h"
+#include "thread_blocks.h"
+
+#ifdef CP_BATCH_ENABLED
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdatomic.h>
+#include <time.h>
+#include <pthread.h>
+
+typedef struct {
+    ThreadBlock header;
+    pthread_mutex_t lock;
+    char* data;
+    size_t capacity;
+    size_t length;                  // Bytes en el buffer (líneas + línea en curso)
+    size_t committed;               // Fin de la última línea completa
+    unsigned long long first_ns;    // Cuándo se completó la primera línea pendiente
+    bool holding_stdout;            // La línea en curso sale directa (stdout bloqueado)
+} BatchBlock;
+
+static CP_THREAD_LOCAL BatchBlock* local_block;
+
+static atomic_bool active;
+static atomic_size_t buffer_size = CPRINT_BATCH_DEFAULT_BUFFER;
+static atomic_uint interval_ms;
+
+// Hilo de vaciado por intervalo
+static pthread_mutex_t flusher_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t flusher_wake = PTHREAD_COND_INITIALIZER;
+static pthread_t flusher;
+static bool flusher_running;
+static bool flusher_stop;
+
+static unsigned long long now_ns(void) {
+    struct timespec ts;
+#ifdef CLOCK_MONOTONIC_COARSE
+    clock_gettime(CLOCK_MONOTONIC_COARSE, &ts);
+#else
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+#endif
+    return (unsigned long long)ts.tv_sec * 1000000000ull + (unsigned long long)ts.tv_nsec;
+}
+
+// ============================================================================
+// ENTREGA
+// ============================================================================
+
+/**
+ * @brief Escribe las líneas completas en stdout (con el bloque bloqueado)
+ * @return true si entregó algo
+ */
+static bool hand_off(BatchBlock* block) {
+    if (block->committed == 0) return false;
+
+    CPrintSink out = cp_sink_file(stdout);
+    cp_sink_write(&out, block->data, block->committed);
+
+    size_t rest = block->length - block->committed;
+    if (rest > 0) memmove(block->data, block->data + block->committed, rest);
+    block->length = rest;
+    block->committed = 0;
+    return true;
+}
+
+static bool expired(const BatchBlock* block, unsigned long long now) {
+    unsigned interval = atomic_load_explicit(&interval_ms, memory_order_relaxed);
+    return interval && block->committed &&
+           now - block->first_ns >= (unsigned long long)interval * 1000000ull;
+}
+
+// ============================================================================
+// BLOQUES POR HILO
+// ============================================================================
+
+static void init_block(ThreadBlock* block) {
+    pthread_mutex_init(&((BatchBlock*)block)->lock, NULL);
+}
+
+static void release_block(ThreadBlock* ptr) {
+    BatchBlock* block = (BatchBlock*)ptr;
+
+    // El hilo termina: sus líneas salen ahora
+    pthread_mutex_lock(&block->lock);
+    hand_off(block);
+    pthread_mutex_unlock(&block->lock);
+
+    local_block = NULL;
+}
+
+static ThreadBlockList batch_blocks = THREAD_BLOCK_LIST_INIT(BatchBlock, init_block, release_block);
+
+static pthread_once_t exit_once = PTHREAD_ONCE_INIT;
+
+static void flush_at_exit(void) {
+    c_print_batch_flush_all();
+}
+
+static void register_flush_at_exit(void) {
+    atexit(flush_at_exit);
+}
+
+static BatchBlock* acquire_block(void) {
+    pthread_once(&exit_once, register_flush_at_exit);
+    local_block = (BatchBlock*)thread_block_acquire(&batch_blocks);
+    return local_block;
+}
+
+/**
+ * @brief Ajusta el buffer al tamaño configurado (solo vacío)
+ */
+static bool ensure_buffer(BatchBlock* block) {
+    size_t size = atomic_load_explicit(&buffer_size, memory_order_relaxed);
+    if (block->data && (block->capacity == size || block->length > 0)) return true;
+
+    char* data = realloc(block->data, size);
+    if (!data) return block->data != NULL;
+    block->data = data;
+    block->capacity = size;
+    return true;
+}
+
+// ============================================================================
+// LÍNEAS
+// ============================================================================
+
+bool cp_batch_begin_line(void) {
+    if (!atomic_load_explicit(&active, memory_order_relaxed)) return false;
+
+    BatchBlock* block = local_block;
+    if (!block && !(block = acquire_block())) return false;
+
+    pthread_mutex_lock(&block->lock);
+    if (!ensure_buffer(block)) {
+        pthread_mutex_unlock(&block->lock);
+        return false;
+    }
+    return true;
+}
+
+void cp_batch_write(const char* data, size_t len) {
+    BatchBlock* block = local_block;
+    CPrintSink out = cp_sink_file(stdout);
+
+    if (block->holding_stdout) {
+        cp_sink_write(&out, data, len);
+        return;
+    }
+
+    if (block->length + len > block->capacity) {
+        hand_off(block);
+
+        if (block->length + len > block->capacity) {
+            // La línea no cabe ni con el buffer vacío: sale directa
+            CP_LOCK_FILE(stdout);
+            block->holding_stdout = true;
+            cp_sink_write(&out, block->data, block->length);
+            cp_sink_write(&out, data, len);
+            block->length = 0;
+            return;
+        }
+    }
+
+    memcpy(block->data + block->length, data, len);
+    block->length += len;
+}
+
+void cp_batch_end_line(void) {
+    BatchBlock* block = local_block;
+
+    if (block->holding_stdout) {
+        block->holding_stdout = false;
+        CP_UNLOCK_FILE(stdout);
+    } else if (block->length > block->committed) {
+        bool timed = atomic_load_explicit(&interval_ms, memory_order_relaxed) != 0;
+        unsigned long long now = timed ? now_ns() : 0;
+
+        if (block->committed == 0) block->first_ns = now;
+        block->committed = block->length;
+
+        // Desactivado mientras se escribía la línea: no queda esperando
+        if (!atomic_load_explicit(&active, memory_order_relaxed) || (timed && expired(block, now))) {
+            hand_off(block);
+        }
+    }
+
+    pthread_mutex_unlock(&block->lock);
+}
+
+void cp_batch_sync(void) {
+    BatchBlock* block = local_block;
+    if (!block) return;
+
+    pthread_mutex_lock(&block->lock);
+    hand_off(block);
+    pthread_mutex_unlock(&block->lock);
+}
+
+// ============================================================================
+// VACIADO
+// ============================================================================
+
+static void* flusher_main(void* unused) {
+    (void)unused;
+    pthread_mutex_lock(&flusher_lock);
+
+    while (!flusher_stop) {
+        unsigned interval = atomic_load(&interval_ms);
+        struct timespec deadline;
+        clock_gettime(CLOCK_REALTIME, &deadline);
+        deadline.tv_sec += interval / 1000;
+        deadline.tv_nsec += (long)(interval % 1000) * 1000000L;
+        if (deadline.tv_nsec >= 1000000000L) {
+            deadline.tv_sec++;
+            deadline.tv_nsec -= 1000000000L;
+        }
+        pthread_cond_timedwait(&flusher_wake, &flusher_lock, &deadline);
+        if (flusher_stop) break;
+
+        // Solo bloques libres: un dueño ocupado vacía el suyo al terminar la línea
+        bool wrote = false;
+        unsigned long long now = now_ns();
+        for (ThreadBlock* block = thread_block_first(&batch_blocks); block; block = block->next) {
+            BatchBlock* it = (BatchBlock*)block;
+            if (pthread_mutex_trylock(&it->lock) != 0) continue;
+            if (expired(it, now)) wrote |= hand_off(it);
+            pthread_mutex_unlock(&it->lock);
+        }
+        if (wrote) fflush(stdout);
+    }
+
+    pthread_mutex_unlock(&flusher_lock);
+    return NULL;
+}
+
+static void stop_flusher(void) {
+    pthread_mutex_lock(&flusher_lock);
+    bool running = flusher_running;
+    flusher_stop = true;
+    pthread_cond_signal(&flusher_wake);
+    pthread_mutex_unlock(&flusher_lock);
+
+    if (running) pthread_join(flusher, NULL);
+    flusher_running = false;
+}
+
+// ============================================================================
+// API PÚBLICA
+// ============================================================================
+
+bool c_print_batch_start(const CPrintBatchConfig* config) {
+    size_t size = config && config->buffer_size ? config->buffer_size
+                                                : CPRINT_BATCH_DEFAULT_BUFFER;
+    unsigned interval = config ? config->flush_interval_ms : 0;
+
+    stop_flusher();
+    atomic_store(&buffer_size, size);
+    atomic_store(&interval_ms, interval);
+
+    if (interval) {
+        flusher_stop = false;
+        if (pthread_create(&flusher, NULL, flusher_main, NULL) != 0) {
+            atomic_store(&active, false);
+            return false;
+        }
+        flusher_running = true;
+    }
+
+    pthread_once(&exit_once, register_flush_at_exit);
+    atomic_store(&active, true);
+    return true;
+}
+
+void c_print_batch_stop(void) {
+    atomic_store(&active, false);
+    stop_flusher();
+    c_print_batch_flush_all();
+}
+
+bool c_print_batch_active(void) {
+    return atomic_load(&active);
+}
+
+void c_print_batch_flush(void) {
+    cp_batch_sync();
+    fflush(stdout);
+}
+
+void c_print_batch_flush_all(void) {
+    for (ThreadBlock* block = thread_block_first(&batch_blocks); block; block = block->next) {
+        BatchBlock* it = (BatchBlock*)block;
+        pthread_mutex_lock(&it->lock);
+        hand_off(it);
+        pthread_mutex_unlock(&it->lock);
+    }
+    fflush(stdout);
+}
+
+#else // !CP_BATCH_ENABLED
+
+bool c_print_batch_start(const CPrintBatchConfig* config) {
+    (void)config;
+    return false;
+}
+
+void c_print_batch_stop(void) {
+}
+
+bool c_print_batch_active(void) {
+    return false;
+}
+
+void c_print_batch_flush(void) {
+    fflush(stdout);
+}
+
+void c_print_batch_flush_all(void) {
+    fflush(stdout);
+}
+
+bool cp_batch_begin_line(void) {
+    return false;
+}
+
+void cp_batch_write(const char* data, size_t len) {
+    (void)data;
+    (void)len;
+}
+
+void cp_batch_end_line(void) {
+}
+
+void cp_batch_sync(void) {
+}
+
+#endif // CP_BATCH_ENABLED
@@ -4,6 +4,11 @@
  */
 
 #include "c_print_builder.h"
+#include "c_print_alloc.h"
+#include "c_print_config.h"
+#include "c_print_stats.h"
+#include "c_print_latency.h"
+#include "c_print_batch.h"
 #include "ansi_codes.h"
 #include "color_parser.h"
 #include "number_formatter.h"
@@ -13,12 +18,17 @@
 #include <string.h>
 #include <stdbool.h>
 
+#ifndef _WIN32
+#include <pthread.h>
+#endif
+
 // ============================================================================
 // ESTRUCTURAS INTERNAS
 // ============================================================================
 
-#define INITIAL_BUFFER_SIZE 256
+#define INLINE_BUFFER_SIZE 160
 #define BUFFER_GROWTH_FACTOR 2
+#define POOL_MAX_RETAINED_CAPACITY (64 * 1024)
 
 typedef struct {
     TextColor text_color;
@@ -36,14 +46,33 @@ typedef struct {
     char fill_char;
 } FormatOptions;
 
+typedef struct {
+    size_t offset;          // Posición del slot dentro del buffer
+    int width;              // Ancho fijo reservado
+    FormatOptions opts;     // Formato capturado al reservar el slot
+} CPrintSlot;
+
 struct CPrintBuilder {
-    char* buffer;           // Buffer dinámico
+    char* buffer;           // Buffer activo (interno, del llamador o heap)
     size_t size;            // Tamaño actual del buffer
     size_t capacity;        // Capacidad del buffer
     FormatOptions pending;  // Opciones pendientes para el próximo elemento
     bool has_pending;       // Si hay opciones pendientes
+    bool owns_buffer;       // El buffer activo está en el heap
+    bool owns_builder;      // La estructura fue creada con cp_new()
+    const CPrintAllocator* allocator;  // Allocator para buffer y estructura
+    CPrintBuilder* pool_next;          // Enlace en el pool thread-local
+    CPrintSink stream_sink;            // Destino en modo streaming
+    size_t high_water;                 // Umbral de auto-flush (0 = desactivado)
+    CPrintSlot* slots;                 // Slots de plantilla reservados
+    int slot_count;
+    int slot_capacity;
+    char inline_buffer[INLINE_BUFFER_SIZE];  // Small-buffer optimization
 };
 
+_Static_assert(sizeof(struct CPrintBuilder) <= sizeof(CPrintBuilderStorage),
+               "CP_BUILDER_STORAGE_SIZE is too small for CPrintBuilder");
+
 // ============================================================================
 // FUNCIONES AUXILIARES INTERNAS
 // ============================================================================
@@ -69,28 +98,44 @@ static void init_format_options(FormatOptions* opts) {
 
 /**
  * @brief Asegura que el buffer tenga capacidad suficiente
+ * @return false si no se pudo obtener memoria
+ *
+ * Mientras el contenido cabe en el buffer interno o en el del llamador
+ * no se toca el heap; al desbordar se copia a un buffer dinámico.
  */
-static void ensure_capacity(CPrintBuilder* b, size_t needed) {
-    if (b->size + needed >= b->capacity) {
-        size_t new_capacity = (b->capacity + needed) * BUFFER_GROWTH_FACTOR;
-        char* new_buffer = realloc(b->buffer, new_capacity);
-        if (!new_buffer) {
-            fprintf(stderr, "[CPrintBuilder] Memory allocation failed\n");
-            return;
+static bool ensure_capacity(CPrintBuilder* b, size_t needed) {
+    if (b->size + needed < b->capacity) return true;
+    
+    size_t new_capacity = (b->capacity + needed) * BUFFER_GROWTH_FACTOR;
+    char* new_buffer;
+    
+    if (b->owns_buffer) {
+        new_buffer = cp_realloc(b->allocator, b->buffer, b->capacity, new_capacity);
+        CP_STAT_ADD(CP_STAT_BUILDER_REALLOCS, 1);
+    } else {
+        new_buffer = cp_alloc(b->allocator, new_capacity);
+        CP_STAT_ADD(CP_STAT_BUILDER_ALLOCS, 1);
+        if (new_buffer) {
+            memcpy(new_buffer, b->buffer, b->size + 1);
         }
-        b->buffer = new_buffer;
-        b->capacity = new_capacity;
     }
+    
+    if (!new_buffer) {
+        fprintf(stderr, "[CPrintBuilder] Memory allocation failed\n");
+        return false;
+    }
+    
+    b->buffer = new_buffer;
+    b->capacity = new_capacity;
+    b->owns_buffer = true;
+    return true;
 }
 
 /**
- * @brief Agrega texto al buffer
+ * @brief Agrega len bytes al buffer
  */
-static void append(CPrintBuilder* b, const char* text) {
-    if (!text) return;
-    
-    size_t len = strlen(text);
-    ensure_capacity(b, len + 1);
+static void append_n(CPrintBuilder* b, const char* text, size_t len) {
+    if (!ensure_capacity(b, len + 1)) return;
     
     memcpy(b->buffer + b->size, text, len);
     b->size += len;
@@ -98,11 +143,30 @@ static void append(CPrintBuilder* b, const char* text) {
 }
 
 /**
- * @brief Aplica formato y agrega valor al buffer
+ * @brief Agrega texto al buffer
  */
-static void append_formatted(CPrintBuilder* b, const char* value) {
-    if (!value) return;
-    
+static void append(CPrintBuilder* b, const char* text) {
+    if (!text) return;
+    append_n(b, text, strlen(text));
+}
+
+/**
+ * @brief Vuelca el contenido al sink si se superó el umbral de streaming
+ *
+ * Solo se llama entre elementos completos, así que nunca se corta una
+ * secuencia ANSI ni un valor alineado. Las opciones pendientes no se tocan.
+ */
+static void maybe_flush(CPrintBuilder* b) {
+    if (b->high_water > 0 && b->size >= b->high_water) {
+        cp_flush(b);
+    }
+}
+
+/**
+ * @brief Agrega la secuencia ANSI de las opciones pendientes
+ * @return true si se agregó alguna secuencia (hay que resetear después)
+ */
+static bool append_style_codes(CPrintBuilder* b) {
     // Aplicar colores/estilos si están configurados
     bool has_styling = (b->pending.text_color != COLOR_RESET ||
                         b->pending.bg_color != BG_RESET ||
@@ -138,99 +202,212 @@ static void append_formatted(CPrintBuilder* b, const char* value) {
         
         strcat(ansi_codes, "m");
         append(b, ansi_codes);
+        CP_STAT_ADD(CP_STAT_ESCAPE_BYTES, strlen(ansi_codes));
     }
     
+    return has_styling;
+}
+
+/**
+ * @brief Agrega la secuencia que resetea los estilos
+ */
+static void append_reset(CPrintBuilder* b) {
+    append_n(b, ANSI_RESET_SEQUENCE, ANSI_RESET_LENGTH);
+    CP_STAT_ADD(CP_STAT_ESCAPE_BYTES, ANSI_RESET_LENGTH);
+}
+
+/**
+ * @brief Agrega count copias del carácter de relleno
+ */
+static void append_fill(CPrintBuilder* b, char ch, size_t count) {
+    if (count == 0 || !ensure_capacity(b, count + 1)) return;
+    
+    memset(b->buffer + b->size, ch, count);
+    b->size += count;
+    b->buffer[b->size] = '\0';
+}
+
+/**
+ * @brief Agrega el valor con la alineación pendiente
+ */
+static void append_aligned(CPrintBuilder* b, const char* value, size_t len) {
+    size_t right;
+    size_t left = alignment_padding(b->pending.align, (size_t)b->pending.align_width,
+                                    len, &right);
+    
+    append_fill(b, b->pending.fill_char, left);
+    append_n(b, value, len);
+    append_fill(b, b->pending.fill_char, right);
+}
+
+/**
+ * @brief Aplica formato y agrega len bytes de valor al buffer
+ */
+static void append_formatted_n(CPrintBuilder* b, const char* value, size_t len) {
+    bool has_styling = append_style_codes(b);
+    
     // Aplicar alineación si está configurada
-    if (b->pending.align != ALIGN_NONE && b->pending.align_width > 0) {
-        int text_len = strlen(value);
-        
-        if (text_len < b->pending.align_width) {
-            int padding = b->pending.align_width - text_len;
-            
-            switch (b->pending.align) {
-                case ALIGN_LEFT:
-                    append(b, value);
-                    for (int i = 0; i < padding; i++) {
-                        char ch[2] = {b->pending.fill_char, '\0'};
-                        append(b, ch);
-                    }
-                    break;
-                    
-                case ALIGN_RIGHT:
-                    for (int i = 0; i < padding; i++) {
-                        char ch[2] = {b->pending.fill_char, '\0'};
-                        append(b, ch);
-                    }
-                    append(b, value);
-                    break;
-                    
-                case ALIGN_CENTER: {
-                    int left_pad = padding / 2;
-                    int right_pad = padding - left_pad;
-                    for (int i = 0; i < left_pad; i++) {
-                        char ch[2] = {b->pending.fill_char, '\0'};
-                        append(b, ch);
-                    }
-                    append(b, value);
-                    for (int i = 0; i < right_pad; i++) {
-                        char ch[2] = {b->pending.fill_char, '\0'};
-                        append(b, ch);
-                    }
-                    break;
-                }
-                    
-                default:
-                    append(b, value);
-                    break;
-            }
-        } else {
-            append(b, value);
-        }
+    if (b->pending.align != ALIGN_NONE && b->pending.align_width > 0 &&
+        len < (size_t)b->pending.align_width) {
+        CP_LAT_TIME(CPRINT_STAGE_ALIGN, append_aligned(b, value, len));
     } else {
-        append(b, value);
+        append_n(b, value, len);
     }
     
     // Resetear estilos si se aplicaron
     if (has_styling) {
-        append(b, "\033[0m");
+        append_reset(b);
     }
     
     // Limpiar opciones pendientes
     init_format_options(&b->pending);
     b->has_pending = false;
+    
+    maybe_flush(b);
+}
+
+/**
+ * @brief Aplica formato y agrega valor al buffer
+ */
+static void append_formatted(CPrintBuilder* b, const char* value) {
+    if (!value) return;
+    append_formatted_n(b, value, strlen(value));
+}
+
+// ============================================================================
+// FORMATEO DE VALORES
+// ============================================================================
+
+static void format_int_value(const FormatOptions* opts, char* buffer, size_t size, int value) {
+    if (opts->separator != '\0') {
+        format_with_separator(buffer, size, value, opts->separator);
+    } else if (opts->padding > 0) {
+        char fmt[32] = "%";
+        if (opts->show_sign) strcat(fmt, "+");
+        if (opts->zero_pad) strcat(fmt, "0");
+        char width_str[16];
+        snprintf(width_str, sizeof(width_str), "%d", opts->padding);
+        strcat(fmt, width_str);
+        strcat(fmt, "d");
+        snprintf(buffer, size, fmt, value);
+    } else {
+        snprintf(buffer, size, "%d", value);
+    }
+}
+
+static void format_uint_value(const FormatOptions* opts, char* buffer, size_t size,
+                              unsigned int value) {
+    if (opts->separator != '\0') {
+        format_with_separator(buffer, size, value, opts->separator);
+    } else {
+        snprintf(buffer, size, "%u", value);
+    }
+}
+
+static void format_long_value(const FormatOptions* opts, char* buffer, size_t size, long value) {
+    if (opts->separator != '\0') {
+        format_with_separator(buffer, size, value, opts->separator);
+    } else {
+        snprintf(buffer, size, "%ld", value);
+    }
+}
+
+static void format_float_value(const FormatOptions* opts, char* buffer, size_t size,
+                               double value) {
+    if (opts->as_percentage) {
+        value *= 100.0;
+        snprintf(buffer, size, "%.*f%%", opts->precision, value);
+    } else {
+        snprintf(buffer, size, "%.*f", opts->precision, value);
+    }
 }
 
 // ============================================================================
 // CREACIÓN Y DESTRUCCIÓN
 // ============================================================================
 
-CPrintBuilder* cp_new(void) {
-    CPrintBuilder* b = malloc(sizeof(CPrintBuilder));
+CPrintBuilder* cp_init(CPrintBuilder* b, char* storage, size_t n) {
     if (!b) return NULL;
     
-    b->buffer = malloc(INITIAL_BUFFER_SIZE);
-    if (!b->buffer) {
-        free(b);
-        return NULL;
+    if (storage && n > 0) {
+        b->buffer = storage;
+        b->capacity = n;
+    } else {
+        b->buffer = b->inline_buffer;
+        b->capacity = sizeof(b->inline_buffer);
     }
     
     b->size = 0;
-    b->capacity = INITIAL_BUFFER_SIZE;
     b->buffer[0] = '\0';
     b->has_pending = false;
+    b->owns_buffer = false;
+    b->owns_builder = false;
+    b->allocator = c_print_get_allocator();
+    b->pool_next = NULL;
+    b->stream_sink.write = NULL;
+    b->stream_sink.ctx = NULL;
+    b->high_water = 0;
+    b->slots = NULL;
+    b->slot_count = 0;
+    b->slot_capacity = 0;
     
     init_format_options(&b->pending);
     
     return b;
 }
 
+CPrintBuilder* cp_new_with_allocator(const CPrintAllocator* allocator) {
+    if (!allocator) allocator = c_print_get_allocator();
+    
+    CPrintBuilder* b = cp_alloc(allocator, sizeof(CPrintBuilder));
+    if (!b) return NULL;
+    
+    cp_init(b, NULL, 0);
+    b->allocator = allocator;
+    b->owns_builder = true;
+    
+    return b;
+}
+
+CPrintBuilder* cp_new(void) {
+    return cp_new_with_allocator(NULL);
+}
+
+CPrintBuilder* cp_set_allocator(CPrintBuilder* b, const CPrintAllocator* allocator) {
+    if (!b) return NULL;
+    
+    // Solo se puede cambiar mientras no haya memoria del allocator anterior
+    if (!b->owns_buffer && !b->owns_builder) {
+        b->allocator = allocator ? allocator : c_print_get_allocator();
+    }
+    return b;
+}
+
 void cp_free(CPrintBuilder* builder) {
     if (!builder) return;
     
-    if (builder->buffer) {
-        free(builder->buffer);
+    if (builder->slots) {
+        cp_dealloc(builder->allocator, builder->slots,
+                   builder->slot_capacity * sizeof(CPrintSlot));
+    }
+    
+    if (builder->owns_buffer) {
+        cp_dealloc(builder->allocator, builder->buffer, builder->capacity);
+    }
+    
+    if (builder->owns_builder) {
+        cp_dealloc(builder->allocator, builder, sizeof(CPrintBuilder));
+    } else {
+        // Builder del llamador: volver al buffer interno vacío
+        builder->buffer = builder->inline_buffer;
+        builder->capacity = sizeof(builder->inline_buffer);
+        builder->owns_buffer = false;
+        builder->size = 0;
+        builder->buffer[0] = '\0';
+        builder->slots = NULL;
+        builder->slot_count = 0;
+        builder->slot_capacity = 0;
     }
-    free(builder);
 }
 
 void cp_reset(CPrintBuilder* builder) {
@@ -239,9 +416,94 @@ void cp_reset(CPrintBuilder* builder) {
     builder->size = 0;
     builder->buffer[0] = '\0';
     builder->has_pending = false;
+    builder->slot_count = 0;
+    builder->stream_sink.write = NULL;
+    builder->stream_sink.ctx = NULL;
+    builder->high_water = 0;
     init_format_options(&builder->pending);
 }
 
+// ============================================================================
+// POOL THREAD-LOCAL
+// ============================================================================
+
+static CP_THREAD_LOCAL CPrintBuilder* pool_head = NULL;
+static CP_THREAD_LOCAL int pool_count = 0;
+
+#ifndef _WIN32
+// Al terminar el hilo su pool se vacía solo (igual que la caché de patrones)
+static CP_THREAD_LOCAL bool pool_registered;
+static pthread_key_t pool_key;
+static pthread_once_t pool_once = PTHREAD_ONCE_INIT;
+
+static void release_pool(void* ptr) {
+    (void)ptr;
+    cp_pool_drain();
+    // Si otro destructor vuelve a usar el pool, se registra de nuevo
+    pool_registered = false;
+}
+
+static void create_pool_key(void) {
+    pthread_key_create(&pool_key, release_pool);
+}
+
+static void register_pool(void) {
+    if (pool_registered) return;
+    pthread_once(&pool_once, create_pool_key);
+    pthread_setspecific(pool_key, &pool_head);
+    pool_registered = true;
+}
+#else
+static void register_pool(void) {}
+#endif
+
+CPrintBuilder* cp_pool_acquire(void) {
+    CPrintBuilder* b = pool_head;
+    
+    if (b) {
+        pool_head = b->pool_next;
+        pool_count--;
+        b->pool_next = NULL;
+        return b;
+    }
+    
+    // El pool siempre usa el heap: sus builders sobreviven a cualquier arena
+    return cp_new_with_allocator(cp_heap_allocator());
+}
+
+void cp_pool_release(CPrintBuilder* b) {
+    if (!b) return;
+    
+    if (pool_count >= CP_POOL_MAX_BUILDERS ||
+        !b->owns_builder || b->allocator != cp_heap_allocator()) {
+        cp_free(b);
+        return;
+    }
+    
+    // Conservar el buffer desbordado para reutilizarlo, salvo si es enorme
+    if (b->owns_buffer && b->capacity > POOL_MAX_RETAINED_CAPACITY) {
+        cp_dealloc(b->allocator, b->buffer, b->capacity);
+        b->buffer = b->inline_buffer;
+        b->capacity = sizeof(b->inline_buffer);
+        b->owns_buffer = false;
+    }
+    
+    register_pool();
+    cp_reset(b);
+    b->pool_next = pool_head;
+    pool_head = b;
+    pool_count++;
+}
+
+void cp_pool_drain(void) {
+    while (pool_head) {
+        CPrintBuilder* next = pool_head->pool_next;
+        cp_free(pool_head);
+        pool_head = next;
+    }
+    pool_count = 0;
+}
+
 // ============================================================================
 // CONFIGURACIÓN DE FORMATO
 // ============================================================================
@@ -377,6 +639,20 @@ CPrintBuilder* cp_fill_char(CPrintBuilder* b, char ch) {
 CPrintBuilder* cp_text(CPrintBuilder* b, const char* text) {
     if (!b || !text) return b;
     append(b, text);
+    maybe_flush(b);
+    return b;
+}
+
+CPrintBuilder* cp_text_n(CPrintBuilder* b, const char* text, size_t length) {
+    if (!b || (!text && length > 0)) return b;
+    append_n(b, text, length);
+    maybe_flush(b);
+    return b;
+}
+
+CPrintBuilder* cp_str_n(CPrintBuilder* b, const char* str, size_t length) {
+    if (!b || !str || length == 0) return b;
+    append_formatted_n(b, str, length);
     return b;
 }
 
@@ -396,22 +672,7 @@ CPrintBuilder* cp_int(CPrintBuilder* b, int value) {
     if (!b) return NULL;
     
     char buffer[256];
-    
-    if (b->pending.separator != '\0') {
-        format_with_separator(buffer, sizeof(buffer), value, b->pending.separator);
-    } else if (b->pending.padding > 0) {
-        char fmt[32] = "%";
-        if (b->pending.show_sign) strcat(fmt, "+");
-        if (b->pending.zero_pad) strcat(fmt, "0");
-        char width_str[16];
-        snprintf(width_str, sizeof(width_str), "%d", b->pending.padding);
-        strcat(fmt, width_str);
-        strcat(fmt, "d");
-        snprintf(buffer, sizeof(buffer), fmt, value);
-    } else {
-        snprintf(buffer, sizeof(buffer), "%d", value);
-    }
-    
+    CP_LAT_TIME(CPRINT_STAGE_FORMAT, format_int_value(&b->pending, buffer, sizeof(buffer), value));
     append_formatted(b, buffer);
     return b;
 }
@@ -420,13 +681,7 @@ CPrintBuilder* cp_uint(CPrintBuilder* b, unsigned int value) {
     if (!b) return NULL;
     
     char buffer[256];
-    
-    if (b->pending.separator != '\0') {
-        format_with_separator(buffer, sizeof(buffer), value, b->pending.separator);
-    } else {
-        snprintf(buffer, sizeof(buffer), "%u", value);
-    }
-    
+    CP_LAT_TIME(CPRINT_STAGE_FORMAT, format_uint_value(&b->pending, buffer, sizeof(buffer), value));
     append_formatted(b, buffer);
     return b;
 }
@@ -435,13 +690,7 @@ CPrintBuilder* cp_long(CPrintBuilder* b, long value) {
     if (!b) return NULL;
     
     char buffer[256];
-    
-    if (b->pending.separator != '\0') {
-        format_with_separator(buffer, sizeof(buffer), value, b->pending.separator);
-    } else {
-        snprintf(buffer, sizeof(buffer), "%ld", value);
-    }
-    
+    CP_LAT_TIME(CPRINT_STAGE_FORMAT, format_long_value(&b->pending, buffer, sizeof(buffer), value));
     append_formatted(b, buffer);
     return b;
 }
@@ -450,14 +699,7 @@ CPrintBuilder* cp_float(CPrintBuilder* b, double value) {
     if (!b) return NULL;
     
     char buffer[256];
-    
-    if (b->pending.as_percentage) {
-        value *= 100.0;
-        snprintf(buffer, sizeof(buffer), "%.*f%%", b->pending.precision, value);
-    } else {
-        snprintf(buffer, sizeof(buffer), "%.*f", b->pending.precision, value);
-    }
-    
+    CP_LAT_TIME(CPRINT_STAGE_FORMAT, format_float_value(&b->pending, buffer, sizeof(buffer), value));
     append_formatted(b, buffer);
     return b;
 }
@@ -480,7 +722,7 @@ CPrintBuilder* cp_binary(CPrintBuilder* b, unsigned int value) {
     if (!b) return NULL;
     
     char buffer[256];
-    format_binary(buffer, sizeof(buffer), value, b->pending.show_prefix);
+    CP_LAT_TIME(CPRINT_STAGE_FORMAT, format_binary(buffer, sizeof(buffer), value, b->pending.show_prefix));
     append_formatted(b, buffer);
     return b;
 }
@@ -489,8 +731,9 @@ CPrintBuilder* cp_hex(CPrintBuilder* b, unsigned int value) {
     if (!b) return NULL;
     
     char buffer[256];
-    format_hex(buffer, sizeof(buffer), value, 
-              b->pending.show_prefix, b->pending.padding, b->pending.zero_pad);
+    CP_LAT_TIME(CPRINT_STAGE_FORMAT,
+                format_hex(buffer, sizeof(buffer), value,
+                           b->pending.show_prefix, b->pending.padding, b->pending.zero_pad));
     append_formatted(b, buffer);
     return b;
 }
@@ -499,35 +742,248 @@ CPrintBuilder* cp_octal(CPrintBuilder* b, unsigned int value) {
     if (!b) return NULL;
     
     char buffer[256];
-    format_octal(buffer, sizeof(buffer), value, b->pending.show_prefix);
+    CP_LAT_TIME(CPRINT_STAGE_FORMAT, format_octal(buffer, sizeof(buffer), value, b->pending.show_prefix));
     append_formatted(b, buffer);
     return b;
 }
 
+// ============================================================================
+// PLANTILLAS CON SLOTS
+// ============================================================================
+
+/**
+ * @brief Escribe un valor dentro de un slot, alineado y sin cambiar su ancho
+ */
+static void patch_slot(CPrintBuilder* b, int slot, const char* value, bool truncate) {
+    CPrintSlot* s = &b->slots[slot];
+    char* dst = b->buffer + s->offset;
+    size_t width = (size_t)s->width;
+    size_t len = strlen(value);
+    
+    if (len > width) {
+        if (truncate) {
+            memcpy(dst, value, width);
+        } else {
+            // Un número recortado sería engañoso: marcar desbordamiento
+            memset(dst, '#', width);
+        }
+        return;
+    }
+    
+    size_t padding = width - len;
+    size_t left_pad;
+    
+    switch (s->opts.align) {
+        case ALIGN_LEFT:
+            left_pad = 0;
+            break;
+        case ALIGN_CENTER:
+            left_pad = padding / 2;
+            break;
+        default:
+            left_pad = truncate ? 0 : padding;  // Strings a la izquierda, números a la derecha
+            break;
+    }
+    
+    memset(dst, s->opts.fill_char, left_pad);
+    memcpy(dst + left_pad, value, len);
+    memset(dst + left_pad + len, s->opts.fill_char, padding - left_pad);
+}
+
+static bool valid_slot(const CPrintBuilder* b, int slot) {
+    return b && slot >= 0 && slot < b->slot_count;
+}
+
+int cp_slot(CPrintBuilder* b, int width) {
+    if (!b || width <= 0) return -1;
+    
+    // Los slots se parchean en el sitio: incompatibles con el streaming
+    if (b->high_water > 0) return -1;
+    
+    if (b->slot_count == b->slot_capacity) {
+        int new_capacity = b->slot_capacity ? b->slot_capacity * 2 : 4;
+        CPrintSlot* slots = cp_realloc(b->allocator, b->slots,
+                                       b->slot_capacity * sizeof(CPrintSlot),
+                                       new_capacity * sizeof(CPrintSlot));
+        if (!slots) return -1;
+        b->slots = slots;
+        b->slot_capacity = new_capacity;
+    }
+    
+    bool has_styling = append_style_codes(b);
+    
+    if (!ensure_capacity(b, (size_t)width + 1)) return -1;
+    
+    CPrintSlot* s = &b->slots[b->slot_count];
+    s->offset = b->size;
+    s->width = width;
+    s->opts = b->pending;
+    
+    memset(b->buffer + b->size, b->pending.fill_char, (size_t)width);
+    b->size += (size_t)width;
+    b->buffer[b->size] = '\0';
+    
+    if (has_styling) {
+        append_reset(b);
+    }
+    
+    init_format_options(&b->pending);
+    b->has_pending = false;
+    
+    return b->slot_count++;
+}
+
+void cp_slot_set_int(CPrintBuilder* b, int slot, int value) {
+    if (!valid_slot(b, slot)) return;
+    
+    char buffer[256];
+    format_int_value(&b->slots[slot].opts, buffer, sizeof(buffer), value);
+    patch_slot(b, slot, buffer, false);
+}
+
+void cp_slot_set_uint(CPrintBuilder* b, int slot, unsigned int value) {
+    if (!valid_slot(b, slot)) return;
+    
+    char buffer[256];
+    format_uint_value(&b->slots[slot].opts, buffer, sizeof(buffer), value);
+    patch_slot(b, slot, buffer, false);
+}
+
+void cp_slot_set_long(CPrintBuilder* b, int slot, long value) {
+    if (!valid_slot(b, slot)) return;
+    
+    char buffer[256];
+    format_long_value(&b->slots[slot].opts, buffer, sizeof(buffer), value);
+    patch_slot(b, slot, buffer, false);
+}
+
+void cp_slot_set_float(CPrintBuilder* b, int slot, double value) {
+    if (!valid_slot(b, slot)) return;
+    
+    char buffer[256];
+    format_float_value(&b->slots[slot].opts, buffer, sizeof(buffer), value);
+    patch_slot(b, slot, buffer, false);
+}
+
+void cp_slot_set_str(CPrintBuilder* b, int slot, const char* value) {
+    if (!valid_slot(b, slot)) return;
+    patch_slot(b, slot, value ? value : "", true);
+}
+
 // ============================================================================
 // IMPRESIÓN
 // ============================================================================
 
 void cp_print(CPrintBuilder* b) {
     if (!b || !b->buffer) return;
-    printf("%s", b->buffer);
+    CP_STAT_CALL(CPRINT_API_BUILDER);
+    CP_BATCH_SYNC();
+    CP_LAT_TIME(CPRINT_STAGE_WRITE, fwrite(b->buffer, 1, b->size, stdout));
+    CP_STAT_ADD(CP_STAT_BYTES, b->size);
 }
 
 void cp_println(CPrintBuilder* b) {
     if (!b || !b->buffer) return;
-    printf("%s\n", b->buffer);
+    CP_STAT_CALL(CPRINT_API_BUILDER);
+    CP_BATCH_SYNC();
+    CP_LAT_TIME(CPRINT_STAGE_WRITE,
+                CP_LOCK_FILE(stdout);       // Texto y salto de línea juntos
+                fwrite(b->buffer, 1, b->size, stdout);
+                putchar('\n');
+                CP_UNLOCK_FILE(stdout));
+    CP_STAT_ADD(CP_STAT_BYTES, b->size + 1);
 }
 
 char* cp_to_string(CPrintBuilder* b) {
     if (!b || !b->buffer) return NULL;
     
-    char* result = malloc(b->size + 1);
+    char* result = cp_alloc(b->allocator, b->size + 1);
     if (!result) return NULL;
     
     memcpy(result, b->buffer, b->size + 1);
     return result;
 }
 
+// ============================================================================
+// SALIDA SIN COPIAS
+// ============================================================================
+
+CPrintView cp_view(const CPrintBuilder* b) {
+    CPrintView view = {"", 0};
+    if (b && b->buffer) {
+        view.data = b->buffer;
+        view.length = b->size;
+    }
+    return view;
+}
+
+char* cp_detach(CPrintBuilder* b, size_t* length) {
+    if (length) *length = 0;
+    if (!b || !b->buffer) return NULL;
+    
+    char* result;
+    size_t size = b->size;
+    
+    if (b->owns_buffer) {
+        // Entregar el buffer del heap tal cual
+        result = b->buffer;
+        b->buffer = b->inline_buffer;
+        b->capacity = sizeof(b->inline_buffer);
+        b->owns_buffer = false;
+    } else {
+        result = cp_to_string(b);
+        if (!result) return NULL;
+    }
+    
+    if (length) *length = size;
+    cp_reset(b);
+    return result;
+}
+
+size_t cp_write(CPrintBuilder* b, const CPrintSink* sink) {
+    if (!b || !b->buffer) return 0;
+    CP_STAT_CALL(CPRINT_API_BUILDER);
+    size_t written;
+    CP_LAT_TIME(CPRINT_STAGE_WRITE, written = cp_sink_write(sink, b->buffer, b->size));
+    return written;
+}
+
+// ============================================================================
+// STREAMING
+// ============================================================================
+
+CPrintBuilder* cp_stream_to(CPrintBuilder* b, const CPrintSink* sink, size_t high_water) {
+    if (!b) return NULL;
+    
+    if (sink && sink->write && high_water > 0) {
+        // Un volcado dejaría los slots reservados apuntando a texto ya escrito
+        if (b->slot_count > 0) return NULL;
+        b->stream_sink = *sink;
+        b->high_water = high_water;
+    } else {
+        b->stream_sink.write = NULL;
+        b->stream_sink.ctx = NULL;
+        b->high_water = 0;
+    }
+    return b;
+}
+
+size_t cp_flush(CPrintBuilder* b) {
+    if (!b || !b->stream_sink.write || b->size == 0) return 0;
+    CP_STAT_CALL(CPRINT_API_BUILDER);
+    
+    size_t written;
+    CP_LAT_TIME(CPRINT_STAGE_WRITE,
+                written = cp_sink_write(&b->stream_sink, b->buffer, b->size));
+    
+    // Lo que el sink no aceptó queda al principio para el próximo volcado
+    if (written > b->size) written = b->size;
+    memmove(b->buffer, b->buffer + written, b->size - written);
+    b->size -= written;
+    b->buffer[b->size] = '\0';
+    return written;
+}
+
 // ============================================================================
 // UTILIDADES
 // ============================================================================
@@ -0,0 +1,100 @@
+/**
+ * @file c_print_freestanding.c
+ * @brief Implementación del renderizado sin stdio ni heap
+ *
+ * Solo se usa código propio de la biblioteca y funciones de string.h; el
+ * único efecto externo es la llamada al write del sink.
+ */
+
+#include "c_print_freestanding.h"
+#include "pattern_parser.h"
+#include "field_format.h"
+#include "output_buffer.h"
+#include "ansi_codes.h"
+#include <string.h>
+
+static void render_plain_field(OutputBuffer* out, const PatternStyle* style, va_list* args) {
+    FieldValue value;
+    value.u = 0;
+    if (is_known_format_type(style->format_type)) {
+        value = read_field_value(style->format_type, args);
+    }
+
+    char escape[ANSI_MAX_SEQUENCE];
+    size_t escape_length = 0;
+    if (style->has_color || style->has_bg || style->has_style) {
+        escape_length = format_ansi_codes(escape, sizeof(escape), style->text_color,
+                                          style->bg_color, style->style);
+    }
+    output_write(out, escape, escape_length);
+
+    if (style->format_type == 's') {
+        // El string se copia directo a la salida, con el mismo tope que c_print
+        const char* str = value.s ? value.s : "";
+        size_t len = strlen(str);
+        if (style->has_truncate && len > (size_t)style->truncate) len = (size_t)style->truncate;
+        if (len > FORMAT_VALUE_BUFFER - 1) len = FORMAT_VALUE_BUFFER - 1;
+        output_write_aligned(out, style, str, len);
+    } else {
+        char value_buffer[CPRINT_FREESTANDING_VALUE_BUFFER];
+        size_t len = format_field_value_plain(value_buffer, sizeof(value_buffer), style, value);
+        output_write_aligned(out, style, value_buffer, len);
+    }
+
+    if (escape_length) output_write(out, ANSI_RESET_SEQUENCE, ANSI_RESET_LENGTH);
+}
+
+size_t c_vprint_to(const CPrintSink* sink, char* buffer, size_t capacity,
+                   const char* pattern, va_list args) {
+    if (sink && (!sink->write || !buffer || capacity == 0)) return 0;
+    if (!buffer) capacity = 0;
+    if (capacity > 0) buffer[0] = '\0';
+    if (!pattern) return 0;
+
+    OutputBuffer out;
+    output_init(&out, buffer, capacity, sink);
+
+    va_list copy;
+    va_copy(copy, args);
+
+    // Mismas reglas que scan_pattern(), sin compilar el patrón
+    const char* p = pattern;
+    const char* run_start = pattern;
+
+    while (*p) {
+        if (*p == '{') {
+            PatternStyle style;
+            if (parse_pattern(p, &style)) {
+                output_write(&out, run_start, (size_t)(p - run_start));
+                render_plain_field(&out, &style, &copy);
+
+                while (*p && *p != '}') p++;
+                if (*p == '}') p++;
+                run_start = p;
+            } else {
+                p++;
+            }
+        } else if (*p == '\\' && *(p + 1) == '{') {
+            output_write(&out, run_start, (size_t)(p - run_start));
+            run_start = p + 1;
+            p += 2;
+        } else {
+            p++;
+        }
+    }
+    output_write(&out, run_start, (size_t)(p - run_start));
+
+    va_end(copy);
+
+    output_flush(&out);
+    return sink ? out.written : out.total;
+}
+
+size_t c_print_to(const CPrintSink* sink, char* buffer, size_t capacity,
+                  const char* pattern, ...) {
+    va_list args;
+    va_start(args, pattern);
+    size_t result = c_vprint_to(sink, buffer, capacity, pattern, args);
+    va_end(args);
+    return result;
+}
@@ -7,101 +7,116 @@
 
 #if __STDC_VERSION__ >= 201112L
 
-#include "pattern_parser.h"
-#include "ansi_codes.h"
-#include "number_formatter.h"
-#include "text_alignment.h"
+#include "pattern_compiler.h"
+#include "format_engine.h"
+#include "c_print_sampling.h"
+#include "c_print_stats.h"
+#include "c_print_probes.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <stdarg.h>
+#include <stdint.h>
+
+#define CHECKED_OUTPUT_BUFFER 1024
 
 // ============================================================================
-// EXTRACCIÓN DE ESPECIFICADORES DE FORMATO
+// FUENTE DE ARGUMENTOS
 // ============================================================================
 
 /**
- * @brief Extrae los especificadores de formato del patrón
+ * @brief Argumentos tipados leídos de un array o, uno a uno, de un va_list
+ *
+ * Los argumentos se consumen a medida que el patrón los pide: no hay
+ * copia previa ni límite en su número.
  */
-static int extract_format_specs(const char* pattern, char specs[], int max_specs) {
-    if (!pattern) return 0;
-    
-    int count = 0;
-    const char* p = pattern;
-    
-    while (*p && count < max_specs) {
-        if (*p == '{' && *(p + 1) != '\0') {
-            // Verificar que no sea escape \{
-            if (p == pattern || *(p - 1) != '\\') {
-                // Encontrar el tipo de formato (primer carácter después de {)
-                const char* start = p + 1;
-                while (*start == ' ') start++;  // Skip whitespace
-                
-                if (*start && *start != '}') {
-                    specs[count++] = *start;
-                }
-            }
-        }
-        p++;
-    }
-    
-    return count;
+typedef struct {
+    const CPrintArg* array;     // NULL = leer de list
+    va_list* list;
+    size_t count;
+    size_t next;
+} ArgSource;
+
+static ArgSource arg_source_array(const CPrintArg* args, size_t count) {
+    ArgSource src = { args, NULL, args ? count : 0, 0 };
+    return src;
+}
+
+static ArgSource arg_source_list(va_list* list, int argc) {
+    ArgSource src = { NULL, list, argc > 0 ? (size_t)argc : 0, 0 };
+    return src;
+}
+
+static bool next_arg(ArgSource* src, CPrintArg* arg) {
+    if (src->next >= src->count) return false;
+    *arg = src->array ? src->array[src->next] : va_arg(*src->list, CPrintArg);
+    src->next++;
+    return true;
 }
 
 // ============================================================================
 // VALIDACIÓN DE PATRONES
 // ============================================================================
 
-bool c_print_validate_pattern(const char* pattern, int argc, ...) {
-    if (!pattern) return false;
-    
-    // Extraer especificadores del patrón
-    char specs[C_PRINT_MAX_ARGS];
-    int expected_count = extract_format_specs(pattern, specs, C_PRINT_MAX_ARGS);
-    
+static bool validate_pattern(const char* pattern, ArgSource* src) {
+    const CompiledPattern* compiled = get_compiled_pattern(pattern);
+    if (!compiled) return false;
+
     // Verificar cantidad de argumentos
-    if (argc != expected_count) {
-        fprintf(stderr, "[C_PRINT ERROR] Argument count mismatch: expected %d, got %d\n",
-                expected_count, argc);
+    if (src->count != compiled->field_count) {
+        fprintf(stderr, "[C_PRINT ERROR] Argument count mismatch: expected %zu, got %zu\n",
+                compiled->field_count, src->count);
         return false;
     }
-    
+
     // Validar tipos
-    va_list args;
-    va_start(args, argc);
-    
     bool valid = true;
-    for (int i = 0; i < argc; i++) {
-        CPrintArg arg = va_arg(args, CPrintArg);
-        
-        if (!cprint_validate_arg_type(specs[i], arg.type)) {
-            fprintf(stderr, "[C_PRINT ERROR] Type mismatch at argument %d:\n", i);
-            fprintf(stderr, "  Pattern: {%c:...}\n", specs[i]);
-            fprintf(stderr, "  Expected: %s\n", cprint_expected_type_name(specs[i]));
+    CPrintArg arg;
+    for (size_t i = 0; next_arg(src, &arg); i++) {
+        char spec = compiled->field_types[i];
+
+        if (!cprint_validate_arg_type(spec, arg.type)) {
+            fprintf(stderr, "[C_PRINT ERROR] Type mismatch at argument %zu:\n", i);
+            fprintf(stderr, "  Pattern: {%c:...}\n", spec);
+            fprintf(stderr, "  Expected: %s\n", cprint_expected_type_name(spec));
             fprintf(stderr, "  Got: %s\n", cprint_type_name(arg.type));
             valid = false;
         }
     }
-    
+
+    return valid;
+}
+
+bool c_print_validate_pattern(const char* pattern, int argc, ...) {
+    if (!pattern) return false;
+
+    va_list args;
+    va_start(args, argc);
+    ArgSource src = arg_source_list(&args, argc);
+    bool valid = validate_pattern(pattern, &src);
     va_end(args);
+
     return valid;
 }
 
+bool c_print_validate_pattern_array(const char* pattern, const CPrintArg* args, size_t count) {
+    if (!pattern) return false;
+
+    ArgSource src = arg_source_array(args, count);
+    return validate_pattern(pattern, &src);
+}
+
 // ============================================================================
 // DEBUG DE TIPOS
 // ============================================================================
 
-void c_print_debug_types_impl(const char* pattern, int argc, ...) {
+static void debug_types(const char* pattern, ArgSource* src) {
     printf("[C_PRINT DEBUG] Pattern: %s\n", pattern);
-    printf("[C_PRINT DEBUG] Argument count: %d\n", argc);
-    
-    va_list args;
-    va_start(args, argc);
-    
-    for (int i = 0; i < argc; i++) {
-        CPrintArg arg = va_arg(args, CPrintArg);
-        
-        printf("[C_PRINT DEBUG] Arg %d: %s = ", i, cprint_type_name(arg.type));
+    printf("[C_PRINT DEBUG] Argument count: %zu\n", src->count);
+
+    CPrintArg arg;
+    for (size_t i = 0; next_arg(src, &arg); i++) {
+        printf("[C_PRINT DEBUG] Arg %zu: %s = ", i, cprint_type_name(arg.type));
         
         switch (arg.type) {
             case CPRINT_ARG_STRING:
@@ -136,195 +151,195 @@ void c_print_debug_types_impl(const char* pattern, int argc, ...) {
                 break;
         }
     }
-    
+}
+
+void c_print_debug_types_impl(const char* pattern, int argc, ...) {
+    va_list args;
+    va_start(args, argc);
+    ArgSource src = arg_source_list(&args, argc);
+    debug_types(pattern, &src);
     va_end(args);
 }
 
+void c_print_debug_types_array(const char* pattern, const CPrintArg* args, size_t count) {
+    ArgSource src = arg_source_array(args, count);
+    debug_types(pattern, &src);
+}
+
 // ============================================================================
 // WRAPPER PRINCIPAL CON VALIDACIÓN
 // ============================================================================
 
+static FieldValue to_field_value(const CPrintArg* arg) {
+    FieldValue fv;
+    fv.u = 0;
+
+    switch (arg->type) {
+        case CPRINT_ARG_STRING: fv.s = arg->value.s; break;
+        case CPRINT_ARG_INT: fv.i = arg->value.i; break;
+        case CPRINT_ARG_UINT: fv.u = arg->value.u; break;
+        case CPRINT_ARG_LONG: fv.i = arg->value.l; break;
+        case CPRINT_ARG_ULONG: fv.u = arg->value.ul; break;
+        case CPRINT_ARG_DOUBLE: fv.d = arg->value.d; break;
+        case CPRINT_ARG_CHAR: fv.i = arg->value.c; break;
+        case CPRINT_ARG_BOOL: fv.i = arg->value.b; break;
+        default: break;
+    }
+    return fv;
+}
+
+/**
+ * @brief Informa un desajuste al contador/callback (solo en modo muestreado)
+ *
+ * Fuera del modo muestreado el error ya queda visible en la salida.
+ */
+static void report_field_error(const char* pattern, size_t arg_index, const char* message) {
+    if (cp_sample_reporting()) cp_report_mismatch(pattern, arg_index, message);
+}
+
+/**
+ * @brief Renderiza un campo tomando (si hay) el siguiente argumento
+ * @param validate false = llamada no muestreada: no se informan desajustes
+ *
+ * La etiqueta de tipo se comprueba siempre (es lo que evita leer un int
+ * como puntero); el muestreo solo decide si el desajuste se informa.
+ */
+static void render_checked_field(OutputBuffer* out, const PatternSegment* seg,
+                                 const char* pattern, ArgSource* src, bool validate) {
+    char value_buffer[FORMAT_VALUE_BUFFER];
+    char format_type = seg->style.format_type;
+    size_t arg_index = src->next;
+    CPrintArg arg;
+
+    if (!seg->consumes_argument) {
+        snprintf(value_buffer, sizeof(value_buffer), "{? unknown format: %c}", format_type);
+        render_field_error(out, seg, value_buffer);
+        return;
+    }
+
+    if (!next_arg(src, &arg)) {
+        snprintf(value_buffer, sizeof(value_buffer),
+                 "{? missing argument for '%c'}", format_type);
+        if (validate) report_field_error(pattern, arg_index, value_buffer);
+        render_field_error(out, seg, value_buffer);
+        return;
+    }
+
+    if (!cprint_validate_arg_type(format_type, arg.type)) {
+        snprintf(value_buffer, sizeof(value_buffer), "{? expected %s, got %s}",
+                 cprint_expected_type_name(format_type), cprint_type_name(arg.type));
+        if (validate) report_field_error(pattern, arg_index, value_buffer);
+        render_field_error(out, seg, value_buffer);
+        return;
+    }
+
+    size_t len = format_field_value(value_buffer, sizeof(value_buffer),
+                                    &seg->style, to_field_value(&arg));
+    render_field(out, seg, value_buffer, len);
+}
+
+/**
+ * @brief Comprueba el número de argumentos (warning o informe muestreado)
+ */
+static void check_arg_count(const CompiledPattern* compiled, const char* pattern, size_t count) {
+    if (count == compiled->field_count) return;
+
+    if (cp_sample_reporting()) {
+        char message[64];
+        snprintf(message, sizeof(message), "{? expected %zu args, got %zu}",
+                 compiled->field_count, count);
+        cp_report_mismatch(pattern, SIZE_MAX, message);
+    } else {
+        fprintf(stderr, "[C_PRINT WARNING] Expected %zu args, got %zu\n",
+                compiled->field_count, count);
+    }
+}
+
+/**
+ * @brief Renderiza una llamada completa en out
+ */
+static void render_checked(OutputBuffer* out, const CompiledPattern* compiled,
+                           const char* pattern, ArgSource* src) {
+    // Validación muestreada: las llamadas no elegidas se saltan el conteo de
+    // argumentos y los informes, pero no la comprobación de etiquetas
+    bool validate = cp_sample_should_validate(pattern);
+    if (validate) check_arg_count(compiled, pattern, src->count);
+
+    for (size_t i = 0; i < compiled->segment_count; i++) {
+        const PatternSegment* seg = &compiled->segments[i];
+
+        if (seg->kind == SEGMENT_LITERAL) {
+            render_literal(out, seg);
+        } else {
+            render_checked_field(out, seg, pattern, src, validate);
+        }
+    }
+}
+
+static void print_checked(const char* pattern, ArgSource* src) {
+    CP_STAT_CALL(CPRINT_API_CHECKED);
+    const CompiledPattern* compiled = get_compiled_pattern(pattern);
+    if (!compiled) return;
+
+    char storage[CHECKED_OUTPUT_BUFFER];
+    LineStream stream;
+    OutputBuffer out;
+    line_stream_init(&stream, stdout);
+    output_init(&out, storage, sizeof(storage), &stream.sink);
+
+    CP_PROBE_FORMAT_START(pattern);
+    render_checked(&out, compiled, pattern, src);
+    line_stream_finish(&stream, &out);
+    CP_PROBE_FORMAT_END(pattern, out.total);
+}
+
 void c_print_checked_wrapper(const char* pattern, int argc, ...) {
     if (!pattern) return;
-    
-    // Extraer especificadores
-    char specs[C_PRINT_MAX_ARGS];
-    int expected_count = extract_format_specs(pattern, specs, C_PRINT_MAX_ARGS);
-    
-    // Validar cantidad de argumentos (warning si no coincide)
-    if (argc != expected_count) {
-        fprintf(stderr, "[C_PRINT WARNING] Expected %d args, got %d\n", 
-                expected_count, argc);
-    }
-    
-    // Obtener argumentos
+
     va_list args;
     va_start(args, argc);
-    
-    CPrintArg typed_args[C_PRINT_MAX_ARGS];
-    for (int i = 0; i < argc && i < C_PRINT_MAX_ARGS; i++) {
-        typed_args[i] = va_arg(args, CPrintArg);
-    }
+    ArgSource src = arg_source_list(&args, argc);
+    print_checked(pattern, &src);
     va_end(args);
-    
-    // Validar y procesar
-    const char* p = pattern;
-    int arg_index = 0;
-    
-    while (*p) {
-        if (*p == '{') {
-            PatternStyle style;
-            
-            if (parse_pattern(p, &style)) {
-                char value_buffer[1024];
-                value_buffer[0] = '\0';
-                bool error = false;
-                
-                // Verificar que no nos pasemos de argumentos
-                if (arg_index >= argc) {
-                    snprintf(value_buffer, sizeof(value_buffer), 
-                            "{? missing argument for '%c'}", style.format_type);
-                    error = true;
-                } else {
-                    CPrintArg arg = typed_args[arg_index];
-                    
-                    // Validar tipo
-                    if (!cprint_validate_arg_type(style.format_type, arg.type)) {
-                        snprintf(value_buffer, sizeof(value_buffer),
-                                "{? expected %s, got %s}",
-                                cprint_expected_type_name(style.format_type),
-                                cprint_type_name(arg.type));
-                        error = true;
-                    } else {
-                        // Formatear según el tipo
-                        switch (style.format_type) {
-                            case 's':
-                                if (arg.value.s) {
-                                    snprintf(value_buffer, sizeof(value_buffer), 
-                                            "%s", arg.value.s);
-                                }
-                                break;
-                                
-                            case 'd':
-                            case 'i':
-                                if (style.has_separator) {
-                                    format_with_separator(value_buffer, sizeof(value_buffer),
-                                                         arg.value.i, style.separator);
-                                } else if (style.padding > 0) {
-                                    char fmt[32] = "%";
-                                    if (style.show_sign) strcat(fmt, "+");
-                                    if (style.zero_pad) strcat(fmt, "0");
-                                    char width[16];
-                                    snprintf(width, sizeof(width), "%d", style.padding);
-                                    strcat(fmt, width);
-                                    strcat(fmt, "d");
-                                    snprintf(value_buffer, sizeof(value_buffer), fmt, arg.value.i);
-                                } else {
-                                    snprintf(value_buffer, sizeof(value_buffer), 
-                                            "%d", arg.value.i);
-                                }
-                                break;
-                                
-                            case 'f':
-                                if (style.as_percentage) {
-                                    double val = arg.value.d * 100.0;
-                                    snprintf(value_buffer, sizeof(value_buffer),
-                                            "%.*f%%", style.precision, val);
-                                } else if (style.has_precision) {
-                                    snprintf(value_buffer, sizeof(value_buffer),
-                                            "%.*f", style.precision, arg.value.d);
-                                } else {
-                                    snprintf(value_buffer, sizeof(value_buffer),
-                                            "%f", arg.value.d);
-                                }
-                                break;
-                                
-                            case 'c':
-                                snprintf(value_buffer, sizeof(value_buffer), 
-                                        "%c", arg.value.c);
-                                break;
-                                
-                            case 'b':
-                                format_binary(value_buffer, sizeof(value_buffer),
-                                             arg.value.u, style.show_prefix);
-                                break;
-                                
-                            case 'x':
-                                format_hex(value_buffer, sizeof(value_buffer), arg.value.u,
-                                          style.show_prefix, style.padding, style.zero_pad);
-                                break;
-                                
-                            case 'o':
-                                format_octal(value_buffer, sizeof(value_buffer),
-                                            arg.value.u, style.show_prefix);
-                                break;
-                                
-                            case 'u':
-                                if (style.has_separator) {
-                                    format_with_separator(value_buffer, sizeof(value_buffer),
-                                                         arg.value.u, style.separator);
-                                } else {
-                                    snprintf(value_buffer, sizeof(value_buffer),
-                                            "%u", arg.value.u);
-                                }
-                                break;
-                                
-                            case 'l':
-                                if (style.has_separator) {
-                                    format_with_separator(value_buffer, sizeof(value_buffer),
-                                                         arg.value.l, style.separator);
-                                } else {
-                                    snprintf(value_buffer, sizeof(value_buffer),
-                                            "%ld", arg.value.l);
-                                }
-                                break;
-                                
-                            default:
-                                snprintf(value_buffer, sizeof(value_buffer),
-                                        "{? unknown format: %c}", style.format_type);
-                                error = true;
-                                break;
-                        }
-                    }
-                    
-                    arg_index++;
-                }
-                
-                // Aplicar estilos
-                if (!error && (style.has_color || style.has_bg || style.has_style)) {
-                    apply_ansi_codes(style.text_color, style.bg_color, style.style);
-                } else if (error) {
-                    apply_ansi_codes(COLOR_RED, BG_RESET, STYLE_BOLD);
-                }
-                
-                // Imprimir
-                if (style.has_alignment) {
-                    print_aligned(value_buffer, style.align, style.width, style.fill_char);
-                } else {
-                    printf("%s", value_buffer);
-                }
-                
-                // Resetear estilos
-                if ((style.has_color || style.has_bg || style.has_style) || error) {
-                    reset_ansi_codes();
-                }
-                
-                // Avanzar
-                while (*p && *p != '}') p++;
-                if (*p == '}') p++;
-                
-            } else {
-                putchar(*p);
-                p++;
-            }
-        } else if (*p == '\\' && *(p + 1) == '{') {
-            putchar('{');
-            p += 2;
-        } else {
-            putchar(*p);
-            p++;
+}
+
+void c_print_checked_array(const char* pattern, const CPrintArg* args, size_t count) {
+    if (!pattern) return;
+
+    ArgSource src = arg_source_array(args, count);
+    print_checked(pattern, &src);
+}
+
+// ============================================================================
+// ENTRADA argv (FFI)
+// ============================================================================
+
+size_t c_print_argv(const char* pattern, const CPrintArg* args, size_t count,
+                    char* buffer, size_t size) {
+    return c_print_argv_batch(pattern, args, count, 1, buffer, size);
+}
+
+size_t c_print_argv_batch(const char* pattern, const CPrintArg* args,
+                          size_t fields_per_record, size_t records,
+                          char* buffer, size_t size) {
+    CP_STAT_CALL(CPRINT_API_ARGV);
+    CP_PROBE_FORMAT_START(pattern);
+    OutputBuffer out;
+    output_init(&out, buffer, buffer ? size : 0, NULL);
+
+    const CompiledPattern* compiled = pattern ? get_compiled_pattern(pattern) : NULL;
+
+    if (compiled) {
+        for (size_t r = 0; r < records; r++) {
+            const CPrintArg* record = args ? args + r * fields_per_record : NULL;
+            ArgSource src = arg_source_array(record, fields_per_record);
+            render_checked(&out, compiled, pattern, &src);
         }
     }
+
+    output_flush(&out);
+    CP_PROBE_FORMAT_END(pattern, out.total);
+    return out.total;
 }
 
 // ============================================================================
@@ -333,21 +348,18 @@ void c_print_checked_wrapper(const char* pattern, int argc, ...) {
 
 void c_print_checked(const char* pattern, ...) {
     if (!pattern) return;
-    
-    // Contar argumentos esperados
-    char specs[C_PRINT_MAX_ARGS];
-    int expected = extract_format_specs(pattern, specs, C_PRINT_MAX_ARGS);
+    CP_STAT_CALL(CPRINT_API_CHECKED);
     
     // Esta función es un placeholder - la validación real está en C_PRINT() macro
-    (void)expected;  // Suprimir warning
-    
     // Procesar con validación básica
     va_list args;
     va_start(args, pattern);
     
     // Llamar a la implementación original (sin validación estricta de tipos)
     // ya que no podemos acceder a CPrintArg desde va_list directo
-    vprintf(pattern, args);
+    int written = vprintf(pattern, args);
+    CP_STAT_ADD(CP_STAT_BYTES, written > 0 ? written : 0);
+    (void)written;
     
     va_end(args);
 }
@@ -0,0 +1,251 @@
+/**
+ * @file c_print_latency.c
+ * @brief Histogramas de latencia por hilo y etapa
+ *
+ * Cada hilo escribe en su propio bloque de histogramas (misma lista
+ * global que solo crece que usan las estadísticas): solo su dueño lo
+ * modifica, con carga y almacenamiento relajados. Las consultas suman
+ * los bloques y restan la base guardada por el último reset.
+ *
+ * Los ticks de rdtsc se convierten a ns al consultar, con la relación
+ * medida entre la primera muestra y el momento de la consulta.
+ */
+
+#include "c_print_latency.h"
+#include "c_print_config.h"
+#include <string.h>
+
+static const char* const stage_names[CPRINT_STAGE_COUNT] = {
+    [CPRINT_STAGE_PARSE] = "parse",
+    [CPRINT_STAGE_FORMAT] = "format",
+    [CPRINT_STAGE_ALIGN] = "align",
+    [CPRINT_STAGE_WRITE] = "write",
+};
+
+const char* c_print_latency_stage_name(CPrintStage stage) {
+    if ((unsigned)stage >= CPRINT_STAGE_COUNT) return "unknown";
+    return stage_names[stage];
+}
+
+#ifdef C_PRINT_LATENCY
+
+#include "thread_blocks.h"
+#include <stdatomic.h>
+#include <time.h>
+
+// ============================================================================
+// BUCKETS LOG-LINEALES
+// ============================================================================
+
+#define SUB_BITS 4
+#define SUB_BUCKETS (1u << SUB_BITS)
+#define MAX_MSB 47                  // Valores mayores se acumulan en el último bucket
+#define BUCKETS ((MAX_MSB - SUB_BITS + 1) * SUB_BUCKETS + SUB_BUCKETS)
+
+static unsigned highest_bit(unsigned long long value) {
+#if defined(__GNUC__) || defined(__clang__)
+    return 63u - (unsigned)__builtin_clzll(value);
+#else
+    unsigned bit = 0;
+    while (value >>= 1) bit++;
+    return bit;
+#endif
+}
+
+/**
+ * @brief Bucket de un valor: lineal hasta 16, luego 16 por potencia de dos
+ */
+static unsigned bucket_index(unsigned long long value) {
+    if (value < SUB_BUCKETS) return (unsigned)value;
+
+    unsigned msb = highest_bit(value);
+    if (msb > MAX_MSB) return BUCKETS - 1;
+
+    unsigned sub = (unsigned)(value >> (msb - SUB_BITS)) & (SUB_BUCKETS - 1);
+    return (msb - SUB_BITS + 1) * SUB_BUCKETS + sub;
+}
+
+/**
+ * @brief Mayor valor que cae en un bucket
+ */
+static unsigned long long bucket_upper(unsigned index) {
+    if (index < SUB_BUCKETS) return index;
+
+    unsigned group = index / SUB_BUCKETS;
+    unsigned sub = index % SUB_BUCKETS;
+    unsigned shift = group - 1;
+    return (((unsigned long long)(SUB_BUCKETS + sub + 1)) << shift) - 1;
+}
+
+// ============================================================================
+// BLOQUES POR HILO
+// ============================================================================
+
+typedef struct {
+    ThreadBlock header;
+    atomic_ullong counts[CPRINT_STAGE_COUNT][BUCKETS];
+} LatencyBlock;
+
+static unsigned long long reset_base[CPRINT_STAGE_COUNT][BUCKETS];
+static CP_THREAD_LOCAL LatencyBlock* local_block;
+
+// Calibración de ticks a ns: primera muestra registrada
+static atomic_bool calibrated;
+static unsigned long long calibration_ticks;
+static double calibration_ns;
+
+static double monotonic_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+static void calibrate_start(void) {
+    bool expected = false;
+    if (atomic_load_explicit(&calibrated, memory_order_relaxed) ||
+        !atomic_compare_exchange_strong(&calibrated, &expected, true)) {
+        return;
+    }
+    calibration_ns = monotonic_ns();
+    calibration_ticks = cp_latency_now();
+}
+
+/**
+ * @brief ns por tick (1.0 sin rdtsc)
+ */
+static double ns_per_tick(void) {
+#ifdef CP_LATENCY_TSC
+    if (!atomic_load(&calibrated)) return 1.0;
+
+    // Al menos 1 ms entre las dos marcas para una relación estable
+    double now_ns;
+    unsigned long long now_ticks;
+    do {
+        now_ns = monotonic_ns();
+        now_ticks = cp_latency_now();
+    } while (now_ns - calibration_ns < 1e6);
+
+    if (now_ticks <= calibration_ticks) return 1.0;
+    return (now_ns - calibration_ns) / (double)(now_ticks - calibration_ticks);
+#else
+    return 1.0;
+#endif
+}
+
+static void release_block(ThreadBlock* block) {
+    (void)block;
+    local_block = NULL;
+}
+
+static ThreadBlockList latency_blocks = THREAD_BLOCK_LIST_INIT(LatencyBlock, NULL, release_block);
+
+static LatencyBlock* acquire_block(void) {
+    LatencyBlock* block = (LatencyBlock*)thread_block_acquire(&latency_blocks);
+    if (block) calibrate_start();
+    local_block = block;
+    return block;
+}
+
+void cp_latency_record(CPrintStage stage, unsigned long long ticks) {
+    LatencyBlock* block = local_block;
+    if (!block && !(block = acquire_block())) return;
+
+    // Único escritor: basta con carga + almacenamiento relajados
+    atomic_ullong* counter = &block->counts[stage][bucket_index(ticks)];
+    atomic_store_explicit(counter,
+                          atomic_load_explicit(counter, memory_order_relaxed) + 1,
+                          memory_order_relaxed);
+}
+
+// ============================================================================
+// CONSULTAS
+// ============================================================================
+
+static void merge_stage(CPrintStage stage, unsigned long long counts[BUCKETS]) {
+    memset(counts, 0, sizeof(unsigned long long) * BUCKETS);
+
+    for (ThreadBlock* block = thread_block_first(&latency_blocks); block; block = block->next) {
+        LatencyBlock* it = (LatencyBlock*)block;
+        for (unsigned i = 0; i < BUCKETS; i++) {
+            counts[i] += atomic_load_explicit(&it->counts[stage][i], memory_order_relaxed);
+        }
+    }
+}
+
+static unsigned long long percentile_ticks(const unsigned long long counts[BUCKETS],
+                                           unsigned long long total, double fraction) {
+    unsigned long long rank = (unsigned long long)((double)total * fraction + 0.5);
+    if (rank < 1) rank = 1;
+    if (rank > total) rank = total;
+
+    unsigned long long seen = 0;
+    for (unsigned i = 0; i < BUCKETS; i++) {
+        seen += counts[i];
+        if (seen >= rank) return bucket_upper(i);
+    }
+    return bucket_upper(BUCKETS - 1);
+}
+
+static void summarize(CPrintStage stage, double scale, CPrintLatency* out) {
+    unsigned long long counts[BUCKETS];
+    merge_stage(stage, counts);
+
+    unsigned long long total = 0;
+    unsigned highest = 0;
+    for (unsigned i = 0; i < BUCKETS; i++) {
+        counts[i] = counts[i] > reset_base[stage][i] ? counts[i] - reset_base[stage][i] : 0;
+        total += counts[i];
+        if (counts[i]) highest = i;
+    }
+
+    memset(out, 0, sizeof(*out));
+    out->count = total;
+    if (total == 0) return;
+
+    out->p50_ns = (double)percentile_ticks(counts, total, 0.50) * scale;
+    out->p99_ns = (double)percentile_ticks(counts, total, 0.99) * scale;
+    out->p999_ns = (double)percentile_ticks(counts, total, 0.999) * scale;
+    out->max_ns = (double)bucket_upper(highest) * scale;
+}
+
+bool c_print_latency(CPrintStage stage, CPrintLatency* out) {
+    if (!out || (unsigned)stage >= CPRINT_STAGE_COUNT) return false;
+    summarize(stage, ns_per_tick(), out);
+    return true;
+}
+
+void c_print_latency_dump(FILE* fp) {
+    if (!fp) return;
+    double scale = ns_per_tick();
+
+    fprintf(fp, "%-8s %12s %12s %12s %12s %12s\n",
+            "stage", "count", "p50 ns", "p99 ns", "p999 ns", "max ns");
+    for (int s = 0; s < CPRINT_STAGE_COUNT; s++) {
+        CPrintLatency lat;
+        summarize((CPrintStage)s, scale, &lat);
+        fprintf(fp, "%-8s %12llu %12.0f %12.0f %12.0f %12.0f\n",
+                stage_names[s], lat.count, lat.p50_ns, lat.p99_ns, lat.p999_ns, lat.max_ns);
+    }
+}
+
+void c_print_latency_reset(void) {
+    for (int s = 0; s < CPRINT_STAGE_COUNT; s++) {
+        merge_stage((CPrintStage)s, reset_base[s]);
+    }
+}
+
+#else // !C_PRINT_LATENCY
+
+bool c_print_latency(CPrintStage stage, CPrintLatency* out) {
+    if (out) memset(out, 0, sizeof(*out));
+    return false;
+}
+
+void c_print_latency_dump(FILE* fp) {
+    if (fp) fprintf(fp, "c_print latency: built without C_PRINT_LATENCY\n");
+}
+
+void c_print_latency_reset(void) {
+}
+
+#endif // C_PRINT_LATENCY
@@ -0,0 +1,563 @@
+/**
+ * @file c_print_queue.c
+ * @brief Cola no bloqueante con buffer de desborde acotado
+ *
+ * El buffer guarda líneas enteras como [longitud][bytes], de la más
+ * vieja a la más nueva, entre start y end. Solo la primera puede estar
+ * a medio escribir (head_sent bytes ya salieron); esa nunca se descarta.
+ * Todo pasa con el mutex de la cola tomado, salvo la espera en poll()
+ * de la política BLOCK.
+ *
+ * Las líneas de c_print que no caben en su buffer de pila se juntan
+ * antes en un buffer por hilo, así a la cola siempre llega la línea
+ * completa.
+ */
+
+#include "c_print_queue.h"
+#include "c_print_config.h"
+#include "c_print_stats.h"
+#include "c_print_probes.h"
+
+#ifdef CP_QUEUE_ENABLED
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdatomic.h>
+#include <errno.h>
+#include <time.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#include <pthread.h>
+
+// Cada línea va precedida por su longitud
+typedef uint32_t RecordHeader;
+#define RECORD_HEADER sizeof(RecordHeader)
+
+// Línea de resumen de descartes
+#define REPORT_BUFFER 96
+
+struct CPrintQueue {
+    pthread_mutex_t lock;
+    int fd;
+    int saved_flags;                // Modo del descriptor antes de la cola
+    CPrintQueueConfig config;
+    char* data;
+    size_t start;                   // Primera línea pendiente
+    size_t end;                     // Fin de lo pendiente
+    size_t head_sent;               // Bytes ya escritos de la primera línea
+    bool head_started;              // La primera línea empezó a salir
+    CPrintQueueStats stats;         // pending_bytes se calcula al pedirlo
+    unsigned long long unreported_lines;
+    unsigned long long unreported_bytes;
+    unsigned long long last_report_ns;
+};
+
+static _Atomic(CPrintQueue*) attached;
+
+static unsigned long long now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (unsigned long long)ts.tv_sec * 1000000000ull + (unsigned long long)ts.tv_nsec;
+}
+
+// ============================================================================
+// BUFFER
+// ============================================================================
+
+static size_t record_length(const CPrintQueue* q, size_t offset) {
+    RecordHeader len;
+    memcpy(&len, q->data + offset, RECORD_HEADER);
+    return len;
+}
+
+static size_t room(const CPrintQueue* q) {
+    return q->config.capacity - (q->end - q->start);
+}
+
+/**
+ * @brief Agrega una línea al final (debe haber lugar)
+ */
+static void store(CPrintQueue* q, const char* data, size_t len) {
+    if (q->end + RECORD_HEADER + len > q->config.capacity) {
+        memmove(q->data, q->data + q->start, q->end - q->start);
+        q->end -= q->start;
+        q->start = 0;
+    }
+
+    RecordHeader header = (RecordHeader)len;
+    memcpy(q->data + q->end, &header, RECORD_HEADER);
+    memcpy(q->data + q->end + RECORD_HEADER, data, len);
+    q->end += RECORD_HEADER + len;
+}
+
+static void count_drop(CPrintQueue* q, size_t len) {
+    q->stats.dropped_lines++;
+    q->stats.dropped_bytes += len;
+    q->unreported_lines++;
+    q->unreported_bytes += len;
+    CP_STAT_ADD(CP_STAT_QUEUE_DROPS, 1);
+    CP_STAT_ADD(CP_STAT_QUEUE_DROPPED_BYTES, len);
+    CP_PROBE_QUEUE_DROP(len);
+}
+
+// ============================================================================
+// DESCRIPTOR
+// ============================================================================
+
+/**
+ * @brief write(2) sin esperar
+ * @return Bytes escritos, o -1 si el descriptor falló (no por EAGAIN)
+ */
+static long write_some(CPrintQueue* q, const char* data, size_t len) {
+    size_t written = 0;
+
+    while (written < len) {
+        ssize_t n = write(q->fd, data + written, len - written);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            if (errno == EAGAIN || errno == EWOULDBLOCK) break;
+            return -1;
+        }
+        if (n == 0) break;
+        written += (size_t)n;
+    }
+
+    q->stats.written_bytes += written;
+    CP_STAT_ADD(CP_STAT_BYTES, written);
+    CP_PROBE_SINK_WRITE(written);
+    return (long)written;
+}
+
+/**
+ * @brief Escribe lo pendiente que el descriptor acepte
+ * @return true si la cola quedó vacía
+ */
+static bool drain(CPrintQueue* q) {
+    while (q->start < q->end) {
+        size_t len = record_length(q, q->start);
+        const char* payload = q->data + q->start + RECORD_HEADER;
+        long n = write_some(q, payload + q->head_sent, len - q->head_sent);
+
+        if (n < 0) {
+            // Descriptor roto: lo pendiente ya no va a salir
+            for (size_t at = q->start; at < q->end; at += RECORD_HEADER + record_length(q, at)) {
+                count_drop(q, record_length(q, at));
+            }
+            break;
+        }
+
+        q->head_sent += (size_t)n;
+        if (q->head_sent < len) {
+            q->head_started = q->head_started || n > 0;
+            return false;
+        }
+
+        q->start += RECORD_HEADER + len;
+        q->head_sent = 0;
+        q->head_started = false;
+    }
+
+    q->start = q->end = 0;
+    q->head_sent = 0;
+    q->head_started = false;
+    return true;
+}
+
+/**
+ * @brief Espera hasta que el descriptor acepte más (soltando la cola)
+ * @param deadline 0 = sin límite
+ * @return false si venció el plazo
+ */
+static bool wait_writable(CPrintQueue* q, unsigned long long deadline) {
+    int wait_ms = -1;
+    if (deadline) {
+        unsigned long long now = now_ns();
+        if (now >= deadline) return false;
+        wait_ms = (int)((deadline - now + 999999ull) / 1000000ull);
+    }
+
+    struct pollfd pfd = { q->fd, POLLOUT, 0 };
+    pthread_mutex_unlock(&q->lock);
+    poll(&pfd, 1, wait_ms);
+    pthread_mutex_lock(&q->lock);
+    return true;
+}
+
+static unsigned long long deadline_after(unsigned timeout_ms) {
+    return timeout_ms ? now_ns() + (unsigned long long)timeout_ms * 1000000ull : 0;
+}
+
+// ============================================================================
+// POLÍTICAS
+// ============================================================================
+
+/**
+ * @brief Descarta las líneas más viejas que no empezaron a salir
+ */
+static bool evict_oldest(CPrintQueue* q, size_t need) {
+    size_t first = q->start;
+    if (q->head_started) first += RECORD_HEADER + record_length(q, first);
+
+    size_t cut = first;
+    while (room(q) + (cut - first) < need && cut < q->end) {
+        size_t len = record_length(q, cut);
+        count_drop(q, len);
+        cut += RECORD_HEADER + len;
+    }
+
+    memmove(q->data + first, q->data + cut, q->end - cut);
+    q->end -= cut - first;
+    return room(q) >= need;
+}
+
+static bool wait_for_room(CPrintQueue* q, size_t need) {
+    unsigned long long deadline = deadline_after(q->config.block_timeout_ms);
+
+    while (room(q) < need) {
+        if (!wait_writable(q, deadline)) return false;
+        drain(q);
+    }
+    return true;
+}
+
+/**
+ * @brief Escribe o encola una línea si hay lugar
+ */
+static bool enqueue(CPrintQueue* q, const char* data, size_t len) {
+    if (q->start == q->end) {
+        // Nada pendiente: directo al descriptor, sin copiar
+        long sent = write_some(q, data, len);
+        if (sent < 0) {
+            count_drop(q, len);
+            return false;
+        }
+        if ((size_t)sent == len) return true;
+
+        store(q, data + sent, len - (size_t)sent);
+        q->head_started = sent > 0;
+        return true;
+    }
+
+    if (room(q) < RECORD_HEADER + len) return false;
+    store(q, data, len);
+    return true;
+}
+
+static bool push_line(CPrintQueue* q, const char* data, size_t len) {
+    size_t need = RECORD_HEADER + len;
+    drain(q);
+
+    if (need > q->config.capacity || len > UINT32_MAX) {
+        CP_PROBE_QUEUE_FULL(len);
+        count_drop(q, len);
+        return false;
+    }
+
+    if (q->start != q->end && room(q) < need) {
+        CP_PROBE_QUEUE_FULL(len);
+
+        bool made_room = false;
+        switch (q->config.policy) {
+            case CPRINT_QUEUE_BLOCK:
+                made_room = wait_for_room(q, need);
+                break;
+            case CPRINT_QUEUE_DROP_OLDEST:
+                made_room = evict_oldest(q, need);
+                break;
+            case CPRINT_QUEUE_DROP_NEWEST:
+            default:
+                break;
+        }
+        if (!made_room) {
+            count_drop(q, len);
+            return false;
+        }
+    }
+
+    return enqueue(q, data, len);
+}
+
+/**
+ * @brief Agrega el resumen de descartes si venció el periodo
+ * @param now_due true para no esperar al periodo (flush)
+ */
+static void report_drops(CPrintQueue* q, bool now_due) {
+    if (!q->config.report_interval_ms || !q->unreported_lines) return;
+
+    unsigned long long now = now_ns();
+    unsigned long long period = (unsigned long long)q->config.report_interval_ms * 1000000ull;
+    if (!now_due && now - q->last_report_ns < period) return;
+
+    char line[REPORT_BUFFER];
+    int len = snprintf(line, sizeof(line), "c_print: dropped %llu lines (%llu bytes)\n",
+                       q->unreported_lines, q->unreported_bytes);
+    if (len <= 0 || (size_t)len >= sizeof(line)) return;
+
+    // Sin lugar: los contadores esperan al próximo intento
+    if (!enqueue(q, line, (size_t)len)) return;
+
+    q->stats.reports++;
+    q->unreported_lines = 0;
+    q->unreported_bytes = 0;
+    q->last_report_ns = now;
+}
+
+// ============================================================================
+// API PÚBLICA
+// ============================================================================
+
+CPrintQueue* c_print_queue_create(int fd, const CPrintQueueConfig* config) {
+    if (fd < 0) return NULL;
+
+    CPrintQueue* q = calloc(1, sizeof(CPrintQueue));
+    if (!q) return NULL;
+
+    if (config) q->config = *config;
+    if (q->config.capacity == 0) q->config.capacity = CPRINT_QUEUE_DEFAULT_CAPACITY;
+
+    q->data = malloc(q->config.capacity);
+    q->saved_flags = fcntl(fd, F_GETFL);
+    if (!q->data || q->saved_flags < 0 ||
+        fcntl(fd, F_SETFL, q->saved_flags | O_NONBLOCK) < 0) {
+        free(q->data);
+        free(q);
+        return NULL;
+    }
+
+    pthread_mutex_init(&q->lock, NULL);
+    q->fd = fd;
+    q->last_report_ns = now_ns();
+    return q;
+}
+
+void c_print_queue_destroy(CPrintQueue* q) {
+    if (!q) return;
+
+    CPrintQueue* expected = q;
+    atomic_compare_exchange_strong(&attached, &expected, NULL);
+
+    // Con BLOCK se espera como a cualquier línea; si no, solo lo inmediato
+    pthread_mutex_lock(&q->lock);
+    report_drops(q, true);
+    if (q->config.policy == CPRINT_QUEUE_BLOCK) {
+        unsigned long long deadline = deadline_after(q->config.block_timeout_ms);
+        while (!drain(q) && wait_writable(q, deadline)) { }
+    } else {
+        drain(q);
+    }
+    pthread_mutex_unlock(&q->lock);
+
+    fcntl(q->fd, F_SETFL, q->saved_flags);
+    pthread_mutex_destroy(&q->lock);
+    free(q->data);
+    free(q);
+}
+
+bool c_print_queue_write(CPrintQueue* q, const char* data, size_t len) {
+    if (!q || !data) return false;
+    if (len == 0) return true;
+
+    pthread_mutex_lock(&q->lock);
+    bool accepted = push_line(q, data, len);
+    report_drops(q, false);
+    pthread_mutex_unlock(&q->lock);
+    return accepted;
+}
+
+bool c_print_queue_flush(CPrintQueue* q, unsigned timeout_ms) {
+    if (!q) return false;
+
+    pthread_mutex_lock(&q->lock);
+    report_drops(q, true);
+
+    bool empty = drain(q);
+    if (timeout_ms) {
+        unsigned long long deadline = deadline_after(timeout_ms);
+        while (!empty && wait_writable(q, deadline)) empty = drain(q);
+    }
+
+    // El resumen pudo no caber antes de vaciar
+    report_drops(q, true);
+    empty = drain(q);
+    pthread_mutex_unlock(&q->lock);
+    return empty;
+}
+
+CPrintQueueStats c_print_queue_stats(CPrintQueue* q) {
+    CPrintQueueStats stats = {0};
+    if (!q) return stats;
+
+    pthread_mutex_lock(&q->lock);
+    stats = q->stats;
+    for (size_t at = q->start; at < q->end; at += RECORD_HEADER + record_length(q, at)) {
+        stats.pending_bytes += record_length(q, at);
+    }
+    stats.pending_bytes -= q->head_sent;
+    pthread_mutex_unlock(&q->lock);
+    return stats;
+}
+
+static size_t queue_sink_write(void* ctx, const char* data, size_t len) {
+    // Una línea descartada no es un error del sink: queda en los contadores
+    c_print_queue_write((CPrintQueue*)ctx, data, len);
+    return len;
+}
+
+CPrintSink cp_sink_queue(CPrintQueue* q) {
+    CPrintSink sink = {queue_sink_write, q};
+    return sink;
+}
+
+void c_print_queue_attach(CPrintQueue* q) {
+    atomic_store(&attached, q);
+}
+
+// ============================================================================
+// LÍNEAS DE c_print
+// ============================================================================
+
+// Línea en curso del hilo cuando no cabe en el buffer de pila
+static CP_THREAD_LOCAL CPrintQueue* line_queue;
+static CP_THREAD_LOCAL char* line_data;
+static CP_THREAD_LOCAL size_t line_length;
+static CP_THREAD_LOCAL size_t line_capacity;
+static CP_THREAD_LOCAL bool line_too_long;
+
+static pthread_key_t line_key;
+static pthread_once_t line_once = PTHREAD_ONCE_INIT;
+
+static void release_line(void* ptr) {
+    free(ptr);
+    line_data = NULL;
+    line_capacity = 0;
+}
+
+static void create_line_key(void) {
+    pthread_key_create(&line_key, release_line);
+}
+
+static bool grow_line(size_t needed) {
+    if (needed <= line_capacity) return true;
+
+    size_t capacity = line_capacity ? line_capacity : 2 * 1024;
+    while (capacity < needed) capacity *= 2;
+
+    char* data = realloc(line_data, capacity);
+    if (!data) return false;
+
+    pthread_once(&line_once, create_line_key);
+    pthread_setspecific(line_key, data);
+    line_data = data;
+    line_capacity = capacity;
+    return true;
+}
+
+bool cp_queue_begin_line(void) {
+    CPrintQueue* q = atomic_load_explicit(&attached, memory_order_acquire);
+    if (!q) return false;
+
+    line_queue = q;
+    line_length = 0;
+    line_too_long = false;
+    return true;
+}
+
+void cp_queue_write_part(const char* data, size_t len) {
+    size_t needed = line_length + len;
+
+    // Más grande que la cola: se descartará entera, solo se cuenta
+    if (!line_too_long &&
+        (RECORD_HEADER + needed > line_queue->config.capacity || !grow_line(needed))) {
+        line_too_long = true;
+    }
+    if (!line_too_long) memcpy(line_data + line_length, data, len);
+    line_length = needed;
+}
+
+void cp_queue_end_line(const char* data, size_t len) {
+    CPrintQueue* q = line_queue;
+
+    if (line_length == 0) {
+        line_queue = NULL;
+        c_print_queue_write(q, data, len);
+        return;
+    }
+
+    cp_queue_write_part(data, len);
+    line_queue = NULL;
+    if (line_too_long) {
+        pthread_mutex_lock(&q->lock);
+        CP_PROBE_QUEUE_FULL(line_length);
+        count_drop(q, line_length);
+        report_drops(q, false);
+        pthread_mutex_unlock(&q->lock);
+    } else {
+        c_print_queue_write(q, line_data, line_length);
+    }
+    line_length = 0;
+}
+
+#else // !CP_QUEUE_ENABLED
+
+CPrintQueue* c_print_queue_create(int fd, const CPrintQueueConfig* config) {
+    (void)fd;
+    (void)config;
+    return NULL;
+}
+
+void c_print_queue_destroy(CPrintQueue* q) {
+    (void)q;
+}
+
+bool c_print_queue_write(CPrintQueue* q, const char* data, size_t len) {
+    (void)q;
+    (void)data;
+    (void)len;
+    return false;
+}
+
+bool c_print_queue_flush(CPrintQueue* q, unsigned timeout_ms) {
+    (void)q;
+    (void)timeout_ms;
+    return false;
+}
+
+CPrintQueueStats c_print_queue_stats(CPrintQueue* q) {
+    CPrintQueueStats stats = {0};
+    (void)q;
+    return stats;
+}
+
+static size_t queue_sink_write(void* ctx, const char* data, size_t len) {
+    (void)ctx;
+    (void)data;
+    (void)len;
+    return 0;
+}
+
+CPrintSink cp_sink_queue(CPrintQueue* q) {
+    CPrintSink sink = {queue_sink_write, q};
+    return sink;
+}
+
+void c_print_queue_attach(CPrintQueue* q) {
+    (void)q;
+}
+
+bool cp_queue_begin_line(void) {
+    return false;
+}
+
+void cp_queue_write_part(const char* data, size_t len) {
+    (void)data;
+    (void)len;
+}
+
+void cp_queue_end_line(const char* data, size_t len) {
+    (void)data;
+    (void)len;
+}
+
+#endif // CP_QUEUE_ENABLED
@@ -6,22 +6,25 @@
  * - Punteros NULL inesperados
  * - Valores sospechosos (punteros en rangos bajos)
  * - Conteo de patrones vs argumentos
+ *
+ * El patrón se analiza una sola vez (caché de patrones compilados), así
+ * que cada llamada solo paga las comprobaciones de los valores.
  */
 
-#include "c_print.h"
-#include "pattern_parser.h"
-#include "ansi_codes.h"
-#include "number_formatter.h"
-#include "text_alignment.h"
+#include "c_print_safe.h"
+#include "pattern_compiler.h"
+#include "format_engine.h"
+#include "string_utils.h"
+#include "c_print_sampling.h"
+#include "c_print_stats.h"
+#include "c_print_probes.h"
 #include <stdlib.h>
 #include <string.h>
 #include <stdarg.h>
 #include <stdbool.h>
 #include <stdint.h>
 
-// Macro para detectar si un puntero parece válido
-#define IS_LIKELY_POINTER(ptr) ((uintptr_t)(ptr) > 0x1000)
-#define IS_LIKELY_STRING(ptr) (IS_LIKELY_POINTER(ptr) && ((char*)(ptr))[0] != '\0')
+#define SAFE_OUTPUT_BUFFER 1024
 
 // Modo debug (compilar con -DDEBUG_C_PRINT)
 #ifdef DEBUG_C_PRINT
@@ -30,26 +33,36 @@
     #define DEBUG_LOG(fmt, ...) ((void)0)
 #endif
 
-/**
- * @brief Cuenta cuántos patrones {} hay en el string
- */
-static int count_patterns(const char* pattern) {
-    int count = 0;
-    const char* p = pattern;
-    
-    while (*p) {
-        if (*p == '{' && *(p + 1) != '\0') {
-            // Verificar que no sea escape \{
-            if (p == pattern || *(p - 1) != '\\') {
-                count++;
-            }
+// ============================================================================
+// MODO SEGURO / RÁPIDO
+// ============================================================================
+
+// -1 = sin configurar (se lee C_PRINT_SAFE en el primer uso)
+static int safe_mode = -1;
+
+void c_print_safe_set_enabled(bool enabled) {
+    safe_mode = enabled ? 1 : 0;
+}
+
+bool c_print_safe_enabled(void) {
+    if (safe_mode < 0) {
+        const char* env = getenv("C_PRINT_SAFE");
+        char value[8] = "";
+        if (env) {
+            strncpy(value, env, sizeof(value) - 1);
+            to_lowercase(value);
         }
-        p++;
+        bool disabled = strcmp(value, "0") == 0 || strcmp(value, "off") == 0 ||
+                        strcmp(value, "fast") == 0 || strcmp(value, "false") == 0;
+        safe_mode = disabled ? 0 : 1;
     }
-    
-    return count;
+    return safe_mode == 1;
 }
 
+// ============================================================================
+// VALIDACIONES
+// ============================================================================
+
 /**
  * @brief Valida si un puntero parece ser un string válido
  */
@@ -62,7 +75,7 @@ static bool validate_string_pointer(const void* ptr, const char* pattern_info) {
     // Verificar que el puntero esté en un rango razonable
     uintptr_t addr = (uintptr_t)ptr;
     if (addr < 0x1000) {  // Valores muy bajos probablemente son ints interpretados como punteros
-        DEBUG_LOG("Suspicious pointer value 0x%lx for pattern: %s", addr, pattern_info);
+        DEBUG_LOG("Suspicious pointer value 0x%lx for pattern: %s", (unsigned long)addr, pattern_info);
         return false;
     }
     
@@ -70,13 +83,117 @@ static bool validate_string_pointer(const void* ptr, const char* pattern_info) {
 }
 
 /**
- * @brief Imprime un valor "seguro" cuando hay error de tipo
+ * @brief Lee el argumento de un campo y lo valida
+ * @return NULL si es válido; si no, el mensaje de error en error_buffer
  */
-static void print_error_value(const char* expected_type, uintptr_t raw_value) {
-    printf("{?:");
-    printf("%s", expected_type);
-    printf(":error=0x%lx", raw_value);
-    printf("}");
+static const char* read_safe_value(char format_type, va_list* args, FieldValue* value,
+                                   char* error_buffer, size_t error_size) {
+    value->u = 0;
+
+    switch (format_type) {
+        case 's': {
+            // Obtener el valor crudo primero
+            void* raw_ptr = va_arg(*args, void*);
+
+            if (validate_string_pointer(raw_ptr, "string")) {
+                value->s = (const char*)raw_ptr;
+                return NULL;
+            }
+
+            // Intentar interpretar como número
+            uintptr_t num_value = (uintptr_t)raw_ptr;
+            if (num_value < 10000) {
+                // Probablemente pasaron un int en lugar de string
+                snprintf(error_buffer, error_size,
+                         "{? expected string, got int=%lu}", (unsigned long)num_value);
+            } else {
+                snprintf(error_buffer, error_size,
+                         "{? invalid pointer: 0x%lx}", (unsigned long)num_value);
+            }
+            return error_buffer;
+        }
+
+        case 'c': {
+            int ch_val = va_arg(*args, int);
+            // Validar rango de char
+            if (ch_val < 0 || ch_val > 127) {
+                snprintf(error_buffer, error_size, "{? invalid char: %d}", ch_val);
+                return error_buffer;
+            }
+            value->i = ch_val;
+            return NULL;
+        }
+
+        case 'd':
+        case 'i':
+            value->i = va_arg(*args, int);
+            return NULL;
+
+        case 'f':
+            value->d = va_arg(*args, double);
+            return NULL;
+
+        case 'l':
+            value->i = va_arg(*args, long);
+            return NULL;
+
+        default:
+            value->u = va_arg(*args, unsigned int);
+            return NULL;
+    }
+}
+
+// ============================================================================
+// RENDERIZADO
+// ============================================================================
+
+static size_t render_safe(const CompiledPattern* compiled, const char* pattern,
+                        va_list* args, bool checked) {
+    char storage[SAFE_OUTPUT_BUFFER];
+    LineStream stream;
+    OutputBuffer out;
+    line_stream_init(&stream, stdout);
+    output_init(&out, storage, sizeof(storage), &stream.sink);
+
+    size_t arg_index = 0;
+
+    for (size_t i = 0; i < compiled->segment_count; i++) {
+        const PatternSegment* seg = &compiled->segments[i];
+        char value_buffer[FORMAT_VALUE_BUFFER];
+        char format_type = seg->style.format_type;
+        FieldValue value;
+
+        if (seg->kind == SEGMENT_LITERAL) {
+            render_literal(&out, seg);
+            continue;
+        }
+
+        if (!seg->consumes_argument) {
+            snprintf(value_buffer, sizeof(value_buffer), "{? unknown format: %c}", format_type);
+            render_field_error(&out, seg, value_buffer);
+            continue;
+        }
+
+        if (checked) {
+            const char* error = read_safe_value(format_type, args, &value,
+                                                value_buffer, sizeof(value_buffer));
+            if (error) {
+                if (cp_sample_reporting()) cp_report_mismatch(pattern, arg_index, error);
+                render_field_error(&out, seg, error);
+                arg_index++;
+                continue;
+            }
+        } else {
+            value = read_field_value(format_type, args);
+        }
+        arg_index++;
+
+        size_t len = format_field_value(value_buffer, sizeof(value_buffer), &seg->style, value);
+        render_field(&out, seg, value_buffer, len);
+    }
+
+    line_stream_finish(&stream, &out);
+    return out.total;
 }
 
 /**
@@ -87,203 +204,20 @@ void c_print_safe(const char* pattern, ...) {
         fprintf(stderr, "[c_print ERROR] NULL pattern\n");
         return;
     }
+    CP_STAT_CALL(CPRINT_API_SAFE);
     
-    // Contar patrones para validación básica
-    int expected_args = count_patterns(pattern);
-    DEBUG_LOG("Pattern has %d placeholders", expected_args);
+    // Análisis memoizado: conteo y tipos se calculan una vez por patrón
+    const CompiledPattern* compiled = get_compiled_pattern(pattern);
+    if (!compiled) return;
+    DEBUG_LOG("Pattern has %zu placeholders", compiled->field_count);
     
     va_list args;
     va_start(args, pattern);
-    
-    const char* p = pattern;
-    int arg_index = 0;
-    
-    while (*p) {
-        if (*p == '{') {
-            PatternStyle style;
-            
-            if (parse_pattern(p, &style)) {
-                char value_buffer[1024];
-                value_buffer[0] = '\0';
-                bool error = false;
-                
-                arg_index++;
-                
-                switch (style.format_type) {
-                    case 's': {
-                        // Obtener el valor crudo primero
-                        void* raw_ptr = va_arg(args, void*);
-                        
-                        // Validar que parece un puntero válido
-                        if (!validate_string_pointer(raw_ptr, "string")) {
-                            // Intentar interpretar como número
-                            uintptr_t num_value = (uintptr_t)raw_ptr;
-                            if (num_value < 10000) {
-                                // Probablemente pasaron un int en lugar de string
-                                snprintf(value_buffer, sizeof(value_buffer), 
-                                        "{? expected string, got int=%lu}", num_value);
-                                error = true;
-                            } else {
-                                snprintf(value_buffer, sizeof(value_buffer), 
-                                        "{? invalid pointer: 0x%lx}", num_value);
-                                error = true;
-                            }
-                        } else {
-                            char* str = (char*)raw_ptr;
-                            if (style.has_truncate && strlen(str) > (size_t)style.truncate) {
-                                snprintf(value_buffer, sizeof(value_buffer), 
-                                        "%.*s", style.truncate, str);
-                            } else {
-                                snprintf(value_buffer, sizeof(value_buffer), "%s", str);
-                            }
-                        }
-                        break;
-                    }
-                    
-                    case 'd':
-                    case 'i': {
-                        int num = va_arg(args, int);
-                        
-                        if (style.has_separator) {
-                            format_with_separator(value_buffer, sizeof(value_buffer), 
-                                                 num, style.separator);
-                        } else if (style.padding > 0 || style.show_sign) {
-                            char fmt[20] = "%";
-                            if (style.show_sign == 1) strcat(fmt, "+");
-                            else if (style.show_sign == 2) strcat(fmt, " ");
-                            if (style.zero_pad) strcat(fmt, "0");
-                            if (style.padding > 0) {
-                                char width[10];
-                                snprintf(width, sizeof(width), "%d", style.padding);
-                                strcat(fmt, width);
-                            }
-                            strcat(fmt, "d");
-                            snprintf(value_buffer, sizeof(value_buffer), fmt, num);
-                        } else {
-                            snprintf(value_buffer, sizeof(value_buffer), "%d", num);
-                        }
-                        break;
-                    }
-                    
-                    case 'f': {
-                        double num = va_arg(args, double);
-                        
-                        if (style.as_percentage) {
-                            num *= 100.0;
-                            if (style.has_precision) {
-                                snprintf(value_buffer, sizeof(value_buffer), 
-                                        "%.*f%%", style.precision, num);
-                            } else {
-                                snprintf(value_buffer, sizeof(value_buffer), "%.1f%%", num);
-                            }
-                        } else if (style.has_precision) {
-                            snprintf(value_buffer, sizeof(value_buffer), 
-                                    "%.*f", style.precision, num);
-                        } else {
-                            snprintf(value_buffer, sizeof(value_buffer), "%f", num);
-                        }
-                        break;
-                    }
-                    
-                    case 'c': {
-                        int ch_val = va_arg(args, int);
-                        // Validar rango de char
-                        if (ch_val < 0 || ch_val > 127) {
-                            snprintf(value_buffer, sizeof(value_buffer), 
-                                    "{? invalid char: %d}", ch_val);
-                            error = true;
-                        } else {
-                            snprintf(value_buffer, sizeof(value_buffer), "%c", (char)ch_val);
-                        }
-                        break;
-                    }
-                    
-                    case 'b': {
-                        unsigned int num = va_arg(args, unsigned int);
-                        format_binary(value_buffer, sizeof(value_buffer), 
-                                     num, style.show_prefix);
-                        break;
-                    }
-                    
-                    case 'x': {
-                        unsigned int num = va_arg(args, unsigned int);
-                        format_hex(value_buffer, sizeof(value_buffer), num, 
-                                  style.show_prefix, style.padding, style.zero_pad);
-                        break;
-                    }
-                    
-                    case 'o': {
-                        unsigned int num = va_arg(args, unsigned int);
-                        format_octal(value_buffer, sizeof(value_buffer), 
-                                    num, style.show_prefix);
-                        break;
-                    }
-                    
-                    case 'u': {
-                        unsigned int num = va_arg(args, unsigned int);
-                        if (style.has_separator) {
-                            format_with_separator(value_buffer, sizeof(value_buffer), 
-                                                 num, style.separator);
-                        } else {
-                            snprintf(value_buffer, sizeof(value_buffer), "%u", num);
-                        }
-                        break;
-                    }
-                    
-                    case 'l': {
-                        long num = va_arg(args, long);
-                        if (style.has_separator) {
-                            format_with_separator(value_buffer, sizeof(value_buffer), 
-                                                 num, style.separator);
-                        } else {
-                            snprintf(value_buffer, sizeof(value_buffer), "%ld", num);
-                        }
-                        break;
-                    }
-                    
-                    default:
-                        snprintf(value_buffer, sizeof(value_buffer), 
-                                "{? unknown format: %c}", style.format_type);
-                        error = true;
-                        break;
-                }
-                
-                // Aplicar estilos solo si no hubo error
-                if (!error && (style.has_color || style.has_bg || style.has_style)) {
-                    apply_ansi_codes(style.text_color, style.bg_color, style.style);
-                } else if (error) {
-                    // Mostrar errores en rojo
-                    apply_ansi_codes(COLOR_RED, BG_RESET, STYLE_BOLD);
-                }
-                
-                // Imprimir con o sin alineación
-                if (style.has_alignment) {
-                    print_aligned(value_buffer, style.align, style.width, style.fill_char);
-                } else {
-                    printf("%s", value_buffer);
-                }
-                
-                // Resetear estilos
-                if ((style.has_color || style.has_bg || style.has_style) || error) {
-                    reset_ansi_codes();
-                }
-                
-                // Avanzar hasta después del }
-                while (*p && *p != '}') p++;
-                if (*p == '}') p++;
-                
-            } else {
-                putchar(*p);
-                p++;
-            }
-        } else if (*p == '\\' && *(p + 1) == '{') {
-            putchar('{');
-            p += 2;
-        } else {
-            putchar(*p);
-            p++;
-        }
-    }
-    
+    // Validación muestreada: las llamadas no elegidas toman el camino rápido
+    bool checked = c_print_safe_enabled() && cp_sample_should_validate(pattern);
+    CP_PROBE_FORMAT_START(pattern);
+    size_t total = render_safe(compiled, pattern, &args, checked);
+    CP_PROBE_FORMAT_END(pattern, total);
+    (void)total;
     va_end(args);
-}
\ No newline at end of file
+}
@@ -0,0 +1,96 @@
+/**
+ * @file c_print_sampling.c
+ * @brief Muestreo de validaciones y registro de desajustes
+ */
+
+#include "c_print_sampling.h"
+#include "c_print_config.h"
+#include <stdint.h>
+
+#define SAMPLE_TABLE_SIZE 64
+
+#if defined(__STDC_VERSION__) && __STDC_VERSION__ >= 201112L && !defined(__STDC_NO_ATOMICS__)
+    #include <stdatomic.h>
+    static atomic_ulong mismatch_count;
+    #define MISMATCH_INCREMENT() atomic_fetch_add(&mismatch_count, 1)
+    #define MISMATCH_LOAD() atomic_load(&mismatch_count)
+    #define MISMATCH_STORE(v) atomic_store(&mismatch_count, (v))
+#else
+    static volatile unsigned long mismatch_count;
+    #define MISMATCH_INCREMENT() (mismatch_count++)
+    #define MISMATCH_LOAD() (mismatch_count)
+    #define MISMATCH_STORE(v) (mismatch_count = (v))
+#endif
+
+static unsigned sample_rate = 0;
+static CPrintMismatchHandler mismatch_handler = NULL;
+static void* mismatch_ctx = NULL;
+
+// ============================================================================
+// CONFIGURACIÓN
+// ============================================================================
+
+void c_print_set_sample_rate(unsigned rate) {
+    sample_rate = rate;
+}
+
+unsigned c_print_get_sample_rate(void) {
+    return sample_rate;
+}
+
+void c_print_set_mismatch_handler(CPrintMismatchHandler handler, void* ctx) {
+    mismatch_handler = handler;
+    mismatch_ctx = ctx;
+}
+
+unsigned long c_print_mismatch_count(void) {
+    return MISMATCH_LOAD();
+}
+
+void c_print_reset_mismatch_count(void) {
+    MISMATCH_STORE(0);
+}
+
+// ============================================================================
+// MUESTREO POR PATRÓN
+// ============================================================================
+
+typedef struct {
+    const char* key;                // Dirección del patrón del llamador
+    unsigned long calls;
+} SampleEntry;
+
+static CP_THREAD_LOCAL SampleEntry sample_table[SAMPLE_TABLE_SIZE];
+
+static size_t sample_index(const char* pattern) {
+    uintptr_t addr = (uintptr_t)pattern;
+    addr ^= addr >> 17;
+    addr *= (uintptr_t)0x9E3779B97F4A7C15ull;
+    return (size_t)(addr >> 7) & (SAMPLE_TABLE_SIZE - 1);
+}
+
+bool cp_sample_should_validate(const char* pattern) {
+    unsigned rate = sample_rate;
+    if (rate <= 1) return true;
+
+    SampleEntry* entry = &sample_table[sample_index(pattern)];
+
+    // Patrón nuevo en la entrada: su primera llamada siempre se valida
+    if (entry->key != pattern) {
+        entry->key = pattern;
+        entry->calls = 0;
+    }
+
+    return (entry->calls++ % rate) == 0;
+}
+
+bool cp_sample_reporting(void) {
+    return sample_rate > 0;
+}
+
+void cp_report_mismatch(const char* pattern, size_t arg_index, const char* message) {
+    MISMATCH_INCREMENT();
+
+    CPrintMismatchHandler handler = mismatch_handler;
+    if (handler) handler(mismatch_ctx, pattern, arg_index, message);
+}
@@ -0,0 +1,33 @@
+/**
+ * @file c_print_signal.c
+ * @brief Implementación de la impresión segura desde manejadores de señales
+ *
+ * Solo se llama a funciones async-signal-safe: write(2) a través de
+ * cp_sink_fd() y el renderizado de c_vprint_to(), que no usa stdio,
+ * locale, locks ni memoria dinámica.
+ */
+
+#include "c_print_signal.h"
+#include "c_print_freestanding.h"
+#include "c_print_sink.h"
+#include <errno.h>
+
+size_t c_vprint_signal_safe(int fd, const char* pattern, va_list args) {
+    if (!pattern || fd < 0) return 0;
+
+    // El sink de descriptor hace write(2) directo, sin estadísticas ni probes
+    int saved_errno = errno;
+    char line[CPRINT_SIGNAL_BUFFER];
+    CPrintSink sink = cp_sink_fd(fd);
+    size_t written = c_vprint_to(&sink, line, sizeof(line), pattern, args);
+    errno = saved_errno;
+    return written;
+}
+
+size_t c_print_signal_safe(int fd, const char* pattern, ...) {
+    va_list args;
+    va_start(args, pattern);
+    size_t written = c_vprint_signal_safe(fd, pattern, args);
+    va_end(args);
+    return written;
+}
@@ -0,0 +1,57 @@
+/**
+ * @file c_print_sink.c
+ * @brief Implementación de los sinks de archivo y descriptor
+ */
+
+#include "c_print_sink.h"
+#include "c_print_stats.h"
+#include "c_print_probes.h"
+#include <stdint.h>
+#include <errno.h>
+
+#ifdef _WIN32
+    #include <io.h>
+    #define sink_sys_write(fd, data, len) _write((fd), (data), (unsigned int)(len))
+#else
+    #include <unistd.h>
+    #define sink_sys_write(fd, data, len) write((fd), (data), (len))
+#endif
+
+static size_t file_write(void* ctx, const char* data, size_t len) {
+    return fwrite(data, 1, len, (FILE*)ctx);
+}
+
+static size_t fd_write(void* ctx, const char* data, size_t len) {
+    int fd = (int)(intptr_t)ctx;
+    size_t written = 0;
+
+    while (written < len) {
+        long n = (long)sink_sys_write(fd, data + written, len - written);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            break;
+        }
+        if (n == 0) break;
+        written += (size_t)n;
+    }
+
+    return written;
+}
+
+CPrintSink cp_sink_file(FILE* fp) {
+    CPrintSink sink = {file_write, fp};
+    return sink;
+}
+
+CPrintSink cp_sink_fd(int fd) {
+    CPrintSink sink = {fd_write, (void*)(intptr_t)fd};
+    return sink;
+}
+
+size_t cp_sink_write(const CPrintSink* sink, const char* data, size_t len) {
+    if (!sink || !sink->write || !data || len == 0) return 0;
+    size_t written = sink->write(sink->ctx, data, len);
+    CP_STAT_ADD(CP_STAT_BYTES, written);
+    CP_PROBE_SINK_WRITE(written);
+    return written;
+}
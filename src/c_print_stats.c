@@ -0,0 +1,127 @@
+/**
+ * @file c_print_stats.c
+ * @brief Contadores por hilo agregados bajo demanda
+ *
+ * Cada hilo obtiene un bloque de contadores de una lista global que solo
+ * crece (thread_blocks.h): solo su dueño lo escribe (carga y almacenamiento
+ * relajados, sin instrucciones con lock) y c_print_stats() recorre la
+ * lista sumando. Cuando un hilo termina su bloque queda libre para el
+ * siguiente hilo nuevo y conserva lo contado, así que los totales incluyen
+ * los hilos terminados. El reset guarda los totales actuales como base en
+ * lugar de escribir en bloques ajenos.
+ */
+
+#include "c_print_stats.h"
+#include "c_print_config.h"
+#include <string.h>
+
+static const char* const api_names[CPRINT_API_COUNT] = {
+    [CPRINT_API_PRINT] = "c_print",
+    [CPRINT_API_STYLED] = "c_print_styled",
+    [CPRINT_API_PRINTF_STYLED] = "c_printf_styled",
+    [CPRINT_API_BUILDER] = "builder",
+    [CPRINT_API_TYPED] = "c_print_typed",
+    [CPRINT_API_CHECKED] = "c_print_checked",
+    [CPRINT_API_SAFE] = "c_print_safe",
+    [CPRINT_API_ARGV] = "c_print_argv",
+    [CPRINT_API_SNPRINT] = "c_snprint",
+    [CPRINT_API_FD] = "c_print_fd",
+};
+
+const char* c_print_stats_api_name(CPrintApi api) {
+    if ((unsigned)api >= CPRINT_API_COUNT) return "unknown";
+    return api_names[api];
+}
+
+#ifdef C_PRINT_STATS
+
+#include "thread_blocks.h"
+
+typedef struct {
+    ThreadBlock header;
+    atomic_ullong counters[CP_STAT_SLOTS];
+} ThreadStats;
+
+static atomic_ullong reset_base[CP_STAT_SLOTS];
+static CP_THREAD_LOCAL ThreadStats* local_stats;
+
+static void release_block(ThreadBlock* block) {
+    (void)block;
+    local_stats = NULL;
+}
+
+static ThreadBlockList stats_blocks = THREAD_BLOCK_LIST_INIT(ThreadStats, NULL, release_block);
+
+static ThreadStats* acquire_block(void) {
+    local_stats = (ThreadStats*)thread_block_acquire(&stats_blocks);
+    return local_stats;
+}
+
+void cp_stat_add(unsigned slot, unsigned long long n) {
+    ThreadStats* block = local_stats;
+    if (!block && !(block = acquire_block())) return;
+
+    // Único escritor: basta con carga + almacenamiento relajados
+    atomic_ullong* counter = &block->counters[slot];
+    atomic_store_explicit(counter,
+                          atomic_load_explicit(counter, memory_order_relaxed) + n,
+                          memory_order_relaxed);
+}
+
+static void sum_blocks(unsigned long long totals[CP_STAT_SLOTS]) {
+    memset(totals, 0, sizeof(unsigned long long) * CP_STAT_SLOTS);
+
+    for (ThreadBlock* block = thread_block_first(&stats_blocks); block; block = block->next) {
+        ThreadStats* it = (ThreadStats*)block;
+        for (unsigned s = 0; s < CP_STAT_SLOTS; s++) {
+            totals[s] += atomic_load_explicit(&it->counters[s], memory_order_relaxed);
+        }
+    }
+}
+
+CPrintStats c_print_stats(void) {
+    unsigned long long totals[CP_STAT_SLOTS];
+    sum_blocks(totals);
+
+    for (unsigned s = 0; s < CP_STAT_SLOTS; s++) {
+        unsigned long long base = atomic_load(&reset_base[s]);
+        totals[s] = totals[s] > base ? totals[s] - base : 0;
+    }
+
+    CPrintStats stats;
+    stats.enabled = true;
+    for (unsigned api = 0; api < CPRINT_API_COUNT; api++) {
+        stats.calls[api] = totals[CP_STAT_CALLS + api];
+    }
+    stats.bytes = totals[CP_STAT_BYTES];
+    stats.escape_bytes = totals[CP_STAT_ESCAPE_BYTES];
+    stats.cache_hits = totals[CP_STAT_CACHE_HITS];
+    stats.cache_misses = totals[CP_STAT_CACHE_MISSES];
+    stats.builder_allocs = totals[CP_STAT_BUILDER_ALLOCS];
+    stats.builder_reallocs = totals[CP_STAT_BUILDER_REALLOCS];
+    stats.queue_drops = totals[CP_STAT_QUEUE_DROPS];
+    stats.queue_dropped_bytes = totals[CP_STAT_QUEUE_DROPPED_BYTES];
+    return stats;
+}
+
+void c_print_stats_reset(void) {
+    unsigned long long totals[CP_STAT_SLOTS];
+    sum_blocks(totals);
+
+    for (unsigned s = 0; s < CP_STAT_SLOTS; s++) {
+        atomic_store(&reset_base[s], totals[s]);
+    }
+}
+
+#else // !C_PRINT_STATS
+
+CPrintStats c_print_stats(void) {
+    CPrintStats stats;
+    memset(&stats, 0, sizeof(stats));
+    return stats;
+}
+
+void c_print_stats_reset(void) {
+}
+
+#endif // C_PRINT_STATS
@@ -0,0 +1,288 @@
+/**
+ * @file c_print_typed.c
+ * @brief Implementación de la API type-safe basada en CPrintValue
+ *
+ * El patrón se compila una vez (caché por hilo) y cada campo se valida
+ * con una consulta a tabla sobre el tipo del CPrintValue; la línea se
+ * ensambla en un buffer de stack y se vuelca a stdout.
+ */
+
+#include "c_print_typed.h"
+#include "pattern_compiler.h"
+#include "format_engine.h"
+#include "c_print_stats.h"
+#include <stdio.h>
+#include <stdarg.h>
+
+#define TYPED_OUTPUT_BUFFER 1024
+
+#define TYPE_BIT(t) (1u << (t))
+
+// ============================================================================
+// TABLA DE TIPOS ACEPTADOS
+// ============================================================================
+
+/**
+ * @brief Máscara de CPrintValueType aceptados por cada tipo de formato
+ *
+ * Mismas reglas que c_print_generic.h; 'c' acepta también int porque
+ * los literales de carácter ('a') son int en C.
+ */
+static const unsigned short accepted_types[128] = {
+    ['s'] = TYPE_BIT(CPRINT_TYPE_STRING),
+    ['d'] = TYPE_BIT(CPRINT_TYPE_INT),
+    ['i'] = TYPE_BIT(CPRINT_TYPE_INT),
+    ['f'] = TYPE_BIT(CPRINT_TYPE_DOUBLE) | TYPE_BIT(CPRINT_TYPE_FLOAT),
+    ['c'] = TYPE_BIT(CPRINT_TYPE_CHAR) | TYPE_BIT(CPRINT_TYPE_INT),
+    ['b'] = TYPE_BIT(CPRINT_TYPE_UINT) | TYPE_BIT(CPRINT_TYPE_INT),
+    ['x'] = TYPE_BIT(CPRINT_TYPE_UINT) | TYPE_BIT(CPRINT_TYPE_INT),
+    ['o'] = TYPE_BIT(CPRINT_TYPE_UINT) | TYPE_BIT(CPRINT_TYPE_INT),
+    ['u'] = TYPE_BIT(CPRINT_TYPE_UINT) | TYPE_BIT(CPRINT_TYPE_INT),
+    ['l'] = TYPE_BIT(CPRINT_TYPE_LONG),
+};
+
+static bool type_accepted(char format_type, CPrintValueType type) {
+    unsigned char index = (unsigned char)format_type;
+    if (index >= 128 || (unsigned)type > CPRINT_TYPE_UNKNOWN) return false;
+    return (accepted_types[index] & TYPE_BIT(type)) != 0;
+}
+
+static const char* value_type_name(CPrintValueType type) {
+    switch (type) {
+        case CPRINT_TYPE_STRING: return "string";
+        case CPRINT_TYPE_INT: return "int";
+        case CPRINT_TYPE_UINT: return "unsigned int";
+        case CPRINT_TYPE_LONG: return "long";
+        case CPRINT_TYPE_ULONG: return "unsigned long";
+        case CPRINT_TYPE_FLOAT: return "float";
+        case CPRINT_TYPE_DOUBLE: return "double";
+        case CPRINT_TYPE_CHAR: return "char";
+        case CPRINT_TYPE_BOOL: return "bool";
+        case CPRINT_TYPE_POINTER: return "pointer";
+        default: return "unknown";
+    }
+}
+
+static const char* expected_type_name(char format_type) {
+    switch (format_type) {
+        case 's': return "string";
+        case 'd':
+        case 'i': return "int";
+        case 'f': return "double";
+        case 'c': return "char";
+        case 'b':
+        case 'x':
+        case 'o':
+        case 'u': return "unsigned int";
+        case 'l': return "long";
+        default: return "unknown";
+    }
+}
+
+// ============================================================================
+// RENDERIZADO
+// ============================================================================
+
+static FieldValue to_field_value(const CPrintValue* v) {
+    FieldValue fv;
+    fv.u = 0;
+
+    switch (v->type) {
+        case CPRINT_TYPE_STRING: fv.s = v->value.s; break;
+        case CPRINT_TYPE_INT: fv.i = v->value.i; break;
+        case CPRINT_TYPE_UINT: fv.u = v->value.u; break;
+        case CPRINT_TYPE_LONG: fv.i = v->value.l; break;
+        case CPRINT_TYPE_ULONG: fv.u = v->value.ul; break;
+        case CPRINT_TYPE_FLOAT: fv.d = v->value.f; break;
+        case CPRINT_TYPE_DOUBLE: fv.d = v->value.d; break;
+        case CPRINT_TYPE_CHAR: fv.i = v->value.c; break;
+        case CPRINT_TYPE_BOOL: fv.i = v->value.b; break;
+        default: break;
+    }
+    return fv;
+}
+
+/**
+ * @brief Renderiza un campo con su valor (NULL = argumento faltante)
+ */
+static void render_typed_field(OutputBuffer* out, const PatternSegment* seg,
+                               const CPrintValue* value) {
+    char value_buffer[FORMAT_VALUE_BUFFER];
+    char format_type = seg->style.format_type;
+
+    if (!value) {
+        snprintf(value_buffer, sizeof(value_buffer),
+                 "{? missing argument for '%c'}", format_type);
+        render_field_error(out, seg, value_buffer);
+        return;
+    }
+
+    if (!type_accepted(format_type, value->type)) {
+        snprintf(value_buffer, sizeof(value_buffer), "{? expected %s, got %s}",
+                 expected_type_name(format_type), value_type_name(value->type));
+        render_field_error(out, seg, value_buffer);
+        return;
+    }
+
+    size_t len = format_field_value(value_buffer, sizeof(value_buffer),
+                                    &seg->style, to_field_value(value));
+    render_field(out, seg, value_buffer, len);
+}
+
+/**
+ * @brief Renderiza un campo que no consume argumento ("{?}")
+ */
+static void render_unknown_field(OutputBuffer* out, const PatternSegment* seg) {
+    char value_buffer[8];
+    FieldValue none;
+    none.u = 0;
+
+    size_t len = format_field_value(value_buffer, sizeof(value_buffer), &seg->style, none);
+    render_field(out, seg, value_buffer, len);
+}
+
+void c_print_typed_array(const char* pattern, const CPrintValue* values, size_t count) {
+    CP_STAT_CALL(CPRINT_API_TYPED);
+    const CompiledPattern* compiled = get_compiled_pattern(pattern);
+    if (!compiled) return;
+
+    char storage[TYPED_OUTPUT_BUFFER];
+    LineStream stream;
+    OutputBuffer out;
+    line_stream_init(&stream, stdout);
+    output_init(&out, storage, sizeof(storage), &stream.sink);
+
+    size_t arg_index = 0;
+
+    for (size_t i = 0; i < compiled->segment_count; i++) {
+        const PatternSegment* seg = &compiled->segments[i];
+
+        if (seg->kind == SEGMENT_LITERAL) {
+            render_literal(&out, seg);
+        } else if (!seg->consumes_argument) {
+            render_unknown_field(&out, seg);
+        } else {
+            const CPrintValue* value = arg_index < count ? &values[arg_index] : NULL;
+            render_typed_field(&out, seg, value);
+            arg_index++;
+        }
+    }
+
+    line_stream_finish(&stream, &out);
+}
+
+void c_print_typed(const char* pattern, ...) {
+    CP_STAT_CALL(CPRINT_API_TYPED);
+    const CompiledPattern* compiled = get_compiled_pattern(pattern);
+    if (!compiled) return;
+
+    char storage[TYPED_OUTPUT_BUFFER];
+    LineStream stream;
+    OutputBuffer out;
+    line_stream_init(&stream, stdout);
+    output_init(&out, storage, sizeof(storage), &stream.sink);
+
+    va_list args;
+    va_start(args, pattern);
+
+    for (size_t i = 0; i < compiled->segment_count; i++) {
+        const PatternSegment* seg = &compiled->segments[i];
+
+        if (seg->kind == SEGMENT_LITERAL) {
+            render_literal(&out, seg);
+        } else if (!seg->consumes_argument) {
+            render_unknown_field(&out, seg);
+        } else {
+            CPrintValue value = va_arg(args, CPrintValue);
+            render_typed_field(&out, seg, &value);
+        }
+    }
+
+    va_end(args);
+    line_stream_finish(&stream, &out);
+}
+
+// ============================================================================
+// VALIDACIÓN Y DEBUG
+// ============================================================================
+
+bool c_print_validate(const char* pattern, int num_args, CPrintValueType expected_types[]) {
+    const CompiledPattern* compiled = get_compiled_pattern(pattern);
+    if (!compiled) return false;
+
+    if (num_args < 0 || (size_t)num_args != compiled->field_count) {
+        fprintf(stderr, "[C_PRINT ERROR] Argument count mismatch: expected %zu, got %d\n",
+                compiled->field_count, num_args);
+        return false;
+    }
+
+    bool valid = true;
+    for (size_t i = 0; i < compiled->field_count; i++) {
+        char format_type = compiled->field_types[i];
+
+        if (!type_accepted(format_type, expected_types[i])) {
+            fprintf(stderr, "[C_PRINT ERROR] Type mismatch at argument %zu:\n", i);
+            fprintf(stderr, "  Pattern: {%c:...}\n", format_type);
+            fprintf(stderr, "  Expected: %s\n", expected_type_name(format_type));
+            fprintf(stderr, "  Got: %s\n", value_type_name(expected_types[i]));
+            valid = false;
+        }
+    }
+
+    return valid;
+}
+
+void c_print_debug_args(const char* pattern, ...) {
+    const CompiledPattern* compiled = get_compiled_pattern(pattern);
+    if (!compiled) return;
+
+    printf("[C_PRINT DEBUG] Pattern: %s\n", pattern);
+    printf("[C_PRINT DEBUG] Argument count: %zu\n", compiled->field_count);
+
+    va_list args;
+    va_start(args, pattern);
+
+    for (size_t i = 0; i < compiled->field_count; i++) {
+        CPrintValue arg = va_arg(args, CPrintValue);
+
+        printf("[C_PRINT DEBUG] Arg %zu: %s = ", i, value_type_name(arg.type));
+
+        switch (arg.type) {
+            case CPRINT_TYPE_STRING:
+                printf("\"%s\"\n", arg.value.s ? arg.value.s : "(null)");
+                break;
+            case CPRINT_TYPE_INT:
+                printf("%d\n", arg.value.i);
+                break;
+            case CPRINT_TYPE_UINT:
+                printf("%u\n", arg.value.u);
+                break;
+            case CPRINT_TYPE_LONG:
+                printf("%ld\n", arg.value.l);
+                break;
+            case CPRINT_TYPE_ULONG:
+                printf("%lu\n", arg.value.ul);
+                break;
+            case CPRINT_TYPE_FLOAT:
+                printf("%f\n", arg.value.f);
+                break;
+            case CPRINT_TYPE_DOUBLE:
+                printf("%f\n", arg.value.d);
+                break;
+            case CPRINT_TYPE_CHAR:
+                printf("'%c'\n", arg.value.c);
+                break;
+            case CPRINT_TYPE_BOOL:
+                printf("%s\n", arg.value.b ? "true" : "false");
+                break;
+            case CPRINT_TYPE_POINTER:
+                printf("%p\n", arg.value.ptr);
+                break;
+            default:
+                printf("(unknown)\n");
+                break;
+        }
+    }
+
+    va_end(args);
+}
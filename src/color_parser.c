@@ -6,7 +6,6 @@
 #include "color_parser.h"
 #include "string_utils.h"
 #include <string.h>
-#include <stdlib.h>
 
 TextColor parse_text_color(const char* color) {
     if (!color || strlen(color) == 0) return COLOR_RESET;
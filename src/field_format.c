@@ -0,0 +1,115 @@
+/**
+ * @file field_format.c
+ * @brief Implementación del formateo de campos sin stdio
+ */
+
+#include "field_format.h"
+#include "number_formatter.h"
+#include <string.h>
+
+bool is_unsigned_format(char format_type) {
+    return format_type == 'b' || format_type == 'x' ||
+           format_type == 'o' || format_type == 'u';
+}
+
+/**
+ * @brief Copia a lo sumo size - 1 bytes y termina en NUL
+ */
+static size_t copy_value(char* buffer, size_t size, const char* text, size_t len) {
+    if (len >= size) len = size - 1;
+    memcpy(buffer, text, len);
+    buffer[len] = '\0';
+    return len;
+}
+
+size_t format_field_value_plain(char* buffer, size_t size, const PatternStyle* style,
+                                FieldValue value) {
+    if (!buffer || size == 0) return 0;
+    buffer[0] = '\0';
+
+    switch (style->format_type) {
+        case 's': {
+            const char* str = value.s;
+            if (!str) return 0;
+            size_t len = strlen(str);
+            if (style->has_truncate && len > (size_t)style->truncate) {
+                len = (size_t)style->truncate;
+            }
+            return copy_value(buffer, size, str, len);
+        }
+
+        case 'd':
+        case 'i':
+            if (style->has_separator) {
+                format_with_separator(buffer, size, (int)value.i, style->separator);
+                return strlen(buffer);
+            }
+            return format_decimal(buffer, size, (int)value.i, style->show_sign,
+                                  style->padding, style->zero_pad);
+
+        case 'f': {
+            double num = value.d;
+            size_t len;
+
+            if (style->as_percentage) {
+                len = format_fixed(buffer, size, num * 100.0,
+                                   style->has_precision ? style->precision : 1);
+                return len + copy_value(buffer + len, size - len, "%", 1);
+            }
+            return format_fixed(buffer, size, num,
+                                style->has_precision ? style->precision : 6);
+        }
+
+        case 'c':
+            if (size < 2) return 0;
+            buffer[0] = (char)value.i;
+            buffer[1] = '\0';
+            return buffer[0] ? 1 : 0;
+
+        case 'b':
+            format_binary(buffer, size, (unsigned int)value.u, style->show_prefix);
+            return strlen(buffer);
+
+        case 'x':
+            format_hex(buffer, size, (unsigned int)value.u,
+                       style->show_prefix, style->padding, style->zero_pad);
+            return strlen(buffer);
+
+        case 'o':
+            format_octal(buffer, size, (unsigned int)value.u, style->show_prefix);
+            return strlen(buffer);
+
+        case 'u':
+            if (style->has_separator) {
+                format_with_separator(buffer, size, (unsigned int)value.u, style->separator);
+                return strlen(buffer);
+            }
+            return format_unsigned(buffer, size, (unsigned int)value.u, 10);
+
+        case 'l':
+            if (style->has_separator) {
+                format_with_separator(buffer, size, (long)value.i, style->separator);
+                return strlen(buffer);
+            }
+            return format_decimal(buffer, size, (long)value.i, 0, 0, 0);
+
+        default:
+            return copy_value(buffer, size, "{?}", 3);
+    }
+}
+
+FieldValue read_field_value(char format_type, va_list* args) {
+    FieldValue value;
+    value.u = 0;
+
+    switch (format_type) {
+        case 's': value.s = va_arg(*args, const char*); break;
+        case 'f': value.d = va_arg(*args, double); break;
+        case 'l': value.i = va_arg(*args, long); break;
+        case 'd':
+        case 'i':
+        case 'c': value.i = va_arg(*args, int); break;
+        default: value.u = va_arg(*args, unsigned int); break;
+    }
+    return value;
+}
@@ -0,0 +1,345 @@
+/**
+ * @file format_engine.c
+ * @brief Implementación del motor de renderizado sobre buffers
+ */
+
+#include "format_engine.h"
+#include "c_print_stats.h"
+#include "c_print_config.h"
+#include "c_print_batch.h"
+#include "c_print_queue.h"
+#include "c_print_probes.h"
+#include <stdio.h>
+#include <string.h>
+
+// ============================================================================
+// LÍNEA ATÓMICA
+// ============================================================================
+
+static size_t line_stream_write(void* ctx, const char* data, size_t len) {
+    LineStream* stream = (LineStream*)ctx;
+    size_t written = len;
+
+    if (stream->queued) {
+        cp_queue_write_part(data, len);
+    } else if (stream->batched) {
+        cp_batch_write(data, len);
+    } else {
+        if (!stream->locked) {
+            CP_LOCK_FILE(stream->fp);
+            stream->locked = true;
+        }
+        written = fwrite(data, 1, len, stream->fp);
+    }
+
+    // output_flush() no cuenta: el sink de la línea cuenta como cp_sink_write
+    CP_STAT_ADD(CP_STAT_BYTES, written);
+    CP_PROBE_SINK_WRITE(written);
+    return written;
+}
+
+void line_stream_init(LineStream* stream, FILE* fp) {
+    stream->fp = fp;
+    stream->locked = false;
+    stream->queued = CP_QUEUE_BEGIN_LINE(fp);
+    stream->batched = !stream->queued && CP_BATCH_BEGIN_LINE(fp);
+    stream->sink.write = line_stream_write;
+    stream->sink.ctx = stream;
+}
+
+size_t line_stream_finish(LineStream* stream, OutputBuffer* out) {
+    if (stream->queued) {
+        size_t pending = out->length;
+        cp_queue_end_line(out->data, pending);
+        out->length = 0;
+        stream->queued = false;
+        return pending;
+    }
+
+    if (stream->batched) {
+        size_t pending = out->length;
+        cp_batch_write(out->data, pending);
+        out->length = 0;
+        cp_batch_end_line();
+        stream->batched = false;
+        return pending;
+    }
+
+    if (!stream->locked) {
+        // La línea entera está en el buffer: un fwrite ya es atómico
+        CPrintSink direct = cp_sink_file(stream->fp);
+        size_t written = cp_sink_write(&direct, out->data, out->length);
+        out->length = 0;
+        return written;
+    }
+
+    size_t written = output_flush(out);
+    CP_UNLOCK_FILE(stream->fp);
+    stream->locked = false;
+    return written;
+}
+
+// ============================================================================
+// FORMATEO DE VALORES
+// ============================================================================
+
+/**
+ * @brief Escribe con snprintf y devuelve la longitud realmente escrita
+ */
+static size_t clamp_length(int written, size_t size) {
+    if (written < 0 || size == 0) return 0;
+    return (size_t)written < size ? (size_t)written : size - 1;
+}
+
+size_t format_field_value(char* buffer, size_t size, const PatternStyle* style,
+                          FieldValue value) {
+    if (!buffer || size == 0) return 0;
+
+    // Solo los floats pasan por snprintf (respetan el punto decimal del locale)
+    if (style->format_type != 'f') {
+        return format_field_value_plain(buffer, size, style, value);
+    }
+
+    double num = value.d;
+    buffer[0] = '\0';
+
+    if (style->as_percentage) {
+        num *= 100.0;
+        if (style->has_precision) {
+            return clamp_length(snprintf(buffer, size, "%.*f%%", style->precision, num), size);
+        }
+        return clamp_length(snprintf(buffer, size, "%.1f%%", num), size);
+    }
+    if (style->has_precision) {
+        return clamp_length(snprintf(buffer, size, "%.*f", style->precision, num), size);
+    }
+    return clamp_length(snprintf(buffer, size, "%f", num), size);
+}
+
+// ============================================================================
+// RENDERIZADO DE CAMPOS
+// ============================================================================
+
+void render_field(OutputBuffer* out, const PatternSegment* segment,
+                  const char* value, size_t len) {
+    if (segment->escape_length) {
+        output_write(out, segment->escape, segment->escape_length);
+        CP_STAT_ADD(CP_STAT_ESCAPE_BYTES, segment->escape_length + ANSI_RESET_LENGTH);
+    }
+
+    output_write_aligned(out, &segment->style, value, len);
+
+    if (segment->escape_length) {
+        output_write(out, ANSI_RESET_SEQUENCE, ANSI_RESET_LENGTH);
+    }
+}
+
+void render_field_error(OutputBuffer* out, const PatternSegment* segment,
+                        const char* message) {
+    static const char error_escape[] = "\033[1;31m";
+
+    output_write(out, error_escape, sizeof(error_escape) - 1);
+    CP_STAT_ADD(CP_STAT_ESCAPE_BYTES, sizeof(error_escape) - 1 + ANSI_RESET_LENGTH);
+    output_write_aligned(out, &segment->style, message, strlen(message));
+    output_write(out, ANSI_RESET_SEQUENCE, ANSI_RESET_LENGTH);
+}
+
+void render_pattern(OutputBuffer* out, const CompiledPattern* compiled, va_list* args) {
+    char value_buffer[FORMAT_VALUE_BUFFER];
+
+    for (size_t i = 0; i < compiled->segment_count; i++) {
+        const PatternSegment* seg = &compiled->segments[i];
+
+        if (seg->kind == SEGMENT_LITERAL) {
+            render_literal(out, seg);
+            continue;
+        }
+
+        // Tipos desconocidos se muestran como "{?}" sin consumir argumento
+        FieldValue value;
+        value.u = 0;
+        if (seg->consumes_argument) value = read_field_value(seg->style.format_type, args);
+
+        size_t len = format_field_value(value_buffer, sizeof(value_buffer), &seg->style, value);
+        render_field(out, seg, value_buffer, len);
+    }
+}
+
+// ============================================================================
+// LÍNEA COMO TRAMOS (writev)
+// ============================================================================
+
+#ifndef _WIN32
+
+#include <errno.h>
+
+// Relleno con espacios referenciado en su lugar
+static const char iov_spaces[] =
+    "                                                                "
+    "                                                                ";
+
+void iov_line_init(IovLine* line, int fd) {
+    line->fd = fd;
+    line->count = 0;
+    line->pending = 0;
+    line->total = 0;
+    line->written = 0;
+    line->scratch_used = 0;
+}
+
+size_t iov_line_flush(IovLine* line) {
+    struct iovec* iov = line->iov;
+    int count = line->count;
+    size_t written = 0;
+
+    while (count > 0) {
+        ssize_t n = writev(line->fd, iov, count);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            break;
+        }
+        if (n == 0) break;
+        written += (size_t)n;
+
+        // Saltar lo ya escrito y reintentar el resto
+        size_t done = (size_t)n;
+        while (count > 0 && done >= iov->iov_len) {
+            done -= iov->iov_len;
+            iov++;
+            count--;
+        }
+        if (count > 0) {
+            iov->iov_base = (char*)iov->iov_base + done;
+            iov->iov_len -= done;
+        }
+    }
+
+    CP_STAT_ADD(CP_STAT_BYTES, written);
+    CP_PROBE_SINK_WRITE(written);
+    line->written += written;
+    line->count = 0;
+    line->pending = 0;
+    line->scratch_used = 0;
+    return written;
+}
+
+void iov_line_add(IovLine* line, const char* data, size_t len) {
+    if (len == 0) return;
+    line->total += len;
+    line->pending += len;
+
+    // Contiguo al tramo anterior (valores seguidos en scratch): se extiende
+    struct iovec* last = line->count ? &line->iov[line->count - 1] : NULL;
+    if (last && (const char*)last->iov_base + last->iov_len == data) {
+        last->iov_len += len;
+        return;
+    }
+
+    if (line->count == IOV_LINE_ENTRIES) {
+        line->total -= len;
+        line->pending -= len;
+        iov_line_flush(line);
+        iov_line_add(line, data, len);
+        return;
+    }
+
+    line->iov[line->count].iov_base = (void*)data;
+    line->iov[line->count].iov_len = len;
+    line->count++;
+}
+
+/**
+ * @brief Copia bytes a scratch y los agrega
+ *
+ * Vuelca antes si no caben o no quedan tramos: el volcado reutiliza
+ * scratch desde el principio.
+ */
+static void iov_line_copy(IovLine* line, const char* data, size_t len) {
+    if (line->scratch_used + len > IOV_LINE_SCRATCH || line->count == IOV_LINE_ENTRIES) {
+        iov_line_flush(line);
+    }
+
+    char* at = line->scratch + line->scratch_used;
+    memcpy(at, data, len);
+    line->scratch_used += len;
+    iov_line_add(line, at, len);
+}
+
+static void iov_line_fill(IovLine* line, char ch, size_t count) {
+    while (count > 0) {
+        size_t chunk;
+        if (ch == ' ') {
+            chunk = count < sizeof(iov_spaces) - 1 ? count : sizeof(iov_spaces) - 1;
+            iov_line_add(line, iov_spaces, chunk);
+        } else {
+            char block[64];
+            chunk = count < sizeof(block) ? count : sizeof(block);
+            memset(block, ch, chunk);
+            iov_line_copy(line, block, chunk);
+        }
+        count -= chunk;
+    }
+}
+
+/**
+ * @brief Mismo resultado que output_write_aligned, con tramos
+ */
+static void iov_write_aligned(IovLine* line, const PatternStyle* style,
+                              const char* value, size_t len, bool in_place) {
+    size_t width = style->has_alignment && style->width > 0 ? (size_t)style->width : 0;
+    size_t right;
+    size_t left = alignment_padding(style->align, width, len, &right);
+
+    iov_line_fill(line, style->fill_char, left);
+    if (in_place) iov_line_add(line, value, len);
+    else iov_line_copy(line, value, len);
+    iov_line_fill(line, style->fill_char, right);
+}
+
+static void iov_render_field(IovLine* line, const PatternSegment* seg, FieldValue value) {
+    char value_buffer[FORMAT_VALUE_BUFFER];
+    const char* text = value_buffer;
+    size_t len;
+    bool in_place = seg->style.format_type == 's' && seg->consumes_argument;
+
+    if (in_place) {
+        // El string del argumento va en su lugar, con los mismos límites
+        text = value.s ? value.s : "";
+        len = strlen(text);
+        if (seg->style.has_truncate && len > (size_t)seg->style.truncate) {
+            len = (size_t)seg->style.truncate;
+        }
+        if (len > FORMAT_VALUE_BUFFER - 1) len = FORMAT_VALUE_BUFFER - 1;
+    } else {
+        len = format_field_value(value_buffer, sizeof(value_buffer), &seg->style, value);
+    }
+
+    if (seg->escape_length) {
+        iov_line_add(line, seg->escape, seg->escape_length);
+        CP_STAT_ADD(CP_STAT_ESCAPE_BYTES, seg->escape_length + ANSI_RESET_LENGTH);
+    }
+
+    iov_write_aligned(line, &seg->style, text, len, in_place);
+
+    if (seg->escape_length) {
+        iov_line_add(line, ANSI_RESET_SEQUENCE, ANSI_RESET_LENGTH);
+    }
+}
+
+void render_pattern_iov(IovLine* line, const CompiledPattern* compiled, va_list* args) {
+    for (size_t i = 0; i < compiled->segment_count; i++) {
+        const PatternSegment* seg = &compiled->segments[i];
+
+        if (seg->kind == SEGMENT_LITERAL) {
+            iov_line_add(line, seg->text, seg->length);
+            continue;
+        }
+
+        FieldValue value;
+        value.u = 0;
+        if (seg->consumes_argument) value = read_field_value(seg->style.format_type, args);
+        iov_render_field(line, seg, value);
+    }
+}
+
+#endif // !_WIN32
@@ -1,48 +1,357 @@
 /**
  * @file number_formatter.c
  * @brief Implementación del formateo avanzado de números
+ *
+ * Ninguna función usa stdio, locale ni memoria dinámica: todo se arma
+ * con dígitos propios sobre buffers del llamador.
  */
 
 #include "number_formatter.h"
-#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
 #include <string.h>
 
+// Dígitos de un unsigned long long en base 2 (el peor caso)
+#define DIGITS_MAX 64
+
+// Dígitos de la parte entera del double más grande (~1.8e308)
+#define FIXED_INTEGER_DIGITS 320
+
+// Palabras de 32 bits para el entero más grande de un double (2^1024)
+// y para la fracción más fina (2^-1074)
+#define FIXED_LIMBS 36
+
+static const char digit_chars[] = "0123456789abcdef";
+
+/**
+ * @brief Dígitos al revés para bases potencia de 2: desplazamiento y máscara
+ */
+static size_t reversed_power_of_two(char* out, unsigned long long num, unsigned shift) {
+    unsigned mask = (1u << shift) - 1u;
+    size_t count = 0;
+    do {
+        out[count++] = digit_chars[num & mask];
+        num >>= shift;
+    } while (num > 0);
+    return count;
+}
+
+/**
+ * @brief Dígitos decimales al revés (divisor constante: sin división real)
+ */
+static size_t reversed_decimal(char* out, unsigned long long num) {
+    size_t count = 0;
+    do {
+        out[count++] = (char)('0' + num % 10u);
+        num /= 10u;
+    } while (num > 0);
+    return count;
+}
+
+/**
+ * @brief Escribe los dígitos de num al revés y devuelve cuántos son
+ *
+ * Solo las bases que no son 2, 8, 10 ni 16 dividen por un divisor
+ * variable (una división de hardware por dígito).
+ */
+static size_t reversed_digits(char* out, unsigned long long num, unsigned base) {
+    switch (base) {
+        case 2:  return reversed_power_of_two(out, num, 1);
+        case 8:  return reversed_power_of_two(out, num, 3);
+        case 16: return reversed_power_of_two(out, num, 4);
+        case 10: return reversed_decimal(out, num);
+        default: break;
+    }
+
+    size_t count = 0;
+    do {
+        out[count++] = digit_chars[num % base];
+        num /= base;
+    } while (num > 0);
+    return count;
+}
+
+/**
+ * @brief Escritura acotada: trunca como snprintf y lleva la longitud
+ */
+typedef struct {
+    char* buffer;
+    size_t limit;               // Bytes útiles (size - 1)
+    size_t length;
+} BoundedText;
+
+static void bounded_init(BoundedText* text, char* buffer, size_t size) {
+    text->buffer = buffer;
+    text->limit = size - 1;
+    text->length = 0;
+}
+
+static void bounded_put(BoundedText* text, const char* data, size_t len) {
+    size_t room = text->limit - text->length;
+    if (len > room) len = room;
+    memcpy(text->buffer + text->length, data, len);
+    text->length += len;
+}
+
+static void bounded_fill(BoundedText* text, char ch, size_t count) {
+    size_t room = text->limit - text->length;
+    if (count > room) count = room;
+    memset(text->buffer + text->length, ch, count);
+    text->length += count;
+}
+
+static void bounded_put_reversed(BoundedText* text, const char* digits, size_t count) {
+    while (count > 0 && text->length < text->limit) {
+        text->buffer[text->length++] = digits[--count];
+    }
+}
+
+static size_t bounded_finish(BoundedText* text) {
+    text->buffer[text->length] = '\0';
+    return text->length;
+}
+
+// ============================================================================
+// DÍGITOS
+// ============================================================================
+
+size_t format_unsigned(char* buffer, size_t size, unsigned long long num, unsigned base) {
+    if (!buffer || size == 0) return 0;
+    if (base < 2 || base > 16) base = 10;
+
+    char digits[DIGITS_MAX];
+    BoundedText text;
+    bounded_init(&text, buffer, size);
+    bounded_put_reversed(&text, digits, reversed_digits(digits, num, base));
+    return bounded_finish(&text);
+}
+
+size_t format_decimal(char* buffer, size_t size, long long num,
+                      int show_sign, int width, int zero_pad) {
+    if (!buffer || size == 0) return 0;
+
+    unsigned long long magnitude = num < 0 ? 0ull - (unsigned long long)num
+                                           : (unsigned long long)num;
+    char digits[DIGITS_MAX];
+    size_t count = reversed_digits(digits, magnitude, 10);
+
+    char sign = num < 0 ? '-' : show_sign == 1 ? '+' : show_sign == 2 ? ' ' : '\0';
+    size_t used = count + (sign ? 1 : 0);
+    size_t padding = width > 0 && (size_t)width > used ? (size_t)width - used : 0;
+
+    BoundedText text;
+    bounded_init(&text, buffer, size);
+    if (!zero_pad) bounded_fill(&text, ' ', padding);
+    if (sign) bounded_put(&text, &sign, 1);
+    if (zero_pad) bounded_fill(&text, '0', padding);
+    bounded_put_reversed(&text, digits, count);
+    return bounded_finish(&text);
+}
+
+/**
+ * @brief Suma m << bit_pos a un número en palabras de 32 bits (little endian)
+ */
+static void place_shifted(uint32_t* limbs, uint64_t m, int bit_pos) {
+    int word = bit_pos / 32;
+    int bit = bit_pos % 32;
+    uint32_t m_lo = (uint32_t)m;
+    uint32_t m_hi = (uint32_t)(m >> 32);
+
+    limbs[word] |= m_lo << bit;
+    limbs[word + 1] |= (bit ? m_lo >> (32 - bit) : 0) | (m_hi << bit);
+    limbs[word + 2] |= bit ? m_hi >> (32 - bit) : 0;
+}
+
+/**
+ * @brief Dígitos decimales (al revés) de m * 2^e para e > 11 (>= 2^64)
+ *
+ * El valor se arma en palabras de 32 bits y se divide por 10^9 hasta
+ * agotarlo: es exacto para cualquier double finito.
+ */
+static size_t big_integer_digits(char* out, uint64_t m, int e) {
+    uint32_t limbs[FIXED_LIMBS];
+    memset(limbs, 0, sizeof(limbs));
+    place_shifted(limbs, m, e);
+
+    int count = e / 32 + 3;
+    size_t digits = 0;
+
+    while (count > 0) {
+        uint64_t rem = 0;
+        for (int i = count - 1; i >= 0; i--) {
+            uint64_t cur = (rem << 32) | limbs[i];
+            limbs[i] = (uint32_t)(cur / 1000000000u);
+            rem = cur % 1000000000u;
+        }
+        while (count > 0 && limbs[count - 1] == 0) count--;
+
+        // Bloques intermedios con sus 9 dígitos; el último sin ceros a la izquierda
+        for (int i = 0; i < 9 && (count > 0 || rem > 0); i++) {
+            out[digits++] = (char)('0' + rem % 10);
+            rem /= 10;
+        }
+    }
+
+    return digits;
+}
+
+/**
+ * @brief Parte fraccionaria exacta: limbs / 2^(32 * count)
+ */
+typedef struct {
+    uint32_t limbs[FIXED_LIMBS];    // Little endian; la coma está sobre limbs[count - 1]
+    int count;
+} FixedFraction;
+
+/**
+ * @brief Prepara la fracción (m mod 2^shift) / 2^shift
+ */
+static void fraction_init(FixedFraction* frac, uint64_t m, int shift) {
+    memset(frac, 0, sizeof(*frac));
+    if (shift <= 0) return;
+
+    uint64_t bits = shift >= 64 ? m : m & ((1ull << shift) - 1);
+    frac->count = (shift + 31) / 32;
+    place_shifted(frac->limbs, bits, 32 * frac->count - shift);
+}
+
+static bool fraction_is_zero(const FixedFraction* frac) {
+    for (int i = 0; i < frac->count; i++) {
+        if (frac->limbs[i]) return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Multiplica por 10 y devuelve el dígito que pasa a la parte entera
+ */
+static unsigned fraction_next_digit(FixedFraction* frac) {
+    uint64_t carry = 0;
+    for (int i = 0; i < frac->count; i++) {
+        uint64_t cur = (uint64_t)frac->limbs[i] * 10 + carry;
+        frac->limbs[i] = (uint32_t)cur;
+        carry = cur >> 32;
+    }
+    return (unsigned)carry;
+}
+
+/**
+ * @brief Compara el resto con 1/2: negativo, cero o positivo
+ */
+static int fraction_compare_half(const FixedFraction* frac) {
+    if (frac->count == 0) return -1;
+
+    uint32_t top = frac->limbs[frac->count - 1];
+    if (top != 0x80000000u) return top > 0x80000000u ? 1 : -1;
+    for (int i = 0; i < frac->count - 1; i++) {
+        if (frac->limbs[i]) return 1;
+    }
+    return 0;
+}
+
+size_t format_fixed(char* buffer, size_t size, double num, int precision) {
+    if (!buffer || size == 0) return 0;
+    if (precision < 0) precision = 6;
+
+    uint64_t bits;
+    memcpy(&bits, &num, sizeof(bits));
+    int negative = (int)(bits >> 63);
+    int exponent = (int)((bits >> 52) & 0x7ff);
+    uint64_t mantissa = bits & ((1ull << 52) - 1);
+
+    BoundedText text;
+    bounded_init(&text, buffer, size);
+    if (negative) bounded_put(&text, "-", 1);
+
+    if (exponent == 0x7ff) {
+        bounded_put(&text, mantissa ? "nan" : "inf", 3);
+        return bounded_finish(&text);
+    }
+
+    // num = m * 2^e
+    uint64_t m = exponent ? mantissa | (1ull << 52) : mantissa;
+    int e = (exponent ? exponent : 1) - 1075;
+    uint64_t integer = 0;
+    char int_digits[FIXED_INTEGER_DIGITS];
+    size_t int_count = 0;
+    FixedFraction frac;
+    fraction_init(&frac, m, -e);
+
+    if (e > 11) int_count = big_integer_digits(int_digits, m, e);
+    else if (e >= 0) integer = m << e;
+    else if (-e < 64) integer = m >> -e;
+
+    // Primera pasada: decidir el redondeo (al par, como printf) sin
+    // guardar los dígitos; el último que no es 9 recibe el acarreo
+    FixedFraction probe = frac;
+    int generated = 0;
+    int last_non_nine = -1;
+    unsigned last_digit = (unsigned)(integer & 1);
+    while (generated < precision && !fraction_is_zero(&probe)) {
+        last_digit = fraction_next_digit(&probe);
+        if (last_digit != 9) last_non_nine = generated;
+        generated++;
+    }
+
+    bool round_up = false;
+    if (generated == precision) {
+        int half = fraction_compare_half(&probe);
+        round_up = half > 0 || (half == 0 && (last_digit & 1));
+    }
+    if (round_up && last_non_nine < 0) integer++;
+
+    if (int_count == 0) int_count = reversed_digits(int_digits, integer, 10);
+    bounded_put_reversed(&text, int_digits, int_count);
+
+    if (precision > 0) {
+        bounded_put(&text, ".", 1);
+
+        // Segunda pasada: escribir con el redondeo ya decidido
+        int i = 0;
+        for (; i < generated && text.length < text.limit; i++) {
+            unsigned digit = fraction_next_digit(&frac);
+            if (round_up && i == last_non_nine) digit++;
+            else if (round_up && i > last_non_nine) digit = 0;
+            text.buffer[text.length++] = (char)('0' + digit);
+        }
+        bounded_fill(&text, '0', (size_t)(precision - i));
+    }
+
+    return bounded_finish(&text);
+}
+
+// ============================================================================
+// FORMATOS CON PREFIJO Y SEPARADORES
+// ============================================================================
+
 void format_with_separator(char* buffer, size_t size, long long num, char separator) {
-    char temp[100];
-    snprintf(temp, sizeof(temp), "%lld", num);
-    
-    int len = strlen(temp);
-    int negative = (temp[0] == '-') ? 1 : 0;
-    int digits = len - negative;
-    int commas = (digits - 1) / 3;
-    int total = len + commas;
-    
+    if (!buffer || size == 0) return;
+
+    // Magnitud sin desbordar en LLONG_MIN
+    unsigned long long magnitude = num < 0 ? 0ull - (unsigned long long)num
+                                           : (unsigned long long)num;
+    char digits[DIGITS_MAX];
+    size_t count = reversed_digits(digits, magnitude, 10);
+    int negative = num < 0;
+    size_t total = negative + count + (count - 1) / 3;
+
+    BoundedText text;
+    bounded_init(&text, buffer, size);
+    if (negative) bounded_put(&text, "-", 1);
+
     // Si no cabe en el buffer, copiar sin formato
-    if (total >= (int)size) {
-        strncpy(buffer, temp, size - 1);
-        buffer[size - 1] = '\0';
+    if (total >= size) {
+        bounded_put_reversed(&text, digits, count);
+        bounded_finish(&text);
         return;
     }
-    
-    // Insertar separadores desde el final
-    int src = len - 1;
-    int dst = total;
-    buffer[dst--] = '\0';
-    
-    int count = 0;
-    while (src >= negative) {
-        if (count == 3) {
-            buffer[dst--] = separator;
-            count = 0;
-        }
-        buffer[dst--] = temp[src--];
-        count++;
-    }
-    
-    // Copiar signo negativo si existe
-    if (negative) {
-        buffer[0] = '-';
+
+    // Separador cada tres dígitos contando desde el final
+    for (size_t i = count; i > 0; i--) {
+        text.buffer[text.length++] = digits[i - 1];
+        if (i > 1 && (i - 1) % 3 == 0) text.buffer[text.length++] = separator;
     }
+    bounded_finish(&text);
 }
 
 void format_binary(char* buffer, size_t size, unsigned long long num, int show_prefix) {
@@ -50,96 +359,64 @@ void format_binary(char* buffer, size_t size, unsigned long long num, int show_p
     if (!buffer || size == 0) {
         return;
     }
-    
+
     // Necesitamos al menos 2 bytes (1 char + null terminator)
     if (size < 2) {
         buffer[0] = '\0';
         return;
     }
-    
-    char temp[100];
-    int idx = 0;
-    
-    // Caso especial: cero
-    if (num == 0) {
-        if (show_prefix) {
-            snprintf(buffer, size, "0b0");
-        } else {
-            snprintf(buffer, size, "0");
-        }
-        return;
-    }
-    
-    // Convertir a binario (dígitos en orden inverso)
-    unsigned long long n = num;
-    while (n > 0) {
-        temp[idx++] = (n & 1) ? '1' : '0';
-        n >>= 1;
-    }
-    
-    // Calcular espacio necesario
-    int prefix_len = show_prefix ? 2 : 0;  // "0b"
-    int total_needed = prefix_len + idx + 1;  // +1 para null terminator
-    
-    // Si no cabe, truncar apropiadamente
-    if ((size_t)total_needed > size) {
-        // Calcular cuántos dígitos podemos incluir
-        int available_digits = size - prefix_len - 1;
-        
-        if (available_digits <= 0) {
+
+    // Dígitos en orden inverso (un bit por vuelta, sin división)
+    char temp[DIGITS_MAX];
+    size_t idx = 0;
+    do {
+        temp[idx++] = (char)('0' + (num & 1u));
+        num >>= 1;
+    } while (num > 0);
+
+    // Si no cabe, se conservan los bits menos significativos
+    size_t prefix_len = show_prefix ? 2 : 0;  // "0b"
+    if (prefix_len + idx + 1 > size) {
+        if (size <= prefix_len + 1) {
             // No hay espacio ni para un dígito
             buffer[0] = '\0';
             return;
         }
-        
-        // Truncar el número de dígitos
-        idx = available_digits;
+        idx = size - prefix_len - 1;
     }
-    
-    // Construir resultado
-    int offset = 0;
+
+    // Ya se verificó que prefijo + dígitos + NUL caben
+    size_t offset = 0;
     if (show_prefix) {
-        if (size < 3) {  // No hay espacio para "0b" + al menos un dígito
-            buffer[0] = '\0';
-            return;
-        }
         buffer[offset++] = '0';
         buffer[offset++] = 'b';
     }
-    
-    // Copiar dígitos en orden correcto (con verificación de límites)
-    for (int i = idx - 1; i >= 0 && offset < (int)size - 1; i--) {
-        buffer[offset++] = temp[i];
-    }
+    while (idx > 0) buffer[offset++] = temp[--idx];
     buffer[offset] = '\0';
 }
 
-void format_hex(char* buffer, size_t size, unsigned int num, 
+void format_hex(char* buffer, size_t size, unsigned int num,
                 int show_prefix, int padding, int zero_pad) {
     // Validar que el buffer sea válido
     if (!buffer || size == 0) {
         return;
     }
-    
-    if (show_prefix) {
-        if (padding > 0 && zero_pad) {
-            // Verificar que el padding no cause overflow
-            // padding incluye el "0x", así que padding-2 son los dígitos hex
-            if (padding > 2) {
-                snprintf(buffer, size, "0x%0*x", padding - 2, num);
-            } else {
-                snprintf(buffer, size, "0x%x", num);
-            }
-        } else {
-            snprintf(buffer, size, "0x%x", num);
-        }
-    } else {
-        if (padding > 0 && zero_pad) {
-            snprintf(buffer, size, "%0*x", padding, num);
-        } else {
-            snprintf(buffer, size, "%x", num);
-        }
+
+    // Con prefijo el padding incluye el "0x", así que padding-2 son los dígitos
+    int width = 0;
+    if (padding > 0 && zero_pad) {
+        width = show_prefix ? (padding > 2 ? padding - 2 : 0) : padding;
     }
+
+    char digits[DIGITS_MAX];
+    size_t count = reversed_digits(digits, num, 16);
+
+    BoundedText text;
+    bounded_init(&text, buffer, size);
+    if (show_prefix) bounded_put(&text, "0x", 2);
+    if ((size_t)width > count) bounded_fill(&text, '0', (size_t)width - count);
+    bounded_put_reversed(&text, digits, count);
+    bounded_finish(&text);
 }
 
 void format_octal(char* buffer, size_t size, unsigned int num, int show_prefix) {
@@ -147,10 +424,13 @@ void format_octal(char* buffer, size_t size, unsigned int num, int show_prefix)
     if (!buffer || size == 0) {
         return;
     }
-    
-    if (show_prefix) {
-        snprintf(buffer, size, "0o%o", num);
-    } else {
-        snprintf(buffer, size, "%o", num);
-    }
-}
\ No newline at end of file
+
+    char digits[DIGITS_MAX];
+    size_t count = reversed_digits(digits, num, 8);
+
+    BoundedText text;
+    bounded_init(&text, buffer, size);
+    if (show_prefix) bounded_put(&text, "0o", 2);
+    bounded_put_reversed(&text, digits, count);
+    bounded_finish(&text);
+}
@@ -0,0 +1,77 @@
+/**
+ * @file output_buffer.c
+ * @brief Implementación del buffer de salida sin stdio
+ */
+
+#include "output_buffer.h"
+#include "text_alignment.h"
+#include <string.h>
+
+void output_init(OutputBuffer* out, char* storage, size_t capacity, const CPrintSink* sink) {
+    out->data = storage;
+    out->length = 0;
+    out->capacity = capacity;
+    out->total = 0;
+    out->written = 0;
+    out->sink = sink;
+    if (capacity > 0) storage[0] = '\0';
+}
+
+void output_write(OutputBuffer* out, const char* data, size_t len) {
+    out->total += len;
+
+    while (len > 0) {
+        // Sin sink se reserva un byte para el terminador
+        size_t limit = out->sink ? out->capacity : (out->capacity ? out->capacity - 1 : 0);
+        size_t room = limit > out->length ? limit - out->length : 0;
+
+        if (room == 0) {
+            if (!out->sink) return;     // Truncar
+            output_flush(out);
+            continue;
+        }
+
+        size_t chunk = len < room ? len : room;
+        memcpy(out->data + out->length, data, chunk);
+        out->length += chunk;
+        data += chunk;
+        len -= chunk;
+    }
+}
+
+void output_fill(OutputBuffer* out, char ch, size_t count) {
+    char block[64];
+    memset(block, ch, sizeof(block));
+
+    while (count > 0) {
+        size_t chunk = count < sizeof(block) ? count : sizeof(block);
+        output_write(out, block, chunk);
+        count -= chunk;
+    }
+}
+
+void output_write_aligned(OutputBuffer* out, const PatternStyle* style,
+                          const char* value, size_t len) {
+    size_t width = style->has_alignment && style->width > 0 ? (size_t)style->width : 0;
+    size_t right;
+    size_t left = alignment_padding(style->align, width, len, &right);
+
+    output_fill(out, style->fill_char, left);
+    output_write(out, value, len);
+    output_fill(out, style->fill_char, right);
+}
+
+size_t output_flush(OutputBuffer* out) {
+    if (!out->sink) {
+        if (out->capacity > 0) out->data[out->length] = '\0';
+        return 0;
+    }
+
+    size_t written = 0;
+    if (out->length > 0) {
+        written = out->sink->write(out->sink->ctx, out->data, out->length);
+        out->written += written;
+    }
+    out->length = 0;
+    return written;
+}
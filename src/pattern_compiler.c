@@ -0,0 +1,231 @@
+/**
+ * @file pattern_compiler.c
+ * @brief Implementación de la compilación y caché de patrones
+ */
+
+#include "pattern_compiler.h"
+#include "c_print_config.h"
+#include "c_print_stats.h"
+#include <string.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifndef _WIN32
+#include <pthread.h>
+#endif
+
+#define PATTERN_CACHE_SIZE 64
+#define PATTERN_CACHE_PROBES 4
+
+// ============================================================================
+// COMPILACIÓN
+// ============================================================================
+
+static void add_literal(PatternSegment* segments, size_t* count,
+                        const char* start, const char* end) {
+    if (end <= start) return;
+
+    if (segments) {
+        PatternSegment* seg = &segments[*count];
+        memset(seg, 0, sizeof(*seg));
+        seg->kind = SEGMENT_LITERAL;
+        seg->text = start;
+        seg->length = (size_t)(end - start);
+    }
+    (*count)++;
+}
+
+/**
+ * @brief Recorre el patrón con las mismas reglas que c_print()
+ *
+ * Con segments == NULL solo cuenta segmentos y campos.
+ */
+static void scan_pattern(const char* pattern, PatternSegment* segments, char* field_types,
+                         size_t* segment_count, size_t* field_count) {
+    const char* p = pattern;
+    const char* run_start = pattern;
+
+    *segment_count = 0;
+    *field_count = 0;
+
+    while (*p) {
+        if (*p == '{') {
+            PatternStyle style;
+
+            if (parse_pattern(p, &style)) {
+                add_literal(segments, segment_count, run_start, p);
+
+                if (segments) {
+                    PatternSegment* seg = &segments[*segment_count];
+                    memset(seg, 0, sizeof(*seg));
+                    seg->kind = SEGMENT_FIELD;
+                    seg->style = style;
+                    seg->consumes_argument = is_known_format_type(style.format_type);
+
+                    if (style.has_color || style.has_bg || style.has_style) {
+                        seg->escape_length = (unsigned char)format_ansi_codes(
+                            seg->escape, sizeof(seg->escape),
+                            style.text_color, style.bg_color, style.style);
+                    }
+
+                    if (seg->consumes_argument) {
+                        field_types[*field_count] = style.format_type;
+                    }
+                }
+                (*segment_count)++;
+                if (is_known_format_type(style.format_type)) {
+                    (*field_count)++;
+                }
+
+                // Avanzar hasta después del }
+                while (*p && *p != '}') p++;
+                if (*p == '}') p++;
+                run_start = p;
+            } else {
+                // No es un patrón válido: forma parte del literal
+                p++;
+            }
+        } else if (*p == '\\' && *(p + 1) == '{') {
+            // Escape para {: el literal continúa desde la llave
+            add_literal(segments, segment_count, run_start, p);
+            run_start = p + 1;
+            p += 2;
+        } else {
+            p++;
+        }
+    }
+
+    add_literal(segments, segment_count, run_start, p);
+}
+
+CompiledPattern* compile_pattern(const char* pattern, const CPrintAllocator* allocator) {
+    if (!pattern) return NULL;
+    if (!allocator) allocator = c_print_get_allocator();
+
+    size_t segment_count, field_count;
+    scan_pattern(pattern, NULL, NULL, &segment_count, &field_count);
+
+    size_t length = strlen(pattern);
+    size_t block_size = sizeof(CompiledPattern)
+                      + segment_count * sizeof(PatternSegment)
+                      + field_count + 1
+                      + length + 1;
+
+    char* block = cp_alloc(allocator, block_size);
+    if (!block) return NULL;
+
+    CompiledPattern* compiled = (CompiledPattern*)block;
+    compiled->segments = (PatternSegment*)(block + sizeof(CompiledPattern));
+    compiled->field_types = (char*)(compiled->segments + segment_count);
+    char* source = compiled->field_types + field_count + 1;
+
+    memcpy(source, pattern, length + 1);
+    compiled->source = source;
+    compiled->source_length = length;
+    compiled->allocator = allocator;
+    compiled->block_size = block_size;
+
+    // Los literales apuntan a la copia, no al patrón del llamador
+    scan_pattern(source, compiled->segments, compiled->field_types,
+                 &compiled->segment_count, &compiled->field_count);
+    compiled->field_types[compiled->field_count] = '\0';
+
+    return compiled;
+}
+
+void free_compiled_pattern(CompiledPattern* compiled) {
+    if (!compiled) return;
+    cp_dealloc(compiled->allocator, compiled, compiled->block_size);
+}
+
+// ============================================================================
+// CACHÉ THREAD-LOCAL
+// ============================================================================
+
+typedef struct {
+    const char* key;                // Dirección del patrón del llamador
+    CompiledPattern* compiled;
+} CacheEntry;
+
+static CP_THREAD_LOCAL CacheEntry pattern_cache[PATTERN_CACHE_SIZE];
+
+#ifndef _WIN32
+// Al terminar el hilo su caché se libera sola (igual que los bloques de stats)
+static CP_THREAD_LOCAL bool cache_registered;
+static pthread_key_t release_key;
+static pthread_once_t release_once = PTHREAD_ONCE_INIT;
+
+static void release_cache(void* ptr) {
+    (void)ptr;
+    clear_pattern_cache();
+    // Si otro destructor vuelve a imprimir, el siguiente fallo se registra de nuevo
+    cache_registered = false;
+}
+
+static void create_release_key(void) {
+    pthread_key_create(&release_key, release_cache);
+}
+
+static void register_cache(void) {
+    if (cache_registered) return;
+    pthread_once(&release_once, create_release_key);
+    pthread_setspecific(release_key, pattern_cache);
+    cache_registered = true;
+}
+#else
+static void register_cache(void) {}
+#endif
+
+static size_t cache_index(const char* pattern) {
+    uintptr_t addr = (uintptr_t)pattern;
+    addr ^= addr >> 17;
+    addr *= (uintptr_t)0x9E3779B97F4A7C15ull;
+    return (size_t)(addr >> 7) & (PATTERN_CACHE_SIZE - 1);
+}
+
+const CompiledPattern* get_compiled_pattern(const char* pattern) {
+    if (!pattern) return NULL;
+
+    // Sondeo lineal corto: dos patrones con el mismo índice no se expulsan
+    // entre sí (tras el calentamiento un hit nunca vuelve a reservar)
+    size_t home = cache_index(pattern);
+    CacheEntry* entry = NULL;
+
+    for (size_t probe = 0; probe < PATTERN_CACHE_PROBES; probe++) {
+        CacheEntry* slot = &pattern_cache[(home + probe) & (PATTERN_CACHE_SIZE - 1)];
+
+        if (slot->key == pattern && slot->compiled &&
+            strcmp(slot->compiled->source, pattern) == 0) {
+            CP_STAT_ADD(CP_STAT_CACHE_HITS, 1);
+            return slot->compiled;
+        }
+        if (slot->key == pattern) {     // Misma dirección, texto distinto
+            entry = slot;
+            break;
+        }
+        if (!entry && !slot->compiled) entry = slot;
+    }
+
+    // Sin hueco libre se reemplaza la entrada de la posición natural
+    if (!entry) entry = &pattern_cache[home];
+
+    CP_STAT_ADD(CP_STAT_CACHE_MISSES, 1);
+
+    // La caché usa siempre el heap: sobrevive a cualquier arena
+    CompiledPattern* compiled = compile_pattern(pattern, cp_heap_allocator());
+    if (!compiled) return NULL;
+
+    register_cache();
+    free_compiled_pattern(entry->compiled);
+    entry->key = pattern;
+    entry->compiled = compiled;
+    return compiled;
+}
+
+void clear_pattern_cache(void) {
+    for (size_t i = 0; i < PATTERN_CACHE_SIZE; i++) {
+        free_compiled_pattern(pattern_cache[i].compiled);
+        pattern_cache[i].key = NULL;
+        pattern_cache[i].compiled = NULL;
+    }
+}
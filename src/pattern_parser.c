@@ -7,8 +7,37 @@
 #include "color_parser.h"
 #include "string_utils.h"
 #include <string.h>
-#include <stdlib.h>
-#include <ctype.h>
+
+bool is_known_format_type(char format_type) {
+    switch (format_type) {
+        case 's': case 'd': case 'i': case 'f': case 'c':
+        case 'b': case 'x': case 'o': case 'u': case 'l':
+            return true;
+        default:
+            return false;
+    }
+}
+
+/**
+ * @brief Siguiente token separado por ':' (mismo recorrido que strtok_r)
+ *
+ * Salta los separadores consecutivos, termina el token con '\0' y deja
+ * el cursor después de él. Devuelve NULL al final del buffer.
+ */
+static char* next_token(char** cursor) {
+    char* start = *cursor;
+    while (*start == ':') start++;
+    if (*start == '\0') {
+        *cursor = start;
+        return NULL;
+    }
+
+    char* end = start;
+    while (*end && *end != ':') end++;
+    if (*end) *end++ = '\0';
+    *cursor = end;
+    return start;
+}
 
 bool is_format_modifier(const char* token, PatternStyle* style) {
     if (!token || strlen(token) == 0) return false;
@@ -16,22 +45,22 @@ bool is_format_modifier(const char* token, PatternStyle* style) {
     const char* ptr = token;
     
     // Detectar precisión (.2, .4, etc.)
-    if (*ptr == '.' && isdigit(*(ptr + 1))) {
-        style->precision = atoi(ptr + 1);
+    if (*ptr == '.' && is_ascii_digit(*(ptr + 1))) {
+        style->precision = parse_digits(ptr + 1);
         style->has_precision = 1;
         return true;
     }
     
     // Detectar padding con ceros (05, 08, etc.)
-    if (*ptr == '0' && isdigit(*(ptr + 1))) {
-        style->padding = atoi(ptr + 1);
+    if (*ptr == '0' && is_ascii_digit(*(ptr + 1))) {
+        style->padding = parse_digits(ptr + 1);
         style->zero_pad = 1;
         return true;
     }
     
     // Detectar padding normal (solo número sin 0 al inicio)
-    if (isdigit(*ptr) && *ptr != '0') {
-        style->padding = atoi(ptr);
+    if (is_ascii_digit(*ptr) && *ptr != '0') {
+        style->padding = parse_digits(ptr);
         style->zero_pad = 0;
         return true;
     }
@@ -101,8 +130,8 @@ bool parse_pattern(const char* pattern, PatternStyle* style) {
     style->precision = 6;  // Precisión por defecto para floats
     
     // Dividir por ':' y procesar tokens
-    char* saveptr;
-    char* token = strtok_r(buffer, ":", &saveptr);
+    char* cursor = buffer;
+    char* token = next_token(&cursor);
     int part = 0;
     
     while (token != NULL) {
@@ -160,7 +189,7 @@ bool parse_pattern(const char* pattern, PatternStyle* style) {
             }
         }
         
-        token = strtok_r(NULL, ":", &saveptr);
+        token = next_token(&cursor);
         part++;
     }
     
@@ -4,15 +4,15 @@
  */
 
 #include "string_utils.h"
-#include <ctype.h>
 #include <string.h>
-#include <stdlib.h>
+#include <limits.h>
 
+// Solo ASCII: el resultado no depende del locale
 void to_lowercase(char* str) {
     if (!str) return;
     
     for (int i = 0; str[i]; i++) {
-        str[i] = tolower((unsigned char)str[i]);
+        if (str[i] >= 'A' && str[i] <= 'Z') str[i] = (char)(str[i] - 'A' + 'a');
     }
 }
 
@@ -20,12 +20,25 @@ bool is_number(const char* str) {
     if (!str || *str == '\0') return false;
     
     while (*str) {
-        if (!isdigit((unsigned char)*str)) return false;
+        if (!is_ascii_digit(*str)) return false;
         str++;
     }
     return true;
 }
 
+int parse_digits(const char* str) {
+    if (!str) return 0;
+
+    int value = 0;
+    while (is_ascii_digit(*str)) {
+        int digit = *str - '0';
+        if (value > (INT_MAX - digit) / 10) return INT_MAX;
+        value = value * 10 + digit;
+        str++;
+    }
+    return value;
+}
+
 void trim_whitespace(char* str) {
     if (!str) return;
     
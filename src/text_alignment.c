@@ -5,58 +5,45 @@
 
 #include "text_alignment.h"
 #include "string_utils.h"
-#include <stdio.h>
 #include <string.h>
-#include <stdlib.h>
+
+size_t alignment_padding(TextAlign align, size_t width, size_t len, size_t* right) {
+    size_t padding = len < width ? width - len : 0;
+    size_t left;
+
+    switch (align) {
+        case ALIGN_LEFT:   left = 0; break;
+        case ALIGN_RIGHT:  left = padding; break;
+        case ALIGN_CENTER: left = padding / 2; break;
+        default:           left = padding = 0; break;
+    }
+
+    *right = padding - left;
+    return left;
+}
+
+#ifndef C_PRINT_FREESTANDING
+#include <stdio.h>
+
+static void print_fill(char fill_char, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        printf("%c", fill_char);
+    }
+}
 
 void print_aligned(const char* text, TextAlign align, int width, char fill_char) {
     if (!text) return;
     
-    int text_len = strlen(text);
-    
-    // Si el texto es más largo que el ancho, imprimir sin padding
-    if (text_len >= width) {
-        printf("%s", text);
-        return;
-    }
+    size_t right;
+    size_t left = alignment_padding(align, width > 0 ? (size_t)width : 0, strlen(text), &right);
     
-    int padding = width - text_len;
-    
-    switch (align) {
-        case ALIGN_LEFT:  // <
-            printf("%s", text);
-            for (int i = 0; i < padding; i++) {
-                printf("%c", fill_char);
-            }
-            break;
-            
-        case ALIGN_RIGHT:  // >
-            for (int i = 0; i < padding; i++) {
-                printf("%c", fill_char);
-            }
-            printf("%s", text);
-            break;
-            
-        case ALIGN_CENTER:  // ^
-            {
-                int left_pad = padding / 2;
-                int right_pad = padding - left_pad;
-                for (int i = 0; i < left_pad; i++) {
-                    printf("%c", fill_char);
-                }
-                printf("%s", text);
-                for (int i = 0; i < right_pad; i++) {
-                    printf("%c", fill_char);
-                }
-            }
-            break;
-            
-        default:
-            printf("%s", text);
-            break;
-    }
+    print_fill(fill_char, left);
+    printf("%s", text);
+    print_fill(fill_char, right);
 }
 
+#endif // !C_PRINT_FREESTANDING
+
 bool is_alignment(const char* token, TextAlign* align, int* width, char* fill_char) {
     if (!token || strlen(token) < 2) return false;
     
@@ -76,7 +63,7 @@ bool is_alignment(const char* token, TextAlign* align, int* width, char* fill_ch
         // Verificar que después venga un número
         if (is_number(ptr + 1)) {
             *align = (TextAlign)first;
-            *width = atoi(ptr + 1);
+            *width = parse_digits(ptr + 1);
             return true;
         }
     }
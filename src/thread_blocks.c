@@ -0,0 +1,69 @@
+/**
+ * @file thread_blocks.c
+ * @brief Implementación del registro de bloques por hilo
+ */
+
+#include "thread_blocks.h"
+#include <stdlib.h>
+
+#ifndef _WIN32
+
+static pthread_mutex_t key_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static void release_thread_block(void* ptr) {
+    ThreadBlock* block = (ThreadBlock*)ptr;
+    if (block->list->release) block->list->release(block);
+    atomic_store(&block->in_use, false);
+}
+
+/**
+ * @brief Registra el bloque para liberarlo cuando termine el hilo
+ */
+static void register_release(ThreadBlockList* list, ThreadBlock* block) {
+    if (!atomic_load(&list->key_ready)) {
+        pthread_mutex_lock(&key_lock);
+        if (!atomic_load(&list->key_ready)) {
+            pthread_key_create(&list->key, release_thread_block);
+            atomic_store(&list->key_ready, true);
+        }
+        pthread_mutex_unlock(&key_lock);
+    }
+    pthread_setspecific(list->key, block);
+}
+
+#else
+
+static void register_release(ThreadBlockList* list, ThreadBlock* block) {
+    (void)list;
+    (void)block;
+}
+
+#endif
+
+ThreadBlock* thread_block_acquire(ThreadBlockList* list) {
+    ThreadBlock* block = NULL;
+
+    for (ThreadBlock* it = atomic_load(&list->head); it; it = it->next) {
+        bool expected = false;
+        if (atomic_compare_exchange_strong(&it->in_use, &expected, true)) {
+            block = it;
+            break;
+        }
+    }
+
+    if (!block) {
+        block = calloc(1, list->block_size);
+        if (!block) return NULL;
+        atomic_init(&block->in_use, true);
+        block->list = list;
+        if (list->init) list->init(block);
+
+        ThreadBlock* head = atomic_load(&list->head);
+        do {
+            block->next = head;
+        } while (!atomic_compare_exchange_weak(&list->head, &head, block));
+    }
+
+    register_release(list, block);
+    return block;
+}
@@ -49,6 +49,21 @@ const lib = dlopen(libraryPath, {
     args: [],
     returns: FFIType.void,
   },
+
+  // size_t c_print_argv(const char* pattern, const CPrintArg* args, size_t count,
+  //                     char* buffer, size_t size)
+  c_print_argv: {
+    args: [FFIType.ptr, FFIType.ptr, FFIType.u64, FFIType.ptr, FFIType.u64],
+    returns: FFIType.u64,
+  },
+
+  // size_t c_print_argv_batch(const char* pattern, const CPrintArg* args,
+  //                           size_t fields_per_record, size_t records,
+  //                           char* buffer, size_t size)
+  c_print_argv_batch: {
+    args: [FFIType.ptr, FFIType.ptr, FFIType.u64, FFIType.u64, FFIType.ptr, FFIType.u64],
+    returns: FFIType.u64,
+  },
 });
 
 const { symbols } = lib;
@@ -110,8 +125,77 @@ const TextStyle = {
   STYLE_STRIKETHROUGH: 9,
 };
 
+// CPrintArgType (c_print_argv.h); CPrintArg ocupa 16 bytes: tipo en 0, valor en 8
+const CPrintArgType = {
+  STRING: 0,
+  INT: 1,
+  UINT: 2,
+  LONG: 3,
+  ULONG: 4,
+  DOUBLE: 5,
+  CHAR: 6,
+  BOOL: 7,
+};
+const CPRINT_ARG_SIZE = 16;
+
+const encoder = new TextEncoder();
+const decoder = new TextDecoder();
+
+function cString(text) {
+  return encoder.encode(`${text}\0`);
+}
+
+// Serializa valores JS a un array de CPrintArg. Los strings se guardan en
+// keepAlive para que su memoria siga viva durante la llamada.
+function packArgs(values, keepAlive) {
+  const buffer = new ArrayBuffer(Math.max(values.length, 1) * CPRINT_ARG_SIZE);
+  const view = new DataView(buffer);
+
+  values.forEach((value, i) => {
+    const offset = i * CPRINT_ARG_SIZE;
+    if (typeof value === 'string') {
+      const bytes = cString(value);
+      keepAlive.push(bytes);
+      view.setInt32(offset, CPrintArgType.STRING, true);
+      view.setBigUint64(offset + 8, BigInt(ptr(bytes)), true);
+    } else if (Number.isInteger(value)) {
+      view.setInt32(offset, CPrintArgType.INT, true);
+      view.setInt32(offset + 8, value, true);
+    } else {
+      view.setInt32(offset, CPrintArgType.DOUBLE, true);
+      view.setFloat64(offset + 8, value, true);
+    }
+  });
+
+  return new Uint8Array(buffer);
+}
+
+const output = new Uint8Array(64 * 1024);
+
 // Wrapper functions para una API más amigable en JavaScript
 const cprint = {
+  // Motor de patrones completo: format("{s:red} {d:,}", "total", 1234)
+  format(pattern, ...values) {
+    const keepAlive = [];
+    const patternBytes = cString(pattern);
+    const args = packArgs(values, keepAlive);
+    const length = Number(symbols.c_print_argv(ptr(patternBytes), ptr(args), values.length,
+                                               ptr(output), output.length));
+    return decoder.decode(output.subarray(0, Math.min(length, output.length - 1)));
+  },
+
+  // Varios registros con el mismo patrón en una sola llamada FFI
+  formatBatch(pattern, records) {
+    if (records.length === 0) return '';
+    const keepAlive = [];
+    const patternBytes = cString(pattern);
+    const args = packArgs(records.flat(), keepAlive);
+    const length = Number(symbols.c_print_argv_batch(ptr(patternBytes), ptr(args),
+                                                     records[0].length, records.length,
+                                                     ptr(output), output.length));
+    return decoder.decode(output.subarray(0, Math.min(length, output.length - 1)));
+  },
+
   // Imprimir con color de texto
   color(text, color) {
     symbols.c_print_color(text, color);
@@ -296,6 +380,16 @@ cprint.styled("●", TextColor.COLOR_BRIGHT_RED, BackgroundColor.BG_RESET, TextS
 console.log(" API Externa: Inactivo");
 console.log();
 
+console.log("========== 9. Motor de patrones (c_print_argv) ==========");
+process.stdout.write(cprint.format("{s:green:bold} tiene {d:cyan} años, saldo ${f:.2}\n",
+                                   "Juan", 25, 1234.5));
+process.stdout.write(cprint.formatBatch("{s:<10} {d:>6:yellow}\n", [
+  ["web", 200],
+  ["db", 15],
+  ["cache", 4096],
+]));
+console.log();
+
 console.log("╔══════════════════════════════════════════════════════════════╗");
 console.log("║                 Fin de ejemplos - ¡Gracias!                  ║");
 console.log("╚══════════════════════════════════════════════════════════════╝");
@@ -0,0 +1,340 @@
+/**
+ * @file test_alloc.c
+ * @brief Tests unitarios para allocators, arena y pool de builders
+ *
+ * Con glibc el test además interpone malloc/free para comprobar que un
+ * hilo que termina no deja los builders de su pool en el heap.
+ */
+
+#include "c_print_alloc.h"
+#include "c_print_builder.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <assert.h>
+#include <pthread.h>
+#include <stdatomic.h>
+
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+
+#define TEST(name) static void test_##name(void)
+#define RUN_TEST(name) do { \
+    printf("  Running: %s... ", #name); \
+    test_##name(); \
+    printf("✓\n"); \
+    tests_passed++; \
+} while(0)
+
+static int tests_passed = 0;
+
+// Allocator que cuenta llamadas y delega en el heap
+static int counted_allocs = 0;
+static int counted_frees = 0;
+
+static void* counting_alloc(void* ctx, size_t size) {
+    (void)ctx;
+    counted_allocs++;
+    return malloc(size);
+}
+
+static void* counting_realloc(void* ctx, void* ptr, size_t old_size, size_t new_size) {
+    (void)ctx;
+    (void)old_size;
+    counted_allocs++;
+    return realloc(ptr, new_size);
+}
+
+static void counting_free(void* ctx, void* ptr, size_t size) {
+    (void)ctx;
+    (void)size;
+    counted_frees++;
+    free(ptr);
+}
+
+static const CPrintAllocator counting_allocator = {
+    counting_alloc, counting_realloc, counting_free, NULL
+};
+
+// ============================================================================
+// MALLOC INTERPUESTO (glibc)
+// ============================================================================
+
+// Bytes vivos en el heap de todo el proceso
+static atomic_long live_bytes;
+
+#ifdef __GLIBC__
+extern void* __libc_malloc(size_t size);
+extern void* __libc_calloc(size_t count, size_t size);
+extern void* __libc_realloc(void* ptr, size_t size);
+extern void __libc_free(void* ptr);
+
+void* malloc(size_t size) {
+    void* ptr = __libc_malloc(size);
+    if (ptr) atomic_fetch_add(&live_bytes, (long)malloc_usable_size(ptr));
+    return ptr;
+}
+
+void* calloc(size_t count, size_t size) {
+    void* ptr = __libc_calloc(count, size);
+    if (ptr) atomic_fetch_add(&live_bytes, (long)malloc_usable_size(ptr));
+    return ptr;
+}
+
+void* realloc(void* ptr, size_t size) {
+    long before = ptr ? (long)malloc_usable_size(ptr) : 0;
+    void* moved = __libc_realloc(ptr, size);
+    if (moved) atomic_fetch_add(&live_bytes, (long)malloc_usable_size(moved) - before);
+    else if (size == 0) atomic_fetch_sub(&live_bytes, before);
+    return moved;
+}
+
+void free(void* ptr) {
+    if (ptr) atomic_fetch_sub(&live_bytes, (long)malloc_usable_size(ptr));
+    __libc_free(ptr);
+}
+#endif
+
+// ============================================================================
+// TESTS DEL ARENA
+// ============================================================================
+
+TEST(arena_allocates_aligned_blocks) {
+    char memory[256];
+    CPrintArena arena;
+    cp_arena_init(&arena, memory, sizeof(memory));
+
+    const CPrintAllocator* a = cp_arena_allocator(&arena);
+    void* p1 = cp_alloc(a, 3);
+    void* p2 = cp_alloc(a, 5);
+
+    assert(p1 != NULL && p2 != NULL);
+    assert(((uintptr_t)p2 % 16) == 0);
+    assert((char*)p2 > (char*)p1);
+}
+
+TEST(arena_returns_null_when_exhausted) {
+    char memory[64];
+    CPrintArena arena;
+    cp_arena_init(&arena, memory, sizeof(memory));
+
+    void* p = cp_alloc(cp_arena_allocator(&arena), 128);
+    assert(p == NULL);
+}
+
+TEST(arena_realloc_last_block_in_place) {
+    char memory[256];
+    CPrintArena arena;
+    cp_arena_init(&arena, memory, sizeof(memory));
+
+    const CPrintAllocator* a = cp_arena_allocator(&arena);
+    char* p = cp_alloc(a, 16);
+    strcpy(p, "hello");
+
+    char* q = cp_realloc(a, p, 16, 64);
+    assert(q == p);
+    assert(strcmp(q, "hello") == 0);
+}
+
+TEST(arena_reset_reclaims_everything) {
+    CPrintArena arena;
+    bool created = cp_arena_create(&arena, 1024);
+    assert(created);
+
+    cp_alloc(cp_arena_allocator(&arena), 100);
+    assert(cp_arena_used(&arena) >= 100);
+
+    cp_arena_reset(&arena);
+    assert(cp_arena_used(&arena) == 0);
+
+    cp_arena_destroy(&arena);
+}
+
+TEST(builder_on_arena) {
+    CPrintArena arena;
+    bool created = cp_arena_create(&arena, 4096);
+    assert(created);
+
+    for (int request = 0; request < 3; request++) {
+        CPrintBuilder* b = cp_new_with_allocator(cp_arena_allocator(&arena));
+        assert(b != NULL);
+
+        for (int i = 0; i < 50; i++) {
+            cp_text(b, "0123456789");
+        }
+        char* result = cp_to_string(b);
+        assert(strlen(result) == 500);
+
+        // Sin cp_free: el reset del arena recupera todo
+        cp_arena_reset(&arena);
+    }
+
+    cp_arena_destroy(&arena);
+}
+
+// ============================================================================
+// TESTS DEL ALLOCATOR GLOBAL Y POR BUILDER
+// ============================================================================
+
+TEST(custom_allocator_per_builder) {
+    counted_allocs = 0;
+    counted_frees = 0;
+
+    CPrintBuilder* b = cp_new_with_allocator(&counting_allocator);
+    cp_text(b, "short");
+    assert(counted_allocs == 1);    // Solo la estructura
+
+    for (int i = 0; i < 100; i++) {
+        cp_text(b, "0123456789");
+    }
+    assert(counted_allocs > 1);     // Desbordamiento del buffer interno
+
+    cp_free(b);
+    assert(counted_frees == 2);
+}
+
+TEST(global_allocator_used_by_cp_new) {
+    counted_allocs = 0;
+
+    c_print_set_allocator(&counting_allocator);
+    CPrintBuilder* b = cp_new();
+    c_print_set_allocator(NULL);
+
+    assert(counted_allocs == 1);
+    assert(c_print_get_allocator() == cp_heap_allocator());
+
+    cp_free(b);
+}
+
+TEST(stack_builder_set_allocator) {
+    char memory[1024];
+    CPrintArena arena;
+    cp_arena_init(&arena, memory, sizeof(memory));
+
+    CPrintBuilderStorage storage;
+    CPrintBuilder* b = cp_init(CP_BUILDER(&storage), NULL, 0);
+    cp_set_allocator(b, cp_arena_allocator(&arena));
+
+    for (int i = 0; i < 30; i++) {
+        cp_text(b, "0123456789");
+    }
+    assert(cp_size(b) == 300);
+    assert(cp_arena_used(&arena) > 0);
+
+    cp_free(b);
+}
+
+// ============================================================================
+// TESTS DEL POOL
+// ============================================================================
+
+TEST(pool_reuses_builders) {
+    CPrintBuilder* b1 = cp_pool_acquire();
+    cp_text(b1, "first");
+    cp_pool_release(b1);
+
+    CPrintBuilder* b2 = cp_pool_acquire();
+    assert(b2 == b1);
+    assert(cp_is_empty(b2));
+
+    cp_pool_release(b2);
+    cp_pool_drain();
+}
+
+TEST(pool_keeps_grown_buffer) {
+    CPrintBuilder* b = cp_pool_acquire();
+    for (int i = 0; i < 100; i++) {
+        cp_text(b, "0123456789");
+    }
+    cp_pool_release(b);
+
+    counted_allocs = 0;
+    c_print_set_allocator(&counting_allocator);
+
+    b = cp_pool_acquire();
+    for (int i = 0; i < 100; i++) {
+        cp_text(b, "0123456789");
+    }
+
+    c_print_set_allocator(NULL);
+    assert(counted_allocs == 0);
+
+    cp_pool_release(b);
+    cp_pool_drain();
+}
+
+#define SHORT_LIVED_THREADS 20
+
+static void* pooling_main(void* arg) {
+    (void)arg;
+    CPrintBuilder* builders[3];
+    for (int i = 0; i < 3; i++) {
+        builders[i] = cp_pool_acquire();
+        for (int j = 0; j < 50; j++) cp_text(builders[i], "0123456789");
+    }
+    // Termina sin cp_pool_drain(): el pool se libera al salir del hilo
+    for (int i = 0; i < 3; i++) cp_pool_release(builders[i]);
+    return NULL;
+}
+
+TEST(pool_freed_at_thread_exit) {
+#ifdef __GLIBC__
+    // Un primer hilo calienta la caché de pilas y el TLS de glibc
+    pthread_t thread;
+    int rc = pthread_create(&thread, NULL, pooling_main, NULL);
+    assert(rc == 0);
+    pthread_join(thread, NULL);
+
+    long before = atomic_load(&live_bytes);
+    for (int t = 0; t < SHORT_LIVED_THREADS; t++) {
+        rc = pthread_create(&thread, NULL, pooling_main, NULL);
+        assert(rc == 0);
+        pthread_join(thread, NULL);
+    }
+    long growth = atomic_load(&live_bytes) - before;
+
+    // Sin liberar, cada hilo dejaría tres builders con buffers de 500 bytes
+    assert(growth < 1024);
+#endif
+}
+
+// ============================================================================
+// MAIN
+// ============================================================================
+
+int main(void) {
+    printf("\n");
+    printf("═══════════════════════════════════════════════════════════\n");
+    printf("  Allocators - Unit Tests\n");
+    printf("═══════════════════════════════════════════════════════════\n");
+    printf("\n");
+
+    printf("Arena:\n");
+    RUN_TEST(arena_allocates_aligned_blocks);
+    RUN_TEST(arena_returns_null_when_exhausted);
+    RUN_TEST(arena_realloc_last_block_in_place);
+    RUN_TEST(arena_reset_reclaims_everything);
+    RUN_TEST(builder_on_arena);
+    printf("\n");
+
+    printf("Allocator Global y por Builder:\n");
+    RUN_TEST(custom_allocator_per_builder);
+    RUN_TEST(global_allocator_used_by_cp_new);
+    RUN_TEST(stack_builder_set_allocator);
+    printf("\n");
+
+    printf("Pool Thread-Local:\n");
+    RUN_TEST(pool_reuses_builders);
+    RUN_TEST(pool_keeps_grown_buffer);
+    RUN_TEST(pool_freed_at_thread_exit);
+    printf("\n");
+
+    printf("═══════════════════════════════════════════════════════════\n");
+    printf("  Results: %d tests passed ✓\n", tests_passed);
+    printf("═══════════════════════════════════════════════════════════\n");
+    printf("\n");
+
+    return 0;
+}
@@ -0,0 +1,146 @@
+/**
+ * @file test_argv.c
+ * @brief Tests unitarios para la entrada no variádica (c_print_argv)
+ */
+
+#include "c_print_argv.h"
+#include "c_print.h"
+#include "pattern_compiler.h"
+#include <stdio.h>
+#include <string.h>
+#include <stddef.h>
+#include <assert.h>
+
+#define TEST(name) static void test_##name(void)
+#define RUN_TEST(name) do { \
+    fprintf(stderr, "  Running: %s... ", #name); \
+    test_##name(); \
+    fprintf(stderr, "✓\n"); \
+    tests_passed++; \
+} while(0)
+
+static int tests_passed = 0;
+
+static CPrintArg arg_str(const char* s) {
+    CPrintArg arg;
+    arg.type = CPRINT_ARG_STRING;
+    arg.value.s = s;
+    return arg;
+}
+
+static CPrintArg arg_int(int i) {
+    CPrintArg arg;
+    arg.type = CPRINT_ARG_INT;
+    arg.value.i = i;
+    return arg;
+}
+
+static CPrintArg arg_double(double d) {
+    CPrintArg arg;
+    arg.type = CPRINT_ARG_DOUBLE;
+    arg.value.d = d;
+    return arg;
+}
+
+static void expect_string(const char* got, const char* expected) {
+    if (strcmp(got, expected) != 0) {
+        fprintf(stderr, "\n  Expected: '%s'\n  Got:      '%s'\n", expected, got);
+        assert(0);
+    }
+}
+
+// ============================================================================
+// c_print_argv
+// ============================================================================
+
+TEST(renders_into_buffer) {
+    CPrintArg args[] = { arg_str("Ana"), arg_int(1234567), arg_double(2.5) };
+    char buffer[128];
+
+    size_t len = c_print_argv("{s:<5}|{d:,}|{f:.1:green}", args, 3, buffer, sizeof(buffer));
+    expect_string(buffer, "Ana  |1,234,567|\033[32m2.5\033[0m");
+    assert(len == strlen(buffer));
+}
+
+TEST(truncates_like_snprintf) {
+    CPrintArg args[] = { arg_str("abcdefgh") };
+    char buffer[5];
+
+    size_t len = c_print_argv("[{s}]", args, 1, buffer, sizeof(buffer));
+    assert(len == 10);
+    expect_string(buffer, "[abc");
+
+    // Consulta de tamaño sin buffer
+    len = c_print_argv("[{s}]", args, 1, NULL, 0);
+    assert(len == 10);
+}
+
+TEST(type_errors_inline) {
+    CPrintArg args[] = { arg_int(5) };
+    char buffer[128];
+
+    c_print_argv("{s}", args, 1, buffer, sizeof(buffer));
+    expect_string(buffer, "\033[1;31m{? expected string, got int}\033[0m");
+}
+
+TEST(ffi_layout) {
+    // Los bindings escriben el tipo en el offset 0 y el valor en el 8 (64 bits)
+    assert(offsetof(CPrintArg, type) == 0);
+    if (sizeof(void*) == 8) {
+        assert(offsetof(CPrintArg, value) == 8);
+        assert(sizeof(CPrintArg) == 16);
+    }
+}
+
+// ============================================================================
+// c_print_argv_batch
+// ============================================================================
+
+TEST(batch_renders_all_records) {
+    CPrintArg args[] = {
+        arg_str("a"), arg_int(1),
+        arg_str("b"), arg_int(22),
+        arg_str("c"), arg_int(333),
+    };
+    char buffer[128];
+
+    size_t len = c_print_argv_batch("{s}={d:03}\n", args, 2, 3, buffer, sizeof(buffer));
+    expect_string(buffer, "a=001\nb=022\nc=333\n");
+    assert(len == 18);
+}
+
+TEST(batch_zero_records) {
+    char buffer[8] = "x";
+    size_t len = c_print_argv_batch("{d}", NULL, 1, 0, buffer, sizeof(buffer));
+    assert(len == 0);
+    expect_string(buffer, "");
+}
+
+int main(void) {
+    fprintf(stderr, "\n");
+    fprintf(stderr, "═══════════════════════════════════════════════════════════\n");
+    fprintf(stderr, "  argv API (FFI) - Unit Tests\n");
+    fprintf(stderr, "═══════════════════════════════════════════════════════════\n");
+    fprintf(stderr, "\n");
+
+    fprintf(stderr, "c_print_argv:\n");
+    RUN_TEST(renders_into_buffer);
+    RUN_TEST(truncates_like_snprintf);
+    RUN_TEST(type_errors_inline);
+    RUN_TEST(ffi_layout);
+    fprintf(stderr, "\n");
+
+    fprintf(stderr, "c_print_argv_batch:\n");
+    RUN_TEST(batch_renders_all_records);
+    RUN_TEST(batch_zero_records);
+    fprintf(stderr, "\n");
+
+    clear_pattern_cache();
+
+    fprintf(stderr, "═══════════════════════════════════════════════════════════\n");
+    fprintf(stderr, "  Results: %d tests passed ✓\n", tests_passed);
+    fprintf(stderr, "═══════════════════════════════════════════════════════════\n");
+    fprintf(stderr, "\n");
+
+    return 0;
+}
@@ -0,0 +1,355 @@
+/**
+ * @file test_atomic_lines.c
+ * @brief Stress test: líneas de varios hilos sin intercalar
+ *
+ * Varios hilos imprimen a la vez por todos los caminos que escriben en
+ * stdout (c_print, c_print_safe, C_PRINT, c_print_typed y
+ * c_print_styled), con líneas cortas y con líneas más largas que el
+ * buffer de pila (que toman el lock de stdout). La salida va a un
+ * archivo temporal y cada línea leída debe ser exactamente una de las
+ * esperadas.
+ *
+ * Con glibc el test además interpone malloc/free para comprobar que un
+ * hilo de vida corta no deja su caché de patrones en el heap.
+ */
+
+#define C_PRINT_USE_GENERIC
+#include "c_print.h"
+#include "c_print_generic.h"
+#include "c_print_safe.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <stdatomic.h>
+
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+
+#define TEST(name) static void test_##name(void)
+#define RUN_TEST(name) do { \
+    fprintf(stderr, "  Running: %s... ", #name); \
+    test_##name(); \
+    fprintf(stderr, "✓\n"); \
+    tests_passed++; \
+} while(0)
+
+#define THREADS 8
+#define LINES_PER_THREAD 2000
+#define LONG_WIDTH 3000         // Mayor que el buffer de pila de c_print
+#define MAX_LINE (LONG_WIDTH + 256)
+#define SHORT_LIVED_THREADS 64
+
+static int tests_passed = 0;
+
+typedef enum {
+    PATH_PRINT = 0,
+    PATH_PRINT_LONG,
+    PATH_SAFE,
+    PATH_CHECKED,
+    PATH_TYPED,
+    PATH_STYLED,
+    PATH_COUNT
+} PrintPath;
+
+typedef struct {
+    int id;
+    PrintPath only;             // PATH_COUNT = rotar por todos
+} Worker;
+
+// ============================================================================
+// MALLOC INTERPUESTO (glibc)
+// ============================================================================
+
+// Bytes vivos en el heap de todo el proceso
+static atomic_long live_bytes;
+
+#ifdef __GLIBC__
+extern void* __libc_malloc(size_t size);
+extern void* __libc_calloc(size_t count, size_t size);
+extern void* __libc_realloc(void* ptr, size_t size);
+extern void __libc_free(void* ptr);
+
+void* malloc(size_t size) {
+    void* ptr = __libc_malloc(size);
+    if (ptr) atomic_fetch_add(&live_bytes, (long)malloc_usable_size(ptr));
+    return ptr;
+}
+
+void* calloc(size_t count, size_t size) {
+    void* ptr = __libc_calloc(count, size);
+    if (ptr) atomic_fetch_add(&live_bytes, (long)malloc_usable_size(ptr));
+    return ptr;
+}
+
+void* realloc(void* ptr, size_t size) {
+    long before = ptr ? (long)malloc_usable_size(ptr) : 0;
+    void* moved = __libc_realloc(ptr, size);
+    if (moved) atomic_fetch_add(&live_bytes, (long)malloc_usable_size(moved) - before);
+    else if (size == 0) atomic_fetch_sub(&live_bytes, before);
+    return moved;
+}
+
+void free(void* ptr) {
+    if (ptr) atomic_fetch_sub(&live_bytes, (long)malloc_usable_size(ptr));
+    __libc_free(ptr);
+}
+#endif
+
+// ============================================================================
+// CAPTURA A ARCHIVO
+// ============================================================================
+
+static FILE* capture;
+static int saved_stdout;
+
+static void start_capture(void) {
+    capture = tmpfile();
+    assert(capture);
+    fflush(stdout);
+    saved_stdout = dup(STDOUT_FILENO);
+    dup2(fileno(capture), STDOUT_FILENO);
+}
+
+static void end_capture(void) {
+    fflush(stdout);
+    dup2(saved_stdout, STDOUT_FILENO);
+    close(saved_stdout);
+    rewind(capture);
+}
+
+// ============================================================================
+// LÍNEAS
+// ============================================================================
+
+static PrintPath path_for(const Worker* w, int seq) {
+    return w->only == PATH_COUNT ? (PrintPath)((seq + w->id) % PATH_COUNT) : w->only;
+}
+
+// c_print_typed() (test_atomic_lines_typed.c)
+void print_typed_line(const char* tag, int seq);
+
+static void print_line(PrintPath path, int id, int seq) {
+    char tag[32];
+    snprintf(tag, sizeof(tag), "T%d", id);
+
+    switch (path) {
+        case PATH_PRINT:
+            c_print("{s} #{d} print {s:green:>12}|\n", tag, seq, "payload");
+            break;
+        case PATH_PRINT_LONG:
+            c_print("{s} #{d} long {s:*^3000}|\n", tag, seq, "middle");
+            break;
+        case PATH_SAFE:
+            c_print_safe("{s} #{d} safe {x:#} {f:.2}|\n", tag, seq, 0xbeefu, 2.5);
+            break;
+        case PATH_CHECKED:
+            C_PRINT("{s} #{d} checked {d:,}|\n", tag, seq, 1234567);
+            break;
+        case PATH_TYPED:
+            print_typed_line(tag, seq);
+            break;
+        case PATH_STYLED: {
+            char text[64];
+            snprintf(text, sizeof(text), "%s #%d styled|\n", tag, seq);
+            c_print_styled(text, COLOR_CYAN, BG_RESET, STYLE_BOLD);
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+/**
+ * @brief Texto exacto que debe producir print_line
+ */
+static size_t expected_line(PrintPath path, int id, int seq, char* out, size_t size) {
+    char tag[32];
+    char long_field[LONG_WIDTH + 1];
+
+    snprintf(tag, sizeof(tag), "T%d", id);
+
+    switch (path) {
+        case PATH_PRINT:
+            return (size_t)snprintf(out, size, "%s #%d print \033[32m     payload\033[0m|\n",
+                                    tag, seq);
+        case PATH_PRINT_LONG: {
+            size_t pad = LONG_WIDTH - 6;
+            memset(long_field, '*', LONG_WIDTH);
+            memcpy(long_field + pad / 2, "middle", 6);
+            long_field[LONG_WIDTH] = '\0';
+            return (size_t)snprintf(out, size, "%s #%d long %s|\n", tag, seq, long_field);
+        }
+        case PATH_SAFE:
+            return (size_t)snprintf(out, size, "%s #%d safe 0xbeef 2.50|\n", tag, seq);
+        case PATH_CHECKED:
+            return (size_t)snprintf(out, size, "%s #%d checked 1,234,567|\n", tag, seq);
+        case PATH_TYPED:
+            return (size_t)snprintf(out, size, "%s #%d typed left      |\n", tag, seq);
+        case PATH_STYLED:
+            return (size_t)snprintf(out, size, "\033[1;36m%s #%d styled|\n\033[0m", tag, seq);
+        default:
+            return 0;
+    }
+}
+
+static void* worker_main(void* arg) {
+    const Worker* w = (const Worker*)arg;
+    for (int seq = 0; seq < LINES_PER_THREAD; seq++) {
+        print_line(path_for(w, seq), w->id, seq);
+    }
+    return NULL;
+}
+
+/**
+ * @brief Lanza los hilos y comprueba cada línea de la salida capturada
+ */
+static void run_and_verify(PrintPath only) {
+    pthread_t threads[THREADS];
+    Worker workers[THREADS];
+    int next_seq[THREADS] = { 0 };
+
+    start_capture();
+    for (int t = 0; t < THREADS; t++) {
+        workers[t].id = t;
+        workers[t].only = only;
+        int rc = pthread_create(&threads[t], NULL, worker_main, &workers[t]);
+        assert(rc == 0);
+    }
+    for (int t = 0; t < THREADS; t++) pthread_join(threads[t], NULL);
+    end_capture();
+
+    // c_print_styled termina con el reset después del salto de línea:
+    // la línea física siguiente empieza con él
+    static char line[MAX_LINE];
+    static char expected[MAX_LINE];
+    char pending_reset = 0;
+    size_t lines = 0;
+
+    while (fgets(line, sizeof(line), capture)) {
+        const char* text = line;
+        if (pending_reset) {
+            assert(strncmp(text, "\033[0m", 4) == 0);
+            text += 4;
+            pending_reset = 0;
+        }
+        if (*text == '\0') continue;    // Solo quedaba el reset final
+
+        // Localizar el autor: "T<id> #<seq>" (tras el escape si lo hay)
+        const char* tag = strchr(text, 'T');
+        assert(tag);
+        int id = -1;
+        int seq = -1;
+        int fields = sscanf(tag, "T%d #%d", &id, &seq);
+        assert(fields == 2);
+        assert(id >= 0 && id < THREADS);
+
+        // Cada hilo imprime en orden: la secuencia sigue sin saltos
+        assert(seq == next_seq[id]);
+        next_seq[id]++;
+
+        PrintPath path = path_for(&workers[id], seq);
+        size_t len = expected_line(path, id, seq, expected, sizeof(expected));
+
+        if (path == PATH_STYLED) {
+            assert(strncmp(text, expected, len - 4) == 0);
+            assert(text[len - 4] == '\0');
+            pending_reset = 1;
+        } else {
+            assert(strcmp(text, expected) == 0);
+        }
+        lines++;
+    }
+
+    assert(!pending_reset || feof(capture));
+    assert(lines == (size_t)THREADS * LINES_PER_THREAD);
+    for (int t = 0; t < THREADS; t++) assert(next_seq[t] == LINES_PER_THREAD);
+
+    fclose(capture);
+}
+
+// ============================================================================
+// TESTS
+// ============================================================================
+
+TEST(expected_lines_match_single_thread) {
+    static char expected[MAX_LINE];
+    char buffer[128];
+
+    expected_line(PATH_PRINT, 1, 2, expected, sizeof(expected));
+    c_snprint(buffer, sizeof(buffer), "{s} #{d} print {s:green:>12}|\n", "T1", 2, "payload");
+    assert(strcmp(buffer, expected) == 0);
+
+    expected_line(PATH_CHECKED, 3, 4, expected, sizeof(expected));
+    c_snprint(buffer, sizeof(buffer), "{s} #{d} checked {d:,}|\n", "T3", 4, 1234567);
+    assert(strcmp(buffer, expected) == 0);
+}
+
+TEST(short_lines_not_torn) {
+    run_and_verify(PATH_PRINT);
+}
+
+TEST(long_lines_not_torn) {
+    run_and_verify(PATH_PRINT_LONG);
+}
+
+TEST(mixed_paths_not_torn) {
+    run_and_verify(PATH_COUNT);
+}
+
+static void* short_lived_main(void* arg) {
+    char buffer[128];
+    int id = *(const int*)arg;
+    c_snprint(buffer, sizeof(buffer), "{s} #{d} first|\n", "T", id);
+    c_snprint(buffer, sizeof(buffer), "{d:05} {x:#} second|\n", id, 0xbeefu);
+    c_snprint(buffer, sizeof(buffer), "{s:red:>8} third {f:.2}|\n", "x", 1.5);
+    return NULL;
+}
+
+TEST(short_lived_threads_free_cache) {
+#ifdef __GLIBC__
+    // Un primer hilo calienta la caché de pilas y el TLS de glibc
+    int id = 0;
+    pthread_t thread;
+    int rc = pthread_create(&thread, NULL, short_lived_main, &id);
+    assert(rc == 0);
+    pthread_join(thread, NULL);
+
+    long before = atomic_load(&live_bytes);
+    for (id = 1; id <= SHORT_LIVED_THREADS; id++) {
+        rc = pthread_create(&thread, NULL, short_lived_main, &id);
+        assert(rc == 0);
+        pthread_join(thread, NULL);
+    }
+    long growth = atomic_load(&live_bytes) - before;
+
+    // Sin liberar, cada hilo dejaría sus tres patrones compilados
+    assert(growth < 1024);
+#endif
+}
+
+int main(void) {
+    fprintf(stderr, "\n");
+    fprintf(stderr, "═══════════════════════════════════════════════════════════\n");
+    fprintf(stderr, "  Atomic Lines - Stress Tests\n");
+    fprintf(stderr, "═══════════════════════════════════════════════════════════\n");
+    fprintf(stderr, "\n");
+
+    fprintf(stderr, "Concurrent output (%d threads x %d lines):\n", THREADS, LINES_PER_THREAD);
+    RUN_TEST(expected_lines_match_single_thread);
+    RUN_TEST(short_lines_not_torn);
+    RUN_TEST(long_lines_not_torn);
+    RUN_TEST(mixed_paths_not_torn);
+    RUN_TEST(short_lived_threads_free_cache);
+    fprintf(stderr, "\n");
+
+    fprintf(stderr, "═══════════════════════════════════════════════════════════\n");
+    fprintf(stderr, "  Results: %d tests passed ✓\n", tests_passed);
+    fprintf(stderr, "═══════════════════════════════════════════════════════════\n");
+    fprintf(stderr, "\n");
+
+    return 0;
+}
@@ -0,0 +1,14 @@
+/**
+ * @file test_atomic_lines_typed.c
+ * @brief Camino c_print_typed para test_atomic_lines
+ *
+ * Va en su propia unidad de traducción porque c_print_typed.h y
+ * c_print_generic.h definen cada uno su C_PRINT.
+ */
+
+#include "c_print_typed.h"
+
+void print_typed_line(const char* tag, int seq) {
+    c_print_typed("{s} #{d} typed {s:<10}|\n",
+                  CPRINT_STR(tag), CPRINT_INT(seq), CPRINT_STR("left"));
+}
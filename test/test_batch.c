@@ -0,0 +1,322 @@
+/**
+ * @file test_batch.c
+ * @brief Tests unitarios para la salida por lotes (c_print_batch)
+ */
+
+#define C_PRINT_USE_GENERIC
+#include "c_print_batch.h"
+#include "c_print.h"
+#include "c_print_generic.h"
+#include "c_print_safe.h"
+#include "c_print_builder.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <time.h>
+#include <sys/stat.h>
+
+#define TEST(name) static void test_##name(void)
+#define RUN_TEST(name) do { \
+    fprintf(stderr, "  Running: %s... ", #name); \
+    test_##name(); \
+    c_print_batch_stop(); \
+    fprintf(stderr, "✓\n"); \
+    tests_passed++; \
+} while(0)
+
+#define THREADS 8
+#define LINES_PER_THREAD 2000
+
+static int tests_passed = 0;
+
+// ============================================================================
+// CAPTURA A ARCHIVO
+// ============================================================================
+
+static FILE* capture;
+static int saved_stdout;
+static char captured[1024 * 1024];
+
+static void start_capture(void) {
+    capture = tmpfile();
+    assert(capture);
+    fflush(stdout);
+    saved_stdout = dup(STDOUT_FILENO);
+    dup2(fileno(capture), STDOUT_FILENO);
+}
+
+/**
+ * @brief Bytes que ya llegaron al archivo (sin vaciar stdout)
+ */
+static long captured_size(void) {
+    struct stat st;
+    int rc = fstat(fileno(capture), &st);
+    assert(rc == 0);
+    return (long)st.st_size;
+}
+
+/**
+ * @brief Lee lo escrito hasta ahora (vaciando stdout)
+ */
+static const char* read_capture(void) {
+    fflush(stdout);
+    long size = captured_size();
+    assert(size < (long)sizeof(captured));
+    ssize_t got = pread(fileno(capture), captured, (size_t)size, 0);
+    assert(got == size);
+    captured[size] = '\0';
+    return captured;
+}
+
+static void end_capture(void) {
+    fflush(stdout);
+    dup2(saved_stdout, STDOUT_FILENO);
+    close(saved_stdout);
+    fclose(capture);
+}
+
+static void sleep_ms(long ms) {
+    struct timespec ts = { ms / 1000, (ms % 1000) * 1000000L };
+    nanosleep(&ts, NULL);
+}
+
+// ============================================================================
+// MODO
+// ============================================================================
+
+TEST(inactive_by_default) {
+    assert(!c_print_batch_active());
+
+    start_capture();
+    c_print("direct {d}\n", 1);
+    const char* text = read_capture();
+    assert(strcmp(text, "direct 1\n") == 0);
+    end_capture();
+}
+
+TEST(start_and_stop) {
+    bool started = c_print_batch_start(NULL);
+    assert(started);
+    assert(c_print_batch_active());
+    c_print_batch_stop();
+    assert(!c_print_batch_active());
+}
+
+// ============================================================================
+// ENTREGA
+// ============================================================================
+
+TEST(lines_wait_for_flush) {
+    start_capture();
+    bool started = c_print_batch_start(NULL);
+    assert(started);
+
+    c_print("one {d}\n", 1);
+    c_print_safe("two {s}\n", "safe");
+    C_PRINT("three {x:#}\n", 255u);
+    fflush(stdout);
+    assert(captured_size() == 0);
+
+    c_print_batch_flush();
+    const char* text = read_capture();
+    assert(strcmp(text, "one 1\ntwo safe\nthree 0xff\n") == 0);
+    end_capture();
+}
+
+TEST(size_triggers_hand_off) {
+    CPrintBatchConfig config = { 256, 0 };
+    start_capture();
+    bool started = c_print_batch_start(&config);
+    assert(started);
+
+    for (int i = 0; i < 100; i++) c_print("line {d:03} of the size test\n", i);
+
+    // Ya se entregaron lotes, siempre en límite de línea
+    const char* text = read_capture();
+    size_t len = strlen(text);
+    assert(len > 0);
+    assert(text[len - 1] == '\n');
+    assert(strncmp(text, "line 000 of the size test\n", 26) == 0);
+
+    c_print_batch_flush();
+    text = read_capture();
+    assert(strlen(text) == 100 * 26);
+    assert(strstr(text, "line 099 of the size test\n"));
+    end_capture();
+}
+
+TEST(line_larger_than_buffer) {
+    CPrintBatchConfig config = { 128, 0 };
+    start_capture();
+    bool started = c_print_batch_start(&config);
+    assert(started);
+
+    c_print("before\n");
+    c_print("{s:-^2000}\n", "wide");
+    c_print("after\n");
+    c_print_batch_flush();
+
+    const char* text = read_capture();
+    assert(strncmp(text, "before\n", 7) == 0);
+    assert(text[7 + 2000] == '\n');
+    assert(strcmp(text + 7 + 2001, "after\n") == 0);
+    assert(strstr(text, "wide"));
+    end_capture();
+}
+
+TEST(interval_flushes_idle_thread) {
+    CPrintBatchConfig config = { 0, 20 };
+    start_capture();
+    bool started = c_print_batch_start(&config);
+    assert(started);
+
+    c_print("idle line\n");
+    for (int i = 0; i < 50 && captured_size() == 0; i++) sleep_ms(10);
+    const char* text = read_capture();
+    assert(strcmp(text, "idle line\n") == 0);
+    end_capture();
+}
+
+TEST(order_kept_with_direct_writers) {
+    CPrintBuilderStorage storage;
+    CPrintBuilder* b = cp_init(CP_BUILDER(&storage), NULL, 0);
+
+    start_capture();
+    bool started = c_print_batch_start(NULL);
+    assert(started);
+
+    c_print("a\n");
+    c_print_styled("b\n", COLOR_RESET, BG_RESET, STYLE_RESET);
+    c_print("c\n");
+    cp_text(b, "d");
+    cp_println(b);
+    c_print("e\n");
+    c_print_batch_flush();
+
+    const char* text = read_capture();
+    assert(strcmp(text, "a\n\033[mb\n\033[0mc\nd\ne\n") == 0);
+    end_capture();
+    cp_free(b);
+}
+
+// ============================================================================
+// HILOS
+// ============================================================================
+
+static void* exiting_worker(void* arg) {
+    c_print("from thread {d}\n", *(int*)arg);
+    return NULL;
+}
+
+TEST(thread_exit_hands_off) {
+    pthread_t thread;
+    int id = 7;
+
+    start_capture();
+    bool started = c_print_batch_start(NULL);
+    assert(started);
+    int rc = pthread_create(&thread, NULL, exiting_worker, &id);
+    assert(rc == 0);
+    pthread_join(thread, NULL);
+
+    const char* text = read_capture();
+    assert(strcmp(text, "from thread 7\n") == 0);
+    end_capture();
+}
+
+static void* stress_worker(void* arg) {
+    int id = *(int*)arg;
+    for (int i = 0; i < LINES_PER_THREAD; i++) {
+        c_print("T{d} #{d} {s:>10}|\n", id, i, "payload");
+    }
+    return NULL;
+}
+
+TEST(threads_not_torn) {
+    CPrintBatchConfig config = { 1024, 5 };
+    pthread_t threads[THREADS];
+    int ids[THREADS];
+    int next_seq[THREADS] = { 0 };
+
+    start_capture();
+    bool started = c_print_batch_start(&config);
+    assert(started);
+    for (int t = 0; t < THREADS; t++) {
+        ids[t] = t;
+        int rc = pthread_create(&threads[t], NULL, stress_worker, &ids[t]);
+        assert(rc == 0);
+    }
+    for (int t = 0; t < THREADS; t++) pthread_join(threads[t], NULL);
+    c_print_batch_stop();
+
+    // Cada línea entera y en orden dentro de su hilo
+    char* text = (char*)read_capture();
+    size_t lines = 0;
+    for (char* line = strtok(text, "\n"); line; line = strtok(NULL, "\n")) {
+        int id = -1;
+        int seq = -1;
+        char expected[64];
+        int fields = sscanf(line, "T%d #%d", &id, &seq);
+        assert(fields == 2);
+        assert(id >= 0 && id < THREADS);
+        assert(seq == next_seq[id]);
+        next_seq[id]++;
+        snprintf(expected, sizeof(expected), "T%d #%d    payload|", id, seq);
+        assert(strcmp(line, expected) == 0);
+        lines++;
+    }
+    assert(lines == (size_t)THREADS * LINES_PER_THREAD);
+    end_capture();
+}
+
+TEST(stop_returns_to_direct_output) {
+    start_capture();
+    bool started = c_print_batch_start(NULL);
+    assert(started);
+    c_print("pending\n");
+    c_print_batch_stop();
+    const char* text = read_capture();
+    assert(strcmp(text, "pending\n") == 0);
+
+    c_print("direct\n");
+    text = read_capture();
+    assert(strcmp(text, "pending\ndirect\n") == 0);
+    end_capture();
+}
+
+int main(void) {
+    fprintf(stderr, "\n");
+    fprintf(stderr, "═══════════════════════════════════════════════════════════\n");
+    fprintf(stderr, "  Batched Output - Unit Tests\n");
+    fprintf(stderr, "═══════════════════════════════════════════════════════════\n");
+    fprintf(stderr, "\n");
+
+    fprintf(stderr, "Mode:\n");
+    RUN_TEST(inactive_by_default);
+    RUN_TEST(start_and_stop);
+    fprintf(stderr, "\n");
+
+    fprintf(stderr, "Hand-off:\n");
+    RUN_TEST(lines_wait_for_flush);
+    RUN_TEST(size_triggers_hand_off);
+    RUN_TEST(line_larger_than_buffer);
+    RUN_TEST(interval_flushes_idle_thread);
+    RUN_TEST(order_kept_with_direct_writers);
+    fprintf(stderr, "\n");
+
+    fprintf(stderr, "Threads:\n");
+    RUN_TEST(thread_exit_hands_off);
+    RUN_TEST(threads_not_torn);
+    RUN_TEST(stop_returns_to_direct_output);
+    fprintf(stderr, "\n");
+
+    fprintf(stderr, "═══════════════════════════════════════════════════════════\n");
+    fprintf(stderr, "  Results: %d tests passed ✓\n", tests_passed);
+    fprintf(stderr, "═══════════════════════════════════════════════════════════\n");
+    fprintf(stderr, "\n");
+
+    return 0;
+}
@@ -47,6 +47,73 @@ TEST(free_null_safe) {
     cp_free(NULL);  // No debe crashear
 }
 
+// ============================================================================
+// TESTS DE BUILDERS EN EL STACK
+// ============================================================================
+
+TEST(init_uses_caller_storage) {
+    CPrintBuilderStorage storage;
+    char text[64];
+    CPrintBuilder* b = cp_init(CP_BUILDER(&storage), text, sizeof(text));
+    
+    cp_text(b, "Stack ");
+    cp_int(b, 42);
+    
+    // El contenido vive en el buffer del llamador
+    assert(strcmp(text, "Stack 42") == 0);
+    assert(cp_size(b) == 8);
+    
+    cp_free(b);
+}
+
+TEST(init_without_storage_uses_inline_buffer) {
+    CPrintBuilderStorage storage;
+    CPrintBuilder* b = cp_init(CP_BUILDER(&storage), NULL, 0);
+    
+    assert(cp_is_empty(b));
+    cp_text(b, "Inline");
+    
+    char* result = cp_to_string(b);
+    assert(strcmp(result, "Inline") == 0);
+    
+    free(result);
+    cp_free(b);
+}
+
+TEST(init_spills_to_heap_on_overflow) {
+    CPrintBuilderStorage storage;
+    char text[8];
+    CPrintBuilder* b = cp_init(CP_BUILDER(&storage), text, sizeof(text));
+    
+    for (int i = 0; i < 100; i++) {
+        cp_text(b, "0123456789");
+    }
+    assert(cp_size(b) == 1000);
+    
+    char* result = cp_to_string(b);
+    assert(strlen(result) == 1000);
+    assert(strncmp(result, "0123456789", 10) == 0);
+    
+    free(result);
+    cp_free(b);
+}
+
+TEST(init_inside_user_struct) {
+    struct {
+        int id;
+        CPrintBuilderStorage line;
+    } request = {7};
+    
+    CPrintBuilder* b = cp_init(CP_BUILDER(&request.line), NULL, 0);
+    cp_int(cp_zero_pad(b, 3), request.id);
+    
+    char* result = cp_to_string(b);
+    assert(strcmp(result, "007") == 0);
+    
+    free(result);
+    cp_free(b);
+}
+
 // ============================================================================
 // TESTS DE CONTENIDO BÁSICO
 // ============================================================================
@@ -374,6 +441,282 @@ TEST(reuse_with_reset) {
     cp_free(b);
 }
 
+// ============================================================================
+// TESTS DE SALIDA SIN COPIAS
+// ============================================================================
+
+TEST(view_exposes_buffer_without_copy) {
+    CPrintBuilder* b = cp_new();
+    cp_text(b, "View ");
+    cp_int(b, 7);
+    
+    CPrintView view = cp_view(b);
+    assert(view.length == 6);
+    assert(memcmp(view.data, "View 7", 6) == 0);
+    
+    cp_free(b);
+}
+
+TEST(detach_hands_over_heap_buffer) {
+    CPrintBuilder* b = cp_new();
+    for (int i = 0; i < 100; i++) {
+        cp_text(b, "0123456789");
+    }
+    const char* before = cp_view(b).data;
+    
+    size_t length = 0;
+    char* result = cp_detach(b, &length);
+    assert(result == before);       // Sin copia
+    assert(length == 1000);
+    assert(cp_is_empty(b));
+    
+    // El builder sigue siendo usable
+    cp_text(b, "again");
+    assert(strcmp(cp_view(b).data, "again") == 0);
+    
+    free(result);
+    cp_free(b);
+}
+
+TEST(detach_copies_inline_buffer) {
+    CPrintBuilder* b = cp_new();
+    cp_text(b, "small");
+    
+    size_t length = 0;
+    char* result = cp_detach(b, &length);
+    assert(strcmp(result, "small") == 0);
+    assert(length == 5);
+    assert(cp_is_empty(b));
+    
+    free(result);
+    cp_free(b);
+}
+
+TEST(write_to_file_sink) {
+    FILE* fp = tmpfile();
+    assert(fp != NULL);
+    
+    CPrintBuilder* b = cp_new();
+    cp_text(b, "Sink ");
+    cp_hex(cp_show_prefix(b, true), 255);
+    
+    CPrintSink sink = cp_sink_file(fp);
+    size_t written = cp_write(b, &sink);
+    assert(written == 9);
+    
+    char text[32] = {0};
+    rewind(fp);
+    size_t got = fread(text, 1, sizeof(text), fp);
+    assert(got == 9);
+    assert(strcmp(text, "Sink 0xff") == 0);
+    
+    fclose(fp);
+    cp_free(b);
+}
+
+// ============================================================================
+// TESTS DE STREAMING
+// ============================================================================
+
+static char stream_output[8192];
+static size_t stream_length = 0;
+static int stream_writes = 0;
+
+static size_t memory_sink_write(void* ctx, const char* data, size_t len) {
+    (void)ctx;
+    memcpy(stream_output + stream_length, data, len);
+    stream_length += len;
+    stream_output[stream_length] = '\0';
+    stream_writes++;
+    return len;
+}
+
+/**
+ * @brief Sink que acepta como mucho 5 bytes por llamada
+ */
+static size_t short_sink_write(void* ctx, const char* data, size_t len) {
+    return memory_sink_write(ctx, data, len < 5 ? len : 5);
+}
+
+static void stream_capture_reset(void) {
+    stream_output[0] = '\0';
+    stream_length = 0;
+    stream_writes = 0;
+}
+
+TEST(stream_flushes_past_high_water) {
+    stream_capture_reset();
+    CPrintSink sink = {memory_sink_write, NULL};
+    
+    CPrintBuilder* b = cp_stream_to(cp_new(), &sink, 32);
+    for (int i = 0; i < 100; i++) {
+        cp_text(b, "0123456789");
+        assert(cp_size(b) < 32);    // Memoria acotada
+    }
+    cp_flush(b);
+    
+    assert(stream_length == 1000);
+    assert(stream_writes > 1);
+    
+    cp_free(b);
+}
+
+TEST(stream_preserves_pending_style) {
+    stream_capture_reset();
+    CPrintSink sink = {memory_sink_write, NULL};
+    
+    CPrintBuilder* b = cp_stream_to(cp_new(), &sink, 4);
+    cp_color_str(b, "red");
+    cp_text(b, "flush here ");      // Provoca un volcado
+    cp_str(b, "Error");             // Debe seguir en rojo
+    cp_flush(b);
+    
+    assert(strstr(stream_output, "flush here \033[31mError\033[0m") != NULL);
+    
+    cp_free(b);
+}
+
+TEST(stream_disabled_keeps_content) {
+    stream_capture_reset();
+    CPrintSink sink = {memory_sink_write, NULL};
+    
+    CPrintBuilder* b = cp_stream_to(cp_new(), &sink, 4);
+    cp_stream_to(b, NULL, 0);
+    cp_text(b, "kept in memory");
+    
+    assert(stream_writes == 0);
+    size_t flushed = cp_flush(b);
+    assert(flushed == 0);
+    assert(strcmp(cp_view(b).data, "kept in memory") == 0);
+    
+    cp_free(b);
+}
+
+TEST(stream_cleared_by_reset) {
+    stream_capture_reset();
+    CPrintSink sink = {memory_sink_write, NULL};
+    
+    CPrintBuilder* b = cp_stream_to(cp_new(), &sink, 4);
+    cp_reset(b);
+    cp_text(b, "kept in memory");
+    
+    assert(stream_writes == 0);
+    size_t flushed = cp_flush(b);
+    assert(flushed == 0);
+    cp_free(b);
+    
+    // Un builder devuelto al pool no conserva el sink del uso anterior
+    b = cp_stream_to(cp_pool_acquire(), &sink, 4);
+    cp_pool_release(b);
+    b = cp_pool_acquire();
+    cp_text(b, "pooled");
+    assert(stream_writes == 0);
+    int slot = cp_slot(b, 4);
+    assert(slot >= 0);
+    cp_pool_release(b);
+    cp_pool_drain();
+}
+
+TEST(stream_keeps_unwritten_bytes) {
+    stream_capture_reset();
+    CPrintSink sink = {short_sink_write, NULL};
+    
+    CPrintBuilder* b = cp_stream_to(cp_new(), &sink, 64);
+    cp_text(b, "0123456789abc");
+    size_t flushed = cp_flush(b);
+    assert(flushed == 5);
+    assert(strcmp(cp_view(b).data, "56789abc") == 0);
+    
+    while (cp_flush(b) > 0) { }
+    assert(cp_is_empty(b));
+    assert(strcmp(stream_output, "0123456789abc") == 0);
+    
+    cp_free(b);
+}
+
+TEST(stream_rejected_with_slots) {
+    stream_capture_reset();
+    CPrintSink sink = {memory_sink_write, NULL};
+    
+    CPrintBuilder* b = cp_new();
+    int slot = cp_slot(b, 4);
+    assert(slot >= 0);
+    CPrintBuilder* streaming = cp_stream_to(b, &sink, 4);
+    assert(streaming == NULL);
+    
+    // Sigue sin streaming: el slot se puede completar
+    cp_text(b, " tail that would pass the high water mark");
+    cp_slot_set_int(b, slot, 7);
+    assert(stream_writes == 0);
+    assert(strncmp(cp_view(b).data, "   7 tail", 9) == 0);
+    
+    cp_free(b);
+}
+
+// ============================================================================
+// TESTS DE PLANTILLAS CON SLOTS
+// ============================================================================
+
+TEST(slot_patches_in_place) {
+    CPrintBuilder* b = cp_new();
+    cp_text(b, "CPU: ");
+    int cpu = cp_slot(cp_precision(b, 1), 5);
+    cp_text(b, "% Jobs: ");
+    int jobs = cp_slot(b, 3);
+    assert(cpu == 0 && jobs == 1);
+    
+    size_t size = cp_size(b);
+    
+    cp_slot_set_float(b, cpu, 42.5);
+    cp_slot_set_int(b, jobs, 7);
+    assert(strcmp(cp_view(b).data, "CPU:  42.5% Jobs:   7") == 0);
+    
+    cp_slot_set_float(b, cpu, 100.0);
+    cp_slot_set_int(b, jobs, 12);
+    assert(strcmp(cp_view(b).data, "CPU: 100.0% Jobs:  12") == 0);
+    assert(cp_size(b) == size);     // El tamaño nunca cambia
+    
+    cp_free(b);
+}
+
+TEST(slot_keeps_precomputed_escapes) {
+    CPrintBuilder* b = cp_new();
+    int slot = cp_slot(cp_color_str(b, "green"), 4);
+    
+    cp_slot_set_int(b, slot, 99);
+    assert(strcmp(cp_view(b).data, "\033[32m  99\033[0m") == 0);
+    
+    cp_free(b);
+}
+
+TEST(slot_alignment_and_overflow) {
+    CPrintBuilder* b = cp_new();
+    int name = cp_slot(b, 5);
+    cp_text(b, "|");
+    int left = cp_slot(cp_fill_char(cp_align_left(b, 0), '.'), 4);
+    cp_text(b, "|");
+    int small = cp_slot(b, 2);
+    
+    cp_slot_set_str(b, name, "abcdefgh");
+    cp_slot_set_int(b, left, 5);
+    cp_slot_set_int(b, small, 1234);
+    assert(strcmp(cp_view(b).data, "abcde|5...|##") == 0);
+    
+    cp_free(b);
+}
+
+TEST(slot_unavailable_while_streaming) {
+    stream_capture_reset();
+    CPrintSink sink = {memory_sink_write, NULL};
+    
+    CPrintBuilder* b = cp_stream_to(cp_new(), &sink, 64);
+    int slot = cp_slot(b, 4);
+    assert(slot == -1);
+    cp_slot_set_int(b, 0, 1);       // Slot inválido: no debe crashear
+    
+    cp_free(b);
+}
+
 // ============================================================================
 // TESTS DE EDGE CASES
 // ============================================================================
@@ -436,6 +779,13 @@ int main(void) {
     RUN_TEST(free_null_safe);
     printf("\n");
     
+    printf("Builders en el Stack:\n");
+    RUN_TEST(init_uses_caller_storage);
+    RUN_TEST(init_without_storage_uses_inline_buffer);
+    RUN_TEST(init_spills_to_heap_on_overflow);
+    RUN_TEST(init_inside_user_struct);
+    printf("\n");
+    
     printf("Contenido Básico:\n");
     RUN_TEST(text_adds_literal);
     RUN_TEST(str_adds_string);
@@ -478,6 +828,29 @@ int main(void) {
     RUN_TEST(reuse_with_reset);
     printf("\n");
     
+    printf("Salida sin Copias:\n");
+    RUN_TEST(view_exposes_buffer_without_copy);
+    RUN_TEST(detach_hands_over_heap_buffer);
+    RUN_TEST(detach_copies_inline_buffer);
+    RUN_TEST(write_to_file_sink);
+    printf("\n");
+    
+    printf("Streaming:\n");
+    RUN_TEST(stream_flushes_past_high_water);
+    RUN_TEST(stream_preserves_pending_style);
+    RUN_TEST(stream_disabled_keeps_content);
+    RUN_TEST(stream_cleared_by_reset);
+    RUN_TEST(stream_keeps_unwritten_bytes);
+    RUN_TEST(stream_rejected_with_slots);
+    printf("\n");
+    
+    printf("Plantillas con Slots:\n");
+    RUN_TEST(slot_patches_in_place);
+    RUN_TEST(slot_keeps_precomputed_escapes);
+    RUN_TEST(slot_alignment_and_overflow);
+    RUN_TEST(slot_unavailable_while_streaming);
+    printf("\n");
+    
     printf("Edge Cases:\n");
     RUN_TEST(empty_string);
     RUN_TEST(null_string_safe);
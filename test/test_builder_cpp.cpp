@@ -0,0 +1,134 @@
+/**
+ * @file test_builder_cpp.cpp
+ * @brief Tests unitarios para el envoltorio RAII cprint::Builder
+ */
+
+#include "c_print_builder.hpp"
+#include <cassert>
+#include <cstdio>
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <utility>
+
+#define TEST(name) static void test_##name()
+#define RUN_TEST(name) do { \
+    fprintf(stderr, "  Running: %s... ", #name); \
+    test_##name(); \
+    fprintf(stderr, "✓\n"); \
+    tests_passed++; \
+} while(0)
+
+static int tests_passed = 0;
+
+TEST(append_values) {
+    cprint::Builder b;
+    b << "x=" << 42 << ", y=" << -7L << ", z=" << 3u << ", c=" << 'q';
+    assert(b.view() == "x=42, y=-7, z=3, c=q");
+}
+
+TEST(floats_match_ostream) {
+    cprint::Builder b;
+    std::ostringstream os;
+    const double values[] = {3.5, 0.1, 1234567.0, 1e-7, 2.0 / 3.0};
+
+    for (double v : values) {
+        b << v << ' ';
+        os << v << ' ';
+    }
+    assert(b.view() == os.str());
+}
+
+TEST(string_view_by_length) {
+    std::string_view word = "abcdef";
+    std::string text = "tail";
+
+    cprint::Builder b;
+    b << word.substr(1, 3) << text;
+    assert(b.view() == "bcdtail");
+
+    // Los bytes nulos embebidos se conservan
+    b << std::string_view("a\0b", 3);
+    assert(b.size() == 10);
+}
+
+TEST(pending_options) {
+    cprint::Builder b;
+    b.align_right(6).fill('.') << 42;
+    b.text("|");
+    b.color(COLOR_RED) << "x";
+    assert(b.view() == "....42|\033[31mx\033[0m");
+}
+
+TEST(move_only) {
+    static_assert(!std::is_copy_constructible_v<cprint::Builder>);
+    static_assert(std::is_nothrow_move_constructible_v<cprint::Builder>);
+
+    cprint::Builder a;
+    a << "moved";
+    cprint::Builder b = std::move(a);
+    assert(b.view() == "moved");
+
+    cprint::Builder c;
+    c << "old";
+    c = std::move(b);
+    assert(c.view() == "moved");
+
+    // Los builders movidos quedan vacíos y se pueden volver a usar
+    assert(a.empty() && a.view().empty());
+    a << "reused " << 1;
+    assert(a.view() == "reused 1");
+    b.clear();
+    b.color(COLOR_RED) << "x";
+    assert(b.view() == "\033[31mx\033[0m");
+}
+
+TEST(str_moves_large_content) {
+    cprint::Builder b;
+    for (int i = 0; i < 200; i++) b << i << ',';
+
+    const char* before = b.view().data();
+    std::string result = std::move(b).str();
+
+    // El buffer desbordado es el propio std::string: sin copia
+    assert(result.data() == before);
+    assert(result.compare(0, 8, "0,1,2,3,") == 0);
+    assert(b.empty());
+
+    // El builder sigue siendo utilizable
+    b << "again";
+    assert(b.view() == "again");
+}
+
+TEST(str_small_content) {
+    cprint::Builder b;
+    b << "short";
+    std::string copy = b.str();
+    std::string moved = std::move(b).str();
+    assert(copy == "short" && moved == "short");
+    assert(b.empty());
+}
+
+int main() {
+    fprintf(stderr, "\n");
+    fprintf(stderr, "═══════════════════════════════════════════════════════════\n");
+    fprintf(stderr, "  cprint::Builder (C++) - Unit Tests\n");
+    fprintf(stderr, "═══════════════════════════════════════════════════════════\n");
+    fprintf(stderr, "\n");
+
+    RUN_TEST(append_values);
+    RUN_TEST(floats_match_ostream);
+    RUN_TEST(string_view_by_length);
+    RUN_TEST(pending_options);
+    RUN_TEST(move_only);
+    RUN_TEST(str_moves_large_content);
+    RUN_TEST(str_small_content);
+    fprintf(stderr, "\n");
+
+    fprintf(stderr, "═══════════════════════════════════════════════════════════\n");
+    fprintf(stderr, "  Results: %d tests passed ✓\n", tests_passed);
+    fprintf(stderr, "═══════════════════════════════════════════════════════════\n");
+    fprintf(stderr, "\n");
+
+    return 0;
+}
@@ -0,0 +1,183 @@
+/**
+ * @file test_checked.c
+ * @brief Tests unitarios para C_PRINT con validación _Generic (c_print_generic)
+ */
+
+#define C_PRINT_USE_GENERIC
+#include "c_print_generic.h"
+#include "pattern_compiler.h"
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include <unistd.h>
+#include <fcntl.h>
+
+#define TEST(name) static void test_##name(void)
+#define RUN_TEST(name) do { \
+    fprintf(stderr, "  Running: %s... ", #name); \
+    test_##name(); \
+    fprintf(stderr, "✓\n"); \
+    tests_passed++; \
+} while(0)
+
+static int tests_passed = 0;
+static char captured_output[4096];
+
+// Usar pipes para capturar stdout
+static int stdout_pipe[2];
+static int saved_stdout;
+
+static void start_capture(void) {
+    fflush(stdout);
+    saved_stdout = dup(STDOUT_FILENO);
+    int rc = pipe(stdout_pipe);
+    assert(rc == 0);
+    dup2(stdout_pipe[1], STDOUT_FILENO);
+    close(stdout_pipe[1]);
+    memset(captured_output, 0, sizeof(captured_output));
+}
+
+static void end_capture(void) {
+    fflush(stdout);
+
+    dup2(saved_stdout, STDOUT_FILENO);
+    close(saved_stdout);
+
+    int flags = fcntl(stdout_pipe[0], F_GETFL, 0);
+    fcntl(stdout_pipe[0], F_SETFL, flags | O_NONBLOCK);
+
+    ssize_t bytes_read = read(stdout_pipe[0], captured_output, sizeof(captured_output) - 1);
+    if (bytes_read > 0) {
+        captured_output[bytes_read] = '\0';
+    }
+
+    close(stdout_pipe[0]);
+}
+
+static void expect_output(const char* expected) {
+    if (strcmp(captured_output, expected) != 0) {
+        fprintf(stderr, "\n  Expected: '%s'\n  Got:      '%s'\n", expected, captured_output);
+        assert(0);
+    }
+}
+
+// ============================================================================
+// SALIDA
+// ============================================================================
+
+TEST(same_output_as_c_print) {
+    char reference[sizeof(captured_output)];
+    const char* pattern = "Hola {s:red}, saldo {d:,} ({f:.2}) hex {x:#} [{s:^9}] \\{ok}\n";
+
+    start_capture();
+    c_print(pattern, "Ana", 1234567, 3.14159, 255u, "mid");
+    end_capture();
+    strcpy(reference, captured_output);
+
+    start_capture();
+    C_PRINT(pattern, "Ana", 1234567, 3.14159, 255u, "mid");
+    end_capture();
+    expect_output(reference);
+}
+
+TEST(more_than_ten_arguments) {
+    start_capture();
+    C_PRINT("{d}{d}{d}{d}{d}{d}{d}{d}{d}{d}{d}{d}{d}{d}{d}{d}",
+            1, 2, 3, 4, 5, 6, 7, 8, 9, 0, 1, 2, 3, 4, 5, 6);
+    end_capture();
+    expect_output("1234567890123456");
+}
+
+TEST(array_with_count) {
+    CPrintArg args[] = { CPRINT_ARG("x"), CPRINT_ARG(7) };
+
+    start_capture();
+    c_print_checked_array("{s}={d:03}", args, 2);
+    end_capture();
+    expect_output("x=007");
+}
+
+TEST(variadic_wrapper) {
+    start_capture();
+    c_print_checked_wrapper("{s} {l}", 2, CPRINT_ARG("big"), CPRINT_ARG(5000000000L));
+    end_capture();
+    expect_output("big 5000000000");
+}
+
+// ============================================================================
+// ERRORES
+// ============================================================================
+
+TEST(type_mismatch) {
+    start_capture();
+    C_PRINT("[{s}]", 500);
+    end_capture();
+    expect_output("[\033[1;31m{? expected string, got int}\033[0m]");
+}
+
+TEST(missing_argument) {
+    start_capture();
+    C_PRINT("{d} {d}", 1);
+    end_capture();
+    expect_output("1 \033[1;31m{? missing argument for 'd'}\033[0m");
+}
+
+TEST(unknown_format_keeps_arguments) {
+    start_capture();
+    C_PRINT("{z} {d}", 9);
+    end_capture();
+    expect_output("\033[1;31m{? unknown format: z}\033[0m 9");
+}
+
+// ============================================================================
+// VALIDACIÓN
+// ============================================================================
+
+TEST(validate_many_arguments) {
+    CPrintArg args[12];
+    for (int i = 0; i < 12; i++) args[i] = CPRINT_ARG(i);
+
+    assert(c_print_validate_pattern_array("{d}{d}{d}{d}{d}{d}{d}{d}{d}{d}{d}{d}", args, 12));
+    assert(!c_print_validate_pattern_array("{d}{d}{d}{d}{d}{d}{d}{d}{d}{d}{d}{s}", args, 12));
+    assert(!c_print_validate_pattern_array("{d}{d}", args, 12));
+}
+
+TEST(validate_variadic) {
+    assert(c_print_validate_pattern("{s} {d}", 2, CPRINT_ARG("a"), CPRINT_ARG(1)));
+    assert(!c_print_validate_pattern("{s} {d}", 2, CPRINT_ARG(1), CPRINT_ARG(1)));
+}
+
+int main(void) {
+    fprintf(stderr, "\n");
+    fprintf(stderr, "═══════════════════════════════════════════════════════════\n");
+    fprintf(stderr, "  Checked C_PRINT (_Generic) - Unit Tests\n");
+    fprintf(stderr, "═══════════════════════════════════════════════════════════\n");
+    fprintf(stderr, "\n");
+
+    fprintf(stderr, "Output:\n");
+    RUN_TEST(same_output_as_c_print);
+    RUN_TEST(more_than_ten_arguments);
+    RUN_TEST(array_with_count);
+    RUN_TEST(variadic_wrapper);
+    fprintf(stderr, "\n");
+
+    fprintf(stderr, "Errors:\n");
+    RUN_TEST(type_mismatch);
+    RUN_TEST(missing_argument);
+    RUN_TEST(unknown_format_keeps_arguments);
+    fprintf(stderr, "\n");
+
+    fprintf(stderr, "Validation:\n");
+    RUN_TEST(validate_many_arguments);
+    RUN_TEST(validate_variadic);
+    fprintf(stderr, "\n");
+
+    clear_pattern_cache();
+
+    fprintf(stderr, "═══════════════════════════════════════════════════════════\n");
+    fprintf(stderr, "  Results: %d tests passed ✓\n", tests_passed);
+    fprintf(stderr, "═══════════════════════════════════════════════════════════\n");
+    fprintf(stderr, "\n");
+
+    return 0;
+}
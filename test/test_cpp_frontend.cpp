@@ -0,0 +1,242 @@
+/**
+ * @file test_cpp_frontend.cpp
+ * @brief Tests para el front end C++ header-only (c_print.hpp)
+ *
+ * Se compila como C++17 (CPRINT_COMPILE) y, si el compilador lo soporta,
+ * como C++20 (cprint::print<"...">). Con -DCPRINT_EXPECT_COMPILE_ERROR
+ * debe fallar al compilar.
+ */
+
+#include "c_print.hpp"
+#include "pattern_parser.h"
+#include <cassert>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+#include <fcntl.h>
+#include <unistd.h>
+
+#define TEST(name) static void test_##name()
+#define RUN_TEST(name) do { \
+    fprintf(stderr, "  Running: %s... ", #name); \
+    test_##name(); \
+    fprintf(stderr, "✓\n"); \
+    tests_passed++; \
+} while(0)
+
+static int tests_passed = 0;
+static char captured_output[4096];
+static int stdout_pipe[2];
+static int saved_stdout;
+
+static void start_capture() {
+    fflush(stdout);
+    saved_stdout = dup(STDOUT_FILENO);
+    int rc = pipe(stdout_pipe);
+    assert(rc == 0);
+    dup2(stdout_pipe[1], STDOUT_FILENO);
+    close(stdout_pipe[1]);
+    memset(captured_output, 0, sizeof(captured_output));
+}
+
+static void end_capture() {
+    fflush(stdout);
+
+    dup2(saved_stdout, STDOUT_FILENO);
+    close(saved_stdout);
+
+    int flags = fcntl(stdout_pipe[0], F_GETFL, 0);
+    fcntl(stdout_pipe[0], F_SETFL, flags | O_NONBLOCK);
+
+    ssize_t bytes_read = read(stdout_pipe[0], captured_output, sizeof(captured_output) - 1);
+    if (bytes_read > 0) {
+        captured_output[bytes_read] = '\0';
+    }
+
+    close(stdout_pipe[0]);
+}
+
+static std::string reference;
+
+static void capture_reference() {
+    end_capture();
+    reference = captured_output;
+    start_capture();
+}
+
+static void expect_reference() {
+    end_capture();
+    if (reference != captured_output) {
+        fprintf(stderr, "\n  Expected: '%s'\n  Got:      '%s'\n", reference.c_str(), captured_output);
+        assert(0);
+    }
+}
+
+// ============================================================================
+// PARSEO CONSTEXPR
+// ============================================================================
+
+static bool same_style(const PatternStyle& a, const PatternStyle& b) {
+    return a.format_type == b.format_type && a.text_color == b.text_color &&
+           a.bg_color == b.bg_color && a.style == b.style &&
+           a.has_color == b.has_color && a.has_bg == b.has_bg && a.has_style == b.has_style &&
+           a.align == b.align && a.width == b.width && a.has_alignment == b.has_alignment &&
+           a.fill_char == b.fill_char && a.precision == b.precision &&
+           a.has_precision == b.has_precision && a.padding == b.padding &&
+           a.zero_pad == b.zero_pad && a.separator == b.separator &&
+           a.has_separator == b.has_separator && a.show_prefix == b.show_prefix &&
+           a.show_sign == b.show_sign && a.as_percentage == b.as_percentage;
+}
+
+TEST(parser_matches_parse_pattern) {
+    const char* patterns[] = {
+        "{s}", "{s:red}", "{s:RED:bold}", "{d:05}", "{d:+}", "{d:+:08}", "{d:,}",
+        "{u:_}", "{f:.2}", "{f:.1%}", "{f:%}", "{x:#:08}", "{b:#}", "{o:#}",
+        "{s:<10}", "{s:*>12}", "{s:-^20:bright_cyan}", "{s:bg_blue:white:underline}",
+        "{s:bg_nope}", "{ d : red }", "{:s}", "{s::red}", "{s:unknown}", "{z}", "{l:,:yellow}",
+    };
+
+    for (const char* pattern : patterns) {
+        PatternStyle expected;
+        PatternStyle actual;
+        bool expected_ok = parse_pattern(pattern, &expected);
+        std::string_view content(pattern + 1, strlen(pattern) - 2);
+        bool actual_ok = cprint::detail::parse_content(content, actual);
+
+        assert(expected_ok == actual_ok);
+        if (expected_ok && !same_style(expected, actual)) {
+            fprintf(stderr, "\n  Mismatch for %s\n", pattern);
+            assert(0);
+        }
+    }
+}
+
+// ============================================================================
+// SALIDA IDÉNTICA A c_print
+// ============================================================================
+
+TEST(cpp17_matches_c_print) {
+    start_capture();
+    c_print("Hola {s:red}, saldo {d:,} ({f:.2}) hex {x:#:08} [{s:^9}] \\{ok} {z}\n",
+            "Ana", 1234567, 3.14159, 255u, "mid");
+    capture_reference();
+    cprint::print(CPRINT_COMPILE("Hola {s:red}, saldo {d:,} ({f:.2}) hex {x:#:08} [{s:^9}] \\{ok} {z}\n"),
+                  "Ana", 1234567, 3.14159, 255u, "mid");
+    expect_reference();
+}
+
+TEST(numbers_match_c_print) {
+    start_capture();
+    c_print("{d:+:05}|{d}|{u:,}|{l:_}|{b:#}|{o:#}|{f}|{f:%}|{c:bold}|{s:*<6}\n",
+            42, -7, 4000000000u, 123456789L, 5u, 8u, 1.5, 0.25, 'z', "ab");
+    capture_reference();
+    cprint::print(CPRINT_COMPILE("{d:+:05}|{d}|{u:,}|{l:_}|{b:#}|{o:#}|{f}|{f:%}|{c:bold}|{s:*<6}\n"),
+                  42, -7, 4000000000u, 123456789L, 5u, 8u, 1.5, 0.25, 'z', "ab");
+    expect_reference();
+}
+
+TEST(std_strings_by_length) {
+    std::string name = "Grace";
+    std::string_view role = "admin-user";
+
+    start_capture();
+    cprint::print(CPRINT_COMPILE("{s:>7}|{s}"), name, role.substr(0, 5));
+    end_capture();
+    assert(strcmp(captured_output, "  Grace|admin") == 0);
+}
+
+#if __cplusplus >= 202002L
+TEST(cpp20_template_pattern) {
+    start_capture();
+    c_print("{s:green} tiene {d:yellow} años\n", "Juan", 25);
+    capture_reference();
+    cprint::print<"{s:green} tiene {d:yellow} años\n">("Juan", 25);
+    expect_reference();
+}
+#endif
+
+// ============================================================================
+// LÍNEAS ATÓMICAS
+// ============================================================================
+
+#define PRINT_THREADS 4
+#define LINES_PER_THREAD 3000
+#define LONG_LINE_WIDTH 3000         // Mayor que el buffer de 1 KB de print_compiled
+
+TEST(long_lines_not_torn) {
+    FILE* capture = tmpfile();
+    assert(capture);
+    fflush(stdout);
+    int saved = dup(STDOUT_FILENO);
+    dup2(fileno(capture), STDOUT_FILENO);
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < PRINT_THREADS; t++) {
+        threads.emplace_back([t] {
+            for (int seq = 0; seq < LINES_PER_THREAD; seq++) {
+                cprint::print(CPRINT_COMPILE("T{d} #{d} {s:*^3000}|\n"), t, seq, "middle");
+            }
+        });
+    }
+    for (std::thread& thread : threads) thread.join();
+
+    fflush(stdout);
+    dup2(saved, STDOUT_FILENO);
+    close(saved);
+    rewind(capture);
+
+    std::string field(LONG_LINE_WIDTH, '*');
+    field.replace((LONG_LINE_WIDTH - 6) / 2, 6, "middle");
+
+    static char line[LONG_LINE_WIDTH + 64];
+    int next_seq[PRINT_THREADS] = {};
+    int lines = 0;
+    while (fgets(line, sizeof(line), capture)) {
+        int id = -1;
+        int seq = -1;
+        int fields = sscanf(line, "T%d #%d", &id, &seq);
+        assert(fields == 2);
+        assert(id >= 0 && id < PRINT_THREADS && seq == next_seq[id]);
+        next_seq[id]++;
+
+        std::string expected = "T" + std::to_string(id) + " #" + std::to_string(seq) +
+                               " " + field + "|\n";
+        assert(expected == line);
+        lines++;
+    }
+    assert(lines == PRINT_THREADS * LINES_PER_THREAD);
+    fclose(capture);
+}
+
+#ifdef CPRINT_EXPECT_COMPILE_ERROR
+TEST(type_mismatch_rejected) {
+    cprint::print(CPRINT_COMPILE("{s}"), 500);
+}
+#endif
+
+int main() {
+    fprintf(stderr, "\n");
+    fprintf(stderr, "═══════════════════════════════════════════════════════════\n");
+    fprintf(stderr, "  C++ Front End (C++%ld) - Unit Tests\n", __cplusplus / 100 % 100);
+    fprintf(stderr, "═══════════════════════════════════════════════════════════\n");
+    fprintf(stderr, "\n");
+
+    RUN_TEST(parser_matches_parse_pattern);
+    RUN_TEST(cpp17_matches_c_print);
+    RUN_TEST(numbers_match_c_print);
+    RUN_TEST(std_strings_by_length);
+#if __cplusplus >= 202002L
+    RUN_TEST(cpp20_template_pattern);
+#endif
+    RUN_TEST(long_lines_not_torn);
+    fprintf(stderr, "\n");
+
+    fprintf(stderr, "═══════════════════════════════════════════════════════════\n");
+    fprintf(stderr, "  Results: %d tests passed ✓\n", tests_passed);
+    fprintf(stderr, "═══════════════════════════════════════════════════════════\n");
+    fprintf(stderr, "\n");
+
+    return 0;
+}
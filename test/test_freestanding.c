@@ -0,0 +1,210 @@
+/**
+ * @file test_freestanding.c
+ * @brief Tests unitarios para la compilación freestanding (c_print_to)
+ *
+ * El test enlaza solo la biblioteca freestanding, así que no puede
+ * comparar contra c_snprint: los resultados esperados son literales. El
+ * chequeo de símbolos (FreestandingSymbols) verifica aparte que la
+ * biblioteca no dependa de stdio, malloc ni ctype.
+ */
+
+#include "c_print_freestanding.h"
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+
+#define TEST(name) static void test_##name(void)
+#define RUN_TEST(name) do { \
+    fprintf(stderr, "  Running: %s... ", #name); \
+    test_##name(); \
+    fprintf(stderr, "✓\n"); \
+    tests_passed++; \
+} while(0)
+
+static int tests_passed = 0;
+
+// ============================================================================
+// SINK DE PRUEBA
+// ============================================================================
+
+typedef struct {
+    char data[8192];
+    size_t length;
+    int calls;
+    size_t largest;             // Bloque más grande recibido
+    size_t accept_limit;        // 0 = acepta todo
+} CollectSink;
+
+static size_t collect_write(void* ctx, const char* data, size_t len) {
+    CollectSink* collect = (CollectSink*)ctx;
+    collect->calls++;
+    if (len > collect->largest) collect->largest = len;
+
+    size_t accepted = collect->accept_limit && len > collect->accept_limit
+                      ? collect->accept_limit : len;
+    assert(collect->length + accepted < sizeof(collect->data));
+    memcpy(collect->data + collect->length, data, accepted);
+    collect->length += accepted;
+    collect->data[collect->length] = '\0';
+    return accepted;
+}
+
+static CollectSink collected;
+
+static CPrintSink collect_sink(void) {
+    memset(&collected, 0, sizeof(collected));
+    CPrintSink sink = {collect_write, &collected};
+    return sink;
+}
+
+/**
+ * @brief Renderiza en un buffer grande y compara con el texto esperado
+ */
+#define EXPECT_TEXT(expected, ...) do { \
+    char out[1024]; \
+    size_t len_ = c_print_to(NULL, out, sizeof(out), __VA_ARGS__); \
+    assert(len_ == strlen(expected)); \
+    assert(strcmp(out, expected) == 0); \
+} while(0)
+
+// ============================================================================
+// TEXTO
+// ============================================================================
+
+TEST(strings_and_alignment) {
+    EXPECT_TEXT("plain literal\n", "plain literal\n");
+    EXPECT_TEXT("Hello World!\n", "Hello {s}!\n", "World");
+    EXPECT_TEXT("[left      ][     right][    mid    ]",
+                "[{s:<10}][{s:>10}][{s:^11}]", "left", "right", "mid");
+    EXPECT_TEXT("************TITLE************", "{s:*^29}", "TITLE");
+    EXPECT_TEXT("text||x", "{s}|{s}|{s}", "text", NULL, "x");
+    EXPECT_TEXT("unknown and {?} and {s} after",
+                "{s} and {?} and \\{s} {s}", "unknown", "after");
+}
+
+TEST(numbers) {
+    EXPECT_TEXT("42 00042 -7 +3", "{d} {d:05} {i} {d:+}", 42, 42, -7, 3);
+    EXPECT_TEXT("-1,234,567 4_000_000_000 9,876,543,210",
+                "{d:,} {u:_} {l:,}", -1234567, 4000000000u, 9876543210L);
+    EXPECT_TEXT("ff 0xff 0b101 0o10 q", "{x} {x:#} {b:#} {o:#} {c}", 255u, 255u, 5u, 8u, 'q');
+    EXPECT_TEXT("[_______7]", "[{d:_>8}]", 7);
+}
+
+TEST(floats) {
+    EXPECT_TEXT("3.141590 2.67 2 75.5%", "{f} {f:.2} {f:.0} {f:.1:%}", 3.14159, 2.675, 2.5, 0.755);
+    EXPECT_TEXT("-0.001 0.125 1234.56", "{f:.3} {f:.3} {f:.2}", -0.0005, 0.125, 1234.56);
+}
+
+TEST(escapes) {
+    EXPECT_TEXT("\033[1;32mok\033[0m", "{s:green:bold}", "ok");
+    EXPECT_TEXT("\033[31m   -5\033[0m|\033[44mx\033[0m", "{d:red:>5}|{s:bg_blue}", -5, "x");
+}
+
+// ============================================================================
+// BUFFER DEL LLAMADOR
+// ============================================================================
+
+TEST(truncates_like_snprintf) {
+    char out[8];
+    memset(out, '#', sizeof(out));
+    size_t len = c_print_to(NULL, out, sizeof(out), "value={d:05}", 42);
+    assert(len == 11);
+    assert(strcmp(out, "value=0") == 0);
+
+    // capacity 0: no se toca el buffer, pero se informa la longitud
+    out[0] = '#';
+    len = c_print_to(NULL, out, 0, "{s}", "abc");
+    assert(len == 3);
+    assert(out[0] == '#');
+
+    // Sin buffer solo se mide
+    len = c_print_to(NULL, NULL, 0, "{d} {s:red}", 12345, "x");
+    assert(len == 16);
+}
+
+TEST(small_buffer_streams_to_sink) {
+    static char long_text[3000];
+    memset(long_text, 'q', sizeof(long_text) - 1);
+    long_text[sizeof(long_text) - 1] = '\0';
+
+    CPrintSink sink = collect_sink();
+    char staging[16];
+    size_t written = c_print_to(&sink, staging, sizeof(staging), "<{s:-^20:cyan}> {d:,} {s}\n",
+                                "wide", 1234567, long_text);
+
+    char expected[4096];
+    int len = snprintf(expected, sizeof(expected), "<\033[36m--------wide--------\033[0m> 1,234,567 %.1023s\n",
+                       long_text);
+    assert(written == (size_t)len);
+    assert(strcmp(collected.data, expected) == 0);
+    assert(collected.largest <= sizeof(staging));
+    assert(collected.calls >= len / (int)sizeof(staging));
+}
+
+TEST(one_write_when_it_fits) {
+    CPrintSink sink = collect_sink();
+    char staging[256];
+    size_t written = c_print_to(&sink, staging, sizeof(staging), "id={d} user={s:cyan}\n", 7, "alice");
+    assert(written == 25);
+    assert(strcmp(collected.data, "id=7 user=\033[36malice\033[0m\n") == 0);
+    assert(collected.calls == 1);
+}
+
+TEST(short_writes_reported) {
+    CPrintSink sink = collect_sink();
+    collected.accept_limit = 3;
+    char staging[8];
+    size_t written = c_print_to(&sink, staging, sizeof(staging), "0123456789abcdef");
+    assert(collected.calls == 2);
+    assert(written == 6);
+    assert(strcmp(collected.data, "01289a") == 0);
+}
+
+TEST(bad_arguments) {
+    char staging[16];
+    CPrintSink sink = collect_sink();
+    CPrintSink no_write = {NULL, NULL};
+
+    size_t no_buffer = c_print_to(&sink, NULL, 16, "x");
+    size_t no_capacity = c_print_to(&sink, staging, 0, "x");
+    size_t no_write_fn = c_print_to(&no_write, staging, sizeof(staging), "x");
+    size_t sink_no_pattern = c_print_to(&sink, staging, sizeof(staging), NULL);
+    size_t no_pattern = c_print_to(NULL, staging, sizeof(staging), NULL);
+    assert(no_buffer == 0);
+    assert(no_capacity == 0);
+    assert(no_write_fn == 0);
+    assert(sink_no_pattern == 0);
+    assert(no_pattern == 0);
+    assert(staging[0] == '\0');
+    assert(collected.calls == 0);
+}
+
+int main(void) {
+    fprintf(stderr, "\n");
+    fprintf(stderr, "═══════════════════════════════════════════════════════════\n");
+    fprintf(stderr, "  Freestanding Build - Unit Tests\n");
+    fprintf(stderr, "═══════════════════════════════════════════════════════════\n");
+    fprintf(stderr, "\n");
+
+    fprintf(stderr, "Text:\n");
+    RUN_TEST(strings_and_alignment);
+    RUN_TEST(numbers);
+    RUN_TEST(floats);
+    RUN_TEST(escapes);
+    fprintf(stderr, "\n");
+
+    fprintf(stderr, "Caller memory:\n");
+    RUN_TEST(truncates_like_snprintf);
+    RUN_TEST(small_buffer_streams_to_sink);
+    RUN_TEST(one_write_when_it_fits);
+    RUN_TEST(short_writes_reported);
+    RUN_TEST(bad_arguments);
+    fprintf(stderr, "\n");
+
+    fprintf(stderr, "═══════════════════════════════════════════════════════════\n");
+    fprintf(stderr, "  Results: %d tests passed ✓\n", tests_passed);
+    fprintf(stderr, "═══════════════════════════════════════════════════════════\n");
+    fprintf(stderr, "\n");
+
+    return 0;
+}
@@ -0,0 +1,190 @@
+/**
+ * @file test_latency.c
+ * @brief Tests unitarios para la latencia por etapa (c_print_latency)
+ */
+
+#include "c_print_latency.h"
+#include "c_print.h"
+#include "c_print_builder.h"
+#include "c_print_sink.h"
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <fcntl.h>
+
+#define TEST(name) static void test_##name(void)
+#define RUN_TEST(name) do { \
+    fprintf(stderr, "  Running: %s... ", #name); \
+    c_print_latency_reset(); \
+    test_##name(); \
+    fprintf(stderr, "✓\n"); \
+    tests_passed++; \
+} while(0)
+
+#define LINES 500
+#define THREADS 4
+
+static int tests_passed = 0;
+static int saved_stdout;
+
+// La salida de c_print se descarta en /dev/null
+static void start_discard(void) {
+    fflush(stdout);
+    saved_stdout = dup(STDOUT_FILENO);
+    int null_fd = open("/dev/null", O_WRONLY);
+    assert(null_fd >= 0);
+    dup2(null_fd, STDOUT_FILENO);
+    close(null_fd);
+}
+
+static void end_discard(void) {
+    fflush(stdout);
+    dup2(saved_stdout, STDOUT_FILENO);
+    close(saved_stdout);
+}
+
+static unsigned long long stage_count(CPrintStage stage) {
+    CPrintLatency lat;
+    bool enabled = c_print_latency(stage, &lat);
+    assert(enabled);
+    return lat.count;
+}
+
+// ============================================================================
+// MUESTRAS POR ETAPA
+// ============================================================================
+
+TEST(c_print_samples_per_call) {
+    start_discard();
+    for (int i = 0; i < LINES; i++) {
+        c_print("user {s:>10} balance {d:,}\n", "ana", i * 1000);
+    }
+    end_discard();
+
+    assert(stage_count(CPRINT_STAGE_PARSE) == LINES);
+    assert(stage_count(CPRINT_STAGE_FORMAT) == LINES);
+    assert(stage_count(CPRINT_STAGE_ALIGN) == LINES);
+    assert(stage_count(CPRINT_STAGE_WRITE) == LINES);
+}
+
+TEST(unused_stage_has_no_samples) {
+    start_discard();
+    for (int i = 0; i < LINES; i++) c_print("plain {d}\n", i);
+    end_discard();
+
+    assert(stage_count(CPRINT_STAGE_PARSE) == LINES);
+    assert(stage_count(CPRINT_STAGE_ALIGN) == 0);
+}
+
+TEST(builder_samples) {
+    CPrintBuilderStorage storage;
+    CPrintBuilder* b = cp_init(CP_BUILDER(&storage), NULL, 0);
+    CPrintSink sink = cp_sink_fd(-1);
+
+    cp_int(b, 42);
+    cp_hex(b, 255u);
+    cp_str(cp_align_right(b, 12), "right");
+    cp_write(b, &sink);
+
+    assert(stage_count(CPRINT_STAGE_FORMAT) == 2);
+    assert(stage_count(CPRINT_STAGE_ALIGN) == 1);
+    assert(stage_count(CPRINT_STAGE_WRITE) == 1);
+    assert(stage_count(CPRINT_STAGE_PARSE) == 0);
+
+    cp_free(b);
+}
+
+TEST(percentiles_are_ordered) {
+    start_discard();
+    for (int i = 0; i < LINES; i++) c_print("{f:.3} {x:#}\n", i * 0.5, (unsigned)i);
+    end_discard();
+
+    for (int s = 0; s < CPRINT_STAGE_COUNT; s++) {
+        CPrintLatency lat;
+        bool enabled = c_print_latency((CPrintStage)s, &lat);
+        assert(enabled);
+        if (s == CPRINT_STAGE_ALIGN) {
+            assert(lat.count == 0);
+            continue;
+        }
+        assert(lat.count == LINES);
+        assert(lat.p50_ns > 0.0);
+        assert(lat.p50_ns <= lat.p99_ns);
+        assert(lat.p99_ns <= lat.p999_ns);
+        assert(lat.p999_ns <= lat.max_ns);
+    }
+}
+
+static void* print_worker(void* unused) {
+    (void)unused;
+    for (int i = 0; i < LINES; i++) c_print("thread line {d}\n", i);
+    return NULL;
+}
+
+TEST(threads_are_merged) {
+    pthread_t threads[THREADS];
+
+    start_discard();
+    for (int t = 0; t < THREADS; t++) {
+        int rc = pthread_create(&threads[t], NULL, print_worker, NULL);
+        assert(rc == 0);
+    }
+    for (int t = 0; t < THREADS; t++) pthread_join(threads[t], NULL);
+    end_discard();
+
+    assert(stage_count(CPRINT_STAGE_PARSE) == THREADS * LINES);
+}
+
+TEST(reset_and_dump) {
+    start_discard();
+    c_print("{d}\n", 1);
+    end_discard();
+    assert(stage_count(CPRINT_STAGE_WRITE) == 1);
+
+    c_print_latency_reset();
+    assert(stage_count(CPRINT_STAGE_WRITE) == 0);
+
+    char text[1024];
+    FILE* fp = fmemopen(text, sizeof(text), "w");
+    assert(fp);
+    c_print_latency_dump(fp);
+    fclose(fp);
+    assert(strstr(text, "p999 ns"));
+    assert(strstr(text, "parse"));
+    assert(strstr(text, "write"));
+}
+
+TEST(stage_names) {
+    assert(strcmp(c_print_latency_stage_name(CPRINT_STAGE_FORMAT), "format") == 0);
+    assert(strcmp(c_print_latency_stage_name(CPRINT_STAGE_COUNT), "unknown") == 0);
+}
+
+int main(void) {
+    fprintf(stderr, "\n");
+    fprintf(stderr, "═══════════════════════════════════════════════════════════\n");
+    fprintf(stderr, "  Stage Latency - Unit Tests\n");
+    fprintf(stderr, "═══════════════════════════════════════════════════════════\n");
+    fprintf(stderr, "\n");
+
+    fprintf(stderr, "Samples:\n");
+    RUN_TEST(c_print_samples_per_call);
+    RUN_TEST(unused_stage_has_no_samples);
+    RUN_TEST(builder_samples);
+    fprintf(stderr, "\n");
+
+    fprintf(stderr, "Histograms:\n");
+    RUN_TEST(percentiles_are_ordered);
+    RUN_TEST(threads_are_merged);
+    RUN_TEST(reset_and_dump);
+    RUN_TEST(stage_names);
+    fprintf(stderr, "\n");
+
+    fprintf(stderr, "═══════════════════════════════════════════════════════════\n");
+    fprintf(stderr, "  Results: %d tests passed ✓\n", tests_passed);
+    fprintf(stderr, "═══════════════════════════════════════════════════════════\n");
+    fprintf(stderr, "\n");
+
+    return 0;
+}
@@ -0,0 +1,325 @@
+/**
+ * @file test_no_heap.c
+ * @brief Comprueba la configuración sin heap con un malloc interpuesto
+ *
+ * El test define malloc/calloc/realloc/free (y variantes alineadas): al
+ * enlazarse en el ejecutable reemplazan a los de libc para todo el
+ * proceso, incluidas las llamadas internas de libc. Sirven la memoria
+ * desde un arena estático y cuentan las reservas mientras hay una
+ * región medida activa.
+ *
+ * Tras un calentamiento (caché de patrones por hilo y buffer de stdout)
+ * cada API de formateo se ejecuta dentro de una región medida que debe
+ * terminar con cero reservas.
+ */
+
+#define C_PRINT_USE_GENERIC
+#include "c_print.h"
+#include "c_print_builder.h"
+#include "c_print_generic.h"
+#include "c_print_safe.h"
+#include "c_print_argv.h"
+#include "c_print_alloc.h"
+#include "pattern_compiler.h"
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <stdint.h>
+#include <stdatomic.h>
+#include <assert.h>
+#include <unistd.h>
+#include <fcntl.h>
+
+#define TEST(name) static void test_##name(void)
+#define RUN_TEST(name) do { \
+    fprintf(stderr, "  Running: %s... ", #name); \
+    test_##name(); \
+    fprintf(stderr, "✓\n"); \
+    tests_passed++; \
+} while(0)
+
+#define ROUNDS 50
+
+static int tests_passed = 0;
+
+// ============================================================================
+// MALLOC INTERPUESTO
+// ============================================================================
+
+#define HEAP_SIZE (64u * 1024u * 1024u)
+#define HEADER 16u
+
+static _Alignas(64) unsigned char heap[HEAP_SIZE];
+static atomic_size_t heap_offset;
+static atomic_bool counting;
+static atomic_ulong allocations;
+
+static void* heap_take(size_t size, size_t align) {
+    if (align < HEADER) align = HEADER;
+
+    size_t start = atomic_load(&heap_offset);
+    size_t user;
+    do {
+        user = (start + HEADER + align - 1) & ~(align - 1);
+        if (user + size > HEAP_SIZE) return NULL;
+    } while (!atomic_compare_exchange_weak(&heap_offset, &start, user + size));
+
+    if (atomic_load(&counting)) atomic_fetch_add(&allocations, 1);
+
+    memcpy(heap + user - sizeof(size_t), &size, sizeof(size_t));
+    return heap + user;
+}
+
+static size_t heap_size_of(void* ptr) {
+    size_t size;
+    memcpy(&size, (unsigned char*)ptr - sizeof(size_t), sizeof(size_t));
+    return size;
+}
+
+void* malloc(size_t size) {
+    return heap_take(size, HEADER);
+}
+
+void* calloc(size_t count, size_t size) {
+    if (size && count > SIZE_MAX / size) return NULL;
+    void* ptr = heap_take(count * size, HEADER);
+    if (ptr) memset(ptr, 0, count * size);
+    return ptr;
+}
+
+void* realloc(void* ptr, size_t size) {
+    if (!ptr) return malloc(size);
+    void* fresh = heap_take(size, HEADER);
+    if (!fresh) return NULL;
+    size_t old = heap_size_of(ptr);
+    memcpy(fresh, ptr, old < size ? old : size);
+    return fresh;
+}
+
+void free(void* ptr) {
+    (void)ptr;      // El arena no reutiliza memoria
+}
+
+void* aligned_alloc(size_t align, size_t size) {
+    return heap_take(size, align);
+}
+
+void* memalign(size_t align, size_t size) {
+    return heap_take(size, align);
+}
+
+int posix_memalign(void** out, size_t align, size_t size) {
+    void* ptr = heap_take(size, align);
+    if (!ptr) return ENOMEM;
+    *out = ptr;
+    return 0;
+}
+
+static void begin_counting(void) {
+    atomic_store(&allocations, 0);
+    atomic_store(&counting, true);
+}
+
+static unsigned long end_counting(void) {
+    atomic_store(&counting, false);
+    return atomic_load(&allocations);
+}
+
+/**
+ * @brief Ejecuta el bloque y falla si reservó memoria
+ */
+#define EXPECT_NO_HEAP(...) do { \
+    begin_counting(); \
+    __VA_ARGS__; \
+    unsigned long n_ = end_counting(); \
+    if (n_ != 0) { \
+        fprintf(stderr, "\n  %lu allocation(s) in: %s\n", n_, #__VA_ARGS__); \
+        assert(0); \
+    } \
+} while (0)
+
+// ============================================================================
+// CARGAS DE TRABAJO
+// ============================================================================
+
+static const char* const patterns[] = {
+    "plain text without fields\n",
+    "{s} has {d} items\n",
+    "{s:red:bold:>20}|{s:<8}|{s:*^12}\n",
+    "{d:,} {d:05} {d:+} {u:_} {l:,}\n",
+    "{f} {f:.2} {f:%} {f:.3:%}\n",
+    "{b:#} {x:#} {x:08} {o:#} {c}\n",
+    "{s:.3} {z} \\{literal}\n",
+};
+
+static void snprint_all(void) {
+    char buffer[256];
+    c_snprint(buffer, sizeof(buffer), patterns[0]);
+    c_snprint(buffer, sizeof(buffer), patterns[1], "ana", 3);
+    c_snprint(buffer, sizeof(buffer), patterns[2], "a", "b", "c");
+    c_snprint(buffer, sizeof(buffer), patterns[3], -1234567, 42, 7, 1000000u, 9876543210L);
+    c_snprint(buffer, sizeof(buffer), patterns[4], 3.14159, 2.5, 0.75, 0.125);
+    c_snprint(buffer, sizeof(buffer), patterns[5], 5u, 255u, 0xbeefu, 8u, 'z');
+    c_snprint(buffer, sizeof(buffer), patterns[6], "truncated");
+    c_snprint(buffer, 8, patterns[1], "truncated output", 123456);
+}
+
+static void print_all(void) {
+    c_print(patterns[1], "ana", 3);
+    c_print(patterns[2], "a", "b", "c");
+    c_print(patterns[3], -1234567, 42, 7, 1000000u, 9876543210L);
+    c_print(patterns[4], 3.14159, 2.5, 0.75, 0.125);
+    c_print_fd(STDOUT_FILENO, patterns[5], 5u, 255u, 0xbeefu, 8u, 'z');
+    c_print_styled("styled\n", COLOR_GREEN, BG_BLACK, STYLE_BOLD);
+    c_printf_styled(COLOR_CYAN, BG_RESET, STYLE_RESET, "%s %d\n", "printf", 7);
+}
+
+// c_print_typed() y el C_PRINT de c_print_typed.h (test_no_heap_typed.c)
+void typed_all(void);
+
+static void engine_all(void) {
+    C_PRINT(patterns[1], "ana", 3);
+    C_PRINT("{s:cyan} {f:.2} {x:#}\n", "checked", 1.5, 255u);
+    c_print_safe(patterns[2], "a", "b", "c");
+    c_print_safe(patterns[3], -1234567, 42, 7, 1000000u, 9876543210L);
+    typed_all();
+    fflush(stdout);
+}
+
+static void argv_all(void) {
+    char buffer[256];
+    CPrintArg args[2];
+    args[0].type = CPRINT_ARG_STRING;
+    args[0].value.s = "argv";
+    args[1].type = CPRINT_ARG_INT;
+    args[1].value.i = 99;
+    c_print_argv(patterns[1], args, 2, buffer, sizeof(buffer));
+    c_print_argv_batch(patterns[1], args, 2, 1, buffer, sizeof(buffer));
+}
+
+static void builder_all(int fd) {
+    CPrintBuilderStorage storage;
+    char text[512];
+    CPrintBuilder* b = cp_init(CP_BUILDER(&storage), text, sizeof(text));
+    CPrintSink sink = cp_sink_fd(fd);
+
+    for (int i = 0; i < 4; i++) {
+        cp_text(b, "row ");
+        cp_int(cp_separator(b, ','), 1234567 * i);
+        cp_text(b, " ");
+        cp_float(cp_precision(b, 2), 3.14159 * i);
+        cp_text(b, " ");
+        cp_hex(cp_show_prefix(b, true), 0xbeefu);
+        cp_text(b, " ");
+        cp_str(cp_align_center(cp_color(b, COLOR_RED), 12), "mid");
+        cp_text(b, "\n");
+        cp_write(b, &sink);
+        cp_reset(b);
+    }
+}
+
+// ============================================================================
+// TESTS
+// ============================================================================
+
+static int null_fd = -1;
+
+TEST(interposer_detects_allocations) {
+    void* (*volatile do_malloc)(size_t) = malloc;
+    begin_counting();
+    do_malloc(32);
+    unsigned long n = end_counting();
+    assert(n == 1);
+
+    // Un builder del heap sí reserva
+    begin_counting();
+    CPrintBuilder* heap_builder = cp_new();
+    n = end_counting();
+    assert(n > 0);
+    cp_free(heap_builder);
+}
+
+TEST(snprint_into_caller_buffer) {
+    for (int r = 0; r < ROUNDS; r++) EXPECT_NO_HEAP(snprint_all());
+
+    char buffer[64];
+    c_snprint(buffer, sizeof(buffer), "{s:>6}|{d:,}", "ok", 1234);
+    assert(strcmp(buffer, "    ok|1,234") == 0);
+}
+
+TEST(compiled_pattern_in_arena) {
+    static char arena_memory[16 * 1024];
+    CPrintArena arena;
+    char buffer[128];
+    size_t len = 0;
+
+    cp_arena_init(&arena, arena_memory, sizeof(arena_memory));
+
+    // Compilar y renderizar sin heap, incluso la primera vez
+    EXPECT_NO_HEAP({
+        const CompiledPattern* compiled =
+            compile_pattern("id={d:05} name={s:green}", cp_arena_allocator(&arena));
+        assert(compiled);
+        len = c_snprint_compiled(buffer, sizeof(buffer), compiled, 42, "x");
+    });
+
+    assert(strcmp(buffer, "id=00042 name=\033[32mx\033[0m") == 0);
+    assert(len == strlen(buffer));
+}
+
+TEST(stack_builder) {
+    for (int r = 0; r < ROUNDS; r++) EXPECT_NO_HEAP(builder_all(null_fd));
+}
+
+TEST(argv_into_caller_buffer) {
+    for (int r = 0; r < ROUNDS; r++) EXPECT_NO_HEAP(argv_all());
+}
+
+TEST(stdout_paths_after_warmup) {
+    for (int r = 0; r < ROUNDS; r++) {
+        EXPECT_NO_HEAP(print_all());
+        EXPECT_NO_HEAP(engine_all());
+    }
+}
+
+int main(void) {
+    fprintf(stderr, "\n");
+    fprintf(stderr, "═══════════════════════════════════════════════════════════\n");
+    fprintf(stderr, "  No-Heap Configuration - Unit Tests\n");
+    fprintf(stderr, "═══════════════════════════════════════════════════════════\n");
+    fprintf(stderr, "\n");
+
+    // stdout a /dev/null; el calentamiento llena la caché y el buffer de stdio
+    null_fd = open("/dev/null", O_WRONLY);
+    assert(null_fd >= 0);
+    fflush(stdout);
+    int saved_stdout = dup(STDOUT_FILENO);
+    dup2(null_fd, STDOUT_FILENO);
+
+    snprint_all();
+    print_all();
+    engine_all();
+    argv_all();
+    builder_all(null_fd);
+
+    fprintf(stderr, "Zero allocations:\n");
+    RUN_TEST(interposer_detects_allocations);
+    RUN_TEST(snprint_into_caller_buffer);
+    RUN_TEST(compiled_pattern_in_arena);
+    RUN_TEST(stack_builder);
+    RUN_TEST(argv_into_caller_buffer);
+    RUN_TEST(stdout_paths_after_warmup);
+    fprintf(stderr, "\n");
+
+    fflush(stdout);
+    dup2(saved_stdout, STDOUT_FILENO);
+    close(saved_stdout);
+    close(null_fd);
+
+    fprintf(stderr, "═══════════════════════════════════════════════════════════\n");
+    fprintf(stderr, "  Results: %d tests passed ✓\n", tests_passed);
+    fprintf(stderr, "═══════════════════════════════════════════════════════════\n");
+    fprintf(stderr, "\n");
+
+    return 0;
+}
@@ -0,0 +1,14 @@
+/**
+ * @file test_no_heap_typed.c
+ * @brief Llamadas de c_print_typed.h para test_no_heap
+ *
+ * Va en su propia unidad de traducción porque c_print_typed.h y
+ * c_print_generic.h definen cada uno su C_PRINT.
+ */
+
+#include "c_print_typed.h"
+
+void typed_all(void) {
+    c_print_typed("{s} {d}\n", CPRINT_STR("typed"), CPRINT_INT(1));
+    C_PRINT("{s} {f:.2}\n", "typed macro", 2.5);
+}
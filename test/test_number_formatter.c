@@ -309,6 +309,70 @@ TEST(octal_powers_of_eight) {
     assert(strcmp(buffer, "1000") == 0);
 }
 
+// ============================================================================
+// TESTS PARA format_unsigned(), format_decimal() y format_fixed()
+// ============================================================================
+
+TEST(unsigned_bases) {
+    char buffer[100];
+    assert(format_unsigned(buffer, sizeof(buffer), 255, 16) == 2);
+    assert(strcmp(buffer, "ff") == 0);
+    format_unsigned(buffer, sizeof(buffer), 18446744073709551615ull, 10);
+    assert(strcmp(buffer, "18446744073709551615") == 0);
+    format_unsigned(buffer, sizeof(buffer), 5, 2);
+    assert(strcmp(buffer, "101") == 0);
+}
+
+TEST(decimal_sign_and_width) {
+    char buffer[100];
+    format_decimal(buffer, sizeof(buffer), 42, 1, 5, 1);
+    assert(strcmp(buffer, "+0042") == 0);
+    format_decimal(buffer, sizeof(buffer), -7, 0, 4, 0);
+    assert(strcmp(buffer, "  -7") == 0);
+    format_decimal(buffer, sizeof(buffer), 3, 2, 0, 0);
+    assert(strcmp(buffer, " 3") == 0);
+    format_decimal(buffer, sizeof(buffer), -9223372036854775807LL - 1, 0, 0, 0);
+    assert(strcmp(buffer, "-9223372036854775808") == 0);
+}
+
+TEST(fixed_matches_printf) {
+    char buffer[400], expected[400];
+    double values[] = {0.0, -0.0, 3.14159, 2.675, 0.125, 2.5, -1.0 / 3.0, 1e21, 1e-7, 123456.789};
+
+    for (size_t i = 0; i < sizeof(values) / sizeof(values[0]); i++) {
+        for (int precision = 0; precision <= 12; precision++) {
+            snprintf(expected, sizeof(expected), "%.*f", precision, values[i]);
+            assert(format_fixed(buffer, sizeof(buffer), values[i], precision) == strlen(expected));
+            assert(strcmp(buffer, expected) == 0);
+        }
+    }
+}
+
+TEST(fixed_rounds_half_even) {
+    char buffer[100];
+    format_fixed(buffer, sizeof(buffer), 0.125, 2);
+    assert(strcmp(buffer, "0.12") == 0);
+    format_fixed(buffer, sizeof(buffer), 0.375, 2);
+    assert(strcmp(buffer, "0.38") == 0);
+    format_fixed(buffer, sizeof(buffer), 9.9999, 2);
+    assert(strcmp(buffer, "10.00") == 0);
+}
+
+TEST(fixed_special_values) {
+    char buffer[400];
+    format_fixed(buffer, sizeof(buffer), 1.0 / 0.0, 2);
+    assert(strcmp(buffer, "inf") == 0);
+    format_fixed(buffer, sizeof(buffer), -1.0 / 0.0, 2);
+    assert(strcmp(buffer, "-inf") == 0);
+    format_fixed(buffer, sizeof(buffer), 1.7976931348623157e308, 0);
+    assert(strlen(buffer) == 309);
+    assert(strncmp(buffer, "17976931348623157", 17) == 0);
+
+    char small[6];
+    assert(format_fixed(small, sizeof(small), -123.456, 3) == 5);
+    assert(strcmp(small, "-123.") == 0);
+}
+
 // ============================================================================
 // TESTS DE INTEGRACIÓN
 // ============================================================================
@@ -508,6 +572,14 @@ int main(void) {
     RUN_TEST(octal_powers_of_eight);
     printf("\n");
     
+    printf("Testing format_unsigned(), format_decimal() and format_fixed():\n");
+    RUN_TEST(unsigned_bases);
+    RUN_TEST(decimal_sign_and_width);
+    RUN_TEST(fixed_matches_printf);
+    RUN_TEST(fixed_rounds_half_even);
+    RUN_TEST(fixed_special_values);
+    printf("\n");
+    
     printf("Integration tests:\n");
     RUN_TEST(integration_all_bases);
     RUN_TEST(integration_format_consistency);
@@ -0,0 +1,254 @@
+/**
+ * @file test_probes.c
+ * @brief Tests unitarios para los probes USDT (C_PRINT_USDT)
+ *
+ * Lee la sección .note.stapsdt de su propio ejecutable (/proc/self/exe)
+ * y comprueba que cada probe de la biblioteca está registrado con el
+ * proveedor, el nombre, los argumentos y la dirección que esperan
+ * bpftrace y perf.
+ */
+
+#include "c_print.h"
+#include "c_print_safe.h"
+#include "c_print_argv.h"
+#include "c_print_sink.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <assert.h>
+#include <elf.h>
+#include <unistd.h>
+#include <fcntl.h>
+
+#define TEST(name) static void test_##name(void)
+#define RUN_TEST(name) do { \
+    fprintf(stderr, "  Running: %s... ", #name); \
+    test_##name(); \
+    fprintf(stderr, "✓\n"); \
+    tests_passed++; \
+} while(0)
+
+#define MAX_PROBES 64
+
+static int tests_passed = 0;
+
+typedef struct {
+    uint64_t pc;
+    uint64_t base;
+    uint64_t semaphore;
+    const char* provider;
+    const char* name;
+    const char* args;
+} Probe;
+
+static unsigned char* image;
+static const Elf64_Shdr* sections;
+static size_t section_count;
+static const char* section_names;
+static Probe probes[MAX_PROBES];
+static size_t probe_count;
+
+// ============================================================================
+// LECTURA DEL ELF
+// ============================================================================
+
+static unsigned char* read_file(const char* path) {
+    FILE* fp = fopen(path, "rb");
+    assert(fp);
+    fseek(fp, 0, SEEK_END);
+    long size = ftell(fp);
+    fseek(fp, 0, SEEK_SET);
+
+    unsigned char* data = malloc((size_t)size);
+    assert(data);
+    size_t got = fread(data, 1, (size_t)size, fp);
+    assert(got == (size_t)size);
+    fclose(fp);
+    return data;
+}
+
+static const Elf64_Shdr* find_section(const char* name) {
+    for (size_t i = 0; i < section_count; i++) {
+        if (strcmp(section_names + sections[i].sh_name, name) == 0) return &sections[i];
+    }
+    return NULL;
+}
+
+static size_t align4(size_t n) {
+    return (n + 3) & ~(size_t)3;
+}
+
+static void load_probes(void) {
+    image = read_file("/proc/self/exe");
+
+    const Elf64_Ehdr* header = (const Elf64_Ehdr*)image;
+    assert(memcmp(header->e_ident, ELFMAG, SELFMAG) == 0);
+    assert(header->e_ident[EI_CLASS] == ELFCLASS64);
+
+    sections = (const Elf64_Shdr*)(image + header->e_shoff);
+    section_count = header->e_shnum;
+    section_names = (const char*)image + sections[header->e_shstrndx].sh_offset;
+
+    const Elf64_Shdr* notes = find_section(".note.stapsdt");
+    if (!notes) return;
+
+    const unsigned char* p = image + notes->sh_offset;
+    const unsigned char* end = p + notes->sh_size;
+
+    while (p + sizeof(Elf64_Nhdr) <= end) {
+        const Elf64_Nhdr* note = (const Elf64_Nhdr*)p;
+        const char* owner = (const char*)(p + sizeof(Elf64_Nhdr));
+        const unsigned char* desc = p + sizeof(Elf64_Nhdr) + align4(note->n_namesz);
+
+        if (note->n_type == 3 && strcmp(owner, "stapsdt") == 0) {
+            assert(probe_count < MAX_PROBES);
+            Probe* probe = &probes[probe_count++];
+            memcpy(&probe->pc, desc, 8);
+            memcpy(&probe->base, desc + 8, 8);
+            memcpy(&probe->semaphore, desc + 16, 8);
+            probe->provider = (const char*)desc + 24;
+            probe->name = probe->provider + strlen(probe->provider) + 1;
+            probe->args = probe->name + strlen(probe->name) + 1;
+        }
+
+        p = desc + align4(note->n_descsz);
+    }
+}
+
+static size_t count_probes(const char* name) {
+    size_t count = 0;
+    for (size_t i = 0; i < probe_count; i++) {
+        if (strcmp(probes[i].name, name) == 0) count++;
+    }
+    return count;
+}
+
+static size_t count_args(const char* args) {
+    size_t count = 0;
+    for (const char* p = args; *p; p++) {
+        if (*p == '@') count++;
+    }
+    return count;
+}
+
+static int in_executable_section(uint64_t addr) {
+    for (size_t i = 0; i < section_count; i++) {
+        if ((sections[i].sh_flags & SHF_EXECINSTR) &&
+            addr >= sections[i].sh_addr && addr < sections[i].sh_addr + sections[i].sh_size) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+// ============================================================================
+// NOTAS
+// ============================================================================
+
+TEST(notes_present) {
+    assert(find_section(".note.stapsdt"));
+    assert(find_section(".stapsdt.base"));
+    assert(probe_count > 0);
+}
+
+TEST(expected_probes) {
+    assert(count_probes("format_start") > 0);
+    assert(count_probes("sink_write") > 0);
+
+    // Cada inicio de formateo tiene su fin
+    assert(count_probes("format_end") == count_probes("format_start"));
+}
+
+TEST(probe_arguments) {
+    for (size_t i = 0; i < probe_count; i++) {
+        const Probe* probe = &probes[i];
+        assert(strcmp(probe->provider, "c_print") == 0);
+
+        size_t expected = strcmp(probe->name, "format_end") == 0 ? 2 : 1;
+        assert(count_args(probe->args) == expected);
+        assert(strncmp(probe->args, "8@", 2) == 0);
+    }
+}
+
+TEST(probe_addresses) {
+    const Elf64_Shdr* base = find_section(".stapsdt.base");
+
+    for (size_t i = 0; i < probe_count; i++) {
+        assert(in_executable_section(probes[i].pc));
+        assert(probes[i].base == base->sh_addr);
+        assert(probes[i].semaphore == 0);
+    }
+}
+
+// ============================================================================
+// COMPORTAMIENTO
+// ============================================================================
+
+TEST(output_unchanged) {
+    char buffer[64];
+    size_t len = c_snprint(buffer, sizeof(buffer), "{s:>6}|{d:,}", "ok", 1234);
+    assert(strcmp(buffer, "    ok|1,234") == 0);
+    assert(len == 12);
+
+    CPrintArg args[1];
+    args[0].type = CPRINT_ARG_INT;
+    args[0].value.i = 7;
+    len = c_print_argv("n={d}", args, 1, buffer, sizeof(buffer));
+    assert(len == 3);
+    assert(strcmp(buffer, "n=7") == 0);
+
+    int fd = open("/dev/null", O_WRONLY);
+    assert(fd >= 0);
+    CPrintSink sink = cp_sink_fd(fd);
+    size_t accepted = cp_sink_write(&sink, "probe\n", 6);
+    assert(accepted == 6);
+    close(fd);
+}
+
+TEST(stdout_paths_run) {
+    fflush(stdout);
+    int saved_stdout = dup(STDOUT_FILENO);
+    int null_fd = open("/dev/null", O_WRONLY);
+    assert(null_fd >= 0);
+    dup2(null_fd, STDOUT_FILENO);
+    close(null_fd);
+
+    c_print("{s} {d}\n", "plain", 1);
+    c_print_safe("{s} {d}\n", "safe", 2);
+
+    fflush(stdout);
+    dup2(saved_stdout, STDOUT_FILENO);
+    close(saved_stdout);
+}
+
+int main(void) {
+    fprintf(stderr, "\n");
+    fprintf(stderr, "═══════════════════════════════════════════════════════════\n");
+    fprintf(stderr, "  USDT Probes - Unit Tests\n");
+    fprintf(stderr, "═══════════════════════════════════════════════════════════\n");
+    fprintf(stderr, "\n");
+
+    load_probes();
+
+    fprintf(stderr, "ELF notes:\n");
+    RUN_TEST(notes_present);
+    RUN_TEST(expected_probes);
+    RUN_TEST(probe_arguments);
+    RUN_TEST(probe_addresses);
+    fprintf(stderr, "\n");
+
+    fprintf(stderr, "Behavior:\n");
+    RUN_TEST(output_unchanged);
+    RUN_TEST(stdout_paths_run);
+    fprintf(stderr, "\n");
+
+    free(image);
+
+    fprintf(stderr, "═══════════════════════════════════════════════════════════\n");
+    fprintf(stderr, "  Results: %d tests passed ✓\n", tests_passed);
+    fprintf(stderr, "═══════════════════════════════════════════════════════════\n");
+    fprintf(stderr, "\n");
+
+    return 0;
+}
@@ -0,0 +1,555 @@
+/**
+ * @file test_queue.c
+ * @brief Tests unitarios para la cola no bloqueante (c_print_queue)
+ *
+ * La cola escribe en un pipe. Para simular un lector detenido el pipe
+ * se llena antes con 'x' (sin saltos de línea), que después se
+ * descartan al leer.
+ */
+
+#define C_PRINT_USE_GENERIC
+#include "c_print_queue.h"
+#include "c_print.h"
+#include "c_print_generic.h"
+#include "c_print_safe.h"
+#include "c_print_stats.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <time.h>
+
+#define TEST(name) static void test_##name(void)
+#define RUN_TEST(name) do { \
+    fprintf(stderr, "  Running: %s... ", #name); \
+    test_##name(); \
+    fprintf(stderr, "✓\n"); \
+    tests_passed++; \
+} while(0)
+
+#define LINE_RECORD 12          // "line NN\n" más la cabecera de 4 bytes
+#define THREADS 4
+#define LINES_PER_THREAD 2000
+
+static int tests_passed = 0;
+
+// ============================================================================
+// PIPE
+// ============================================================================
+
+static int pipe_fds[2];
+static char received[1024 * 1024];
+static size_t received_length;
+
+static void open_pipe(void) {
+    int rc = pipe(pipe_fds);
+    assert(rc == 0);
+    fcntl(pipe_fds[0], F_SETFL, fcntl(pipe_fds[0], F_GETFL) | O_NONBLOCK);
+    received_length = 0;
+}
+
+static void close_pipe(void) {
+    close(pipe_fds[0]);
+    close(pipe_fds[1]);
+}
+
+/**
+ * @brief Llena el pipe hasta que no acepte ni un byte más
+ */
+static void fill_pipe(void) {
+    char chunk[4096];
+    int flags = fcntl(pipe_fds[1], F_GETFL);
+    memset(chunk, 'x', sizeof(chunk));
+
+    fcntl(pipe_fds[1], F_SETFL, flags | O_NONBLOCK);
+    while (write(pipe_fds[1], chunk, sizeof(chunk)) > 0) { }
+    while (write(pipe_fds[1], chunk, 1) > 0) { }
+    assert(errno == EAGAIN || errno == EWOULDBLOCK);
+    fcntl(pipe_fds[1], F_SETFL, flags);
+}
+
+/**
+ * @brief Lee todo lo disponible, sin el relleno
+ */
+static const char* read_pipe(void) {
+    ssize_t n;
+    char chunk[4096];
+
+    while ((n = read(pipe_fds[0], chunk, sizeof(chunk))) > 0) {
+        for (ssize_t i = 0; i < n; i++) {
+            if (chunk[i] == 'x' && received_length == 0) continue;
+            assert(received_length < sizeof(received) - 1);
+            received[received_length++] = chunk[i];
+        }
+    }
+    received[received_length] = '\0';
+    return received;
+}
+
+static void sleep_ms(long ms) {
+    struct timespec ts = { ms / 1000, (ms % 1000) * 1000000L };
+    nanosleep(&ts, NULL);
+}
+
+static double elapsed_ms(const struct timespec* start) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)(now.tv_sec - start->tv_sec) * 1e3 +
+           (double)(now.tv_nsec - start->tv_nsec) / 1e6;
+}
+
+/**
+ * @brief Escribe "line 00\n" ... con el pipe lleno
+ */
+static void write_lines(CPrintQueue* q, int count) {
+    char line[16];
+    for (int i = 0; i < count; i++) {
+        snprintf(line, sizeof(line), "line %02d\n", i);
+        c_print_queue_write(q, line, strlen(line));
+    }
+}
+
+static void expect_lines(const char* text, int first, int last) {
+    char line[16];
+    for (int i = first; i <= last; i++) {
+        snprintf(line, sizeof(line), "line %02d\n", i);
+        assert(strncmp(text, line, 8) == 0);
+        text += 8;
+    }
+    assert(*text == '\0');
+}
+
+// ============================================================================
+// MODO
+// ============================================================================
+
+TEST(create_sets_nonblocking) {
+    open_pipe();
+    CPrintQueue* q = c_print_queue_create(pipe_fds[1], NULL);
+    assert(q);
+    assert(fcntl(pipe_fds[1], F_GETFL) & O_NONBLOCK);
+
+    c_print_queue_destroy(q);
+    assert(!(fcntl(pipe_fds[1], F_GETFL) & O_NONBLOCK));
+    close_pipe();
+}
+
+TEST(writes_go_straight_through) {
+    open_pipe();
+    CPrintQueue* q = c_print_queue_create(pipe_fds[1], NULL);
+
+    bool written = c_print_queue_write(q, "hello\n", 6);
+    assert(written);
+    const char* text = read_pipe();
+    assert(strcmp(text, "hello\n") == 0);
+
+    CPrintQueueStats stats = c_print_queue_stats(q);
+    assert(stats.written_bytes == 6);
+    assert(stats.pending_bytes == 0);
+    assert(stats.dropped_lines == 0);
+
+    c_print_queue_destroy(q);
+    close_pipe();
+}
+
+TEST(sink_writes_lines) {
+    open_pipe();
+    CPrintQueue* q = c_print_queue_create(pipe_fds[1], NULL);
+    CPrintSink sink = cp_sink_queue(q);
+
+    size_t accepted = cp_sink_write(&sink, "via sink\n", 9);
+    assert(accepted == 9);
+    const char* text = read_pipe();
+    assert(strcmp(text, "via sink\n") == 0);
+
+    c_print_queue_destroy(q);
+    close_pipe();
+}
+
+// ============================================================================
+// POLÍTICAS
+// ============================================================================
+
+TEST(stalled_reader_buffers_lines) {
+    CPrintQueueConfig config = { 256, CPRINT_QUEUE_DROP_NEWEST, 0, 0 };
+    open_pipe();
+    fill_pipe();
+    CPrintQueue* q = c_print_queue_create(pipe_fds[1], &config);
+
+    write_lines(q, 5);
+    CPrintQueueStats stats = c_print_queue_stats(q);
+    assert(stats.pending_bytes == 5 * 8);
+    assert(stats.dropped_lines == 0);
+
+    // El lector vuelve: lo pendiente sale con la escritura siguiente
+    read_pipe();
+    bool written = c_print_queue_write(q, "next\n", 5);
+    assert(written);
+    const char* text = read_pipe();
+    assert(strcmp(text, "line 00\nline 01\nline 02\nline 03\nline 04\nnext\n") == 0);
+
+    c_print_queue_destroy(q);
+    close_pipe();
+}
+
+TEST(drop_newest_keeps_oldest) {
+    CPrintQueueConfig config = { 256, CPRINT_QUEUE_DROP_NEWEST, 0, 0 };
+    int fit = 256 / LINE_RECORD;
+    open_pipe();
+    fill_pipe();
+    CPrintQueue* q = c_print_queue_create(pipe_fds[1], &config);
+
+    c_print_stats_reset();
+    write_lines(q, 40);
+    CPrintQueueStats stats = c_print_queue_stats(q);
+    assert(stats.dropped_lines == (unsigned long long)(40 - fit));
+    assert(stats.dropped_bytes == (unsigned long long)(40 - fit) * 8);
+
+    // Los descartes también llegan a c_print_stats()
+    CPrintStats global = c_print_stats();
+    if (global.enabled) {
+        assert(global.queue_drops == stats.dropped_lines);
+        assert(global.queue_dropped_bytes == stats.dropped_bytes);
+    }
+
+    read_pipe();
+    bool flushed = c_print_queue_flush(q, 0);
+    assert(flushed);
+    expect_lines(read_pipe(), 0, fit - 1);
+
+    c_print_queue_destroy(q);
+    close_pipe();
+}
+
+TEST(drop_oldest_keeps_newest) {
+    CPrintQueueConfig config = { 256, CPRINT_QUEUE_DROP_OLDEST, 0, 0 };
+    int fit = 256 / LINE_RECORD;
+    open_pipe();
+    fill_pipe();
+    CPrintQueue* q = c_print_queue_create(pipe_fds[1], &config);
+
+    write_lines(q, 40);
+    assert(c_print_queue_stats(q).dropped_lines == (unsigned long long)(40 - fit));
+
+    read_pipe();
+    bool flushed = c_print_queue_flush(q, 0);
+    assert(flushed);
+    expect_lines(read_pipe(), 40 - fit, 39);
+
+    c_print_queue_destroy(q);
+    close_pipe();
+}
+
+TEST(started_line_never_dropped) {
+    CPrintQueueConfig config = { 8192, CPRINT_QUEUE_DROP_OLDEST, 0, 0 };
+    static char page[4096];
+    static char first[5000];
+    memset(first, 'a', sizeof(first));
+    first[sizeof(first) - 1] = '\n';
+
+    open_pipe();
+    fill_pipe();
+
+    // Lugar para una página: la primera línea sale a medias
+    ssize_t got = read(pipe_fds[0], page, sizeof(page));
+    assert(got == (ssize_t)sizeof(page));
+    CPrintQueue* q = c_print_queue_create(pipe_fds[1], &config);
+    bool written = c_print_queue_write(q, first, sizeof(first));
+    assert(written);
+    assert(c_print_queue_stats(q).pending_bytes < sizeof(first));
+
+    for (int round = 0; round < 7; round++) write_lines(q, 100);
+    assert(c_print_queue_stats(q).dropped_lines > 0);
+
+    read_pipe();
+    bool flushed = c_print_queue_flush(q, 0);
+    assert(flushed);
+    const char* text = read_pipe();
+    assert(strncmp(text, first, sizeof(first)) == 0);
+    assert(strstr(text, "line 99\n"));
+
+    c_print_queue_destroy(q);
+    close_pipe();
+}
+
+TEST(line_larger_than_capacity_dropped) {
+    CPrintQueueConfig config = { 64, CPRINT_QUEUE_BLOCK, 0, 0 };
+    char big[100];
+    memset(big, '-', sizeof(big));
+    big[sizeof(big) - 1] = '\n';
+
+    open_pipe();
+    CPrintQueue* q = c_print_queue_create(pipe_fds[1], &config);
+
+    bool written = c_print_queue_write(q, big, sizeof(big));
+    assert(!written);
+    CPrintQueueStats stats = c_print_queue_stats(q);
+    assert(stats.dropped_lines == 1);
+    assert(stats.dropped_bytes == sizeof(big));
+    const char* text = read_pipe();
+    assert(strcmp(text, "") == 0);
+
+    c_print_queue_destroy(q);
+    close_pipe();
+}
+
+TEST(block_times_out) {
+    CPrintQueueConfig config = { 256, CPRINT_QUEUE_BLOCK, 50, 0 };
+    int fit = 256 / LINE_RECORD;
+    struct timespec start;
+    open_pipe();
+    fill_pipe();
+    CPrintQueue* q = c_print_queue_create(pipe_fds[1], &config);
+
+    write_lines(q, fit);
+    assert(c_print_queue_stats(q).dropped_lines == 0);
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    bool written = c_print_queue_write(q, "late\n", 5);
+    assert(!written);
+    assert(elapsed_ms(&start) >= 45.0);
+    assert(c_print_queue_stats(q).dropped_lines == 1);
+
+    read_pipe();
+    c_print_queue_destroy(q);
+    expect_lines(read_pipe(), 0, fit - 1);
+    close_pipe();
+}
+
+static void* slow_reader(void* arg) {
+    (void)arg;
+    sleep_ms(50);
+    read_pipe();
+    return NULL;
+}
+
+TEST(block_waits_for_reader) {
+    CPrintQueueConfig config = { 256, CPRINT_QUEUE_BLOCK, 5000, 0 };
+    pthread_t reader;
+    open_pipe();
+    fill_pipe();
+    CPrintQueue* q = c_print_queue_create(pipe_fds[1], &config);
+
+    int rc = pthread_create(&reader, NULL, slow_reader, NULL);
+    assert(rc == 0);
+    write_lines(q, 40);
+    pthread_join(reader, NULL);
+
+    assert(c_print_queue_stats(q).dropped_lines == 0);
+    bool flushed = c_print_queue_flush(q, 1000);
+    assert(flushed);
+    expect_lines(read_pipe(), 0, 39);
+
+    c_print_queue_destroy(q);
+    close_pipe();
+}
+
+// ============================================================================
+// RESUMEN
+// ============================================================================
+
+TEST(summary_after_interval) {
+    CPrintQueueConfig config = { 256, CPRINT_QUEUE_DROP_NEWEST, 0, 20 };
+    int fit = 256 / LINE_RECORD;
+    open_pipe();
+    fill_pipe();
+    CPrintQueue* q = c_print_queue_create(pipe_fds[1], &config);
+
+    write_lines(q, fit + 3);
+    assert(c_print_queue_stats(q).reports == 0);
+
+    sleep_ms(30);
+    read_pipe();
+    bool written = c_print_queue_write(q, "after\n", 6);
+    assert(written);
+    assert(c_print_queue_stats(q).reports == 1);
+
+    const char* text = read_pipe();
+    assert(strstr(text, "after\nc_print: dropped 3 lines (24 bytes)\n"));
+
+    // Los contadores del resumen vuelven a cero, los totales no
+    written = c_print_queue_write(q, "quiet\n", 6);
+    assert(written);
+    assert(c_print_queue_stats(q).reports == 1);
+    assert(c_print_queue_stats(q).dropped_lines == 3);
+
+    c_print_queue_destroy(q);
+    close_pipe();
+}
+
+TEST(flush_reports_pending) {
+    CPrintQueueConfig config = { 256, CPRINT_QUEUE_DROP_NEWEST, 0, 60000 };
+    int fit = 256 / LINE_RECORD;
+    open_pipe();
+    fill_pipe();
+    CPrintQueue* q = c_print_queue_create(pipe_fds[1], &config);
+
+    write_lines(q, fit + 1);
+    read_pipe();
+    bool flushed = c_print_queue_flush(q, 0);
+    assert(flushed);
+    const char* text = read_pipe();
+    assert(strstr(text, "c_print: dropped 1 lines (8 bytes)\n"));
+
+    c_print_queue_destroy(q);
+    close_pipe();
+}
+
+// ============================================================================
+// c_print
+// ============================================================================
+
+TEST(attached_c_print_goes_to_queue) {
+    open_pipe();
+    CPrintQueue* q = c_print_queue_create(pipe_fds[1], NULL);
+    c_print_queue_attach(q);
+
+    c_print("print {d}\n", 1);
+    c_print_safe("safe {s}\n", "two");
+    C_PRINT("checked {x:#}\n", 255u);
+    c_print("{s:-^3000}\n", "long");
+
+    c_print_queue_attach(NULL);
+    c_print_queue_destroy(q);
+
+    const char* text = read_pipe();
+    assert(strncmp(text, "print 1\nsafe two\nchecked 0xff\n", 30) == 0);
+    assert(strlen(text + 30) == 3001);
+    assert(strstr(text + 30, "long"));
+    close_pipe();
+}
+
+TEST(attached_long_line_dropped_whole) {
+    CPrintQueueConfig config = { 1024, CPRINT_QUEUE_DROP_NEWEST, 0, 0 };
+    open_pipe();
+    CPrintQueue* q = c_print_queue_create(pipe_fds[1], &config);
+    c_print_queue_attach(q);
+
+    c_print("{s:-^3000}\n", "long");
+    c_print("short\n");
+
+    CPrintQueueStats stats = c_print_queue_stats(q);
+    c_print_queue_attach(NULL);
+    c_print_queue_destroy(q);
+
+    assert(stats.dropped_lines == 1);
+    assert(stats.dropped_bytes == 3001);
+    const char* text = read_pipe();
+    assert(strcmp(text, "short\n") == 0);
+    close_pipe();
+}
+
+static void* print_worker(void* arg) {
+    int id = *(int*)arg;
+    for (int i = 0; i < LINES_PER_THREAD; i++) {
+        c_print("T{d} #{d} {s:>10}|\n", id, i, "payload");
+    }
+    return NULL;
+}
+
+static volatile int writers_done;
+
+static void* draining_reader(void* arg) {
+    (void)arg;
+    while (!writers_done) {
+        read_pipe();
+        sleep_ms(1);
+    }
+    return NULL;
+}
+
+TEST(threads_with_slow_reader) {
+    CPrintQueueConfig config = { 4096, CPRINT_QUEUE_BLOCK, 0, 0 };
+    pthread_t threads[THREADS];
+    pthread_t reader;
+    int ids[THREADS];
+    int next_seq[THREADS] = { 0 };
+
+    open_pipe();
+    fill_pipe();
+    CPrintQueue* q = c_print_queue_create(pipe_fds[1], &config);
+    c_print_queue_attach(q);
+
+    writers_done = 0;
+    int rc = pthread_create(&reader, NULL, draining_reader, NULL);
+    assert(rc == 0);
+    for (int t = 0; t < THREADS; t++) {
+        ids[t] = t;
+        rc = pthread_create(&threads[t], NULL, print_worker, &ids[t]);
+        assert(rc == 0);
+    }
+    for (int t = 0; t < THREADS; t++) pthread_join(threads[t], NULL);
+    c_print_queue_attach(NULL);
+    assert(c_print_queue_stats(q).dropped_lines == 0);
+
+    writers_done = 1;
+    pthread_join(reader, NULL);
+    read_pipe();
+    bool flushed = c_print_queue_flush(q, 1000);
+    assert(flushed);
+    c_print_queue_destroy(q);
+
+    // Cada línea entera y en orden dentro de su hilo
+    size_t lines = 0;
+    for (char* line = strtok(received, "\n"); line; line = strtok(NULL, "\n")) {
+        int id = -1;
+        int seq = -1;
+        char expected[64];
+        int fields = sscanf(line, "T%d #%d", &id, &seq);
+        assert(fields == 2);
+        assert(id >= 0 && id < THREADS);
+        assert(seq == next_seq[id]);
+        next_seq[id]++;
+        snprintf(expected, sizeof(expected), "T%d #%d    payload|", id, seq);
+        assert(strcmp(line, expected) == 0);
+        lines++;
+    }
+    assert(lines == (size_t)THREADS * LINES_PER_THREAD);
+    close_pipe();
+}
+
+int main(void) {
+    fprintf(stderr, "\n");
+    fprintf(stderr, "═══════════════════════════════════════════════════════════\n");
+    fprintf(stderr, "  Output Queue - Unit Tests\n");
+    fprintf(stderr, "═══════════════════════════════════════════════════════════\n");
+    fprintf(stderr, "\n");
+
+    fprintf(stderr, "Mode:\n");
+    RUN_TEST(create_sets_nonblocking);
+    RUN_TEST(writes_go_straight_through);
+    RUN_TEST(sink_writes_lines);
+    fprintf(stderr, "\n");
+
+    fprintf(stderr, "Policies:\n");
+    RUN_TEST(stalled_reader_buffers_lines);
+    RUN_TEST(drop_newest_keeps_oldest);
+    RUN_TEST(drop_oldest_keeps_newest);
+    RUN_TEST(started_line_never_dropped);
+    RUN_TEST(line_larger_than_capacity_dropped);
+    RUN_TEST(block_times_out);
+    RUN_TEST(block_waits_for_reader);
+    fprintf(stderr, "\n");
+
+    fprintf(stderr, "Summary:\n");
+    RUN_TEST(summary_after_interval);
+    RUN_TEST(flush_reports_pending);
+    fprintf(stderr, "\n");
+
+    fprintf(stderr, "c_print:\n");
+    RUN_TEST(attached_c_print_goes_to_queue);
+    RUN_TEST(attached_long_line_dropped_whole);
+    RUN_TEST(threads_with_slow_reader);
+    fprintf(stderr, "\n");
+
+    fprintf(stderr, "═══════════════════════════════════════════════════════════\n");
+    fprintf(stderr, "  Results: %d tests passed ✓\n", tests_passed);
+    fprintf(stderr, "═══════════════════════════════════════════════════════════\n");
+    fprintf(stderr, "\n");
+
+    return 0;
+}
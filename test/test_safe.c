@@ -0,0 +1,183 @@
+/**
+ * @file test_safe.c
+ * @brief Tests unitarios para c_print_safe (modo seguro y rápido)
+ */
+
+#include "c_print_safe.h"
+#include "pattern_compiler.h"
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include <unistd.h>
+#include <fcntl.h>
+
+#define TEST(name) static void test_##name(void)
+#define RUN_TEST(name) do { \
+    fprintf(stderr, "  Running: %s... ", #name); \
+    test_##name(); \
+    fprintf(stderr, "✓\n"); \
+    tests_passed++; \
+} while(0)
+
+static int tests_passed = 0;
+static char captured_output[4096];
+
+// Usar pipes para capturar stdout
+static int stdout_pipe[2];
+static int saved_stdout;
+
+static void start_capture(void) {
+    fflush(stdout);
+    saved_stdout = dup(STDOUT_FILENO);
+    int rc = pipe(stdout_pipe);
+    assert(rc == 0);
+    dup2(stdout_pipe[1], STDOUT_FILENO);
+    close(stdout_pipe[1]);
+    memset(captured_output, 0, sizeof(captured_output));
+}
+
+static void end_capture(void) {
+    fflush(stdout);
+
+    dup2(saved_stdout, STDOUT_FILENO);
+    close(saved_stdout);
+
+    int flags = fcntl(stdout_pipe[0], F_GETFL, 0);
+    fcntl(stdout_pipe[0], F_SETFL, flags | O_NONBLOCK);
+
+    ssize_t bytes_read = read(stdout_pipe[0], captured_output, sizeof(captured_output) - 1);
+    if (bytes_read > 0) {
+        captured_output[bytes_read] = '\0';
+    }
+
+    close(stdout_pipe[0]);
+}
+
+static void expect_output(const char* expected) {
+    if (strcmp(captured_output, expected) != 0) {
+        fprintf(stderr, "\n  Expected: '%s'\n  Got:      '%s'\n", expected, captured_output);
+        assert(0);
+    }
+}
+
+// ============================================================================
+// MODO SEGURO
+// ============================================================================
+
+static const char* reference_pattern =
+    "Hola {s:red}, saldo {d:,} ({f:.2}) hex {x:#} [{s:^9}] {c}{l} \\{ok}\n";
+
+static void expect_same_as_c_print(void) {
+    char reference[sizeof(captured_output)];
+
+    start_capture();
+    c_print(reference_pattern, "Ana", 1234567, 3.14159, 255u, "mid", 'z', 9L);
+    end_capture();
+    strcpy(reference, captured_output);
+
+    start_capture();
+    c_print_safe(reference_pattern, "Ana", 1234567, 3.14159, 255u, "mid", 'z', 9L);
+    end_capture();
+    expect_output(reference);
+}
+
+TEST(env_selects_fast_mode) {
+    // La variable se lee una sola vez, en el primer uso
+    setenv("C_PRINT_SAFE", "Off", 1);
+    assert(!c_print_safe_enabled());
+    unsetenv("C_PRINT_SAFE");
+    assert(!c_print_safe_enabled());
+}
+
+TEST(same_output_as_c_print) {
+    c_print_safe_set_enabled(true);
+    assert(c_print_safe_enabled());
+    expect_same_as_c_print();
+}
+
+TEST(int_for_string) {
+    start_capture();
+    c_print_safe("[{s}]", (void*)(uintptr_t)42);
+    end_capture();
+    expect_output("[\033[1;31m{? expected string, got int=42}\033[0m]");
+}
+
+TEST(null_string) {
+    start_capture();
+    c_print_safe("{s} {d}", (const char*)NULL, 7);
+    end_capture();
+    expect_output("\033[1;31m{? expected string, got int=0}\033[0m 7");
+}
+
+TEST(invalid_char) {
+    start_capture();
+    c_print_safe("<{c:>3}>", 300);
+    end_capture();
+    expect_output("<\033[1;31m{? invalid char: 300}\033[0m>");
+}
+
+TEST(unknown_format) {
+    start_capture();
+    c_print_safe("{z} {d}", 5);
+    end_capture();
+    expect_output("\033[1;31m{? unknown format: z}\033[0m 5");
+}
+
+// ============================================================================
+// MODO RÁPIDO
+// ============================================================================
+
+TEST(fast_mode_same_output) {
+    c_print_safe_set_enabled(false);
+    assert(!c_print_safe_enabled());
+    expect_same_as_c_print();
+    c_print_safe_set_enabled(true);
+}
+
+TEST(pattern_analyzed_once) {
+    const char* pattern = "{s}={d}\n";
+
+    start_capture();
+    c_print_safe(pattern, "a", 1);
+    end_capture();
+    const CompiledPattern* first = get_compiled_pattern(pattern);
+
+    start_capture();
+    c_print_safe(pattern, "b", 2);
+    end_capture();
+    expect_output("b=2\n");
+    assert(get_compiled_pattern(pattern) == first);
+}
+
+int main(void) {
+    fprintf(stderr, "\n");
+    fprintf(stderr, "═══════════════════════════════════════════════════════════\n");
+    fprintf(stderr, "  c_print_safe - Unit Tests\n");
+    fprintf(stderr, "═══════════════════════════════════════════════════════════\n");
+    fprintf(stderr, "\n");
+
+    fprintf(stderr, "Safe mode:\n");
+    RUN_TEST(env_selects_fast_mode);
+    RUN_TEST(same_output_as_c_print);
+    RUN_TEST(int_for_string);
+    RUN_TEST(null_string);
+    RUN_TEST(invalid_char);
+    RUN_TEST(unknown_format);
+    fprintf(stderr, "\n");
+
+    fprintf(stderr, "Fast mode:\n");
+    RUN_TEST(fast_mode_same_output);
+    RUN_TEST(pattern_analyzed_once);
+    fprintf(stderr, "\n");
+
+    clear_pattern_cache();
+
+    fprintf(stderr, "═══════════════════════════════════════════════════════════\n");
+    fprintf(stderr, "  Results: %d tests passed ✓\n", tests_passed);
+    fprintf(stderr, "═══════════════════════════════════════════════════════════\n");
+    fprintf(stderr, "\n");
+
+    return 0;
+}
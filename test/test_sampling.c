@@ -0,0 +1,228 @@
+/**
+ * @file test_sampling.c
+ * @brief Tests unitarios para la validación muestreada (c_print_sampling)
+ */
+
+#define C_PRINT_USE_GENERIC
+#include "c_print_generic.h"
+#include "c_print_safe.h"
+#include "c_print_sampling.h"
+#include "pattern_compiler.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include <unistd.h>
+#include <fcntl.h>
+
+#define TEST(name) static void test_##name(void)
+#define RUN_TEST(name) do { \
+    fprintf(stderr, "  Running: %s... ", #name); \
+    test_##name(); \
+    fprintf(stderr, "✓\n"); \
+    tests_passed++; \
+} while(0)
+
+static int tests_passed = 0;
+static char captured_output[4096];
+
+// Usar pipes para capturar stdout
+static int stdout_pipe[2];
+static int saved_stdout;
+
+static void start_capture(void) {
+    fflush(stdout);
+    saved_stdout = dup(STDOUT_FILENO);
+    int rc = pipe(stdout_pipe);
+    assert(rc == 0);
+    dup2(stdout_pipe[1], STDOUT_FILENO);
+    close(stdout_pipe[1]);
+    memset(captured_output, 0, sizeof(captured_output));
+}
+
+static void end_capture(void) {
+    fflush(stdout);
+
+    dup2(saved_stdout, STDOUT_FILENO);
+    close(saved_stdout);
+
+    int flags = fcntl(stdout_pipe[0], F_GETFL, 0);
+    fcntl(stdout_pipe[0], F_SETFL, flags | O_NONBLOCK);
+
+    ssize_t bytes_read = read(stdout_pipe[0], captured_output, sizeof(captured_output) - 1);
+    if (bytes_read > 0) {
+        captured_output[bytes_read] = '\0';
+    }
+
+    close(stdout_pipe[0]);
+}
+
+static void expect_output(const char* expected) {
+    if (strcmp(captured_output, expected) != 0) {
+        fprintf(stderr, "\n  Expected: '%s'\n  Got:      '%s'\n", expected, captured_output);
+        assert(0);
+    }
+}
+
+// ============================================================================
+// CALLBACK DE PRUEBA
+// ============================================================================
+
+static int handler_calls = 0;
+static size_t last_index = 0;
+static char last_message[128];
+
+static void on_mismatch(void* ctx, const char* pattern, size_t arg_index, const char* message) {
+    (void)pattern;
+    (*(int*)ctx)++;
+    last_index = arg_index;
+    snprintf(last_message, sizeof(last_message), "%s", message);
+}
+
+static void reset_reports(void) {
+    handler_calls = 0;
+    last_index = 0;
+    last_message[0] = '\0';
+    c_print_reset_mismatch_count();
+    c_print_set_mismatch_handler(on_mismatch, &handler_calls);
+}
+
+// ============================================================================
+// MUESTREO
+// ============================================================================
+
+TEST(default_validates_always) {
+    assert(c_print_get_sample_rate() == 0);
+    for (int i = 0; i < 5; i++) {
+        bool v = cp_sample_should_validate("default");
+        assert(v);
+    }
+    assert(!cp_sample_reporting());
+}
+
+TEST(first_call_then_one_in_n) {
+    static const char pattern[] = "sampled";
+    int validated = 0;
+
+    c_print_set_sample_rate(4);
+    for (int i = 0; i < 12; i++) {
+        bool v = cp_sample_should_validate(pattern);
+        if (v) validated++;
+        if (i == 0) assert(v);
+    }
+    assert(validated == 3);
+    c_print_set_sample_rate(0);
+}
+
+TEST(patterns_sampled_independently) {
+    static const char a[] = "pattern a";
+    static const char b[] = "pattern b";
+
+    c_print_set_sample_rate(100);
+    bool first_a = cp_sample_should_validate(a);
+    bool second_a = cp_sample_should_validate(a);
+    bool first_b = cp_sample_should_validate(b);
+    assert(first_a);
+    assert(!second_a);
+    assert(first_b);
+    c_print_set_sample_rate(0);
+}
+
+// ============================================================================
+// INFORMES
+// ============================================================================
+
+TEST(checked_reports_through_callback) {
+    reset_reports();
+    c_print_set_sample_rate(4);
+
+    start_capture();
+    for (int i = 0; i < 8; i++) C_PRINT("[{d} {s}]", 1, 500);
+    end_capture();
+
+    // Todas las llamadas comprueban la etiqueta y muestran el error; solo las
+    // muestreadas lo informan
+    int shown = 0;
+    for (const char* p = captured_output; (p = strstr(p, "{? expected string, got int}")); p++) shown++;
+    assert(shown == 8);
+    assert(c_print_mismatch_count() == 2);
+    assert(handler_calls == 2);
+    assert(last_index == 1);
+    assert(strcmp(last_message, "{? expected string, got int}") == 0);
+
+    c_print_set_sample_rate(0);
+}
+
+TEST(checked_count_mismatch) {
+    reset_reports();
+    c_print_set_sample_rate(1);
+
+    start_capture();
+    C_PRINT("{d} {d}", 1);
+    end_capture();
+
+    // Falta un argumento: se informa el conteo y el campo
+    assert(c_print_mismatch_count() == 2);
+    assert(last_index == 1);
+    assert(strcmp(last_message, "{? missing argument for 'd'}") == 0);
+
+    c_print_set_sample_rate(0);
+}
+
+TEST(safe_reports_through_callback) {
+    reset_reports();
+    c_print_set_sample_rate(3);
+
+    start_capture();
+    for (int i = 0; i < 6; i++) c_print_safe("{s}{c}", "x", 300);
+    end_capture();
+
+    assert(c_print_mismatch_count() == 2);
+    assert(last_index == 1);
+    assert(strcmp(last_message, "{? invalid char: 300}") == 0);
+
+    c_print_set_sample_rate(0);
+}
+
+TEST(no_handler) {
+    c_print_set_mismatch_handler(NULL, NULL);
+    c_print_reset_mismatch_count();
+    c_print_set_sample_rate(1);
+
+    start_capture();
+    C_PRINT("{s}", 5);
+    end_capture();
+    assert(c_print_mismatch_count() == 1);
+
+    c_print_set_sample_rate(0);
+}
+
+int main(void) {
+    fprintf(stderr, "\n");
+    fprintf(stderr, "═══════════════════════════════════════════════════════════\n");
+    fprintf(stderr, "  Sampled Validation - Unit Tests\n");
+    fprintf(stderr, "═══════════════════════════════════════════════════════════\n");
+    fprintf(stderr, "\n");
+
+    fprintf(stderr, "Sampling:\n");
+    RUN_TEST(default_validates_always);
+    RUN_TEST(first_call_then_one_in_n);
+    RUN_TEST(patterns_sampled_independently);
+    fprintf(stderr, "\n");
+
+    fprintf(stderr, "Reports:\n");
+    RUN_TEST(checked_reports_through_callback);
+    RUN_TEST(checked_count_mismatch);
+    RUN_TEST(safe_reports_through_callback);
+    RUN_TEST(no_handler);
+    fprintf(stderr, "\n");
+
+    clear_pattern_cache();
+
+    fprintf(stderr, "═══════════════════════════════════════════════════════════\n");
+    fprintf(stderr, "  Results: %d tests passed ✓\n", tests_passed);
+    fprintf(stderr, "═══════════════════════════════════════════════════════════\n");
+    fprintf(stderr, "\n");
+
+    return 0;
+}
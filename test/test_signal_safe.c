@@ -0,0 +1,263 @@
+/**
+ * @file test_signal_safe.c
+ * @brief Tests unitarios para c_print_signal_safe
+ *
+ * Además de comparar el texto con c_snprint, el test imprime desde un
+ * manejador de SIGALRM mientras el hilo principal está en un bucle de
+ * malloc/free, stdio y c_print. Si el camino tomara un lock de malloc o
+ * de un FILE, alguna señal llegaría con ese lock tomado y el test se
+ * bloquearía (ctest lo corta por timeout). Con glibc el test además
+ * interpone malloc y cuenta las reservas hechas dentro del manejador.
+ */
+
+#include "c_print.h"
+#include "c_print_signal.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <signal.h>
+#include <assert.h>
+#include <unistd.h>
+#include <time.h>
+#include <sys/time.h>
+
+#define TEST(name) static void test_##name(void)
+#define RUN_TEST(name) do { \
+    fprintf(stderr, "  Running: %s... ", #name); \
+    test_##name(); \
+    fprintf(stderr, "✓\n"); \
+    tests_passed++; \
+} while(0)
+
+#define SIGNALS_WANTED 2000
+#define LOAD_SECONDS_MAX 20
+
+static int tests_passed = 0;
+
+// ============================================================================
+// MALLOC INTERPUESTO (glibc)
+// ============================================================================
+
+static volatile sig_atomic_t in_handler;
+static volatile sig_atomic_t handler_allocations;
+
+#ifdef __GLIBC__
+extern void* __libc_malloc(size_t size);
+extern void* __libc_calloc(size_t count, size_t size);
+extern void* __libc_realloc(void* ptr, size_t size);
+extern void __libc_free(void* ptr);
+
+void* malloc(size_t size) {
+    if (in_handler) handler_allocations++;
+    return __libc_malloc(size);
+}
+
+void* calloc(size_t count, size_t size) {
+    if (in_handler) handler_allocations++;
+    return __libc_calloc(count, size);
+}
+
+void* realloc(void* ptr, size_t size) {
+    if (in_handler) handler_allocations++;
+    return __libc_realloc(ptr, size);
+}
+
+void free(void* ptr) {
+    if (in_handler && ptr) handler_allocations++;
+    __libc_free(ptr);
+}
+#endif
+
+// ============================================================================
+// CAPTURA
+// ============================================================================
+
+static FILE* capture;
+static char captured[256 * 1024];
+
+static int start_capture(void) {
+    capture = tmpfile();
+    assert(capture);
+    return fileno(capture);
+}
+
+static const char* end_capture(void) {
+    long size = lseek(fileno(capture), 0, SEEK_END);
+    assert(size >= 0 && size < (long)sizeof(captured));
+    ssize_t got = pread(fileno(capture), captured, (size_t)size, 0);
+    assert(got == size);
+    captured[size] = '\0';
+    fclose(capture);
+    return captured;
+}
+
+/**
+ * @brief c_print_signal_safe debe producir lo mismo que c_snprint
+ */
+#define EXPECT_SAME(...) do { \
+    static char expected[16 * 1024]; \
+    size_t expected_len = c_snprint(expected, sizeof(expected), __VA_ARGS__); \
+    int fd = start_capture(); \
+    size_t written_ = c_print_signal_safe(fd, __VA_ARGS__); \
+    const char* text_ = end_capture(); \
+    assert(written_ == expected_len); \
+    assert(strcmp(text_, expected) == 0); \
+} while(0)
+
+// ============================================================================
+// TEXTO
+// ============================================================================
+
+TEST(same_text_as_c_print) {
+    EXPECT_SAME("plain literal\n");
+    EXPECT_SAME("Hello {s:green:bold}! {d:05:cyan} {x:#} {b} {o:#}\n", "World", 42, 255u, 5u, 8u);
+    EXPECT_SAME("[{s:<10}][{s:>10}][{s:^11}]\n", "left", "right", "mid");
+    EXPECT_SAME("[{s:*^30}] [{d:_>8}] [{d:+}] [{d: }] [{d:+06}] [{d:6}]\n",
+                "TITLE", 7, 3, 4, -12, -5);
+    EXPECT_SAME("{d:,} {u:_} {l:,} {l} {u}\n", -1234567, 4000000000u, 9876543210L, -77L, 7u);
+    EXPECT_SAME("{x:08:#} {x:6:0} {x:06} {b:#:bg_blue} {c:yellow}\n", 0xbeefu, 0xabu, 0xabu, 10u, 'q');
+    EXPECT_SAME("{s:.3} {s:red:>12}|{s:blue:<4}|\n", "truncated", NULL, "x");
+    EXPECT_SAME("{s} and {?} and \\{s} {s}\n", "unknown", "after");
+}
+
+TEST(floats_match_printf) {
+    EXPECT_SAME("{f} {f:.2} {f:.0} {f:.1%:green} {f:%}\n", 3.14159, 2.675, 2.5, 0.755, 0.5);
+    EXPECT_SAME("{f:.3} {f:.3} {f} {f:.2}\n", -0.0005, 1e21, -1.0 / 3.0, 0.125);
+    EXPECT_SAME("{f:.1} {f:.12}\n", 1.7976931348623157e308, 4.9e-324);
+}
+
+TEST(long_line_several_writes) {
+    static char long_text[3000];
+    memset(long_text, 'q', sizeof(long_text) - 1);
+    long_text[sizeof(long_text) - 1] = '\0';
+
+    EXPECT_SAME("<{s}>\n", long_text);
+    EXPECT_SAME("<{s:-^3000:red}>\n", "wide");
+}
+
+// ============================================================================
+// SEGURIDAD
+// ============================================================================
+
+TEST(errno_preserved) {
+    int fd = start_capture();
+    errno = ERANGE;
+    c_print_signal_safe(fd, "{d}\n", 1);
+    assert(errno == ERANGE);
+    end_capture();
+
+    // Un descriptor cerrado falla con EBADF, pero errno no cambia
+    errno = ERANGE;
+    size_t written = c_print_signal_safe(1000, "closed {d}\n", 2);
+    assert(written == 0);
+    assert(errno == ERANGE);
+}
+
+TEST(bad_arguments) {
+    size_t bad_fd = c_print_signal_safe(-1, "nothing {d}\n", 1);
+    size_t no_pattern = c_print_signal_safe(1, NULL);
+    assert(bad_fd == 0);
+    assert(no_pattern == 0);
+}
+
+static int handler_fd;
+static volatile sig_atomic_t handled;
+static volatile sig_atomic_t errno_changed;
+
+static void on_alarm(int sig) {
+    int before = errno;
+    in_handler = 1;
+    c_print_signal_safe(handler_fd, "{s:red:bold} sig={d} n={d:06} {x:#} {f:.2} [{s:^9}]\n",
+                        "[handler]", sig, (int)handled, 0xdeadu, 2.5, "ok");
+    in_handler = 0;
+    if (errno != before) errno_changed = 1;
+    handled++;
+}
+
+TEST(handler_under_load) {
+    handler_fd = start_capture();
+    FILE* sink = tmpfile();
+    assert(sink);
+
+    struct sigaction action;
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = on_alarm;
+    sigemptyset(&action.sa_mask);
+    action.sa_flags = SA_RESTART;
+    int rc = sigaction(SIGALRM, &action, NULL);
+    assert(rc == 0);
+
+    struct itimerval timer;
+    memset(&timer, 0, sizeof(timer));
+    timer.it_interval.tv_usec = 200;
+    timer.it_value.tv_usec = 200;
+    rc = setitimer(ITIMER_REAL, &timer, NULL);
+    assert(rc == 0);
+
+    // Carga: malloc/free, stdio y c_print con sus locks y su caché
+    time_t start = time(NULL);
+    unsigned long rounds = 0;
+    while (handled < SIGNALS_WANTED && time(NULL) - start < LOAD_SECONDS_MAX) {
+        size_t size = 16 + (rounds * 37) % 4096;
+        char* block = malloc(size);
+        assert(block);
+        memset(block, 'm', size);
+        fprintf(sink, "round %lu %.3f %s\n", rounds, rounds / 7.0, size > 2048 ? "big" : "small");
+        char line[128];
+        c_snprint(line, sizeof(line), "{d} {s:cyan} {f:.2}\n", (int)rounds, "load", 1.25);
+        free(block);
+        rounds++;
+    }
+
+    memset(&timer, 0, sizeof(timer));
+    setitimer(ITIMER_REAL, &timer, NULL);
+    signal(SIGALRM, SIG_DFL);
+    fclose(sink);
+
+    int count = handled;
+    assert(count > 0);
+    assert(!errno_changed);
+    assert(handler_allocations == 0);
+
+    // Cada línea completa y en orden
+    const char* text = end_capture();
+    char expected[256];
+    for (int i = 0; i < count; i++) {
+        size_t len = c_snprint(expected, sizeof(expected),
+                               "{s:red:bold} sig={d} n={d:06} {x:#} {f:.2} [{s:^9}]\n",
+                               "[handler]", SIGALRM, i, 0xdeadu, 2.5, "ok");
+        assert(strncmp(text, expected, len) == 0);
+        text += len;
+    }
+    assert(*text == '\0');
+
+    fprintf(stderr, "(%d signals, %lu rounds) ", count, rounds);
+}
+
+int main(void) {
+    fprintf(stderr, "\n");
+    fprintf(stderr, "═══════════════════════════════════════════════════════════\n");
+    fprintf(stderr, "  Signal-Safe Output - Unit Tests\n");
+    fprintf(stderr, "═══════════════════════════════════════════════════════════\n");
+    fprintf(stderr, "\n");
+
+    fprintf(stderr, "Text:\n");
+    RUN_TEST(same_text_as_c_print);
+    RUN_TEST(floats_match_printf);
+    RUN_TEST(long_line_several_writes);
+    fprintf(stderr, "\n");
+
+    fprintf(stderr, "Safety:\n");
+    RUN_TEST(errno_preserved);
+    RUN_TEST(bad_arguments);
+    RUN_TEST(handler_under_load);
+    fprintf(stderr, "\n");
+
+    fprintf(stderr, "═══════════════════════════════════════════════════════════\n");
+    fprintf(stderr, "  Results: %d tests passed ✓\n", tests_passed);
+    fprintf(stderr, "═══════════════════════════════════════════════════════════\n");
+    fprintf(stderr, "\n");
+
+    return 0;
+}
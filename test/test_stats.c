@@ -0,0 +1,242 @@
+/**
+ * @file test_stats.c
+ * @brief Tests unitarios para las estadísticas en tiempo de ejecución
+ */
+
+#include "c_print_stats.h"
+#include "c_print.h"
+#include "c_print_safe.h"
+#include "c_print_builder.h"
+#include "c_print_argv.h"
+#include "pattern_compiler.h"
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <fcntl.h>
+
+#define TEST(name) static void test_##name(void)
+#define RUN_TEST(name) do { \
+    fprintf(stderr, "  Running: %s... ", #name); \
+    c_print_stats_reset(); \
+    test_##name(); \
+    fprintf(stderr, "✓\n"); \
+    tests_passed++; \
+} while(0)
+
+#define THREADS 4
+#define CALLS_PER_THREAD 1000
+
+static int tests_passed = 0;
+static char captured_output[4096];
+
+// Usar pipes para capturar stdout
+static int stdout_pipe[2];
+static int saved_stdout;
+
+static void start_capture(void) {
+    fflush(stdout);
+    saved_stdout = dup(STDOUT_FILENO);
+    int rc = pipe(stdout_pipe);
+    assert(rc == 0);
+    dup2(stdout_pipe[1], STDOUT_FILENO);
+    close(stdout_pipe[1]);
+    memset(captured_output, 0, sizeof(captured_output));
+}
+
+static void end_capture(void) {
+    fflush(stdout);
+
+    dup2(saved_stdout, STDOUT_FILENO);
+    close(saved_stdout);
+
+    int flags = fcntl(stdout_pipe[0], F_GETFL, 0);
+    fcntl(stdout_pipe[0], F_SETFL, flags | O_NONBLOCK);
+
+    ssize_t bytes_read = read(stdout_pipe[0], captured_output, sizeof(captured_output) - 1);
+    if (bytes_read > 0) {
+        captured_output[bytes_read] = '\0';
+    }
+
+    close(stdout_pipe[0]);
+}
+
+static CPrintArg arg_int(int i) {
+    CPrintArg arg;
+    arg.type = CPRINT_ARG_INT;
+    arg.value.i = i;
+    return arg;
+}
+
+// ============================================================================
+// CONTADORES
+// ============================================================================
+
+TEST(enabled) {
+    CPrintStats stats = c_print_stats();
+    assert(stats.enabled);
+    for (int api = 0; api < CPRINT_API_COUNT; api++) assert(stats.calls[api] == 0);
+    assert(stats.bytes == 0);
+}
+
+TEST(c_print_bytes_match_output) {
+    start_capture();
+    c_print("ab{d} [{s:>6}] \\{x}\n", 42, "hi");
+    end_capture();
+
+    CPrintStats stats = c_print_stats();
+    assert(stats.calls[CPRINT_API_PRINT] == 1);
+    assert(stats.bytes == strlen(captured_output));
+    assert(stats.escape_bytes == 0);
+}
+
+TEST(escape_bytes) {
+    start_capture();
+    c_print("{s:red}\n", "x");
+    end_capture();
+
+    CPrintStats stats = c_print_stats();
+    assert(stats.escape_bytes == strlen("\033[31m") + strlen("\033[0m"));
+    assert(stats.bytes == strlen(captured_output));
+
+    // Mismo patrón por el motor compilado
+    c_print_stats_reset();
+    start_capture();
+    c_print_safe("{s:red}\n", "x");
+    end_capture();
+
+    stats = c_print_stats();
+    assert(stats.calls[CPRINT_API_SAFE] == 1);
+    assert(stats.escape_bytes == strlen("\033[31m") + strlen("\033[0m"));
+    assert(stats.bytes == strlen(captured_output));
+}
+
+TEST(cache_hits_and_misses) {
+    static const char pattern[] = "stats {d}\n";
+    clear_pattern_cache();
+
+    start_capture();
+    c_print_safe(pattern, 1);
+    c_print_safe(pattern, 2);
+    c_print_safe(pattern, 3);
+    end_capture();
+
+    CPrintStats stats = c_print_stats();
+    assert(stats.cache_misses == 1);
+    assert(stats.cache_hits == 2);
+}
+
+TEST(builder_allocations) {
+    CPrintBuilderStorage storage;
+    CPrintBuilder* b = cp_init(CP_BUILDER(&storage), NULL, 0);
+    char chunk[64];
+    memset(chunk, 'z', sizeof(chunk) - 1);
+    chunk[sizeof(chunk) - 1] = '\0';
+
+    cp_text(b, "small");
+    assert(c_print_stats().builder_allocs == 0);
+
+    for (int i = 0; i < 64; i++) cp_text(b, chunk);
+
+    CPrintStats stats = c_print_stats();
+    assert(stats.builder_allocs == 1);
+    assert(stats.builder_reallocs >= 1);
+
+    start_capture();
+    cp_print(b);
+    end_capture();
+
+    stats = c_print_stats();
+    assert(stats.calls[CPRINT_API_BUILDER] == 1);
+    assert(stats.bytes == cp_size(b));
+
+    cp_free(b);
+}
+
+static void* argv_worker(void* unused) {
+    CPrintArg args[1];
+    char buffer[32];
+    (void)unused;
+
+    for (int i = 0; i < CALLS_PER_THREAD; i++) {
+        args[0] = arg_int(i);
+        c_print_argv("n={d}", args, 1, buffer, sizeof(buffer));
+    }
+    return NULL;
+}
+
+TEST(threads_are_aggregated) {
+    pthread_t threads[THREADS];
+    for (int t = 0; t < THREADS; t++) {
+        int rc = pthread_create(&threads[t], NULL, argv_worker, NULL);
+        assert(rc == 0);
+    }
+    for (int t = 0; t < THREADS; t++) pthread_join(threads[t], NULL);
+
+    // Los hilos ya terminaron: sus contadores se conservan
+    CPrintStats stats = c_print_stats();
+    assert(stats.calls[CPRINT_API_ARGV] == THREADS * CALLS_PER_THREAD);
+    assert(stats.bytes == 0);
+
+    // Hilos nuevos reutilizan los bloques libres y siguen sumando
+    for (int t = 0; t < THREADS; t++) {
+        int rc = pthread_create(&threads[t], NULL, argv_worker, NULL);
+        assert(rc == 0);
+    }
+    for (int t = 0; t < THREADS; t++) pthread_join(threads[t], NULL);
+
+    stats = c_print_stats();
+    assert(stats.calls[CPRINT_API_ARGV] == 2 * THREADS * CALLS_PER_THREAD);
+}
+
+TEST(reset) {
+    char buffer[16];
+    CPrintArg args[1] = { arg_int(7) };
+
+    c_print_argv("{d}", args, 1, buffer, sizeof(buffer));
+    assert(c_print_stats().calls[CPRINT_API_ARGV] == 1);
+
+    c_print_stats_reset();
+    assert(c_print_stats().calls[CPRINT_API_ARGV] == 0);
+
+    c_print_argv("{d}", args, 1, buffer, sizeof(buffer));
+    assert(c_print_stats().calls[CPRINT_API_ARGV] == 1);
+}
+
+TEST(api_names) {
+    assert(strcmp(c_print_stats_api_name(CPRINT_API_PRINT), "c_print") == 0);
+    assert(strcmp(c_print_stats_api_name(CPRINT_API_BUILDER), "builder") == 0);
+    assert(strcmp(c_print_stats_api_name(CPRINT_API_COUNT), "unknown") == 0);
+}
+
+int main(void) {
+    fprintf(stderr, "\n");
+    fprintf(stderr, "═══════════════════════════════════════════════════════════\n");
+    fprintf(stderr, "  Runtime Stats - Unit Tests\n");
+    fprintf(stderr, "═══════════════════════════════════════════════════════════\n");
+    fprintf(stderr, "\n");
+
+    fprintf(stderr, "Counters:\n");
+    RUN_TEST(enabled);
+    RUN_TEST(c_print_bytes_match_output);
+    RUN_TEST(escape_bytes);
+    RUN_TEST(cache_hits_and_misses);
+    RUN_TEST(builder_allocations);
+    fprintf(stderr, "\n");
+
+    fprintf(stderr, "Aggregation:\n");
+    RUN_TEST(threads_are_aggregated);
+    RUN_TEST(reset);
+    RUN_TEST(api_names);
+    fprintf(stderr, "\n");
+
+    clear_pattern_cache();
+
+    fprintf(stderr, "═══════════════════════════════════════════════════════════\n");
+    fprintf(stderr, "  Results: %d tests passed ✓\n", tests_passed);
+    fprintf(stderr, "═══════════════════════════════════════════════════════════\n");
+    fprintf(stderr, "\n");
+
+    return 0;
+}
@@ -121,6 +121,24 @@ TEST(is_number_large_numbers) {
     assert(is_number("1234567890") == true);
 }
 
+// ============================================================================
+// TESTS PARA parse_digits()
+// ============================================================================
+
+TEST(parse_digits_like_atoi) {
+    assert(parse_digits("42") == 42);
+    assert(parse_digits("007") == 7);
+    assert(parse_digits("15abc") == 15);
+    assert(parse_digits("abc") == 0);
+    assert(parse_digits("") == 0);
+    assert(parse_digits(NULL) == 0);
+}
+
+TEST(parse_digits_saturates) {
+    assert(parse_digits("2147483647") == 2147483647);
+    assert(parse_digits("99999999999999") == 2147483647);
+}
+
 // ============================================================================
 // TESTS PARA trim_whitespace()
 // ============================================================================
@@ -313,6 +331,11 @@ int main(void) {
     RUN_TEST(is_number_large_numbers);
     printf("\n");
     
+    printf("Testing parse_digits():\n");
+    RUN_TEST(parse_digits_like_atoi);
+    RUN_TEST(parse_digits_saturates);
+    printf("\n");
+    
     printf("Testing trim_whitespace():\n");
     RUN_TEST(trim_whitespace_leading);
     RUN_TEST(trim_whitespace_trailing);
@@ -0,0 +1,199 @@
+/**
+ * @file test_typed.c
+ * @brief Tests unitarios para la API type-safe (c_print_typed)
+ */
+
+#include "c_print_typed.h"
+#include "pattern_compiler.h"
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include <unistd.h>
+#include <fcntl.h>
+
+#define TEST(name) static void test_##name(void)
+#define RUN_TEST(name) do { \
+    fprintf(stderr, "  Running: %s... ", #name); \
+    test_##name(); \
+    fprintf(stderr, "✓\n"); \
+    tests_passed++; \
+} while(0)
+
+static int tests_passed = 0;
+static char captured_output[4096];
+
+// Usar pipes para capturar stdout
+static int stdout_pipe[2];
+static int saved_stdout;
+
+static void start_capture(void) {
+    fflush(stdout);
+    saved_stdout = dup(STDOUT_FILENO);
+    int rc = pipe(stdout_pipe);
+    assert(rc == 0);
+    dup2(stdout_pipe[1], STDOUT_FILENO);
+    close(stdout_pipe[1]);
+    memset(captured_output, 0, sizeof(captured_output));
+}
+
+static void end_capture(void) {
+    fflush(stdout);
+
+    dup2(saved_stdout, STDOUT_FILENO);
+    close(saved_stdout);
+
+    int flags = fcntl(stdout_pipe[0], F_GETFL, 0);
+    fcntl(stdout_pipe[0], F_SETFL, flags | O_NONBLOCK);
+
+    ssize_t bytes_read = read(stdout_pipe[0], captured_output, sizeof(captured_output) - 1);
+    if (bytes_read > 0) {
+        captured_output[bytes_read] = '\0';
+    }
+
+    close(stdout_pipe[0]);
+}
+
+static void expect_output(const char* expected) {
+    if (strcmp(captured_output, expected) != 0) {
+        fprintf(stderr, "\n  Expected: '%s'\n  Got:      '%s'\n", expected, captured_output);
+        assert(0);
+    }
+}
+
+// ============================================================================
+// EQUIVALENCIA CON c_print
+// ============================================================================
+
+TEST(same_output_as_c_print) {
+    char reference[sizeof(captured_output)];
+    const char* pattern = "Hola {s:red}, saldo {d:,} ({f:.2}) hex {x:#} [{s:^9}] \\{ok}\n";
+
+    start_capture();
+    c_print(pattern, "Ana", 1234567, 3.14159, 255u, "mid");
+    end_capture();
+    strcpy(reference, captured_output);
+
+    start_capture();
+    C_PRINT(pattern, "Ana", 1234567, 3.14159, 255u, "mid");
+    end_capture();
+    expect_output(reference);
+}
+
+TEST(variadic_explicit_values) {
+    start_capture();
+    c_print_typed("{s} tiene {d} años", CPRINT_STR("Juan"), CPRINT_INT(25));
+    end_capture();
+    expect_output("Juan tiene 25 años");
+}
+
+TEST(array_with_count) {
+    CPrintValue values[] = { CPRINT_STR("x"), CPRINT_INT(7) };
+
+    start_capture();
+    c_print_typed_array("{s}={d:03}", values, 2);
+    end_capture();
+    expect_output("x=007");
+}
+
+TEST(auto_detection) {
+    start_capture();
+    C_PRINT("{c}{c} {l} {u} {f:.1}", 'o', (char)'k', 5000000000L, 3u, 2.5f);
+    end_capture();
+    expect_output("ok 5000000000 3 2.5");
+}
+
+TEST(more_than_ten_arguments) {
+    start_capture();
+    C_PRINT("{d}{d}{d}{d}{d}{d}{d}{d}{d}{d}{d}{d}", 1, 2, 3, 4, 5, 6, 7, 8, 9, 0, 1, 2);
+    end_capture();
+    expect_output("123456789012");
+}
+
+// ============================================================================
+// ERRORES DE TIPO
+// ============================================================================
+
+TEST(type_mismatch) {
+    start_capture();
+    C_PRINT("[{s}]", 500);
+    end_capture();
+    expect_output("[\033[1;31m{? expected string, got int}\033[0m]");
+}
+
+TEST(missing_argument) {
+    start_capture();
+    C_PRINT("{d} {d}", 1);
+    end_capture();
+    expect_output("1 \033[1;31m{? missing argument for 'd'}\033[0m");
+}
+
+TEST(unknown_format_keeps_arguments) {
+    start_capture();
+    C_PRINT("{z} {d}", 9);
+    end_capture();
+    expect_output("{?} 9");
+}
+
+// ============================================================================
+// VALIDACIÓN
+// ============================================================================
+
+TEST(validate_matches) {
+    CPrintValueType expected[] = { CPRINT_TYPE_STRING, CPRINT_TYPE_INT };
+    assert(c_print_validate("{s} {d}", 2, expected));
+}
+
+TEST(validate_rejects) {
+    CPrintValueType wrong_type[] = { CPRINT_TYPE_INT, CPRINT_TYPE_INT };
+    CPrintValueType one[] = { CPRINT_TYPE_STRING };
+
+    assert(!c_print_validate("{s} {d}", 2, wrong_type));
+    assert(!c_print_validate("{s} {d}", 1, one));
+}
+
+TEST(debug_args) {
+    start_capture();
+    c_print_debug_args("{s} {d}", CPRINT_STR("a"), CPRINT_INT(3));
+    end_capture();
+    expect_output("[C_PRINT DEBUG] Pattern: {s} {d}\n"
+                  "[C_PRINT DEBUG] Argument count: 2\n"
+                  "[C_PRINT DEBUG] Arg 0: string = \"a\"\n"
+                  "[C_PRINT DEBUG] Arg 1: int = 3\n");
+}
+
+int main(void) {
+    fprintf(stderr, "\n");
+    fprintf(stderr, "═══════════════════════════════════════════════════════════\n");
+    fprintf(stderr, "  Typed API - Unit Tests\n");
+    fprintf(stderr, "═══════════════════════════════════════════════════════════\n");
+    fprintf(stderr, "\n");
+
+    fprintf(stderr, "Output:\n");
+    RUN_TEST(same_output_as_c_print);
+    RUN_TEST(variadic_explicit_values);
+    RUN_TEST(array_with_count);
+    RUN_TEST(auto_detection);
+    RUN_TEST(more_than_ten_arguments);
+    fprintf(stderr, "\n");
+
+    fprintf(stderr, "Type errors:\n");
+    RUN_TEST(type_mismatch);
+    RUN_TEST(missing_argument);
+    RUN_TEST(unknown_format_keeps_arguments);
+    fprintf(stderr, "\n");
+
+    fprintf(stderr, "Validation:\n");
+    RUN_TEST(validate_matches);
+    RUN_TEST(validate_rejects);
+    RUN_TEST(debug_args);
+    fprintf(stderr, "\n");
+
+    clear_pattern_cache();
+
+    fprintf(stderr, "═══════════════════════════════════════════════════════════\n");
+    fprintf(stderr, "  Results: %d tests passed ✓\n", tests_passed);
+    fprintf(stderr, "═══════════════════════════════════════════════════════════\n");
+    fprintf(stderr, "\n");
+
+    return 0;
+}
@@ -0,0 +1,117 @@
+/**
+ * @file test_validated.c
+ * @brief Tests para C_PRINT en modo validado (C_PRINT_VALIDATED)
+ *
+ * Compilado con -DCPRINT_EXPECT_COMPILE_ERROR debe fallar: CTest lo usa
+ * para comprobar el rechazo en compile-time de tipos no soportados.
+ */
+
+#define C_PRINT_VALIDATED
+#include "c_print.h"
+#include "c_print_generic.h"
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include <unistd.h>
+#include <fcntl.h>
+
+#define TEST(name) static void test_##name(void)
+#define RUN_TEST(name) do { \
+    fprintf(stderr, "  Running: %s... ", #name); \
+    test_##name(); \
+    fprintf(stderr, "✓\n"); \
+    tests_passed++; \
+} while(0)
+
+static int tests_passed = 0;
+static char captured_output[2048];
+
+// Usar pipes para capturar stdout
+static int stdout_pipe[2];
+static int saved_stdout;
+
+static void start_capture(void) {
+    fflush(stdout);
+    saved_stdout = dup(STDOUT_FILENO);
+    int rc = pipe(stdout_pipe);
+    assert(rc == 0);
+    dup2(stdout_pipe[1], STDOUT_FILENO);
+    close(stdout_pipe[1]);
+    memset(captured_output, 0, sizeof(captured_output));
+}
+
+static void end_capture(void) {
+    fflush(stdout);
+
+    dup2(saved_stdout, STDOUT_FILENO);
+    close(saved_stdout);
+
+    int flags = fcntl(stdout_pipe[0], F_GETFL, 0);
+    fcntl(stdout_pipe[0], F_SETFL, flags | O_NONBLOCK);
+
+    ssize_t bytes_read = read(stdout_pipe[0], captured_output, sizeof(captured_output) - 1);
+    if (bytes_read > 0) {
+        captured_output[bytes_read] = '\0';
+    }
+
+    close(stdout_pipe[0]);
+}
+
+TEST(fast_path_matches_c_print) {
+    char reference[sizeof(captured_output)];
+
+    start_capture();
+    c_print("{s:red} {d:,} {f:.2} {x:#} {l}\n", "Ana", 1234567, 2.5, 255u, 9L);
+    end_capture();
+    strcpy(reference, captured_output);
+
+    start_capture();
+    C_PRINT("{s:red} {d:,} {f:.2} {x:#} {l}\n", "Ana", 1234567, 2.5f, 255u, 9L);
+    end_capture();
+    assert(strcmp(captured_output, reference) == 0);
+}
+
+TEST(supported_types_compile) {
+    char c = 'z';
+    unsigned char uc = 7;
+
+    start_capture();
+    C_PRINT("{c}{c}", c, uc);
+    end_capture();
+    assert(captured_output[0] == 'z' && captured_output[1] == 7);
+}
+
+TEST(pattern_still_checked_at_runtime) {
+    // En C el patrón no se valida al compilar: el mismatch se informa en runtime
+    start_capture();
+    C_PRINT("[{s}]", 5);
+    end_capture();
+    assert(strcmp(captured_output, "[\033[1;31m{? expected string, got int}\033[0m]") == 0);
+}
+
+#ifdef CPRINT_EXPECT_COMPILE_ERROR
+TEST(unsupported_type_rejected) {
+    short s = 1;
+    C_PRINT("{d}", s);      // short no tiene CPrintArgType: _Static_assert
+}
+#endif
+
+int main(void) {
+    fprintf(stderr, "\n");
+    fprintf(stderr, "═══════════════════════════════════════════════════════════\n");
+    fprintf(stderr, "  Validated C_PRINT - Unit Tests\n");
+    fprintf(stderr, "═══════════════════════════════════════════════════════════\n");
+    fprintf(stderr, "\n");
+
+    RUN_TEST(fast_path_matches_c_print);
+    RUN_TEST(supported_types_compile);
+    RUN_TEST(pattern_still_checked_at_runtime);
+    fprintf(stderr, "\n");
+
+    fprintf(stderr, "═══════════════════════════════════════════════════════════\n");
+    fprintf(stderr, "  Results: %d tests passed ✓\n", tests_passed);
+    fprintf(stderr, "═══════════════════════════════════════════════════════════\n");
+    fprintf(stderr, "\n");
+
+    return 0;
+}
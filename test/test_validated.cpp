@@ -0,0 +1,67 @@
+/**
+ * @file test_validated.cpp
+ * @brief Tests para la validación consteval de C_PRINT (C++20)
+ *
+ * Compilado con -DCPRINT_EXPECT_COMPILE_ERROR debe fallar: CTest lo usa
+ * para comprobar que un patrón incorrecto no compila.
+ */
+
+#include "c_print.h"
+#include "c_print_generic.h"
+#include <cassert>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+
+static char captured_output[2048];
+static int stdout_pipe[2];
+static int saved_stdout;
+
+static void start_capture() {
+    fflush(stdout);
+    saved_stdout = dup(STDOUT_FILENO);
+    int rc = pipe(stdout_pipe);
+    assert(rc == 0);
+    dup2(stdout_pipe[1], STDOUT_FILENO);
+    close(stdout_pipe[1]);
+    memset(captured_output, 0, sizeof(captured_output));
+}
+
+static void end_capture() {
+    fflush(stdout);
+
+    dup2(saved_stdout, STDOUT_FILENO);
+    close(saved_stdout);
+
+    int flags = fcntl(stdout_pipe[0], F_GETFL, 0);
+    fcntl(stdout_pipe[0], F_SETFL, flags | O_NONBLOCK);
+
+    ssize_t bytes_read = read(stdout_pipe[0], captured_output, sizeof(captured_output) - 1);
+    if (bytes_read > 0) {
+        captured_output[bytes_read] = '\0';
+    }
+
+    close(stdout_pipe[0]);
+}
+
+int main() {
+    fprintf(stderr, "\n  Validated C_PRINT (C++20 consteval)... ");
+
+    start_capture();
+    C_PRINT("{s:<6}|{d:05}|{f:.1}|{u}|{l:,}|{c}\\{x}\n", "ab", 42, 2.5f, 7u, 1234567LL, 'q');
+    end_capture();
+    assert(strcmp(captured_output, "ab    |00042|2.5|7|1,234,567|q{x}\n") == 0);
+
+    start_capture();
+    C_PRINT("sin campos {z}\n");
+    end_capture();
+    assert(strcmp(captured_output, "sin campos {?}\n") == 0);
+
+#ifdef CPRINT_EXPECT_COMPILE_ERROR
+    C_PRINT("{s}\n", 500);
+#endif
+
+    fprintf(stderr, "✓\n\n");
+    return 0;
+}
@@ -0,0 +1,214 @@
+/**
+ * @file test_writev.c
+ * @brief Tests unitarios para c_print_fd (salida con writev)
+ *
+ * El test define writev: al enlazarse en el ejecutable reemplaza al de
+ * libc y cuenta las llamadas y sus tramos antes de hacer la llamada al
+ * sistema. También puede limitar cuántos bytes acepta cada llamada para
+ * simular escrituras parciales.
+ */
+
+#include "c_print.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <unistd.h>
+#include <sys/uio.h>
+#include <sys/syscall.h>
+
+#define TEST(name) static void test_##name(void)
+#define RUN_TEST(name) do { \
+    fprintf(stderr, "  Running: %s... ", #name); \
+    test_##name(); \
+    fprintf(stderr, "✓\n"); \
+    tests_passed++; \
+} while(0)
+
+#define MAX_RECORDED 64
+
+static int tests_passed = 0;
+
+// ============================================================================
+// WRITEV INTERPUESTO
+// ============================================================================
+
+static int writev_calls;
+static int last_entries;
+static const void* recorded_bases[MAX_RECORDED];
+static size_t short_write;          // 0 = sin límite
+
+ssize_t writev(int fd, const struct iovec* iov, int count) {
+    writev_calls++;
+    last_entries = count;
+    for (int i = 0; i < count && i < MAX_RECORDED; i++) recorded_bases[i] = iov[i].iov_base;
+
+    if (short_write == 0) return syscall(SYS_writev, fd, iov, count);
+
+    // Solo los primeros short_write bytes del primer tramo
+    size_t len = iov[0].iov_len < short_write ? iov[0].iov_len : short_write;
+    return write(fd, iov[0].iov_base, len);
+}
+
+static void reset_counts(void) {
+    writev_calls = 0;
+    last_entries = 0;
+    short_write = 0;
+}
+
+static int base_recorded(const void* ptr) {
+    for (int i = 0; i < last_entries && i < MAX_RECORDED; i++) {
+        if (recorded_bases[i] == ptr) return 1;
+    }
+    return 0;
+}
+
+// ============================================================================
+// CAPTURA
+// ============================================================================
+
+static FILE* capture;
+static char captured[64 * 1024];
+
+static int start_capture(void) {
+    capture = tmpfile();
+    assert(capture);
+    reset_counts();
+    return fileno(capture);
+}
+
+static const char* end_capture(void) {
+    long size = lseek(fileno(capture), 0, SEEK_END);
+    assert(size >= 0 && size < (long)sizeof(captured));
+    ssize_t got = pread(fileno(capture), captured, (size_t)size, 0);
+    assert(got == size);
+    captured[size] = '\0';
+    fclose(capture);
+    return captured;
+}
+
+/**
+ * @brief c_print_fd debe producir lo mismo que c_snprint
+ */
+#define EXPECT_SAME(...) do { \
+    static char expected[16 * 1024]; \
+    size_t expected_len = c_snprint(expected, sizeof(expected), __VA_ARGS__); \
+    int fd = start_capture(); \
+    size_t written_ = c_print_fd(fd, __VA_ARGS__); \
+    const char* text_ = end_capture(); \
+    assert(written_ == expected_len); \
+    assert(strcmp(text_, expected) == 0); \
+} while(0)
+
+// ============================================================================
+// TEXTO
+// ============================================================================
+
+TEST(same_text_as_c_print) {
+    EXPECT_SAME("plain literal\n");
+    EXPECT_SAME("Hello {s:green:bold}! {d:05:cyan} {x:#} {b} {o:#}\n", "World", 42, 255u, 5u, 8u);
+    EXPECT_SAME("[{s:<10}][{s:>10}][{s:^11}]\n", "left", "right", "mid");
+    EXPECT_SAME("[{s:*^30}] [{d:_>8}]\n", "TITLE", 7);
+    EXPECT_SAME("{f:.2:,} {f:.1%:green} {d:,} {d:+}\n", 1234.56, 0.75, 1234567, 3);
+    EXPECT_SAME("{s:.3} {c} {u} {l}\n", "truncated", 'z', 7u, 123456789L);
+    EXPECT_SAME("{s} and {?} and {s}\n", "unknown", "after");
+    EXPECT_SAME("{s:red:>12}|{s:blue:<4}|\n", NULL, "x");
+}
+
+TEST(long_string_capped_like_c_print) {
+    static char long_text[3000];
+    memset(long_text, 'q', sizeof(long_text) - 1);
+    long_text[sizeof(long_text) - 1] = '\0';
+
+    EXPECT_SAME("<{s}>\n", long_text);
+    EXPECT_SAME("<{s:-^3000}>\n", "wide");
+}
+
+TEST(many_segments_need_several_writev) {
+    static char pattern[2048];
+    size_t len = 0;
+    for (int i = 0; i < 100; i++) {
+        len += (size_t)snprintf(pattern + len, sizeof(pattern) - len, "{s:red}.");
+    }
+    snprintf(pattern + len, sizeof(pattern) - len, "\n");
+
+    const char* s = "v";
+    EXPECT_SAME(pattern, s, s, s, s, s, s, s, s, s, s, s, s, s, s, s, s, s, s, s, s,
+                s, s, s, s, s, s, s, s, s, s, s, s, s, s, s, s, s, s, s, s,
+                s, s, s, s, s, s, s, s, s, s, s, s, s, s, s, s, s, s, s, s,
+                s, s, s, s, s, s, s, s, s, s, s, s, s, s, s, s, s, s, s, s,
+                s, s, s, s, s, s, s, s, s, s, s, s, s, s, s, s, s, s, s, s);
+    assert(writev_calls > 1);
+}
+
+// ============================================================================
+// TRAMOS
+// ============================================================================
+
+TEST(one_writev_per_line) {
+    int fd = start_capture();
+    c_print_fd(fd, "id={d} user={s:cyan} ok\n", 7, "alice");
+    end_capture();
+
+    assert(writev_calls == 1);
+    // "id=", "7 user=" (valor en scratch, literal aparte), escape, ...
+    assert(last_entries > 1 && last_entries <= 8);
+}
+
+TEST(strings_referenced_in_place) {
+    static const char user[] = "referenced";
+    int fd = start_capture();
+    c_print_fd(fd, "[{s}] [{s:>14}]\n", user, user);
+    const char* text = end_capture();
+    assert(strcmp(text, "[referenced] [    referenced]\n") == 0);
+
+    assert(writev_calls == 1);
+    assert(base_recorded(user));
+}
+
+TEST(partial_writes_completed) {
+    int fd = start_capture();
+    short_write = 3;
+    size_t written = c_print_fd(fd, "abc {d} {s:green} {s:*^9} end\n", 12345, "color", "pad");
+    short_write = 0;
+
+    const char* text = end_capture();
+    assert(strcmp(text, "abc 12345 \033[32mcolor\033[0m ***pad*** end\n") == 0);
+    assert(written == strlen(text));
+    assert(writev_calls > 5);
+}
+
+TEST(bad_descriptor) {
+    size_t bad_fd = c_print_fd(-1, "nothing {d}\n", 1);
+    size_t no_pattern = c_print_fd(1, NULL);
+    assert(bad_fd == 0);
+    assert(no_pattern == 0);
+}
+
+int main(void) {
+    fprintf(stderr, "\n");
+    fprintf(stderr, "═══════════════════════════════════════════════════════════\n");
+    fprintf(stderr, "  writev Output - Unit Tests\n");
+    fprintf(stderr, "═══════════════════════════════════════════════════════════\n");
+    fprintf(stderr, "\n");
+
+    fprintf(stderr, "Text:\n");
+    RUN_TEST(same_text_as_c_print);
+    RUN_TEST(long_string_capped_like_c_print);
+    RUN_TEST(many_segments_need_several_writev);
+    fprintf(stderr, "\n");
+
+    fprintf(stderr, "Segments:\n");
+    RUN_TEST(one_writev_per_line);
+    RUN_TEST(strings_referenced_in_place);
+    RUN_TEST(partial_writes_completed);
+    RUN_TEST(bad_descriptor);
+    fprintf(stderr, "\n");
+
+    fprintf(stderr, "═══════════════════════════════════════════════════════════\n");
+    fprintf(stderr, "  Results: %d tests passed ✓\n", tests_passed);
+    fprintf(stderr, "═══════════════════════════════════════════════════════════\n");
+    fprintf(stderr, "\n");
+
+    return 0;
+}